@@ -6,9 +6,12 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -20,7 +23,9 @@
 // clang-format on
 
 #include "Common/Align.h"
+#include "Common/ChunkFile.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/ScopeGuard.h"
@@ -38,6 +43,11 @@ enum : u32
 static std::mutex s_fatfs_mutex;
 static Common::FatFsCallbacks* s_callbacks;
 
+static std::mutex s_dirty_sectors_mutex;
+// Sectors of the SD image that the emulated SD card wrote to since the last sync. Unset when the
+// image and the SD folder aren't known to have been in sync at that point.
+static std::optional<std::vector<bool>> s_dirty_sectors;
+
 namespace
 {
 int SDCardDiskRead(File::IOFile* image, u8 pdrv, u8* buff, u32 sector, unsigned int count)
@@ -351,14 +361,193 @@ static u64 GetSize(const File::FSTEntry& entry)
   return size;
 }
 
+constexpr u32 SD_SYNC_MANIFEST_REVISION = 2;
+
+struct SDSyncManifest
+{
+  std::string image_path;
+  std::string folder_path;
+  u64 image_size = 0;
+  u64 image_mtime = 0;
+  SDSyncEntries entries;
+
+  void DoState(PointerWrap& p)
+  {
+    p.Do(image_path);
+    p.Do(folder_path);
+    p.Do(image_size);
+    p.Do(image_mtime);
+
+    // PointerWrap can't handle maps with non-trivial keys.
+    std::vector<std::pair<std::string, SDSyncEntry>> entry_list(entries.begin(), entries.end());
+    p.Do(entry_list);
+    if (p.IsReadMode())
+      entries = {entry_list.begin(), entry_list.end()};
+  }
+};
+
+// State shared by the recursive calls of Pack and Unpack.
+struct SyncState
+{
+  std::vector<u8> tmp_buffer = std::vector<u8>(MAX_CLUSTER_SIZE);
+
+  // Files that are unchanged compared to the previous sync are skipped.
+  SDSyncEntries old_entries;
+  SDSyncEntries new_entries;
+  u32 copied_files = 0;
+
+  // Only used by incremental unpacking, which needs to know which clusters of the image the
+  // emulated SD card wrote to.
+  std::optional<std::vector<bool>> dirty_clusters;
+  std::vector<u32> fat;
+  const FATFS* fs = nullptr;
+  FileChangeCallback before_file_change;
+};
+
+static std::string GetSDSyncManifestPath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "SDSyncManifest.bin";
+}
+
+static std::optional<SDSyncManifest> LoadSDSyncManifest(const std::string& image_path,
+                                                        const std::string& folder_path)
+{
+  File::IOFile file(GetSDSyncManifestPath(), "rb");
+  std::vector<u8> buffer(file.GetSize());
+  if (buffer.empty() || !file.ReadBytes(buffer.data(), buffer.size()))
+    return std::nullopt;
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  u32 revision = 0;
+  p.Do(revision);
+  if (revision != SD_SYNC_MANIFEST_REVISION)
+    return std::nullopt;
+
+  SDSyncManifest manifest;
+  manifest.DoState(p);
+  if (!p.IsReadMode() || manifest.image_path != image_path || manifest.folder_path != folder_path)
+    return std::nullopt;
+
+  return manifest;
+}
+
+static void SaveSDSyncManifest(SDSyncManifest& manifest)
+{
+  u32 revision = SD_SYNC_MANIFEST_REVISION;
+
+  // Measure the size of the buffer.
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  p_measure.Do(revision);
+  manifest.DoState(p_measure);
+  const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+
+  // Then actually do the write.
+  std::vector<u8> buffer(buffer_size);
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+  p.Do(revision);
+  manifest.DoState(p);
+
+  const std::string path = GetSDSyncManifestPath();
+  if (!File::CreateFullPath(path) ||
+      !File::IOFile(path, "wb").WriteBytes(buffer.data(), buffer_size))
+    WARN_LOG_FMT(COMMON, "Failed to write SD sync manifest to {}", path);
+}
+
+static void DeleteSDSyncManifest()
+{
+  File::Delete(GetSDSyncManifestPath(), File::IfAbsentBehavior::NoConsoleWarning);
+}
+
+static void SetSDImageInSync(bool in_sync)
+{
+  std::lock_guard lk(s_dirty_sectors_mutex);
+  if (in_sync)
+    s_dirty_sectors.emplace();
+  else
+    s_dirty_sectors.reset();
+}
+
+void MarkSDImageDirty(u64 offset, u64 size)
+{
+  std::lock_guard lk(s_dirty_sectors_mutex);
+  if (!s_dirty_sectors || size == 0)
+    return;
+
+  const u64 first = offset / SECTOR_SIZE;
+  const u64 end = (offset + size + SECTOR_SIZE - 1) / SECTOR_SIZE;
+  if (s_dirty_sectors->size() < end)
+    s_dirty_sectors->resize(end);
+  std::fill(s_dirty_sectors->begin() + first, s_dirty_sectors->begin() + end, true);
+}
+
+static std::string GetChildPath(const std::string& relative_path, std::string_view name)
+{
+  return relative_path.empty() ? std::string(name) : fmt::format("{}/{}", relative_path, name);
+}
+
+static u32 GetFATTimestamp(const FILINFO& info)
+{
+  return (static_cast<u32>(info.fdate) << 16) | info.ftime;
+}
+
+static std::optional<u32> ComputeFileCRC(const std::function<bool()>& cancelled,
+                                         const std::string& path, std::vector<u8>& tmp_buffer)
+{
+  File::IOFile file(path, "rb");
+  if (!file)
+    return std::nullopt;
+
+  u32 crc = StartCRC32();
+  u64 size = file.GetSize();
+  while (size > 0)
+  {
+    if (cancelled())
+      return std::nullopt;
+
+    const size_t chunk_size = static_cast<size_t>(std::min<u64>(size, tmp_buffer.size()));
+    if (!file.ReadBytes(tmp_buffer.data(), chunk_size))
+      return std::nullopt;
+
+    crc = UpdateCRC32(crc, tmp_buffer.data(), chunk_size);
+    size -= chunk_size;
+  }
+
+  return crc;
+}
+
 static bool Pack(const std::function<bool()>& cancelled, const File::FSTEntry& entry, bool is_root,
-                 std::vector<u8>& tmp_buffer)
+                 const std::string& relative_path, SyncState& state)
 {
   if (cancelled())
     return false;
 
   if (!entry.isDirectory)
   {
+    const u64 host_mtime = File::GetModificationTime(entry.physicalName);
+    const auto old_entry = state.old_entries.find(relative_path);
+    if (old_entry != state.old_entries.end() && !old_entry->second.is_directory &&
+        old_entry->second.size == entry.size)
+    {
+      // Files are often written again without changing, so compare the contents before copying.
+      SDSyncEntry unchanged_entry = old_entry->second;
+      bool is_unchanged = unchanged_entry.host_mtime == host_mtime;
+      if (!is_unchanged)
+      {
+        is_unchanged = ComputeFileCRC(cancelled, entry.physicalName, state.tmp_buffer) ==
+                       unchanged_entry.crc;
+        unchanged_entry.host_mtime = host_mtime;
+      }
+
+      if (is_unchanged)
+      {
+        state.new_entries[relative_path] = unchanged_entry;
+        return true;
+      }
+    }
+
     File::IOFile src(entry.physicalName, "rb");
     if (!src)
     {
@@ -366,9 +555,10 @@ static bool Pack(const std::function<bool()>& cancelled, const File::FSTEntry& e
       return false;
     }
 
+    // An existing file is overwritten in place, which reuses its clusters.
     FIL dst{};
     const auto open_error_code =
-        f_open(&dst, entry.virtualName.c_str(), FA_CREATE_ALWAYS | FA_WRITE);
+        f_open(&dst, entry.virtualName.c_str(), FA_OPEN_ALWAYS | FA_WRITE);
     if (open_error_code != FR_OK)
     {
       ERROR_LOG_FMT(COMMON, "Failed to open file {} in SD image: {}", entry.physicalName,
@@ -391,21 +581,23 @@ static bool Pack(const std::function<bool()>& cancelled, const File::FSTEntry& e
       return false;
     }
 
+    u32 crc = StartCRC32();
     u64 size = entry.size;
     while (size > 0)
     {
       if (cancelled())
         return false;
 
-      u32 chunk_size = static_cast<u32>(std::min(size, static_cast<u64>(tmp_buffer.size())));
-      if (!src.ReadBytes(tmp_buffer.data(), chunk_size))
+      u32 chunk_size = static_cast<u32>(std::min(size, static_cast<u64>(state.tmp_buffer.size())));
+      if (!src.ReadBytes(state.tmp_buffer.data(), chunk_size))
       {
         ERROR_LOG_FMT(COMMON, "Failed to read data from file at {}", entry.physicalName);
         return false;
       }
 
       u32 written_size;
-      const auto write_error_code = f_write(&dst, tmp_buffer.data(), chunk_size, &written_size);
+      const auto write_error_code =
+          f_write(&dst, state.tmp_buffer.data(), chunk_size, &written_size);
       if (write_error_code != FR_OK)
       {
         ERROR_LOG_FMT(COMMON, "Failed to write file {} to SD image: {}", entry.physicalName,
@@ -420,9 +612,19 @@ static bool Pack(const std::function<bool()>& cancelled, const File::FSTEntry& e
         return false;
       }
 
+      crc = UpdateCRC32(crc, state.tmp_buffer.data(), chunk_size);
       size -= chunk_size;
     }
 
+    const auto truncate_error_code = f_truncate(&dst);
+    if (truncate_error_code != FR_OK)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to truncate file {} in SD image: {}", entry.physicalName,
+                    FatFsErrorToString(truncate_error_code));
+      return false;
+    }
+
+    const u32 first_cluster = dst.obj.sclust;
     const auto close_error_code = f_close(&dst);
     if (close_error_code != FR_OK)
     {
@@ -437,17 +639,36 @@ static bool Pack(const std::function<bool()>& cancelled, const File::FSTEntry& e
       return false;
     }
 
+    FILINFO info{};
+    const auto stat_error_code = f_stat(entry.virtualName.c_str(), &info);
+    if (stat_error_code != FR_OK)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to stat file {} in SD image: {}", entry.physicalName,
+                    FatFsErrorToString(stat_error_code));
+      return false;
+    }
+
+    state.new_entries[relative_path] = {.size = entry.size,
+                                        .host_mtime = host_mtime,
+                                        .crc = crc,
+                                        .fat_timestamp = GetFATTimestamp(info),
+                                        .first_cluster = first_cluster};
+    ++state.copied_files;
     return true;
   }
 
   if (!is_root)
   {
-    const auto mkdir_error_code = f_mkdir(entry.virtualName.c_str());
-    if (mkdir_error_code != FR_OK)
+    const auto old_entry = state.old_entries.find(relative_path);
+    if (old_entry == state.old_entries.end() || !old_entry->second.is_directory)
     {
-      ERROR_LOG_FMT(COMMON, "Failed to make directory {} in SD image: {}", entry.physicalName,
-                    FatFsErrorToString(mkdir_error_code));
-      return false;
+      const auto mkdir_error_code = f_mkdir(entry.virtualName.c_str());
+      if (mkdir_error_code != FR_OK)
+      {
+        ERROR_LOG_FMT(COMMON, "Failed to make directory {} in SD image: {}", entry.physicalName,
+                      FatFsErrorToString(mkdir_error_code));
+        return false;
+      }
     }
 
     const auto chdir_error_code = f_chdir(entry.virtualName.c_str());
@@ -457,11 +678,13 @@ static bool Pack(const std::function<bool()>& cancelled, const File::FSTEntry& e
                     FatFsErrorToString(chdir_error_code));
       return false;
     }
+
+    state.new_entries[relative_path] = {.is_directory = true};
   }
 
   for (const File::FSTEntry& child : entry.children)
   {
-    if (!Pack(cancelled, child, false, tmp_buffer))
+    if (!Pack(cancelled, child, false, GetChildPath(relative_path, child.virtualName), state))
       return false;
   }
 
@@ -486,6 +709,96 @@ static void SortFST(File::FSTEntry* root)
     SortFST(&child);
 }
 
+static void CollectPaths(const File::FSTEntry& entry, const std::string& relative_path,
+                         std::map<std::string, bool>* is_directory)
+{
+  for (const File::FSTEntry& child : entry.children)
+  {
+    const std::string child_path = GetChildPath(relative_path, child.virtualName);
+    is_directory->emplace(child_path, child.isDirectory);
+    if (child.isDirectory)
+      CollectPaths(child, child_path, is_directory);
+  }
+}
+
+// Updates the files in an existing SD image that changed in the SD folder since the last sync,
+// instead of building a new image from scratch.
+static bool PackIncrementally(const std::function<bool()>& cancelled, const File::FSTEntry& root,
+                              SDSyncManifest& manifest, SDCardFatFsCallbacks& callbacks)
+{
+  if (File::GetSize(manifest.image_path) != manifest.image_size ||
+      File::GetModificationTime(manifest.image_path) != manifest.image_mtime)
+  {
+    INFO_LOG_FMT(COMMON, "SD image {} was modified since the last sync", manifest.image_path);
+    return false;
+  }
+
+  File::IOFile image;
+  callbacks.m_image = &image;
+  if (!image.Open(manifest.image_path, "r+b"))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open SD image at {}", manifest.image_path);
+    return false;
+  }
+
+  // If this fails halfway, the image no longer matches the manifest.
+  DeleteSDSyncManifest();
+
+  FATFS fs{};
+  const auto mount_error_code = f_mount(&fs, "", 0);
+  if (mount_error_code != FR_OK)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to mount SD image filesystem: {}",
+                  FatFsErrorToString(mount_error_code));
+    return false;
+  }
+  Common::ScopeGuard unmount_guard{[] { f_unmount(""); }};
+
+  // Delete removed files first to make room for the new ones. Going backwards deletes the
+  // contents of a directory before the directory itself.
+  std::map<std::string, bool> is_directory;
+  CollectPaths(root, "", &is_directory);
+  for (auto it = manifest.entries.rbegin(); it != manifest.entries.rend(); ++it)
+  {
+    const auto host_entry = is_directory.find(it->first);
+    if (host_entry != is_directory.end() && host_entry->second == it->second.is_directory)
+      continue;
+
+    const auto unlink_error_code = f_unlink(it->first.c_str());
+    if (unlink_error_code != FR_OK && unlink_error_code != FR_NO_FILE)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to delete {} from SD image: {}", it->first,
+                    FatFsErrorToString(unlink_error_code));
+      return false;
+    }
+  }
+
+  SyncState state;
+  state.old_entries = std::move(manifest.entries);
+  if (!Pack(cancelled, root, true, "", state))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to update SD image at {} from folder {}", manifest.image_path,
+                  manifest.folder_path);
+    return false;
+  }
+
+  unmount_guard.Exit();  // unmount before closing the image
+
+  if (!image.Close())
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to close SD image at {}", manifest.image_path);
+    return false;
+  }
+
+  manifest.image_mtime = File::GetModificationTime(manifest.image_path);
+  manifest.entries = std::move(state.new_entries);
+  SaveSDSyncManifest(manifest);
+
+  INFO_LOG_FMT(COMMON, "Successfully updated SD image at {} from folder {} ({} files copied)",
+               manifest.image_path, manifest.folder_path, state.copied_files);
+  return true;
+}
+
 bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool deterministic)
 {
   const std::string source_dir = File::GetUserPath(D_WIISDCARDSYNCFOLDER_IDX);
@@ -508,7 +821,8 @@ bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool determin
   if (!CheckIfFATCompatible(root))
     return false;
 
-  u64 size = Config::Get(Config::MAIN_WII_SD_CARD_FILESIZE);
+  const u64 configured_size = Config::Get(Config::MAIN_WII_SD_CARD_FILESIZE);
+  u64 size = configured_size;
   if (size == 0)
   {
     size = GetSize(root);
@@ -521,10 +835,35 @@ bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool determin
   SDCardFatFsCallbacks callbacks;
   s_callbacks = &callbacks;
   Common::ScopeGuard callbacks_guard{[] { s_callbacks = nullptr; }};
+  callbacks.m_deterministic = deterministic;
+
+  SetSDImageInSync(false);
+
+  // What an incremental sync produces depends on what was in the image before, so it can't be
+  // used when the image has to be deterministic.
+  if (!deterministic && Config::Get(Config::MAIN_WII_SD_CARD_INCREMENTAL_SYNC))
+  {
+    std::optional<SDSyncManifest> manifest = LoadSDSyncManifest(image_path, source_dir);
+    if (manifest && (configured_size == 0 ||
+                     AlignUp(configured_size, MAX_CLUSTER_SIZE) == manifest->image_size))
+    {
+      if (PackIncrementally(cancelled, root, *manifest, callbacks))
+      {
+        SetSDImageInSync(true);
+        return true;
+      }
+
+      if (cancelled())
+        return false;
+
+      WARN_LOG_FMT(COMMON, "Incremental SD card sync failed, rebuilding SD image {}", image_path);
+    }
+  }
+
+  DeleteSDSyncManifest();
 
   File::IOFile image;
   callbacks.m_image = &image;
-  callbacks.m_deterministic = deterministic;
 
   const std::string temp_image_path = File::GetTempFilenameForAtomicWrite(image_path);
   if (!image.Open(temp_image_path, "w+b"))
@@ -552,9 +891,9 @@ bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool determin
   options.n_root = 0;   // Number of root directory entries: automatic (and unused for FAT32)
   options.au_size = 0;  // Cluster size: automatic
 
-  std::vector<u8> tmp_buffer(MAX_CLUSTER_SIZE);
+  SyncState state;
   const auto mkfs_error_code =
-      f_mkfs("", &options, tmp_buffer.data(), static_cast<UINT>(tmp_buffer.size()));
+      f_mkfs("", &options, state.tmp_buffer.data(), static_cast<UINT>(state.tmp_buffer.size()));
   if (mkfs_error_code != FR_OK)
   {
     ERROR_LOG_FMT(COMMON, "Failed to initialize SD image filesystem: {}",
@@ -572,7 +911,7 @@ bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool determin
   }
   Common::ScopeGuard unmount_guard{[] { f_unmount(""); }};
 
-  if (!Pack(cancelled, root, true, tmp_buffer))
+  if (!Pack(cancelled, root, true, "", state))
   {
     ERROR_LOG_FMT(COMMON, "Failed to pack folder {} to SD image at {}", source_dir,
                   temp_image_path);
@@ -595,12 +934,53 @@ bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool determin
 
   image_delete_guard.Dismiss();  // no need to delete the temp file anymore after the rename
 
+  SDSyncManifest manifest{image_path, source_dir, size, File::GetModificationTime(image_path),
+                          std::move(state.new_entries)};
+  SaveSDSyncManifest(manifest);
+  SetSDImageInSync(true);
+
   INFO_LOG_FMT(COMMON, "Successfully packed folder {} to SD image at {}", source_dir, image_path);
   return true;
 }
 
+// Returns whether a file in the SD image may differ from the SD folder since the last sync.
+static bool WasChangedInImage(const FIL& file, const std::string& path,
+                              const std::string& relative_path, u32 fat_timestamp,
+                              const SyncState& state)
+{
+  const auto old_entry = state.old_entries.find(relative_path);
+  if (old_entry == state.old_entries.end() || old_entry->second.is_directory ||
+      old_entry->second.size != file.obj.objsize ||
+      old_entry->second.fat_timestamp != fat_timestamp ||
+      old_entry->second.first_cluster != file.obj.sclust || !File::IsFile(path))
+  {
+    return true;
+  }
+
+  // Overwriting a file in place only changes its clusters, so follow its cluster chain.
+  const std::vector<bool>& dirty_clusters = *state.dirty_clusters;
+  u32 cluster = file.obj.sclust;
+  for (u32 i = 0; cluster >= 2 && cluster < state.fs->n_fatent; ++i)
+  {
+    // A chain that is longer than the FAT has a loop, so the FAT can't be trusted.
+    if (dirty_clusters[cluster] || i == state.fs->n_fatent)
+      return true;
+    cluster = state.fat[cluster] & 0x0FFFFFFF;
+  }
+
+  return false;
+}
+
+static bool IsPathTraversalAttack(std::string_view name)
+{
+  return (name.find("\\") != std::string_view::npos) ||
+         (name.find('/') != std::string_view::npos) ||
+         std::ranges::all_of(name, [](char c) { return c == '.'; });
+}
+
 static bool Unpack(const std::function<bool()>& cancelled, const std::string path,
-                   bool is_directory, const char* name, std::vector<u8>& tmp_buffer)
+                   bool is_directory, const char* name, const std::string& relative_path,
+                   u32 fat_timestamp, SyncState& state)
 {
   if (cancelled())
     return false;
@@ -616,6 +996,17 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
       return false;
     }
 
+    if (state.dirty_clusters &&
+        !WasChangedInImage(src, path, relative_path, fat_timestamp, state))
+    {
+      state.new_entries[relative_path] = state.old_entries.at(relative_path);
+      f_close(&src);
+      return true;
+    }
+
+    if (state.before_file_change)
+      state.before_file_change(relative_path);
+
     File::IOFile dst(path, "wb");
     if (!dst)
     {
@@ -623,15 +1014,18 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
       return false;
     }
 
-    u32 size = f_size(&src);
+    u32 crc = StartCRC32();
+    const u32 file_size = f_size(&src);
+    const u32 first_cluster = src.obj.sclust;
+    u32 size = file_size;
     while (size > 0)
     {
       if (cancelled())
         return false;
 
-      u32 chunk_size = std::min(size, static_cast<u32>(tmp_buffer.size()));
+      u32 chunk_size = std::min(size, static_cast<u32>(state.tmp_buffer.size()));
       u32 read_size;
-      const auto read_error_code = f_read(&src, tmp_buffer.data(), chunk_size, &read_size);
+      const auto read_error_code = f_read(&src, state.tmp_buffer.data(), chunk_size, &read_size);
       if (read_error_code != FR_OK)
       {
         ERROR_LOG_FMT(COMMON, "Failed to read from file {} in SD image: {}", path,
@@ -646,12 +1040,13 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
         return false;
       }
 
-      if (!dst.WriteBytes(tmp_buffer.data(), chunk_size))
+      if (!dst.WriteBytes(state.tmp_buffer.data(), chunk_size))
       {
         ERROR_LOG_FMT(COMMON, "Failed to write to file {}", path);
         return false;
       }
 
+      crc = UpdateCRC32(crc, state.tmp_buffer.data(), chunk_size);
       size -= chunk_size;
     }
 
@@ -669,6 +1064,12 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
       return false;
     }
 
+    state.new_entries[relative_path] = {.size = file_size,
+                                        .host_mtime = File::GetModificationTime(path),
+                                        .crc = crc,
+                                        .fat_timestamp = fat_timestamp,
+                                        .first_cluster = first_cluster};
+    ++state.copied_files;
     return true;
   }
 
@@ -686,6 +1087,9 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
     return false;
   }
 
+  if (!relative_path.empty())
+    state.new_entries[relative_path] = {.is_directory = true};
+
   DIR directory{};
   const auto opendir_error_code = f_opendir(&directory, ".");
   if (opendir_error_code != FR_OK)
@@ -719,11 +1123,7 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
     const std::string_view childname = entry.fname;
 
     // Check for path traversal attacks.
-    const bool is_path_traversal_attack =
-        (childname.find("\\") != std::string_view::npos) ||
-        (childname.find('/') != std::string_view::npos) ||
-        std::ranges::all_of(childname, [](char c) { return c == '.'; });
-    if (is_path_traversal_attack)
+    if (IsPathTraversalAttack(childname))
     {
       ERROR_LOG_FMT(
           COMMON,
@@ -733,7 +1133,8 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
     }
 
     if (!Unpack(cancelled, fmt::format("{}/{}", path, childname), entry.fattrib & AM_DIR,
-                entry.fname, tmp_buffer))
+                entry.fname, GetChildPath(relative_path, childname),
+                GetFATTimestamp(entry), state))
     {
       return false;
     }
@@ -758,6 +1159,129 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
   return true;
 }
 
+std::optional<SDSyncEntries> UnpackChangedFiles(const std::function<bool()>& cancelled,
+                                                const std::string& folder,
+                                                SDSyncEntries old_entries,
+                                                const std::vector<bool>& dirty_sectors,
+                                                const FileChangeCallback& before_file_change)
+{
+  // Mount immediately so that the layout of the filesystem is known.
+  FATFS fs{};
+  const auto mount_error_code = f_mount(&fs, "", 1);
+  if (mount_error_code != FR_OK)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to mount SD image file system: {}",
+                  FatFsErrorToString(mount_error_code));
+    return std::nullopt;
+  }
+  Common::ScopeGuard unmount_guard{[] { f_unmount(""); }};
+
+  if (fs.fs_type != FS_FAT32)
+    return std::nullopt;
+
+  SyncState state;
+  state.fs = &fs;
+  state.fat.resize(static_cast<size_t>(fs.fsize) * SECTOR_SIZE / sizeof(u32));
+  if (s_callbacks->DiskRead(0, reinterpret_cast<u8*>(state.fat.data()),
+                            static_cast<u32>(fs.fatbase), fs.fsize) != RES_OK)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to read FAT of SD image");
+    return std::nullopt;
+  }
+
+  std::vector<bool>& dirty_clusters = state.dirty_clusters.emplace(fs.n_fatent);
+  for (u64 sector = fs.database; sector < dirty_sectors.size(); ++sector)
+  {
+    const u64 cluster = (sector - fs.database) / fs.csize + 2;
+    if (dirty_sectors[sector] && cluster < fs.n_fatent)
+      dirty_clusters[cluster] = true;
+  }
+
+  const std::string folder_without_slash = folder.substr(0, folder.length() - 1);
+  state.old_entries = std::move(old_entries);
+  state.before_file_change = before_file_change;
+  if (!Unpack(cancelled, folder_without_slash, true, "", "", 0, state))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to update folder {} from SD image", folder);
+    return std::nullopt;
+  }
+
+  // Delete what was deleted from the image. Going backwards deletes the contents of a directory
+  // before the directory itself.
+  for (auto it = state.old_entries.rbegin(); it != state.old_entries.rend(); ++it)
+  {
+    if (state.new_entries.contains(it->first))
+      continue;
+
+    const std::string path = folder + it->first;
+    if (!it->second.is_directory && state.before_file_change)
+      state.before_file_change(it->first);
+
+    const bool deleted = it->second.is_directory ?
+                             File::DeleteDirRecursively(path) :
+                             File::Delete(path, File::IfAbsentBehavior::NoConsoleWarning);
+    if (!deleted)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to delete {}", path);
+      return std::nullopt;
+    }
+  }
+
+  INFO_LOG_FMT(COMMON, "Successfully updated folder {} from SD image ({} files copied)", folder,
+               state.copied_files);
+  return std::move(state.new_entries);
+}
+
+// Unpacks only the files that the emulated SD card changed since the last sync, directly into the
+// existing SD folder.
+static bool UnpackIncrementally(const std::function<bool()>& cancelled, SDSyncManifest& manifest,
+                                const std::vector<bool>& dirty_sectors,
+                                SDCardFatFsCallbacks& callbacks)
+{
+  if (File::GetSize(manifest.image_path) != manifest.image_size ||
+      !File::IsDirectory(manifest.folder_path))
+  {
+    return false;
+  }
+
+  if (std::ranges::find(dirty_sectors, true) == dirty_sectors.end())
+  {
+    if (File::GetModificationTime(manifest.image_path) != manifest.image_mtime)
+    {
+      INFO_LOG_FMT(COMMON, "SD image {} was modified outside of emulation", manifest.image_path);
+      return false;
+    }
+
+    INFO_LOG_FMT(COMMON, "SD image {} was not written to since the last sync", manifest.image_path);
+    return true;
+  }
+
+  File::IOFile image;
+  callbacks.m_image = &image;
+  if (!image.Open(manifest.image_path, "r+b"))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open SD image at {}", manifest.image_path);
+    return false;
+  }
+
+  // If this fails halfway, the SD folder no longer matches the manifest.
+  DeleteSDSyncManifest();
+
+  std::optional<SDSyncEntries> new_entries = UnpackChangedFiles(
+      cancelled, manifest.folder_path, std::move(manifest.entries), dirty_sectors, {});
+  if (!new_entries)
+    return false;
+
+  // even if this fails the conversion has already succeeded
+  if (!image.Close())
+    ERROR_LOG_FMT(COMMON, "Failed to close SD image {}", manifest.image_path);
+
+  manifest.image_mtime = File::GetModificationTime(manifest.image_path);
+  manifest.entries = std::move(*new_entries);
+  SaveSDSyncManifest(manifest);
+  return true;
+}
+
 bool SyncSDImageToSDFolder(const std::function<bool()>& cancelled)
 {
   const std::string image_path = File::GetUserPath(F_WIISDCARDIMAGE_IDX);
@@ -773,13 +1297,40 @@ bool SyncSDImageToSDFolder(const std::function<bool()>& cancelled)
   INFO_LOG_FMT(COMMON, "Starting SD card conversion from file {} to folder {}", image_path,
                target_dir);
 
-  File::IOFile image;
-  callbacks.m_image = &image;
-
   // this shouldn't matter since we're not modifying the SD image here, but initialize it to
   // something consistent just in case
   callbacks.m_deterministic = true;
 
+  std::optional<std::vector<bool>> dirty_sectors;
+  {
+    std::lock_guard dirty_lk(s_dirty_sectors_mutex);
+    dirty_sectors = std::exchange(s_dirty_sectors, std::nullopt);
+  }
+
+  if (dirty_sectors && Config::Get(Config::MAIN_WII_SD_CARD_INCREMENTAL_SYNC))
+  {
+    std::optional<SDSyncManifest> manifest = LoadSDSyncManifest(image_path, target_dir);
+    if (manifest)
+    {
+      if (UnpackIncrementally(cancelled, *manifest, *dirty_sectors, callbacks))
+      {
+        SetSDImageInSync(true);
+        return true;
+      }
+
+      if (cancelled())
+        return false;
+
+      WARN_LOG_FMT(COMMON, "Incremental SD card sync failed, unpacking all of SD image {}",
+                   image_path);
+    }
+  }
+
+  DeleteSDSyncManifest();
+
+  File::IOFile image;
+  callbacks.m_image = &image;
+
   if (!image.Open(image_path, "r+b"))
   {
     ERROR_LOG_FMT(COMMON, "Failed to open SD image at {}", image_path);
@@ -814,8 +1365,8 @@ bool SyncSDImageToSDFolder(const std::function<bool()>& cancelled)
     }
   }
 
-  std::vector<u8> tmp_buffer(MAX_CLUSTER_SIZE);
-  if (!Unpack(cancelled, target_dir_without_slash, true, "", tmp_buffer))
+  SyncState state;
+  if (!Unpack(cancelled, target_dir_without_slash, true, "", "", 0, state))
   {
     ERROR_LOG_FMT(COMMON, "Failed to unpack SD image {} to {}", image_path, target_dir);
     File::DeleteDirRecursively(target_dir_without_slash);
@@ -833,6 +1384,11 @@ bool SyncSDImageToSDFolder(const std::function<bool()>& cancelled)
   if (!image.Close())
     ERROR_LOG_FMT(COMMON, "Failed to close SD image {}", image_path);
 
+  SDSyncManifest manifest{image_path, target_dir, File::GetSize(image_path),
+                          File::GetModificationTime(image_path), std::move(state.new_entries)};
+  SaveSDSyncManifest(manifest);
+  SetSDImageInSync(true);
+
   INFO_LOG_FMT(COMMON, "Successfully unpacked SD image {} to {}", image_path, target_dir);
   return true;
 }
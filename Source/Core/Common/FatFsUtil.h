@@ -4,6 +4,10 @@
 #pragma once
 
 #include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
@@ -13,9 +17,45 @@ namespace Common
 static constexpr auto SD_PACK_TEXT = _trans("Pack SD Card Now");
 static constexpr auto SD_UNPACK_TEXT = _trans("Unpack SD Card Now");
 
+// Unless incremental sync is disabled, these only copy what changed since the last sync in either
+// direction, and fall back to copying everything when that can't be determined.
 bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool deterministic);
 bool SyncSDImageToSDFolder(const std::function<bool()>& cancelled);
 
+// Records a write of the emulated SD card to the SD image, so that the next SyncSDImageToSDFolder
+// only has to unpack the files stored in the written sectors.
+void MarkSDImageDirty(u64 offset, u64 size);
+
+// What the last sync wrote to both the SD folder and the SD image for one file or directory.
+struct SDSyncEntry
+{
+  bool is_directory = false;
+  u64 size = 0;
+  u64 host_mtime = 0;
+  u32 crc = 0;
+  // FAT modification date in the upper and time in the lower 16 bits.
+  u32 fat_timestamp = 0;
+  // Renaming files only changes which directory entry points to which clusters.
+  u32 first_cluster = 0;
+};
+
+// Keyed by the path relative to the root of the SD card, with / as the separator.
+using SDSyncEntries = std::map<std::string, SDSyncEntry>;
+
+using FileChangeCallback = std::function<void(const std::string& relative_path)>;
+
+// Copies the files of the FAT32 filesystem provided by the current callbacks that changed since
+// old_entries was recorded into folder (which ends with a separator), and deletes the ones that
+// were removed. A file counts as changed if its directory entry differs or if any of its clusters
+// were written to according to dirty_sectors. before_file_change, if set, is called before a file
+// in folder is overwritten or deleted. Returns the entries after the update.
+// Must be called from RunInFatFsContext.
+std::optional<SDSyncEntries> UnpackChangedFiles(const std::function<bool()>& cancelled,
+                                                const std::string& folder,
+                                                SDSyncEntries old_entries,
+                                                const std::vector<bool>& dirty_sectors,
+                                                const FileChangeCallback& before_file_change);
+
 class FatFsCallbacks
 {
 public:
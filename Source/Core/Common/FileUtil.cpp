@@ -378,6 +378,16 @@ u64 GetSize(FILE* f)
   return size;
 }
 
+// Returns the time a path was last modified, in an unspecified but consistent unit, or 0 on error
+u64 GetModificationTime(const std::string& path)
+{
+  std::error_code error;
+  const auto time = fs::last_write_time(StringToPath(path), error);
+  if (error)
+    return 0;
+  return static_cast<u64>(time.time_since_epoch().count());
+}
+
 // creates an empty file filename, returns true on success
 bool CreateEmptyFile(const std::string& filename)
 {
@@ -154,6 +154,10 @@ u64 GetSize(const std::string& path);
 // Overloaded GetSize, accepts FILE*
 u64 GetSize(FILE* f);
 
+// Returns the time a path was last modified, in an unspecified but consistent unit, or 0 on error.
+// Only useful for comparing against earlier results for the same path.
+u64 GetModificationTime(const std::string& path);
+
 // Creates a single directory. Returns true if successful or if the path already exists.
 bool CreateDir(const std::string& filename);
 
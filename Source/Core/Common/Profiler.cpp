@@ -4,13 +4,21 @@
 #include "Common/Profiler.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <iomanip>
 #include <ios>
+#include <memory>
 #include <sstream>
+#include <string_view>
+#include <vector>
 
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Thread.h"
 #include "Common/Timer.h"
 
 namespace Common
@@ -162,4 +170,162 @@ std::string Profiler::Read()
 
   return buffer.str();
 }
+
+namespace
+{
+struct TraceEvent
+{
+  const char* name;
+  u64 begin_ns;
+  u64 end_ns;
+};
+
+struct ThreadTrace
+{
+  static constexpr u64 SIZE = 0x20000;
+
+  int thread_id;
+  std::string name;
+  std::unique_ptr<TraceEvent[]> events = std::make_unique<TraceEvent[]>(SIZE);
+  std::atomic<u64> write_index = 0;
+};
+
+// The traces of threads that have exited are kept, since their zones can still be exported.
+std::mutex s_trace_mutex;
+std::vector<std::unique_ptr<ThreadTrace>> s_thread_traces;
+std::atomic<u64> s_trace_start_ns = 0;
+
+thread_local ThreadTrace* t_thread_trace = nullptr;
+thread_local std::string t_thread_name;
+
+void AppendEscaped(std::string* out, std::string_view str)
+{
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      *out += '\\';
+    if (static_cast<unsigned char>(c) < 0x20)
+      *out += fmt::format("\\u{:04x}", static_cast<int>(c));
+    else
+      *out += c;
+  }
+}
+}  // namespace
+
+std::atomic<bool> ProfilerTrace::s_enabled = false;
+
+void ProfilerTrace::Start()
+{
+  // The ring buffers can't be cleared while other threads write to them, so older events are
+  // skipped when the trace is written instead.
+  s_trace_start_ns = NowNs();
+  s_enabled = true;
+}
+
+void ProfilerTrace::Stop()
+{
+  s_enabled = false;
+}
+
+u64 ProfilerTrace::NowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void ProfilerTrace::SetThreadName(const char* name)
+{
+  t_thread_name = name;
+  if (t_thread_trace)
+  {
+    std::lock_guard lk(s_trace_mutex);
+    t_thread_trace->name = name;
+  }
+}
+
+void ProfilerTrace::AddZone(const char* name, u64 begin_ns, u64 end_ns)
+{
+  if (!t_thread_trace)
+  {
+    auto trace = std::make_unique<ThreadTrace>();
+    trace->thread_id = CurrentThreadId();
+    trace->name = t_thread_name;
+    t_thread_trace = trace.get();
+
+    std::lock_guard lk(s_trace_mutex);
+    s_thread_traces.push_back(std::move(trace));
+  }
+
+  // Only this thread writes to its buffer, so the index only has to be published.
+  const u64 index = t_thread_trace->write_index.load(std::memory_order_relaxed);
+  t_thread_trace->events[index % ThreadTrace::SIZE] = {name, begin_ns, end_ns};
+  t_thread_trace->write_index.store(index + 1, std::memory_order_release);
+}
+
+bool ProfilerTrace::WriteChromeTrace(const std::string& path)
+{
+  File::IOFile file(path, "w");
+  if (!file)
+    return false;
+
+  const u64 start_ns = s_trace_start_ns;
+  std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  const auto begin_event = [&] {
+    if (!first)
+      out += ',';
+    out += '\n';
+    first = false;
+  };
+
+  std::lock_guard lk(s_trace_mutex);
+  for (const std::unique_ptr<ThreadTrace>& trace : s_thread_traces)
+  {
+    begin_event();
+    out += fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")",
+                       trace->thread_id);
+    AppendEscaped(&out, trace->name.empty() ? "Unnamed thread" : trace->name);
+    out += "\"}}";
+
+    // The thread may still be adding zones, which can overwrite the oldest ones while they are
+    // being copied. Those are dropped by checking the write index again afterwards, including the
+    // one that the thread may be in the middle of overwriting.
+    const u64 end = trace->write_index.load(std::memory_order_acquire);
+    const u64 begin = end > ThreadTrace::SIZE ? end - ThreadTrace::SIZE : 0;
+    std::vector<TraceEvent> events;
+    events.reserve(end - begin);
+    for (u64 i = begin; i < end; ++i)
+      events.push_back(trace->events[i % ThreadTrace::SIZE]);
+    const u64 new_end = trace->write_index.load(std::memory_order_acquire);
+    const u64 first_valid =
+        std::max(begin, new_end >= ThreadTrace::SIZE ? new_end + 1 - ThreadTrace::SIZE : 0);
+
+    for (u64 i = first_valid; i < end; ++i)
+    {
+      const TraceEvent& event = events[i - begin];
+      if (event.begin_ns < start_ns)
+        continue;
+
+      const u64 ts_ns = event.begin_ns - start_ns;
+      const u64 dur_ns = event.end_ns - event.begin_ns;
+      begin_event();
+      out += R"({"name":")";
+      AppendEscaped(&out, event.name);
+      out += fmt::format(R"(","ph":"X","pid":1,"tid":{},"ts":{}.{:03},"dur":{}.{:03}}})",
+                         trace->thread_id, ts_ns / 1000, ts_ns % 1000, dur_ns / 1000,
+                         dur_ns % 1000);
+    }
+
+    if (out.size() > 0x100000)
+    {
+      if (!file.WriteString(out))
+        return false;
+      out.clear();
+    }
+  }
+
+  out += "\n]}\n";
+  return file.WriteString(out);
+}
 }  // namespace Common
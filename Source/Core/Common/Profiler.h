@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <string>
@@ -22,6 +23,7 @@ public:
   void Start(u64* time, int* depth);
   void Stop(u64* time, int* depth);
   std::string Read();
+  const std::string& GetName() const { return m_name; }
 
   bool operator<(const Profiler& b) const;
 
@@ -44,6 +46,52 @@ private:
   u64 m_calls;
 };
 
+// While tracing is enabled, zones are recorded with their start and end times into a ring buffer
+// of the thread that they ran on, so that the recent zones of all threads can be exported as a
+// timeline in the Chrome trace event format (chrome://tracing, ui.perfetto.dev). Otherwise a zone
+// only costs a relaxed atomic load.
+class ProfilerTrace
+{
+public:
+  static void Start();
+  static void Stop();
+  static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+  static bool WriteChromeTrace(const std::string& path);
+
+  // The name is shown for the thread in the timeline.
+  static void SetThreadName(const char* name);
+
+  static u64 NowNs();
+  // Only the pointer to the name is stored, so it has to outlive the trace.
+  static void AddZone(const char* name, u64 begin_ns, u64 end_ns);
+
+private:
+  static std::atomic<bool> s_enabled;
+};
+
+class ProfilerTraceZone
+{
+public:
+  explicit ProfilerTraceZone(const char* name)
+      : m_name(name), m_enabled(ProfilerTrace::IsEnabled()),
+        m_begin_ns(m_enabled ? ProfilerTrace::NowNs() : 0)
+  {
+  }
+  ~ProfilerTraceZone()
+  {
+    if (m_enabled)
+      ProfilerTrace::AddZone(m_name, m_begin_ns, ProfilerTrace::NowNs());
+  }
+
+  ProfilerTraceZone(const ProfilerTraceZone&) = delete;
+  ProfilerTraceZone& operator=(const ProfilerTraceZone&) = delete;
+
+private:
+  const char* m_name;
+  bool m_enabled;
+  u64 m_begin_ns;
+};
+
 class ProfilerExecuter
 {
 public:
@@ -58,6 +106,7 @@ private:
   Profiler* m_profiler;
   u64* m_time;
   int* m_depth;
+  ProfilerTraceZone m_zone{m_profiler->GetName().c_str()};
 };
 }  // namespace Common
 
@@ -66,3 +115,6 @@ private:
   static thread_local u64 prof_time;                                                               \
   static thread_local int prof_depth;                                                              \
   Common::ProfilerExecuter prof_e(&prof_gen, &prof_time, &prof_depth);
+
+// Only records the zone for traces, without adding it to the statistics that ToString shows.
+#define PROFILE_ZONE(name) Common::ProfilerTraceZone prof_zone(name);
@@ -0,0 +1,100 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ThreadPool.h"
+
+#include <utility>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+ThreadPool::~ThreadPool()
+{
+  Stop();
+}
+
+void ThreadPool::Start(std::string name, u32 num_threads)
+{
+  Stop();
+
+  m_name = std::move(name);
+  m_stop = false;
+  for (u32 thread = 1; thread < num_threads; ++thread)
+    m_threads.emplace_back(&ThreadPool::ThreadLoop, this, thread);
+}
+
+void ThreadPool::Stop()
+{
+  if (m_threads.empty())
+    return;
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_stop = true;
+  }
+  m_work_cv.notify_all();
+
+  for (std::thread& thread : m_threads)
+    thread.join();
+  m_threads.clear();
+}
+
+void ThreadPool::Run(u32 count, const Function& function)
+{
+  if (m_threads.empty() || count <= 1)
+  {
+    for (u32 i = 0; i < count; ++i)
+      function(i, 0);
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_function = &function;
+    m_count = count;
+    m_next_index.store(0, std::memory_order_relaxed);
+    m_busy_threads = static_cast<u32>(m_threads.size());
+    ++m_generation;
+  }
+  m_work_cv.notify_all();
+
+  Work(0);
+
+  std::unique_lock lk(m_mutex);
+  m_done_cv.wait(lk, [this] { return m_busy_threads == 0; });
+  m_function = nullptr;
+}
+
+void ThreadPool::ThreadLoop(u32 thread)
+{
+  SetCurrentThreadName(m_name.c_str());
+
+  u64 generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock lk(m_mutex);
+      m_work_cv.wait(lk, [&] { return m_stop || m_generation != generation; });
+      if (m_stop)
+        return;
+      generation = m_generation;
+    }
+
+    Work(thread);
+
+    std::lock_guard lk(m_mutex);
+    if (--m_busy_threads == 0)
+      m_done_cv.notify_one();
+  }
+}
+
+void ThreadPool::Work(u32 thread)
+{
+  for (u32 index = m_next_index.fetch_add(1, std::memory_order_relaxed); index < m_count;
+       index = m_next_index.fetch_add(1, std::memory_order_relaxed))
+  {
+    (*m_function)(index, thread);
+  }
+}
+}  // namespace Common
@@ -0,0 +1,61 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// A fixed set of threads for splitting up work that the calling thread waits for. The calling
+// thread works along with the pool, so a pool of one thread doesn't start any.
+class ThreadPool
+{
+public:
+  using Function = std::function<void(u32 index, u32 thread)>;
+
+  ThreadPool() = default;
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void Start(std::string name, u32 num_threads);
+  void Stop();
+
+  // Including the calling thread.
+  u32 GetThreadCount() const { return static_cast<u32>(m_threads.size()) + 1; }
+
+  // Calls function(index, thread) for every index in [0, count) and returns when all calls are
+  // done. Indices are handed out in increasing order. thread is below GetThreadCount() and the same
+  // for all calls on one thread, so it can select per-thread state. Only one thread may call this.
+  void Run(u32 count, const Function& function);
+
+private:
+  void ThreadLoop(u32 thread);
+  void Work(u32 thread);
+
+  std::string m_name;
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  u64 m_generation = 0;
+  bool m_stop = false;
+  // Threads that haven't finished their part of the current Run yet.
+  u32 m_busy_threads = 0;
+
+  const Function* m_function = nullptr;
+  u32 m_count = 0;
+  std::atomic<u32> m_next_index = 0;
+};
+}  // namespace Common
@@ -27,6 +27,7 @@
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SI/SI_Device.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateCompression.h"
 #include "Core/USBUtils.h"
 #include "DiscIO/Enums.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -42,6 +43,16 @@ const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
 const Info<bool> MAIN_FASTMEM_ARENA{{System::Main, "Core", "FastmemArena"}, true};
 const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP{{System::Main, "Core", "LargeEntryPointsMap"}, true};
+const Info<bool> MAIN_JIT_TIERED_COMPILATION{{System::Main, "Core", "JITTieredCompilation"},
+                                              false};
+const Info<u32> MAIN_JIT_TIER_UP_THRESHOLD{{System::Main, "Core", "JITTierUpThreshold"}, 4};
+const Info<bool> MAIN_JIT_WARM_START{{System::Main, "Core", "JITWarmStart"}, false};
+const Info<bool> MAIN_JIT_SUPERBLOCKS{{System::Main, "Core", "JITSuperblocks"}, false};
+const Info<u32> MAIN_JIT_SUPERBLOCK_THRESHOLD{{System::Main, "Core", "JITSuperblockThreshold"},
+                                              2000};
+const Info<bool> MAIN_JIT_BOUND_ENTRIES{{System::Main, "Core", "JITBoundEntries"}, false};
+const Info<bool> MAIN_JIT_EVICT_COLD_BLOCKS{{System::Main, "Core", "JITEvictColdBlocks"}, false};
+const Info<bool> MAIN_JIT_SOFTWARE_TLB{{System::Main, "Core", "JITSoftwareTLB"}, true};
 const Info<bool> MAIN_ACCURATE_CPU_CACHE{{System::Main, "Core", "AccurateCPUCache"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_MAX_FALLBACK{{System::Main, "Core", "MaxFallback"}, 100};
@@ -196,6 +207,13 @@ const Info<bool> MAIN_WII_SD_CARD{{System::Main, "Core", "WiiSDCard"}, true};
 const Info<bool> MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC{
     {System::Main, "Core", "WiiSDCardEnableFolderSync"}, false};
 const Info<u64> MAIN_WII_SD_CARD_FILESIZE{{System::Main, "Core", "WiiSDCardFilesize"}, 0};
+const Info<bool> MAIN_WII_SD_CARD_INCREMENTAL_SYNC{
+    {System::Main, "Core", "WiiSDCardIncrementalSync"}, true};
+const Info<bool> MAIN_WII_SD_CARD_VIRTUAL_FOLDER{
+    {System::Main, "Core", "WiiSDCardVirtualFolder"}, false};
+const Info<u32> MAIN_WII_SD_CARD_READ_CACHE_MB{{System::Main, "Core", "WiiSDCardReadCacheMB"}, 32};
+const Info<bool> MAIN_WII_SD_CARD_ACCESS_TRACE{{System::Main, "Core", "WiiSDCardAccessTrace"},
+                                               false};
 const Info<bool> MAIN_WII_KEYBOARD{{System::Main, "Core", "WiiKeyboard"}, false};
 const Info<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING{
     {System::Main, "Core", "WiimoteContinuousScanning"}, false};
@@ -271,6 +289,13 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<State::CompressionType> MAIN_STATE_COMPRESSION_TYPE{
+    {System::Main, "Core", "StateCompressionType"}, State::CompressionType::ChunkedLZ4};
+const Info<int> MAIN_STATE_ZSTD_LEVEL{{System::Main, "Core", "StateZstdLevel"},
+                                      State::DEFAULT_STATE_ZSTD_LEVEL};
+const Info<bool> MAIN_REWIND_ENABLED{{System::Main, "Core", "RewindEnabled"}, false};
+const Info<u32> MAIN_REWIND_FRAME_INTERVAL{{System::Main, "Core", "RewindFrameInterval"}, 30};
+const Info<u32> MAIN_REWIND_MEMORY_MB{{System::Main, "Core", "RewindMemoryMB"}, 512};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 const Info<bool> MAIN_WII_WIILINK_ENABLE{{System::Main, "Core", "EnableWiiLink"}, false};
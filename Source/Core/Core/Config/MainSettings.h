@@ -49,6 +49,11 @@ namespace HSP
 enum class HSPDeviceType : int;
 }
 
+namespace State
+{
+enum CompressionType : u16;
+}
+
 namespace Config
 {
 // Main.Core
@@ -59,6 +64,16 @@ extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
 extern const Info<bool> MAIN_FASTMEM;
 extern const Info<bool> MAIN_FASTMEM_ARENA;
 extern const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+extern const Info<u32> MAIN_JIT_TIER_UP_THRESHOLD;
+extern const Info<bool> MAIN_JIT_WARM_START;
+extern const Info<bool> MAIN_JIT_SUPERBLOCKS;
+// Number of times a block has to run before it is recompiled as a superblock. 0 only counts block
+// entries, which gives a baseline for the statistics.
+extern const Info<u32> MAIN_JIT_SUPERBLOCK_THRESHOLD;
+extern const Info<bool> MAIN_JIT_BOUND_ENTRIES;
+extern const Info<bool> MAIN_JIT_EVICT_COLD_BLOCKS;
+extern const Info<bool> MAIN_JIT_SOFTWARE_TLB;
 extern const Info<bool> MAIN_ACCURATE_CPU_CACHE;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
@@ -107,6 +122,12 @@ const Info<bool>& GetInfoForSimulateKonga(int channel);
 extern const Info<bool> MAIN_WII_SD_CARD;
 extern const Info<bool> MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC;
 extern const Info<u64> MAIN_WII_SD_CARD_FILESIZE;
+extern const Info<bool> MAIN_WII_SD_CARD_INCREMENTAL_SYNC;
+extern const Info<bool> MAIN_WII_SD_CARD_VIRTUAL_FOLDER;
+// 0 disables the cache.
+extern const Info<u32> MAIN_WII_SD_CARD_READ_CACHE_MB;
+// Records the accesses to the SD card to SDAccessTrace.txt in the Logs directory.
+extern const Info<bool> MAIN_WII_SD_CARD_ACCESS_TRACE;
 extern const Info<bool> MAIN_WII_KEYBOARD;
 extern const Info<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING;
 extern const Info<std::string> MAIN_WIIMOTE_AUTO_CONNECT_ADDRESSES;
@@ -157,6 +178,11 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+extern const Info<State::CompressionType> MAIN_STATE_COMPRESSION_TYPE;
+extern const Info<int> MAIN_STATE_ZSTD_LEVEL;
+extern const Info<bool> MAIN_REWIND_ENABLED;
+extern const Info<u32> MAIN_REWIND_FRAME_INTERVAL;
+extern const Info<u32> MAIN_REWIND_MEMORY_MB;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
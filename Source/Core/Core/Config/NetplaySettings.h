@@ -38,10 +38,15 @@ extern const Info<std::string> NETPLAY_INDEX_PASSWORD;
 
 extern const Info<bool> NETPLAY_ENABLE_CHUNKED_UPLOAD_LIMIT;
 extern const Info<u32> NETPLAY_CHUNKED_UPLOAD_LIMIT;
+// Size of the cache of received chunked data, in MiB. The data of the latest transfer is always
+// kept in full, even if it is larger, so that sending it again only sends what changed.
+extern const Info<u32> NETPLAY_CHUNK_CACHE_SIZE;
 
 extern const Info<u32> NETPLAY_MINIMUM_BUFFER_SIZE;
 extern const Info<u32> NETPLAY_PLAYER_BUFFER_SIZE;
 extern const Info<u32> NETPLAY_CLIENT_BUFFER_SIZE;
+extern const Info<u32> NETPLAY_ROLLBACK_FRAMES;
+extern const Info<u32> NETPLAY_ROLLBACK_SYNC_TEST_FRAMES;
 
 extern const Info<bool> NETPLAY_BRAWL_MUSIC_OFF;
 extern const Info<bool> NETPLAY_IS_SPECTATOR;
@@ -55,5 +60,7 @@ extern const Info<bool> NETPLAY_STRICT_SETTINGS_SYNC;
 extern const Info<std::string> NETPLAY_NETWORK_MODE;
 extern const Info<bool> NETPLAY_GOLF_MODE_OVERLAY;
 extern const Info<bool> NETPLAY_HIDE_REMOTE_GBAS;
+extern const Info<bool> NETPLAY_RAM_DESYNC_CHECK;
+extern const Info<u32> NETPLAY_RAM_HASH_INTERVAL;
 
 }  // namespace Config
@@ -62,12 +62,14 @@
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/IOS/IOS.h"
+#include "Core/IOS/SDIO/VirtualSDCard.h"
 #include "Core/MemTools.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/NetPlayProto.h"
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/GDBStub.h"
+#include "Core/PowerPC/JitCommon/JitSamplingProfiler.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/State.h"
@@ -161,6 +163,14 @@ void OnFrameEnd(Core::System& system)
     s_memory_watcher->Step(guard);
   }
 #endif
+
+  State::OnFrameEnd(system);
+
+  // Keeps the sample buffer of the profiler from filling up.
+  system.GetJitInterface().GetSamplingProfiler().ProcessSamples();
+
+  if (NetPlay::IsNetPlayRunning())
+    NetPlay::NetPlayClient::OnFrameEnd(system);
 }
 
 // Display messages and return values
@@ -499,8 +509,10 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
   const bool delete_savestate =
       boot_session_data.GetDeleteSavestate() == DeleteSavestateAfterBoot::Yes;
 
+  // A virtual SD card reads from and writes to the folder directly.
   bool sync_sd_folder = system.IsWii() && Config::Get(Config::MAIN_WII_SD_CARD) &&
-                        Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC);
+                        Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC) &&
+                        !IOS::HLE::ShouldUseVirtualSDCard();
   if (sync_sd_folder)
   {
     sync_sd_folder = Common::SyncSDFolderToSDImage([] { return false; }, Core::WantsDeterminism());
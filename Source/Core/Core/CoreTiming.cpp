@@ -14,6 +14,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/Profiler.h"
 #include "Common/SPSCQueue.h"
 
 #include "Core/AchievementManager.h"
@@ -123,6 +124,7 @@ void CoreTimingManager::Shutdown()
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
+  m_safe_point_jobs.clear();
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
 }
 
@@ -333,6 +335,15 @@ void CoreTimingManager::MoveEvents()
 
 void CoreTimingManager::Advance()
 {
+  // The slices that the CPU thread runs between calls to this show up in traces.
+  const bool tracing = Common::ProfilerTrace::IsEnabled();
+  if (tracing && m_slice_trace_begin_ns != 0)
+  {
+    Common::ProfilerTrace::AddZone("CPU slice", m_slice_trace_begin_ns,
+                                   Common::ProfilerTrace::NowNs());
+  }
+  PROFILE_ZONE("CoreTiming events");
+
   CPUThreadConfigCallback::CheckForConfigChanges();
 
   MoveEvents();
@@ -372,6 +383,22 @@ void CoreTimingManager::Advance()
   // until the next slice:
   //        Pokemon Box refuses to boot if the first exception from the audio DMA is received late
   power_pc.CheckExternalExceptions();
+
+  m_slice_trace_begin_ns = tracing ? Common::ProfilerTrace::NowNs() : 0;
+
+  if (!m_safe_point_jobs.empty()) [[unlikely]]
+  {
+    // A job may load a state, which replaces everything set up above, so nothing may follow this.
+    auto jobs = std::move(m_safe_point_jobs);
+    m_safe_point_jobs.clear();
+    for (auto& job : jobs)
+      job();
+  }
+}
+
+void CoreTimingManager::RunAtSafePoint(Common::MoveOnlyFunction<void()> function)
+{
+  m_safe_point_jobs.emplace_back(std::move(function));
 }
 
 TimePoint CoreTimingManager::CalculateTargetHostTimeInternal(s64 target_cycle)
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Functional.h"
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
 #include "Core/CPUThreadConfigCallback.h"
@@ -130,6 +131,11 @@ public:
   void Advance();
   void MoveEvents();
 
+  // Runs function on the CPU thread at the end of the next Advance(), once the events that are due
+  // have been processed. Unlike inside an event callback, the event queue is consistent at that
+  // point, so the emulated state can be saved or loaded. Must be called from the CPU thread.
+  void RunAtSafePoint(Common::MoveOnlyFunction<void()> function);
+
   // Pretend that the main CPU has executed enough cycles to reach the next event.
   void Idle();
 
@@ -192,11 +198,15 @@ private:
   Common::SPSCQueue<Event> m_ts_queue;
 
   float m_last_oc_factor = 0.0f;
+  u64 m_slice_trace_begin_ns = 0;
 
   s64 m_idled_cycles = 0;
   u32 m_fake_dec_start_value = 0;
   u64 m_fake_dec_start_ticks = 0;
 
+  // Jobs queued by RunAtSafePoint(). Only accessed from the CPU thread.
+  std::vector<Common::MoveOnlyFunction<void()>> m_safe_point_jobs;
+
   // Are we in a function that has been called from Advance()
   bool m_is_global_timer_sane = false;
 
@@ -0,0 +1,66 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/IOS/SDIO/SDCardBackend.h"
+
+#include <cstdio>
+#include <utility>
+
+#include "Common/FatFsUtil.h"
+#include "Common/Logging/Log.h"
+
+namespace IOS::HLE
+{
+SDCardBackend::~SDCardBackend() = default;
+
+std::unique_ptr<SDCardImage> SDCardImage::Open(const std::string& path)
+{
+  File::IOFile file(path, "r+b");
+  if (!file)
+    return nullptr;
+  return std::make_unique<SDCardImage>(std::move(file));
+}
+
+SDCardImage::SDCardImage(File::IOFile file) : m_file(std::move(file))
+{
+}
+
+u64 SDCardImage::GetSize() const
+{
+  return m_file.GetSize();
+}
+
+bool SDCardImage::Read(u64 offset, u8* buffer, u64 size)
+{
+  if (!m_file.Seek(offset, File::SeekOrigin::Begin))
+    ERROR_LOG_FMT(IOS_SD, "Seek failed");
+
+  if (!m_file.ReadBytes(buffer, size))
+  {
+    ERROR_LOG_FMT(IOS_SD, "Read Failed - error: {}, eof: {}", std::ferror(m_file.GetHandle()),
+                  std::feof(m_file.GetHandle()));
+    return false;
+  }
+
+  return true;
+}
+
+bool SDCardImage::Write(u64 offset, const u8* buffer, u64 size)
+{
+  if (!m_file.Seek(offset, File::SeekOrigin::Begin))
+    ERROR_LOG_FMT(IOS_SD, "Seek failed");
+
+  const bool success = m_file.WriteBytes(buffer, size);
+
+  // Even a failed write may have changed part of the image.
+  Common::MarkSDImageDirty(offset, size);
+
+  if (!success)
+  {
+    ERROR_LOG_FMT(IOS_SD, "Write Failed - error: {}, eof: {}", std::ferror(m_file.GetHandle()),
+                  std::feof(m_file.GetHandle()));
+  }
+
+  return success;
+}
+}  // namespace IOS::HLE
@@ -0,0 +1,41 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace IOS::HLE
+{
+// The storage behind the emulated SD card. Offsets and sizes are in bytes.
+class SDCardBackend
+{
+public:
+  virtual ~SDCardBackend();
+
+  virtual u64 GetSize() const = 0;
+  virtual bool Read(u64 offset, u8* buffer, u64 size) = 0;
+  virtual bool Write(u64 offset, const u8* buffer, u64 size) = 0;
+};
+
+// An SD card image file on the host.
+class SDCardImage final : public SDCardBackend
+{
+public:
+  // Returns nullptr if the image can't be opened.
+  static std::unique_ptr<SDCardImage> Open(const std::string& path);
+
+  explicit SDCardImage(File::IOFile file);
+
+  u64 GetSize() const override;
+  bool Read(u64 offset, u8* buffer, u64 size) override;
+  bool Write(u64 offset, const u8* buffer, u64 size) override;
+
+private:
+  File::IOFile m_file;
+};
+}  // namespace IOS::HLE
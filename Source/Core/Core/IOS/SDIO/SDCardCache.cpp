@@ -0,0 +1,224 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/IOS/SDIO/SDCardCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Common/Logging/Log.h"
+
+namespace IOS::HLE
+{
+static std::mutex s_active_cache_mutex;
+static SDCardCache* s_active_cache = nullptr;
+
+SDCardCache::SDCardCache(std::unique_ptr<SDCardBackend> backend, u64 capacity)
+    : m_backend(std::move(backend)), m_size(m_backend->GetSize()),
+      m_max_blocks(std::max<size_t>(capacity / BLOCK_SIZE, 1))
+{
+  m_read_ahead_thread.Reset("SD Card Read-Ahead", [this](u64 index) { ReadAhead(index); });
+
+  std::lock_guard lk(s_active_cache_mutex);
+  s_active_cache = this;
+}
+
+SDCardCache::~SDCardCache()
+{
+  {
+    std::lock_guard lk(s_active_cache_mutex);
+    if (s_active_cache == this)
+      s_active_cache = nullptr;
+  }
+
+  m_read_ahead_thread.StopAndCancel();
+}
+
+u64 SDCardCache::GetSize() const
+{
+  return m_size;
+}
+
+SDCardCache::Block* SDCardCache::FindBlock(u64 index)
+{
+  const auto it = m_blocks.find(index);
+  if (it == m_blocks.end())
+    return nullptr;
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second.lru_position);
+  return &it->second;
+}
+
+void SDCardCache::InsertBlock(u64 index, std::vector<u8> data, bool read_ahead)
+{
+  if (m_blocks.contains(index))
+    return;
+
+  if (m_blocks.size() >= m_max_blocks)
+  {
+    m_blocks.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+
+  m_lru.push_front(index);
+  m_blocks.emplace(index, Block{std::move(data), m_lru.begin(), read_ahead});
+}
+
+bool SDCardCache::ReadBlockFromBackend(u64 index, std::vector<u8>* data)
+{
+  const u64 offset = index * BLOCK_SIZE;
+  data->resize(std::min(BLOCK_SIZE, m_size - offset));
+  return m_backend->Read(offset, data->data(), data->size());
+}
+
+bool SDCardCache::Read(u64 offset, u8* buffer, u64 size)
+{
+  if (offset + size > m_size || offset + size < offset)
+  {
+    ERROR_LOG_FMT(IOS_SD, "Read of {} bytes at {:#x} is out of bounds", size, offset);
+    return false;
+  }
+
+  const bool sequential = offset == m_last_read_end;
+  m_last_read_end = offset + size;
+
+  const u64 end = offset + size;
+  while (offset < end)
+  {
+    const u64 index = offset / BLOCK_SIZE;
+    const u64 offset_in_block = offset % BLOCK_SIZE;
+    const u64 chunk_size = std::min(end - offset, BLOCK_SIZE - offset_in_block);
+
+    bool hit = false;
+    {
+      std::lock_guard lk(m_cache_mutex);
+      if (Block* block = FindBlock(index))
+      {
+        std::memcpy(buffer, block->data.data() + offset_in_block, chunk_size);
+        if (std::exchange(block->read_ahead, false))
+          ++m_read_ahead_hits;
+        hit = true;
+      }
+    }
+
+    if (hit)
+    {
+      ++m_hits;
+    }
+    else
+    {
+      ++m_misses;
+
+      std::lock_guard backend_lk(m_backend_mutex);
+      std::lock_guard lk(m_cache_mutex);
+
+      // The read-ahead thread may have loaded the block while this thread was waiting.
+      Block* block = FindBlock(index);
+      if (!block)
+      {
+        std::vector<u8> data;
+        if (!ReadBlockFromBackend(index, &data))
+          return false;
+        InsertBlock(index, std::move(data), false);
+        block = FindBlock(index);
+      }
+
+      std::memcpy(buffer, block->data.data() + offset_in_block, chunk_size);
+    }
+
+    offset += chunk_size;
+    buffer += chunk_size;
+  }
+
+  if (!sequential)
+  {
+    m_read_ahead_end = 0;
+    return true;
+  }
+
+  // Queue the blocks after the read that haven't been queued already.
+  const u64 last_block = (end - 1) / BLOCK_SIZE;
+  const u64 num_blocks = (m_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  const u64 read_ahead_end = std::min(last_block + 1 + READ_AHEAD_BLOCKS, num_blocks);
+  for (u64 index = std::max(last_block + 1, m_read_ahead_end); index < read_ahead_end; ++index)
+    m_read_ahead_thread.Push(index);
+  m_read_ahead_end = std::max(m_read_ahead_end, read_ahead_end);
+
+  return true;
+}
+
+void SDCardCache::ReadAhead(u64 index)
+{
+  std::lock_guard backend_lk(m_backend_mutex);
+  {
+    std::lock_guard lk(m_cache_mutex);
+    if (m_blocks.contains(index))
+      return;
+  }
+
+  // Holding m_backend_mutex until the block is inserted keeps writes from going in between.
+  std::vector<u8> data;
+  if (!ReadBlockFromBackend(index, &data))
+    return;
+
+  std::lock_guard lk(m_cache_mutex);
+  InsertBlock(index, std::move(data), true);
+  ++m_read_ahead_blocks;
+}
+
+bool SDCardCache::Write(u64 offset, const u8* buffer, u64 size)
+{
+  // Reading after a write is not a continuation of the previous read.
+  m_last_read_end = 0;
+
+  std::lock_guard backend_lk(m_backend_mutex);
+  const bool success = m_backend->Write(offset, buffer, size);
+
+  std::lock_guard lk(m_cache_mutex);
+  if (!success)
+  {
+    // The backend may have been partially written to, so the cached data can't be trusted.
+    for (u64 index = offset / BLOCK_SIZE; index * BLOCK_SIZE < offset + size; ++index)
+    {
+      if (const auto it = m_blocks.find(index); it != m_blocks.end())
+      {
+        m_lru.erase(it->second.lru_position);
+        m_blocks.erase(it);
+      }
+    }
+    return false;
+  }
+
+  // Keep the cached blocks up to date.
+  const u64 end = offset + size;
+  while (offset < end)
+  {
+    const u64 offset_in_block = offset % BLOCK_SIZE;
+    const u64 chunk_size = std::min(end - offset, BLOCK_SIZE - offset_in_block);
+    if (const auto it = m_blocks.find(offset / BLOCK_SIZE); it != m_blocks.end())
+      std::memcpy(it->second.data.data() + offset_in_block, buffer, chunk_size);
+
+    offset += chunk_size;
+    buffer += chunk_size;
+  }
+
+  return true;
+}
+
+SDCardCache::Stats SDCardCache::GetStats() const
+{
+  return {m_hits, m_misses, m_read_ahead_blocks, m_read_ahead_hits};
+}
+
+void SDCardCache::WaitForReadAhead()
+{
+  m_read_ahead_thread.WaitForCompletion();
+}
+
+SDCardCache::Stats GetSDCardCacheStats()
+{
+  std::lock_guard lk(s_active_cache_mutex);
+  return s_active_cache ? s_active_cache->GetStats() : SDCardCache::Stats{};
+}
+}  // namespace IOS::HLE
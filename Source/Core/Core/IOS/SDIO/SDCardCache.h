@@ -0,0 +1,97 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// A read cache in front of another SD card backend. Data is cached in blocks that are evicted in
+// least recently used order. When the emulated software reads the card sequentially, the blocks
+// after the read are loaded on a background thread, so that the next read doesn't have to wait
+// for the host.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+#include "Core/IOS/SDIO/SDCardBackend.h"
+
+namespace IOS::HLE
+{
+class SDCardCache final : public SDCardBackend
+{
+public:
+  static constexpr u64 BLOCK_SIZE = 64 * 1024;
+  static constexpr u32 READ_AHEAD_BLOCKS = 4;
+
+  struct Stats
+  {
+    u64 hits = 0;
+    u64 misses = 0;
+    // Blocks loaded by read-ahead, and how many of those were read before being evicted.
+    u64 read_ahead_blocks = 0;
+    u64 read_ahead_hits = 0;
+  };
+
+  SDCardCache(std::unique_ptr<SDCardBackend> backend, u64 capacity);
+  ~SDCardCache() override;
+
+  SDCardCache(const SDCardCache&) = delete;
+  SDCardCache& operator=(const SDCardCache&) = delete;
+
+  u64 GetSize() const override;
+  bool Read(u64 offset, u8* buffer, u64 size) override;
+  bool Write(u64 offset, const u8* buffer, u64 size) override;
+
+  Stats GetStats() const;
+  // Waits for the pending read-ahead to finish.
+  void WaitForReadAhead();
+
+private:
+  struct Block
+  {
+    std::vector<u8> data;
+    std::list<u64>::iterator lru_position;
+    bool read_ahead = false;
+  };
+
+  // These must be called with m_cache_mutex held.
+  Block* FindBlock(u64 index);
+  void InsertBlock(u64 index, std::vector<u8> data, bool read_ahead);
+
+  // Must be called with m_backend_mutex held.
+  bool ReadBlockFromBackend(u64 index, std::vector<u8>* data);
+
+  void ReadAhead(u64 index);
+
+  const std::unique_ptr<SDCardBackend> m_backend;
+  const u64 m_size;
+  const size_t m_max_blocks;
+
+  // When both are needed, m_backend_mutex has to be locked first.
+  std::mutex m_backend_mutex;
+  std::mutex m_cache_mutex;
+
+  std::unordered_map<u64, Block> m_blocks;
+  // Most recently used first.
+  std::list<u64> m_lru;
+
+  // Only used by the thread that calls Read and Write.
+  u64 m_last_read_end = 0;
+  u64 m_read_ahead_end = 0;
+
+  std::atomic<u64> m_hits = 0;
+  std::atomic<u64> m_misses = 0;
+  std::atomic<u64> m_read_ahead_blocks = 0;
+  std::atomic<u64> m_read_ahead_hits = 0;
+
+  // Declared last so that the thread is stopped before anything it uses is destroyed.
+  Common::WorkQueueThreadSP<u64> m_read_ahead_thread;
+};
+
+// Returns the stats of the cache of the emulated SD card, if it has one.
+SDCardCache::Stats GetSDCardCacheStats();
+}  // namespace IOS::HLE
@@ -0,0 +1,82 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/IOS/SDIO/SDCardTrace.h"
+
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+
+namespace IOS::HLE
+{
+std::optional<std::vector<SDCardAccess>> LoadSDCardTrace(const std::string& path)
+{
+  std::string contents;
+  if (!File::ReadFileToString(path, contents))
+    return std::nullopt;
+
+  std::vector<SDCardAccess> accesses;
+  for (const std::string& line : SplitString(contents, '\n'))
+  {
+    const std::vector<std::string> fields = SplitString(std::string(StripWhitespace(line)), ' ');
+    if (fields.size() == 1 && fields[0].empty())
+      continue;
+
+    SDCardAccess access;
+    if (fields.size() != 4 || (fields[0] != "R" && fields[0] != "W") ||
+        !TryParse(fields[1], &access.delay_us) || !TryParse(fields[2], &access.offset) ||
+        !TryParse(fields[3], &access.size))
+    {
+      ERROR_LOG_FMT(IOS_SD, "Invalid line in SD card trace {}: {}", path, line);
+      return std::nullopt;
+    }
+
+    access.is_write = fields[0] == "W";
+    accesses.push_back(access);
+  }
+
+  return accesses;
+}
+
+SDCardTraceRecorder::SDCardTraceRecorder(std::unique_ptr<SDCardBackend> backend,
+                                         const std::string& trace_path)
+    : m_backend(std::move(backend)), m_trace(trace_path, "w")
+{
+  if (m_trace)
+    NOTICE_LOG_FMT(IOS_SD, "Recording SD card accesses to {}", trace_path);
+  else
+    ERROR_LOG_FMT(IOS_SD, "Failed to open SD card trace {}", trace_path);
+}
+
+u64 SDCardTraceRecorder::GetSize() const
+{
+  return m_backend->GetSize();
+}
+
+bool SDCardTraceRecorder::Read(u64 offset, u8* buffer, u64 size)
+{
+  Record(false, offset, size);
+  return m_backend->Read(offset, buffer, size);
+}
+
+bool SDCardTraceRecorder::Write(u64 offset, const u8* buffer, u64 size)
+{
+  Record(true, offset, size);
+  return m_backend->Write(offset, buffer, size);
+}
+
+void SDCardTraceRecorder::Record(bool is_write, u64 offset, u64 size)
+{
+  const u64 now = Common::Timer::NowUs();
+  const u64 delay = m_last_access_us == 0 ? 0 : now - m_last_access_us;
+  m_last_access_us = now;
+
+  const std::string line = fmt::format("{} {} {} {}\n", is_write ? 'W' : 'R', delay, offset, size);
+  m_trace.WriteString(line);
+}
+}  // namespace IOS::HLE
@@ -0,0 +1,48 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Recording of the accesses the emulated software makes to the SD card, so that they can be
+// replayed to benchmark SD card backends. Traces are text files with one access per line:
+// "<R or W> <microseconds since the previous access> <offset> <size>".
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Core/IOS/SDIO/SDCardBackend.h"
+
+namespace IOS::HLE
+{
+struct SDCardAccess
+{
+  bool is_write = false;
+  u64 delay_us = 0;
+  u64 offset = 0;
+  u64 size = 0;
+};
+
+std::optional<std::vector<SDCardAccess>> LoadSDCardTrace(const std::string& path);
+
+// Passes all accesses on to another backend and appends them to a trace.
+class SDCardTraceRecorder final : public SDCardBackend
+{
+public:
+  SDCardTraceRecorder(std::unique_ptr<SDCardBackend> backend, const std::string& trace_path);
+
+  u64 GetSize() const override;
+  bool Read(u64 offset, u8* buffer, u64 size) override;
+  bool Write(u64 offset, const u8* buffer, u64 size) override;
+
+private:
+  void Record(bool is_write, u64 offset, u64 size);
+
+  const std::unique_ptr<SDCardBackend> m_backend;
+  File::IOFile m_trace;
+  u64 m_last_access_us = 0;
+};
+}  // namespace IOS::HLE
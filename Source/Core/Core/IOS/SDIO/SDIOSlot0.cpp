@@ -3,15 +3,14 @@
 
 #include "Core/IOS/SDIO/SDIOSlot0.h"
 
-#include <cstdio>
 #include <cstring>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
-#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/SDCardUtil.h"
 
@@ -21,6 +20,9 @@
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/IOS.h"
+#include "Core/IOS/SDIO/SDCardCache.h"
+#include "Core/IOS/SDIO/SDCardTrace.h"
+#include "Core/IOS/SDIO/VirtualSDCard.h"
 #include "Core/IOS/VersionInfo.h"
 #include "Core/System.h"
 
@@ -86,24 +88,56 @@ void SDIOSlot0Device::EventNotify()
   }
 }
 
-void SDIOSlot0Device::OpenInternal()
+static std::unique_ptr<SDCardBackend> OpenSDCard()
 {
+  if (ShouldUseVirtualSDCard())
+  {
+    std::unique_ptr<SDCardBackend> card =
+        VirtualSDCard::Create(File::GetUserPath(D_WIISDCARDSYNCFOLDER_IDX),
+                              Config::Get(Config::MAIN_WII_SD_CARD_FILESIZE));
+    if (card)
+      return card;
+
+    WARN_LOG_FMT(IOS_SD, "Failed to create virtual SD card, falling back to the SD card image");
+  }
+
   const std::string filename = File::GetUserPath(F_WIISDCARDIMAGE_IDX);
-  m_card.Open(filename, "r+b");
-  if (!m_card)
+  std::unique_ptr<SDCardBackend> card = SDCardImage::Open(filename);
+  if (!card)
   {
     WARN_LOG_FMT(IOS_SD, "Failed to open SD Card image, trying to create a new 128 MB image...");
     if (Common::SDCardCreate(128, filename))
     {
       INFO_LOG_FMT(IOS_SD, "Successfully created {}", filename);
-      m_card.Open(filename, "r+b");
+      card = SDCardImage::Open(filename);
     }
-    if (!m_card)
+    if (!card)
     {
       ERROR_LOG_FMT(IOS_SD, "Could not open SD Card image or create a new one, are you running "
                             "from a read-only directory?");
     }
   }
+  return card;
+}
+
+void SDIOSlot0Device::OpenInternal()
+{
+  // Close the previous card first, so that a virtual SD card sees the changes it wrote back.
+  m_card.reset();
+
+  m_card = OpenSDCard();
+  if (!m_card)
+    return;
+
+  const u64 cache_size = u64(Config::Get(Config::MAIN_WII_SD_CARD_READ_CACHE_MB)) * 1024 * 1024;
+  if (cache_size != 0)
+    m_card = std::make_unique<SDCardCache>(std::move(m_card), cache_size);
+
+  if (Config::Get(Config::MAIN_WII_SD_CARD_ACCESS_TRACE))
+  {
+    m_card = std::make_unique<SDCardTraceRecorder>(
+        std::move(m_card), File::GetUserPath(D_LOGS_IDX) + "SDAccessTrace.txt");
+  }
 }
 
 std::optional<IPCReply> SDIOSlot0Device::Open(const OpenRequest& request)
@@ -118,7 +152,7 @@ std::optional<IPCReply> SDIOSlot0Device::Open(const OpenRequest& request)
 
 std::optional<IPCReply> SDIOSlot0Device::Close(u32 fd)
 {
-  m_card.Close();
+  m_card.reset();
   m_block_length = 0;
   m_bus_width = 0;
 
@@ -284,19 +318,10 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
       const u32 size = req.bsize * req.blocks;
       const u64 address = GetAddressFromRequest(req.arg);
 
-      if (!m_card.Seek(address, File::SeekOrigin::Begin))
-        ERROR_LOG_FMT(IOS_SD, "Seek failed");
-
-      if (m_card.ReadBytes(memory.GetPointerForRange(req.addr, size), size))
-      {
+      if (m_card->Read(address, memory.GetPointerForRange(req.addr, size), size))
         DEBUG_LOG_FMT(IOS_SD, "Outbuffer size {} got {}", rw_buffer_size, size);
-      }
       else
-      {
-        ERROR_LOG_FMT(IOS_SD, "Read Failed - error: {}, eof: {}", std::ferror(m_card.GetHandle()),
-                      std::feof(m_card.GetHandle()));
         ret = RET_FAIL;
-      }
     }
   }
     memory.Write_U32(0x900, buffer_out);
@@ -314,15 +339,8 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
       const u32 size = req.bsize * req.blocks;
       const u64 address = GetAddressFromRequest(req.arg);
 
-      if (!m_card.Seek(address, File::SeekOrigin::Begin))
-        ERROR_LOG_FMT(IOS_SD, "Seek failed");
-
-      if (!m_card.WriteBytes(memory.GetPointerForRange(req.addr, size), size))
-      {
-        ERROR_LOG_FMT(IOS_SD, "Write Failed - error: {}, eof: {}", std::ferror(m_card.GetHandle()),
-                      std::feof(m_card.GetHandle()));
+      if (!m_card->Write(address, memory.GetPointerForRange(req.addr, size), size))
         ret = RET_FAIL;
-      }
     }
   }
     memory.Write_U32(0x900, buffer_out);
@@ -467,7 +485,7 @@ IPCReply SDIOSlot0Device::GetStatus(const IOCtlRequest& request)
   // Since IOS does the SD initialization itself, we just say we're always initialized.
   if (m_card)
   {
-    if (m_card.GetSize() <= SDSC_MAX_SIZE)
+    if (m_card->GetSize() <= SDSC_MAX_SIZE)
     {
       // No further initialization required.
       m_status |= CARD_INITIALIZED;
@@ -541,7 +559,7 @@ u32 SDIOSlot0Device::GetOCRegister() const
 
 std::array<u32, 4> SDIOSlot0Device::GetCSDv1() const
 {
-  u64 size = m_card.GetSize();
+  u64 size = m_card ? m_card->GetSize() : 0;
 
   // 2048 bytes/sector
   // We could make this dynamic to support a wider range of file sizes
@@ -625,7 +643,7 @@ std::array<u32, 4> SDIOSlot0Device::GetCSDv1() const
 
 std::array<u32, 4> SDIOSlot0Device::GetCSDv2() const
 {
-  const u64 size = m_card.GetSize();
+  const u64 size = m_card ? m_card->GetSize() : 0;
 
   if (size % (512 * 1024) != 0)
     WARN_LOG_FMT(IOS_SD, "SDHC Card size cannot be divided by 1024 * 512");
@@ -6,13 +6,14 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <string>
 
 #include "Common/CommonTypes.h"
-#include "Common/IOFile.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
+#include "Core/IOS/SDIO/SDCardBackend.h"
 
 class PointerWrap;
 
@@ -165,7 +166,7 @@ private:
 
   std::array<u32, 0x200 / sizeof(u32)> m_registers{};
 
-  File::IOFile m_card;
+  std::unique_ptr<SDCardBackend> m_card;
 
   CPUThreadConfigCallback::ConfigChangedCallbackID m_config_callback_id;
   bool m_sd_card_inserted = false;
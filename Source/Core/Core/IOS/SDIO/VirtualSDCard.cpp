@@ -0,0 +1,727 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/IOS/SDIO/VirtualSDCard.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <string_view>
+
+#include <fmt/format.h>
+
+// Does not compile if diskio.h is included first.
+// clang-format off
+#include "ff.h"
+#include "diskio.h"
+// clang-format on
+
+#include "Common/Align.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+
+namespace IOS::HLE
+{
+// The layout matches what FatFs creates for a FAT32 volume without a partition table.
+constexpr u32 RESERVED_SECTORS = 32;
+constexpr u32 FSINFO_SECTOR = 1;
+constexpr u32 BACKUP_BOOT_SECTOR = 6;
+constexpr u32 ROOT_CLUSTER = 2;
+constexpr u32 DIRECTORY_ENTRY_SIZE = 32;
+constexpr u32 MAX_DIRECTORY_ENTRIES = 65536;
+constexpr u32 LFN_CHARACTERS_PER_ENTRY = 13;
+constexpr u8 ATTRIBUTE_LFN = AM_RDO | AM_HID | AM_SYS | 0x08;
+// FatFs treats volumes with fewer clusters as FAT16.
+constexpr u32 MIN_FAT32_CLUSTERS = 65526;
+constexpr u32 FAT_END_OF_CHAIN = 0x0FFFFFFF;
+
+constexpr u64 MIN_SIZE = 64 * 1024 * 1024;
+constexpr u64 MAX_SIZE = u64(0xFFFFFFFF) * VirtualSDCard::SECTOR_SIZE;
+constexpr u64 SIZE_ALIGNMENT = 1024 * 1024;
+// Only used to pick a size for the card. The actual cluster size depends on the size.
+constexpr u64 ESTIMATED_CLUSTER_SIZE = 32 * 1024;
+
+namespace
+{
+class VirtualSDCardFatFsCallbacks : public Common::FatFsCallbacks
+{
+public:
+  explicit VirtualSDCardFatFsCallbacks(VirtualSDCard& card) : m_card(card) {}
+
+  int DiskRead(u8 pdrv, u8* buff, u32 sector, unsigned int count) override
+  {
+    const u64 offset = u64(sector) * VirtualSDCard::SECTOR_SIZE;
+    const u64 size = u64(count) * VirtualSDCard::SECTOR_SIZE;
+    return m_card.Read(offset, buff, size) ? RES_OK : RES_ERROR;
+  }
+
+  int DiskWrite(u8 pdrv, const u8* buff, u32 sector, unsigned int count) override
+  {
+    // Flushing only reads the card.
+    return RES_WRPRT;
+  }
+
+  int DiskIOCtl(u8 pdrv, u8 cmd, void* buff) override
+  {
+    switch (cmd)
+    {
+    case CTRL_SYNC:
+      return RES_OK;
+    case GET_SECTOR_COUNT:
+      *static_cast<LBA_t*>(buff) = m_card.GetSize() / VirtualSDCard::SECTOR_SIZE;
+      return RES_OK;
+    default:
+      WARN_LOG_FMT(IOS_SD, "Unexpected virtual SD card ioctl {}", cmd);
+      return RES_OK;
+    }
+  }
+
+private:
+  VirtualSDCard& m_card;
+};
+}  // namespace
+
+static bool IsValidName(std::string_view name)
+{
+  if (name.empty() || name.back() == '.' || name.back() == ' ')
+    return false;
+
+  return std::ranges::none_of(name, [](char c) {
+    return static_cast<u8>(c) < 0x20 ||
+           std::string_view("\"*/:<>?\\|").find(c) != std::string_view::npos;
+  });
+}
+
+static std::string ToUpperASCII(std::string_view name)
+{
+  std::string result(name);
+  for (char& c : result)
+  {
+    if (c >= 'a' && c <= 'z')
+      c = c - 'a' + 'A';
+  }
+  return result;
+}
+
+static u32 GetNumLFNEntries(const std::u16string& name)
+{
+  return static_cast<u32>((name.size() + LFN_CHARACTERS_PER_ENTRY - 1) / LFN_CHARACTERS_PER_ENTRY);
+}
+
+// Every entry gets a long name, so the short name only has to be unique within its directory,
+// which the numeric tail takes care of.
+static std::array<u8, 11> GetShortName(std::string_view name, u32 index)
+{
+  const auto sanitize = [](char c) -> u8 {
+    if (c >= 'a' && c <= 'z')
+      return c - 'a' + 'A';
+    if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+      return c;
+    return '_';
+  };
+
+  std::string_view base = name;
+  std::string_view extension;
+  if (const size_t dot = name.rfind('.'); dot != std::string_view::npos && dot != 0)
+  {
+    base = name.substr(0, dot);
+    extension = name.substr(dot + 1);
+  }
+
+  std::array<u8, 11> short_name;
+  short_name.fill(' ');
+
+  const std::string tail = fmt::format("~{}", index + 1);
+  const size_t base_length = std::min(base.size(), 8 - tail.size());
+  for (size_t i = 0; i < base_length; ++i)
+    short_name[i] = sanitize(base[i]);
+  std::ranges::copy(tail, short_name.begin() + base_length);
+
+  for (size_t i = 0; i < std::min<size_t>(extension.size(), 3); ++i)
+    short_name[8 + i] = sanitize(extension[i]);
+
+  return short_name;
+}
+
+static u8 GetShortNameChecksum(const std::array<u8, 11>& short_name)
+{
+  u8 sum = 0;
+  for (u8 c : short_name)
+    sum = static_cast<u8>(((sum & 1) << 7) + (sum >> 1) + c);
+  return sum;
+}
+
+static void WriteU16(u8* buffer, u16 value)
+{
+  std::memcpy(buffer, &value, sizeof(value));
+}
+
+static void WriteU32(u8* buffer, u32 value)
+{
+  std::memcpy(buffer, &value, sizeof(value));
+}
+
+static void WriteShortEntry(u8* entry, const std::array<u8, 11>& short_name, bool is_directory,
+                            u32 cluster, u32 size)
+{
+  std::ranges::copy(short_name, entry);
+  entry[11] = is_directory ? AM_DIR : AM_ARC;
+  WriteU16(entry + 20, static_cast<u16>(cluster >> 16));
+  WriteU16(entry + 26, static_cast<u16>(cluster));
+  WriteU32(entry + 28, size);
+}
+
+bool ShouldUseVirtualSDCard()
+{
+  // The contents of the card have to be identical for everyone when determinism is required, which
+  // is only guaranteed by packing the folder deterministically.
+  return Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC) &&
+         Config::Get(Config::MAIN_WII_SD_CARD_VIRTUAL_FOLDER) && !Core::WantsDeterminism();
+}
+
+std::unique_ptr<VirtualSDCard> VirtualSDCard::Create(const std::string& folder, u64 size)
+{
+  if (!File::IsDirectory(folder))
+  {
+    ERROR_LOG_FMT(IOS_SD, "{} is not a directory, can't create virtual SD card", folder);
+    return nullptr;
+  }
+
+  std::unique_ptr<VirtualSDCard> card(new VirtualSDCard(folder));
+  card->m_nodes.push_back({.is_directory = true});
+  card->AddChildren(File::ScanDirectoryTree(folder, true), 0, "");
+
+  if (size == 0)
+  {
+    u64 used_size = 0;
+    for (const Node& node : card->m_nodes)
+      used_size += Common::AlignUp(std::max<u64>(node.size, 1), ESTIMATED_CLUSTER_SIZE);
+
+    // Leave a reasonable amount of free space, like packing the folder into an image does.
+    size = used_size +
+           std::clamp<u64>(used_size / 2, 512 * 1024 * 1024, 8ULL * 1024 * 1024 * 1024);
+  }
+  size = std::clamp(Common::AlignUp(size, SIZE_ALIGNMENT), MIN_SIZE,
+                    Common::AlignDown(MAX_SIZE, SIZE_ALIGNMENT));
+
+  if (!card->Layout(size))
+    return nullptr;
+
+  INFO_LOG_FMT(IOS_SD, "Created virtual SD card for {} ({} bytes, {} files and directories)",
+               folder, size, card->m_nodes.size() - 1);
+  return card;
+}
+
+VirtualSDCard::VirtualSDCard(std::string folder) : m_folder(std::move(folder))
+{
+}
+
+VirtualSDCard::~VirtualSDCard()
+{
+  Flush();
+}
+
+void VirtualSDCard::AddChildren(const File::FSTEntry& entry, u32 parent,
+                                const std::string& relative_path)
+{
+  std::vector<const File::FSTEntry*> children;
+  children.reserve(entry.children.size());
+  for (const File::FSTEntry& child : entry.children)
+    children.push_back(&child);
+  std::ranges::sort(children, {}, &File::FSTEntry::virtualName);
+
+  // FAT names are case-insensitive.
+  std::set<std::string> upper_names;
+  u64 directory_size = parent == 0 ? 0 : 2 * DIRECTORY_ENTRY_SIZE;
+
+  for (const File::FSTEntry* child : children)
+  {
+    const std::string child_path =
+        relative_path.empty() ? child->virtualName : relative_path + '/' + child->virtualName;
+    const std::u16string utf16_name = UTF8ToUTF16(child->virtualName);
+
+    if (!IsValidName(child->virtualName) || utf16_name.size() > 255 ||
+        !upper_names.insert(ToUpperASCII(child->virtualName)).second)
+    {
+      WARN_LOG_FMT(IOS_SD, "Skipping {} because its name can't be used on the virtual SD card",
+                   child->physicalName);
+      continue;
+    }
+
+    if (!child->isDirectory && child->size >= 4ULL * 1024 * 1024 * 1024)
+    {
+      WARN_LOG_FMT(IOS_SD, "Skipping {} because it is too large ({})", child->physicalName,
+                   child->size);
+      continue;
+    }
+
+    if (m_nodes[parent].children.size() == MAX_DIRECTORY_ENTRIES)
+    {
+      WARN_LOG_FMT(IOS_SD, "Skipping {} because its directory has too many entries",
+                   child->physicalName);
+      continue;
+    }
+
+    directory_size += (GetNumLFNEntries(utf16_name) + 1) * DIRECTORY_ENTRY_SIZE;
+
+    const u32 index = static_cast<u32>(m_nodes.size());
+    m_nodes[parent].children.push_back(index);
+    m_nodes.push_back({.host_path = child->physicalName,
+                       .name = child->virtualName,
+                       .is_directory = child->isDirectory,
+                       .size = child->isDirectory ? 0 : child->size,
+                       .parent = parent});
+
+    m_entries[child_path] = {.is_directory = child->isDirectory,
+                             .size = m_nodes[index].size,
+                             .host_mtime = File::GetModificationTime(child->physicalName)};
+
+    if (child->isDirectory)
+      AddChildren(*child, index, child_path);
+    else
+      m_file_nodes.emplace(child_path, index);
+  }
+
+  m_nodes[parent].size = directory_size;
+}
+
+bool VirtualSDCard::Layout(u64 size)
+{
+  const u64 total_sectors = size / SECTOR_SIZE;
+
+  // Prefer large clusters, which keep the FAT small.
+  for (m_sectors_per_cluster = 64; m_sectors_per_cluster != 0; m_sectors_per_cluster /= 2)
+  {
+    const u64 max_clusters = (total_sectors - RESERVED_SECTORS) / m_sectors_per_cluster;
+    m_fat_sectors = static_cast<u32>(
+        Common::AlignUp((max_clusters + 2) * sizeof(u32), SECTOR_SIZE) / SECTOR_SIZE);
+    m_num_clusters = static_cast<u32>((total_sectors - RESERVED_SECTORS - m_fat_sectors) /
+                                      m_sectors_per_cluster);
+    if (m_num_clusters >= MIN_FAT32_CLUSTERS)
+      break;
+  }
+
+  if (m_sectors_per_cluster == 0)
+  {
+    ERROR_LOG_FMT(IOS_SD, "Virtual SD card size {} is too small for FAT32", size);
+    return false;
+  }
+
+  m_size = size;
+  m_data_start = RESERVED_SECTORS + m_fat_sectors;
+
+  // Nodes are in depth-first order, so the clusters of a directory and its contents are close.
+  u32 next_cluster = ROOT_CLUSTER;
+  for (u32 i = 0; i < m_nodes.size(); ++i)
+  {
+    Node& node = m_nodes[i];
+    node.num_clusters = static_cast<u32>(Common::AlignUp(node.size, GetClusterSize()) /
+                                         GetClusterSize());
+    // Directories always need a cluster, even when they're empty.
+    if (node.is_directory && node.num_clusters == 0)
+      node.num_clusters = 1;
+    if (node.num_clusters == 0)
+      continue;
+
+    if (u64(next_cluster) - ROOT_CLUSTER + node.num_clusters > m_num_clusters)
+    {
+      ERROR_LOG_FMT(IOS_SD, "{} doesn't fit on a virtual SD card of {} bytes", m_folder, size);
+      return false;
+    }
+
+    node.first_cluster = next_cluster;
+    next_cluster += node.num_clusters;
+    m_extents.emplace_back(node.first_cluster, i);
+  }
+
+  for (const auto& [relative_path, index] : m_file_nodes)
+    m_entries[relative_path].first_cluster = m_nodes[index].first_cluster;
+
+  m_used_clusters = next_cluster - ROOT_CLUSTER;
+  m_dirty_sectors.resize(total_sectors);
+  return true;
+}
+
+u64 VirtualSDCard::GetSize() const
+{
+  return m_size;
+}
+
+u64 VirtualSDCard::GetFirstSector(const Node& node) const
+{
+  return m_data_start + u64(node.first_cluster - ROOT_CLUSTER) * m_sectors_per_cluster;
+}
+
+const VirtualSDCard::Node* VirtualSDCard::FindNode(u32 cluster) const
+{
+  const auto it = std::ranges::upper_bound(m_extents, cluster, {},
+                                           [](const auto& extent) { return extent.first; });
+  if (it == m_extents.begin())
+    return nullptr;
+
+  const Node& node = m_nodes[std::prev(it)->second];
+  return cluster < node.first_cluster + node.num_clusters ? &node : nullptr;
+}
+
+u32 VirtualSDCard::GetFATEntry(u32 cluster) const
+{
+  if (cluster == 0)
+    return 0x0FFFFFF8;  // media descriptor
+  if (cluster == 1)
+    return FAT_END_OF_CHAIN;
+
+  const Node* node = FindNode(cluster);
+  if (!node)
+    return 0;
+
+  return cluster + 1 == node->first_cluster + node->num_clusters ? FAT_END_OF_CHAIN : cluster + 1;
+}
+
+bool VirtualSDCard::Read(u64 offset, u8* buffer, u64 size)
+{
+  if (offset + size > m_size || offset + size < offset)
+  {
+    ERROR_LOG_FMT(IOS_SD, "Read of {} bytes at {:#x} is out of bounds", size, offset);
+    return false;
+  }
+
+  m_read_error = false;
+
+  // Handle a partial first sector.
+  if (offset % SECTOR_SIZE != 0 && size != 0)
+  {
+    std::array<u8, SECTOR_SIZE> sector;
+    ReadSectors(offset / SECTOR_SIZE, 1, sector.data());
+    const u64 chunk_size = std::min<u64>(size, SECTOR_SIZE - offset % SECTOR_SIZE);
+    std::memcpy(buffer, sector.data() + offset % SECTOR_SIZE, chunk_size);
+    offset += chunk_size;
+    buffer += chunk_size;
+    size -= chunk_size;
+  }
+
+  ReadSectors(offset / SECTOR_SIZE, size / SECTOR_SIZE, buffer);
+
+  // Handle a partial last sector.
+  if (size % SECTOR_SIZE != 0)
+  {
+    std::array<u8, SECTOR_SIZE> sector;
+    ReadSectors((offset + size) / SECTOR_SIZE, 1, sector.data());
+    std::memcpy(buffer + Common::AlignDown(size, SECTOR_SIZE), sector.data(), size % SECTOR_SIZE);
+  }
+
+  return !m_read_error;
+}
+
+void VirtualSDCard::ReadSectors(u64 sector, u64 count, u8* buffer)
+{
+  while (count != 0)
+  {
+    if (const auto it = m_overlay.find(sector); it != m_overlay.end())
+    {
+      std::ranges::copy(it->second, buffer);
+      ++sector;
+      --count;
+      buffer += SECTOR_SIZE;
+      continue;
+    }
+
+    // Read as many consecutive sectors of a file from the host as possible in one go.
+    if (sector >= m_data_start)
+    {
+      const u32 cluster =
+          static_cast<u32>((sector - m_data_start) / m_sectors_per_cluster + ROOT_CLUSTER);
+      const Node* node = FindNode(cluster);
+      if (node && !node->is_directory)
+      {
+        const u64 first_sector = GetFirstSector(*node);
+        const u64 end_sector = first_sector + u64(node->num_clusters) * m_sectors_per_cluster;
+        u64 run = 1;
+        while (run < std::min(count, end_sector - sector) && !m_overlay.contains(sector + run))
+          ++run;
+
+        ReadFileData(static_cast<u32>(node - m_nodes.data()),
+                     (sector - first_sector) * SECTOR_SIZE, buffer, run * SECTOR_SIZE);
+        sector += run;
+        count -= run;
+        buffer += run * SECTOR_SIZE;
+        continue;
+      }
+    }
+
+    ReadSector(sector, buffer);
+    ++sector;
+    --count;
+    buffer += SECTOR_SIZE;
+  }
+}
+
+void VirtualSDCard::ReadSector(u64 sector, u8* buffer)
+{
+  if (sector == 0 || sector == BACKUP_BOOT_SECTOR)
+    ReadBootSector(buffer);
+  else if (sector == FSINFO_SECTOR || sector == BACKUP_BOOT_SECTOR + FSINFO_SECTOR)
+    ReadFSInfoSector(buffer);
+  else if (sector >= RESERVED_SECTORS && sector < m_data_start)
+    ReadFATSector(sector - RESERVED_SECTORS, buffer);
+  else if (sector >= m_data_start)
+    ReadDataSector(sector - m_data_start, buffer);
+  else
+    std::fill_n(buffer, SECTOR_SIZE, 0);
+}
+
+void VirtualSDCard::ReadBootSector(u8* buffer) const
+{
+  std::fill_n(buffer, SECTOR_SIZE, 0);
+
+  const u8 jump[] = {0xEB, 0x58, 0x90};
+  std::ranges::copy(jump, buffer);
+  std::memcpy(buffer + 3, "MSWIN4.1", 8);
+  WriteU16(buffer + 11, SECTOR_SIZE);
+  buffer[13] = static_cast<u8>(m_sectors_per_cluster);
+  WriteU16(buffer + 14, RESERVED_SECTORS);
+  buffer[16] = 1;     // number of FATs
+  buffer[21] = 0xF8;  // media descriptor
+  WriteU16(buffer + 24, 63);   // sectors per track
+  WriteU16(buffer + 26, 255);  // heads
+  WriteU32(buffer + 32, static_cast<u32>(m_size / SECTOR_SIZE));
+  WriteU32(buffer + 36, m_fat_sectors);
+  WriteU32(buffer + 44, ROOT_CLUSTER);
+  WriteU16(buffer + 48, FSINFO_SECTOR);
+  WriteU16(buffer + 50, BACKUP_BOOT_SECTOR);
+  buffer[64] = 0x80;  // drive number
+  buffer[66] = 0x29;  // extended boot signature
+  WriteU32(buffer + 67, 0x44534456);  // volume serial number
+  std::memcpy(buffer + 71, "NO NAME    ", 11);
+  std::memcpy(buffer + 82, "FAT32   ", 8);
+  buffer[510] = 0x55;
+  buffer[511] = 0xAA;
+}
+
+void VirtualSDCard::ReadFSInfoSector(u8* buffer) const
+{
+  std::fill_n(buffer, SECTOR_SIZE, 0);
+  WriteU32(buffer, 0x41615252);
+  WriteU32(buffer + 484, 0x61417272);
+  WriteU32(buffer + 488, m_num_clusters - m_used_clusters);
+  WriteU32(buffer + 492, ROOT_CLUSTER + m_used_clusters);
+  WriteU32(buffer + 508, 0xAA550000);
+}
+
+void VirtualSDCard::ReadFATSector(u64 index, u8* buffer) const
+{
+  constexpr u32 ENTRIES_PER_SECTOR = SECTOR_SIZE / sizeof(u32);
+  for (u32 i = 0; i < ENTRIES_PER_SECTOR; ++i)
+  {
+    const u64 cluster = index * ENTRIES_PER_SECTOR + i;
+    const u32 entry = cluster < u64(m_num_clusters) + ROOT_CLUSTER ?
+                          GetFATEntry(static_cast<u32>(cluster)) :
+                          0;
+    WriteU32(buffer + i * sizeof(u32), entry);
+  }
+}
+
+void VirtualSDCard::ReadDataSector(u64 index, u8* buffer)
+{
+  const u32 cluster = static_cast<u32>(index / m_sectors_per_cluster + ROOT_CLUSTER);
+  const Node* node = FindNode(cluster);
+  if (!node)
+  {
+    std::fill_n(buffer, SECTOR_SIZE, 0);
+    return;
+  }
+
+  const u32 node_index = static_cast<u32>(node - m_nodes.data());
+  const u64 offset = (index - u64(node->first_cluster - ROOT_CLUSTER) * m_sectors_per_cluster) *
+                     SECTOR_SIZE;
+  if (!node->is_directory)
+  {
+    ReadFileData(node_index, offset, buffer, SECTOR_SIZE);
+    return;
+  }
+
+  const std::vector<u8>& data = GetDirectoryData(node_index);
+  std::fill_n(buffer, SECTOR_SIZE, 0);
+  if (offset < data.size())
+    std::copy_n(data.begin() + offset, std::min<u64>(SECTOR_SIZE, data.size() - offset), buffer);
+}
+
+void VirtualSDCard::ReadFileData(u32 node_index, u64 offset, u8* buffer, u64 size)
+{
+  const Node& node = m_nodes[node_index];
+  const u64 available = offset < node.size ? std::min(size, node.size - offset) : 0;
+  std::fill_n(buffer + available, size - available, 0);
+  if (available == 0)
+    return;
+
+  if (m_open_file_node != node_index || !m_open_file)
+  {
+    m_open_file_node = node_index;
+    if (!m_open_file.Open(node.host_path, "rb"))
+      ERROR_LOG_FMT(IOS_SD, "Failed to open {} for the virtual SD card", node.host_path);
+  }
+
+  if (!m_open_file.Seek(offset, File::SeekOrigin::Begin) ||
+      !m_open_file.ReadBytes(buffer, available))
+  {
+    ERROR_LOG_FMT(IOS_SD, "Failed to read {} bytes at {:#x} from {}", available, offset,
+                  node.host_path);
+    m_open_file.ClearError();
+    std::fill_n(buffer, available, 0);
+    m_read_error = true;
+  }
+}
+
+const std::vector<u8>& VirtualSDCard::GetDirectoryData(u32 node_index)
+{
+  const auto [it, inserted] = m_directory_data.try_emplace(node_index);
+  std::vector<u8>& data = it->second;
+  if (!inserted)
+    return data;
+
+  const Node& node = m_nodes[node_index];
+  data.resize(node.size);
+  u8* entry = data.data();
+
+  if (node_index != 0)
+  {
+    std::array<u8, 11> dot_name;
+    dot_name.fill(' ');
+    dot_name[0] = '.';
+    WriteShortEntry(entry, dot_name, true, node.first_cluster, 0);
+    entry += DIRECTORY_ENTRY_SIZE;
+
+    // The root directory is referred to as cluster 0.
+    dot_name[1] = '.';
+    WriteShortEntry(entry, dot_name, true,
+                    node.parent == 0 ? 0 : m_nodes[node.parent].first_cluster, 0);
+    entry += DIRECTORY_ENTRY_SIZE;
+  }
+
+  for (u32 i = 0; i < node.children.size(); ++i)
+  {
+    const Node& child = m_nodes[node.children[i]];
+    const std::array<u8, 11> short_name = GetShortName(child.name, i);
+    const u8 checksum = GetShortNameChecksum(short_name);
+
+    // The long name is stored in reverse order in front of the short entry, padded with 0xFFFF
+    // after a null terminator.
+    const std::u16string name = UTF8ToUTF16(child.name);
+    const u32 num_lfn_entries = GetNumLFNEntries(name);
+    for (u32 j = num_lfn_entries; j != 0; --j)
+    {
+      constexpr u32 CHARACTER_OFFSETS[LFN_CHARACTERS_PER_ENTRY] = {1,  3,  5,  7,  9,  14, 16,
+                                                                   18, 20, 22, 24, 28, 30};
+      entry[0] = static_cast<u8>(j | (j == num_lfn_entries ? 0x40 : 0));
+      entry[11] = ATTRIBUTE_LFN;
+      entry[13] = checksum;
+      for (u32 k = 0; k < LFN_CHARACTERS_PER_ENTRY; ++k)
+      {
+        const size_t position = (j - 1) * LFN_CHARACTERS_PER_ENTRY + k;
+        const u16 c = position < name.size() ? name[position] :
+                      position == name.size() ? 0 :
+                                                0xFFFF;
+        WriteU16(entry + CHARACTER_OFFSETS[k], c);
+      }
+      entry += DIRECTORY_ENTRY_SIZE;
+    }
+
+    WriteShortEntry(entry, short_name, child.is_directory, child.first_cluster,
+                    static_cast<u32>(child.size));
+    entry += DIRECTORY_ENTRY_SIZE;
+  }
+
+  return data;
+}
+
+bool VirtualSDCard::Write(u64 offset, const u8* buffer, u64 size)
+{
+  if (offset + size > m_size || offset + size < offset)
+  {
+    ERROR_LOG_FMT(IOS_SD, "Write of {} bytes at {:#x} is out of bounds", size, offset);
+    return false;
+  }
+
+  m_read_error = false;
+  while (size != 0)
+  {
+    const u64 sector = offset / SECTOR_SIZE;
+    const u64 offset_in_sector = offset % SECTOR_SIZE;
+    const u64 chunk_size = std::min<u64>(size, SECTOR_SIZE - offset_in_sector);
+
+    auto it = m_overlay.find(sector);
+    if (it == m_overlay.end())
+    {
+      std::array<u8, SECTOR_SIZE> data;
+      if (chunk_size != SECTOR_SIZE)
+        ReadSectors(sector, 1, data.data());
+      it = m_overlay.emplace(sector, data).first;
+    }
+
+    std::memcpy(it->second.data() + offset_in_sector, buffer, chunk_size);
+    m_dirty_sectors[sector] = true;
+
+    offset += chunk_size;
+    buffer += chunk_size;
+    size -= chunk_size;
+  }
+
+  return !m_read_error;
+}
+
+void VirtualSDCard::DetachFile(const std::string& relative_path)
+{
+  const auto it = m_file_nodes.find(relative_path);
+  if (it == m_file_nodes.end() || m_nodes[it->second].detached)
+    return;
+
+  Node& node = m_nodes[it->second];
+  const u64 first_sector = GetFirstSector(node);
+  const u64 num_sectors = u64(node.num_clusters) * m_sectors_per_cluster;
+  for (u64 sector = first_sector; sector < first_sector + num_sectors; ++sector)
+  {
+    if (m_overlay.contains(sector))
+      continue;
+
+    std::array<u8, SECTOR_SIZE> data;
+    ReadFileData(it->second, (sector - first_sector) * SECTOR_SIZE, data.data(), SECTOR_SIZE);
+    m_overlay.emplace(sector, data);
+  }
+
+  node.detached = true;
+  // On some systems, open files can't be replaced or deleted.
+  m_open_file.Close();
+}
+
+bool VirtualSDCard::Flush()
+{
+  if (std::ranges::find(m_dirty_sectors, true) == m_dirty_sectors.end())
+    return true;
+
+  INFO_LOG_FMT(IOS_SD, "Copying changes on the virtual SD card to {}", m_folder);
+
+  std::optional<Common::SDSyncEntries> new_entries;
+  VirtualSDCardFatFsCallbacks callbacks(*this);
+  Common::RunInFatFsContext(callbacks, [&] {
+    // Reading an unchanged part of a file needs its host file, so it has to be copied before
+    // the host file is replaced.
+    new_entries = Common::UnpackChangedFiles(
+        [] { return false; }, m_folder, m_entries, m_dirty_sectors,
+        [this](const std::string& relative_path) { DetachFile(relative_path); });
+  });
+  m_open_file.Close();
+
+  if (!new_entries)
+  {
+    ERROR_LOG_FMT(IOS_SD, "Failed to copy changes on the virtual SD card to {}", m_folder);
+    return false;
+  }
+
+  m_entries = std::move(*new_entries);
+  std::fill(m_dirty_sectors.begin(), m_dirty_sectors.end(), false);
+  return true;
+}
+}  // namespace IOS::HLE
@@ -0,0 +1,120 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// An SD card whose FAT32 filesystem is generated on the fly from a host folder, so that no image
+// has to be packed before emulation and unpacked after it. Only the layout of the folder is
+// scanned when the card is created. The boot sector, the FAT and the directories are generated
+// when they are read, and file data is read from the host files. Writes go to an overlay in
+// memory, and the files they changed are copied back to the folder when the card is flushed.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FatFsUtil.h"
+#include "Common/IOFile.h"
+#include "Core/IOS/SDIO/SDCardBackend.h"
+
+namespace File
+{
+struct FSTEntry;
+}
+
+namespace IOS::HLE
+{
+// Whether the emulated SD card should be served from the SD sync folder instead of an image.
+bool ShouldUseVirtualSDCard();
+
+class VirtualSDCard final : public SDCardBackend
+{
+public:
+  static constexpr u32 SECTOR_SIZE = 512;
+
+  // folder must end with a separator. If size is 0, a size is picked based on the contents of the
+  // folder. Returns nullptr if the folder doesn't fit.
+  static std::unique_ptr<VirtualSDCard> Create(const std::string& folder, u64 size);
+
+  ~VirtualSDCard() override;
+
+  VirtualSDCard(const VirtualSDCard&) = delete;
+  VirtualSDCard& operator=(const VirtualSDCard&) = delete;
+
+  u64 GetSize() const override;
+  bool Read(u64 offset, u8* buffer, u64 size) override;
+  bool Write(u64 offset, const u8* buffer, u64 size) override;
+
+  // Copies the files that were changed by writes since the last flush back to the folder. The
+  // folder must not be modified by anything else while the card exists.
+  bool Flush();
+
+private:
+  struct Node
+  {
+    std::string host_path;
+    std::string name;
+    bool is_directory = false;
+    // For directories, the size of their directory entries.
+    u64 size = 0;
+    u32 parent = 0;
+    u32 first_cluster = 0;
+    u32 num_clusters = 0;
+    bool detached = false;
+    std::vector<u32> children;
+  };
+
+  explicit VirtualSDCard(std::string folder);
+
+  void AddChildren(const File::FSTEntry& entry, u32 parent, const std::string& relative_path);
+  bool Layout(u64 size);
+
+  void ReadSectors(u64 sector, u64 count, u8* buffer);
+  void ReadSector(u64 sector, u8* buffer);
+  void ReadBootSector(u8* buffer) const;
+  void ReadFSInfoSector(u8* buffer) const;
+  void ReadFATSector(u64 index, u8* buffer) const;
+  void ReadDataSector(u64 index, u8* buffer);
+  void ReadFileData(u32 node_index, u64 offset, u8* buffer, u64 size);
+  // Copies the parts of a file that weren't written to into the overlay, so that its host file is
+  // no longer needed.
+  void DetachFile(const std::string& relative_path);
+
+  // Returns the node whose clusters include cluster, or nullptr if it is free.
+  const Node* FindNode(u32 cluster) const;
+  u32 GetClusterSize() const { return m_sectors_per_cluster * SECTOR_SIZE; }
+  u64 GetFirstSector(const Node& node) const;
+  u32 GetFATEntry(u32 cluster) const;
+  const std::vector<u8>& GetDirectoryData(u32 node_index);
+
+  const std::string m_folder;
+  u64 m_size = 0;
+
+  u32 m_sectors_per_cluster = 0;
+  u32 m_fat_sectors = 0;
+  u32 m_data_start = 0;
+  u32 m_num_clusters = 0;
+  u32 m_used_clusters = 0;
+
+  // Index 0 is the root directory. Nodes are stored in the order of their clusters.
+  std::vector<Node> m_nodes;
+  std::unordered_map<std::string, u32> m_file_nodes;
+  // First cluster and index of every node that has clusters, sorted by cluster.
+  std::vector<std::pair<u32, u32>> m_extents;
+  std::unordered_map<u32, std::vector<u8>> m_directory_data;
+
+  File::IOFile m_open_file;
+  u32 m_open_file_node = 0;
+  bool m_read_error = false;
+
+  std::unordered_map<u64, std::array<u8, SECTOR_SIZE>> m_overlay;
+  // Sectors written to since the last flush.
+  std::vector<bool> m_dirty_sectors;
+  // What the folder looked like as of the last flush.
+  Common::SDSyncEntries m_entries;
+};
+}  // namespace IOS::HLE
@@ -0,0 +1,217 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayChunkedData.h"
+
+#include <algorithm>
+#include <array>
+#include <future>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace NetPlay
+{
+// Random values for the rolling hash, one for every byte value.
+static constexpr std::array<u64, 256> GEAR_TABLE = [] {
+  std::array<u64, 256> table{};
+  u64 state = 0x2545f4914f6cdd1d;
+  for (u64& value : table)
+  {
+    // splitmix64
+    state += 0x9e3779b97f4a7c15;
+    u64 z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    value = z ^ (z >> 31);
+  }
+  return table;
+}();
+
+// The rolling hash shifts left, so its top bits depend on the most recent 64 bytes. A cut is made
+// when the masked bits are all zero. The mask is stricter before the average size and looser
+// after it, which keeps chunk sizes closer to the average.
+constexpr u64 CHUNK_MASK_SMALL = ~u64(0) << (64 - 18);
+constexpr u64 CHUNK_MASK_LARGE = ~u64(0) << (64 - 14);
+
+static size_t FindChunkEnd(std::span<const u8> data)
+{
+  if (data.size() <= CHUNK_MIN_SIZE)
+    return data.size();
+
+  const size_t end = std::min<size_t>(data.size(), CHUNK_MAX_SIZE);
+  const size_t average = std::min<size_t>(end, CHUNK_AVERAGE_SIZE);
+  u64 hash = 0;
+  size_t i = CHUNK_MIN_SIZE;
+  for (; i < average; ++i)
+  {
+    hash = (hash << 1) + GEAR_TABLE[data[i]];
+    if ((hash & CHUNK_MASK_SMALL) == 0)
+      return i + 1;
+  }
+  for (; i < end; ++i)
+  {
+    hash = (hash << 1) + GEAR_TABLE[data[i]];
+    if ((hash & CHUNK_MASK_LARGE) == 0)
+      return i + 1;
+  }
+  return end;
+}
+
+ChunkHash HashChunk(std::span<const u8> data)
+{
+  const XXH128_hash_t hash = XXH3_128bits(data.data(), data.size());
+  return {hash.low64, hash.high64};
+}
+
+std::vector<ChunkInfo> SplitIntoChunks(std::span<const u8> data)
+{
+  std::vector<ChunkInfo> chunks;
+  for (u64 offset = 0; offset < data.size();)
+  {
+    const size_t size = FindChunkEnd(data.subspan(offset));
+    chunks.push_back({{}, offset, static_cast<u32>(size)});
+    offset += size;
+  }
+
+  // Finding the boundaries has to be sequential, but hashing the chunks doesn't.
+  const size_t threads = std::min<size_t>(
+      chunks.size(), std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+  const auto hash_range = [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i)
+      chunks[i].hash = HashChunk(data.subspan(chunks[i].offset, chunks[i].size));
+  };
+  if (threads <= 1)
+  {
+    hash_range(0, chunks.size());
+    return chunks;
+  }
+
+  std::vector<std::future<void>> futures(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    futures[i] = std::async(std::launch::async, hash_range, i * chunks.size() / threads,
+                            (i + 1) * chunks.size() / threads);
+  }
+  for (std::future<void>& future : futures)
+    future.get();
+
+  return chunks;
+}
+
+ChunkCache::ChunkCache(std::string directory, u64 max_size)
+    : m_directory(std::move(directory)), m_max_size(max_size)
+{
+}
+
+std::string ChunkCache::GetPath(const ChunkHash& hash) const
+{
+  return fmt::format("{}{:016x}{:016x}", m_directory, hash.high, hash.low);
+}
+
+void ChunkCache::ScanDirectory()
+{
+  if (m_scanned)
+    return;
+  m_scanned = true;
+
+  if (!File::IsDirectory(m_directory))
+    return;
+
+  for (const File::FSTEntry& file : File::ScanDirectoryTree(m_directory, false).children)
+  {
+    u64 high, low;
+    if (file.isDirectory || file.virtualName.size() != 32 ||
+        !TryParse(file.virtualName.substr(0, 16), &high, 16) ||
+        !TryParse(file.virtualName.substr(16), &low, 16))
+    {
+      continue;
+    }
+
+    // Chunks from earlier sessions are older than anything used in this one.
+    m_entries[{low, high}] = {file.size, 0};
+    m_total_size += file.size;
+  }
+}
+
+std::optional<std::vector<u8>> ChunkCache::Load(const ChunkHash& hash, u32 size)
+{
+  std::lock_guard lk(m_mutex);
+  ScanDirectory();
+
+  const auto it = m_entries.find(hash);
+  if (it == m_entries.end() || it->second.size != size)
+    return std::nullopt;
+
+  std::vector<u8> data(size);
+  File::IOFile file(GetPath(hash), "rb");
+  if (!file.ReadBytes(data.data(), data.size()) || HashChunk(data) != hash)
+  {
+    WARN_LOG_FMT(NETPLAY, "Discarding corrupted cached chunk {}", GetPath(hash));
+    file.Close();
+    File::Delete(GetPath(hash));
+    m_total_size -= it->second.size;
+    m_entries.erase(it);
+    return std::nullopt;
+  }
+
+  it->second.last_use = ++m_use_counter;
+  return data;
+}
+
+void ChunkCache::Store(const ChunkHash& hash, std::span<const u8> data)
+{
+  std::lock_guard lk(m_mutex);
+  ScanDirectory();
+
+  if (m_entries.contains(hash))
+    return;
+
+  if (!File::CreateFullPath(m_directory))
+    return;
+
+  File::IOFile file(GetPath(hash), "wb");
+  if (!file.WriteBytes(data.data(), data.size()))
+  {
+    file.Close();
+    File::Delete(GetPath(hash));
+    return;
+  }
+
+  m_entries[hash] = {data.size(), ++m_use_counter};
+  m_total_size += data.size();
+}
+
+void ChunkCache::Prune(u64 keep_size)
+{
+  std::lock_guard lk(m_mutex);
+  ScanDirectory();
+
+  const u64 max_size = std::max(m_max_size, keep_size);
+  if (m_total_size <= max_size)
+    return;
+
+  std::vector<std::pair<u64, ChunkHash>> by_age;
+  by_age.reserve(m_entries.size());
+  for (const auto& [hash, entry] : m_entries)
+    by_age.emplace_back(entry.last_use, hash);
+  std::ranges::sort(by_age);
+
+  for (const auto& [last_use, hash] : by_age)
+  {
+    if (m_total_size <= max_size)
+      break;
+
+    File::Delete(GetPath(hash));
+    m_total_size -= m_entries[hash].size;
+    m_entries.erase(hash);
+  }
+}
+}  // namespace NetPlay
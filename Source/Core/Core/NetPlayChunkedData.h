@@ -0,0 +1,82 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Deduplication for NetPlay chunked data transfers. The data is split into content-defined chunks,
+// so that a change in one file only changes the chunks around it, and every chunk is identified by
+// its hash. Clients keep the chunks they received in an on-disk cache. When the same data is sent
+// again, in a later session or after reconnecting in the middle of a transfer, only the chunks
+// that aren't in the cache have to be sent.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace NetPlay
+{
+constexpr u32 CHUNK_MIN_SIZE = 16 * 1024;
+constexpr u32 CHUNK_AVERAGE_SIZE = 64 * 1024;
+constexpr u32 CHUNK_MAX_SIZE = 256 * 1024;
+// How many times a client asks for chunks that didn't arrive intact before it gives up.
+constexpr u32 CHUNK_MAX_RETRIES = 3;
+
+struct ChunkHash
+{
+  u64 low = 0;
+  u64 high = 0;
+
+  auto operator<=>(const ChunkHash&) const = default;
+};
+
+struct ChunkInfo
+{
+  ChunkHash hash;
+  u64 offset = 0;
+  u32 size = 0;
+};
+
+ChunkHash HashChunk(std::span<const u8> data);
+
+// Splits data into chunks of CHUNK_MIN_SIZE to CHUNK_MAX_SIZE bytes whose boundaries only depend on
+// the bytes around them, and hashes the chunks in parallel.
+std::vector<ChunkInfo> SplitIntoChunks(std::span<const u8> data);
+
+class ChunkCache
+{
+public:
+  ChunkCache(std::string directory, u64 max_size);
+
+  // Returns the chunk if it is cached and its contents still match the hash.
+  std::optional<std::vector<u8>> Load(const ChunkHash& hash, u32 size);
+  void Store(const ChunkHash& hash, std::span<const u8> data);
+  // Deletes the least recently used chunks until the cache fits in max_size, or in keep_size if
+  // that is larger. Passing the size of the data that was just received keeps all of it cached
+  // even when it is larger than max_size.
+  void Prune(u64 keep_size = 0);
+
+private:
+  struct Entry
+  {
+    u64 size = 0;
+    u64 last_use = 0;
+  };
+
+  void ScanDirectory();
+  std::string GetPath(const ChunkHash& hash) const;
+
+  const std::string m_directory;
+  const u64 m_max_size;
+
+  std::mutex m_mutex;
+  bool m_scanned = false;
+  std::map<ChunkHash, Entry> m_entries;
+  u64 m_total_size = 0;
+  u64 m_use_counter = 0;
+};
+}  // namespace NetPlay
@@ -44,6 +44,7 @@
 #include "Core/Config/WiimoteSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
@@ -53,6 +54,7 @@
 #include "Core/HW/GBAPad.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
 #include "Core/HW/GCPad.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
 #include "Core/HW/SI/SI_DeviceGCController.h"
@@ -69,6 +71,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayCommon.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/System.h"
 #include "DiscIO/Blob.h"
@@ -95,6 +98,9 @@ NetPlayClient::~NetPlayClient()
   if (m_is_running.IsSet())
     StopGame();
 
+  // Samples that are still being hashed would be sent through the connection.
+  m_ram_hasher.Stop();
+
   if (m_is_connected)
   {
     m_should_compute_game_digest = false;
@@ -136,6 +142,10 @@ NetPlayClient::NetPlayClient(const std::string& address, const u16 port, NetPlay
 {
   ClearBuffers();
 
+  m_chunk_cache = std::make_unique<ChunkCache>(
+      File::GetUserPath(D_CACHE_IDX) + "NetPlayChunks" DIR_SEP,
+      u64{Config::Get(Config::NETPLAY_CHUNK_CACHE_SIZE)} * 1024 * 1024);
+
   if (!traversal_config.use_traversal)
   {
     // Direct Connection
@@ -487,6 +497,10 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnDesyncDetected(packet);
     break;
 
+  case MessageID::RamDesyncDetected:
+    OnRamDesyncDetected(packet);
+    break;
+
   case MessageID::SyncSaveData:
     OnSyncSaveData(packet);
     break;
@@ -583,14 +597,64 @@ void NetPlayClient::OnChunkedDataStart(sf::Packet& packet)
   std::string title;
   packet >> title;
   const u64 data_size = Common::PacketReadU64(packet);
+  u32 chunk_count;
+  packet >> chunk_count;
+
+  INFO_LOG_FMT(NETPLAY, "Starting data chunk {} ({} chunks).", cid, chunk_count);
+
+  ChunkedDataReceive receive;
+  u64 offset = 0;
+  for (u32 i = 0; i < chunk_count && !packet.endOfPacket(); ++i)
+  {
+    ChunkInfo chunk;
+    chunk.hash.low = Common::PacketReadU64(packet);
+    chunk.hash.high = Common::PacketReadU64(packet);
+    packet >> chunk.size;
+    chunk.offset = offset;
+    offset += chunk.size;
+    receive.chunks.push_back(chunk);
+  }
+
+  if (receive.chunks.size() != chunk_count || offset != data_size)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Invalid chunk list for data chunk {}.", cid);
+    receive.chunks.clear();
+    receive.valid = false;
+  }
+  receive.data.resize(offset);
+  receive.received.resize(receive.chunks.size());
+
+  // Chunks from an earlier transfer of the same data don't have to be sent again.
+  std::vector<u32> missing;
+  for (u32 i = 0; i < receive.chunks.size(); ++i)
+  {
+    const ChunkInfo& chunk = receive.chunks[i];
+    const std::optional<std::vector<u8>> cached = m_chunk_cache->Load(chunk.hash, chunk.size);
+    if (!cached)
+    {
+      missing.push_back(i);
+      continue;
+    }
+
+    std::ranges::copy(*cached, receive.data.begin() + chunk.offset);
+    receive.received[i] = true;
+    receive.received_size += chunk.size;
+  }
 
-  INFO_LOG_FMT(NETPLAY, "Starting data chunk {}.", cid);
+  INFO_LOG_FMT(NETPLAY, "{} of {} chunks of data chunk {} are cached.",
+               receive.chunks.size() - missing.size(), receive.chunks.size(), cid);
 
-  m_chunked_data_receive_queue.emplace(cid, sf::Packet{});
+  SendChunkedDataMissing(cid, missing);
+
+  const u64 received_size = receive.received_size;
+  m_chunked_data_receive_queue.insert_or_assign(cid, std::move(receive));
 
   std::vector<int> players;
   players.push_back(m_local_player->pid);
   m_dialog->ShowChunkedProgressDialog(title, data_size, players);
+
+  if (received_size != 0)
+    SendChunkedDataProgress(cid, received_size);
 }
 
 void NetPlayClient::OnChunkedDataEnd(sf::Packet& packet)
@@ -607,10 +671,51 @@ void NetPlayClient::OnChunkedDataEnd(sf::Packet& packet)
 
   INFO_LOG_FMT(NETPLAY, "Ending data chunk {}.", cid);
 
-  auto& data_packet = data_packet_iter->second;
-  OnData(data_packet);
+  ChunkedDataReceive& receive = data_packet_iter->second;
+  std::vector<u32> missing;
+  for (u32 i = 0; i < receive.received.size(); ++i)
+  {
+    if (!receive.received[i])
+      missing.push_back(i);
+  }
+
+  // Chunks that didn't match their hash were dropped, so ask for them again. The host only
+  // counts the transfer as done once every chunk arrived intact.
+  if (receive.valid && !missing.empty() && receive.retries < CHUNK_MAX_RETRIES)
+  {
+    ++receive.retries;
+    WARN_LOG_FMT(NETPLAY, "Requesting {} chunks of data chunk {} again (attempt {}).",
+                 missing.size(), cid, receive.retries);
+    SendChunkedDataMissing(cid, missing);
+    return;
+  }
+
+  const bool complete = receive.valid && missing.empty();
+  const u64 data_size = receive.data.size();
+  if (complete)
+  {
+    sf::Packet data_packet;
+    data_packet.append(receive.data.data(), receive.data.size());
+    OnData(data_packet);
+  }
+  else
+  {
+    ERROR_LOG_FMT(NETPLAY, "Data chunk {} is incomplete.", cid);
+  }
   m_chunked_data_receive_queue.erase(data_packet_iter);
   m_dialog->HideChunkedProgressDialog();
+  m_chunk_cache->Prune(data_size);
+
+  if (!complete)
+  {
+    m_dialog->AppendChat(Common::GetStringT("Error processing data."));
+
+    sf::Packet failed_packet;
+    failed_packet << MessageID::ChunkedDataFailed;
+    failed_packet << cid;
+    Send(failed_packet, CHUNKED_DATA_CHANNEL);
+    return;
+  }
 
   sf::Packet complete_packet;
   complete_packet << MessageID::ChunkedDataComplete;
@@ -621,7 +726,9 @@ void NetPlayClient::OnChunkedDataEnd(sf::Packet& packet)
 void NetPlayClient::OnChunkedDataPayload(sf::Packet& packet)
 {
   u32 cid;
+  u32 index;
   packet >> cid;
+  packet >> index;
 
   const auto data_packet_iter = m_chunked_data_receive_queue.find(cid);
   if (data_packet_iter == m_chunked_data_receive_queue.end())
@@ -630,25 +737,56 @@ void NetPlayClient::OnChunkedDataPayload(sf::Packet& packet)
     return;
   }
 
-  auto& data_packet = data_packet_iter->second;
-  while (!packet.endOfPacket())
+  ChunkedDataReceive& receive = data_packet_iter->second;
+  if (index >= receive.chunks.size() || receive.received[index])
   {
-    u8 byte;
+    INFO_LOG_FMT(NETPLAY, "Invalid chunk index {} of data chunk {}.", index, cid);
+    return;
+  }
+
+  const ChunkInfo& chunk = receive.chunks[index];
+  const std::span<u8> chunk_data(receive.data.data() + chunk.offset, chunk.size);
+  for (u8& byte : chunk_data)
     packet >> byte;
-    data_packet << byte;
+
+  if (!packet.endOfPacket() || !packet || HashChunk(chunk_data) != chunk.hash)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Chunk {} of data chunk {} doesn't match its hash.", index, cid);
+    return;
   }
 
-  INFO_LOG_FMT(NETPLAY, "Received {} bytes of data chunk {}.", data_packet.getDataSize(), cid);
+  // Storing chunks right away lets a transfer pick up where it stopped after reconnecting.
+  m_chunk_cache->Store(chunk.hash, chunk_data);
+  receive.received[index] = true;
+  receive.received_size += chunk.size;
 
-  m_dialog->SetChunkedProgress(m_local_player->pid, data_packet.getDataSize());
+  INFO_LOG_FMT(NETPLAY, "Received {} bytes of data chunk {}.", receive.received_size, cid);
+
+  SendChunkedDataProgress(cid, receive.received_size);
+}
+
+void NetPlayClient::SendChunkedDataProgress(u32 cid, u64 progress)
+{
+  m_dialog->SetChunkedProgress(m_local_player->pid, progress);
 
   sf::Packet progress_packet;
   progress_packet << MessageID::ChunkedDataProgress;
   progress_packet << cid;
-  progress_packet << u64{data_packet.getDataSize()};
+  progress_packet << progress;
   Send(progress_packet, CHUNKED_DATA_CHANNEL);
 }
 
+void NetPlayClient::SendChunkedDataMissing(u32 cid, const std::vector<u32>& missing)
+{
+  sf::Packet missing_packet;
+  missing_packet << MessageID::ChunkedDataMissing;
+  missing_packet << cid;
+  missing_packet << static_cast<u32>(missing.size());
+  for (const u32 index : missing)
+    missing_packet << index;
+  Send(missing_packet, CHUNKED_DATA_CHANNEL);
+}
+
 void NetPlayClient::OnChunkedDataAbort(sf::Packet& packet)
 {
   u32 cid;
@@ -730,7 +868,10 @@ void NetPlayClient::OnPadData(sf::Packet& packet)
 
     // Trusting server for good map value (>=0 && <4)
     // add to pad buffer
-    m_pad_buffer.at(map).Push(pad);
+    if (m_rollback)
+      m_rollback->AddRemoteInput(map, pad);
+    else
+      m_pad_buffer.at(map).Push(pad);
     m_gc_pad_event.Set();
   }
 }
@@ -986,11 +1127,34 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.golf_mode;
     packet >> m_net_settings.use_fma;
     packet >> m_net_settings.hide_remote_gbas;
+    packet >> m_net_settings.rollback_frames;
+    packet >> m_net_settings.rollback_sync_test_frames;
+    packet >> m_net_settings.ram_hash_interval;
 
     for (size_t i = 0; i < sizeof(m_net_settings.sram); ++i)
       packet >> m_net_settings.sram[i];
 
     m_net_settings.is_hosting = m_local_player->IsHost();
+
+    CreateRollbackSession();
+
+    if (m_net_settings.ram_hash_interval != 0)
+    {
+      m_ram_hasher.Start([this](RamHashes hashes) {
+        sf::Packet packet;
+        packet << MessageID::RamHash;
+        packet << hashes.frame;
+        packet << hashes.combined;
+        packet << static_cast<u32>(hashes.regions.size());
+        for (const u64 region : hashes.regions)
+          packet << region;
+        SendAsync(std::move(packet));
+      });
+    }
+    else
+    {
+      m_ram_hasher.Stop();
+    }
   }
 
   m_dialog->OnMsgStartGame();
@@ -1057,6 +1221,36 @@ void NetPlayClient::OnDesyncDetected(sf::Packet& packet)
   m_dialog->OnDesync(frame, player);
 }
 
+void NetPlayClient::OnRamDesyncDetected(sf::Packet& packet)
+{
+  int pid_to_blame;
+  u32 frame;
+  RamDivergence divergence;
+  packet >> pid_to_blame;
+  packet >> frame;
+  packet >> divergence.begin_address;
+  packet >> divergence.end_address;
+  packet >> divergence.num_regions;
+
+  std::string player = "??";
+  {
+    std::lock_guard lkp(m_crit.players);
+    const auto it = m_players.find(pid_to_blame);
+    if (it != m_players.end())
+      player = it->second.name;
+  }
+
+  ERROR_LOG_FMT(NETPLAY,
+                "RAM of player {} ({}) differs at frame {}: {:08x}-{:08x} ({} regions of {} KiB)",
+                player, pid_to_blame, frame, divergence.begin_address, divergence.end_address,
+                divergence.num_regions, RAM_HASH_REGION_SIZE / 1024);
+
+  m_dialog->AppendChat(Common::FmtFormatT("RAM differs at frame {0} between {1:08x} and {2:08x}.",
+                                          frame, divergence.begin_address,
+                                          divergence.end_address));
+  m_dialog->OnDesync(frame, player);
+}
+
 void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
 {
   SyncSaveDataID sub_id;
@@ -2096,6 +2290,9 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
+  if (m_rollback)
+    return GetRollbackPad(pad_nb, pad_status);
+
   if (IsFirstInGamePad(pad_nb) && batching)
   {
     sf::Packet packet;
@@ -2229,25 +2426,22 @@ bool NetPlayClient::WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entrie
   return true;
 }
 
+GCPadStatus NetPlayClient::ReadLocalPad(const int local_pad) const
+{
+  if (m_gba_config[LocalPadToInGamePad(local_pad)].enabled)
+    return Pad::GetGBAStatus(local_pad);
+
+  if (Config::Get(Config::GetInfoForSIDevice(local_pad)) == SerialInterface::SIDEVICE_WIIU_ADAPTER)
+    return GCAdapter::Input(local_pad);
+
+  return Pad::GetStatus(local_pad);
+}
+
 bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
 {
   const int ingame_pad = LocalPadToInGamePad(local_pad);
   bool data_added = false;
-  GCPadStatus pad_status;
-
-  if (m_gba_config[ingame_pad].enabled)
-  {
-    pad_status = Pad::GetGBAStatus(local_pad);
-  }
-  else if (Config::Get(Config::GetInfoForSIDevice(local_pad)) ==
-           SerialInterface::SIDEVICE_WIIU_ADAPTER)
-  {
-    pad_status = GCAdapter::Input(local_pad);
-  }
-  else
-  {
-    pad_status = Pad::GetStatus(local_pad);
-  }
+  const GCPadStatus pad_status = ReadLocalPad(local_pad);
 
   if (m_host_input_authority)
   {
@@ -2282,6 +2476,62 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
   return data_added;
 }
 
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackPad(const int pad_nb, GCPadStatus* pad_status)
+{
+  // Local inputs are sent as soon as they are read instead of going through the pad buffer. Polls
+  // that are run again after a rollback already have their input, so the controller isn't read.
+  const int local_pad = InGamePadToLocalPad(pad_nb);
+  if (local_pad < 4 && m_rollback->NeedsLocalInput(pad_nb))
+  {
+    const GCPadStatus local_status = ReadLocalPad(local_pad);
+    m_rollback->AddLocalInput(pad_nb, local_status);
+
+    sf::Packet packet;
+    packet << MessageID::PadData;
+    AddPadStateToPacket(pad_nb, local_status, packet);
+    SendAsync(std::move(packet));
+  }
+
+  // Only wait when the remote inputs are too far behind to keep predicting them.
+  while (!m_rollback->CanPoll(pad_nb))
+  {
+    if (!m_is_running.IsSet())
+    {
+      return false;
+    }
+
+    m_gc_pad_event.Wait();
+  }
+
+  *pad_status = m_rollback->Poll(pad_nb);
+  return true;
+}
+
+void NetPlayClient::CreateRollbackSession()
+{
+  if (m_net_settings.rollback_frames == 0)
+  {
+    m_rollback.reset();
+    return;
+  }
+
+  RollbackSession::Callbacks callbacks;
+  callbacks.save_state = [](Common::UniqueBuffer<u8>& buffer) {
+    return State::SaveSnapshot(Core::System::GetInstance(), buffer);
+  };
+  callbacks.load_state = [](std::span<const u8> state) {
+    return State::LoadSnapshot(Core::System::GetInstance(), state);
+  };
+  callbacks.on_desync = [this](u64 frame, u64, u64) {
+    m_dialog->OnDesync(static_cast<u32>(frame), m_local_player->name);
+  };
+
+  m_rollback = std::make_unique<RollbackSession>(m_net_settings.rollback_frames,
+                                                 m_net_settings.rollback_sync_test_frames,
+                                                 std::move(callbacks));
+}
+
 bool NetPlayClient::AddLocalWiimoteToBuffer(const int local_wiimote,
                                             const WiimoteEmu::SerializedWiimoteState& state,
                                             sf::Packet& packet)
@@ -2387,6 +2637,8 @@ bool NetPlayClient::StopGame()
 {
   InvokeStop();
 
+  m_ram_hasher.Stop();
+
   NetPlay_Disable();
 
   // stop game
@@ -2570,6 +2822,18 @@ void NetPlayClient::SendTimeBase()
 {
   std::lock_guard lk(crit_netplay_client);
 
+  // Frames are run more than once with rollback, so the frame numbers wouldn't line up.
+  if (netplay_client->m_rollback)
+    return;
+
+  const u32 ram_hash_interval = netplay_client->m_net_settings.ram_hash_interval;
+  if (ram_hash_interval != 0 && netplay_client->m_timebase_frame % ram_hash_interval == 0)
+  {
+    auto& memory = Core::System::GetInstance().GetMemory();
+    netplay_client->m_ram_hasher.Sample(netplay_client->m_timebase_frame,
+                                        {memory.GetRAM(), memory.GetRamSizeReal()});
+  }
+
   if (netplay_client->m_timebase_frame % 60 == 0)
   {
     const u64 timebase = Core::System::GetInstance().GetSystemTimers().GetFakeTimeBase();
@@ -2585,6 +2849,22 @@ void NetPlayClient::SendTimeBase()
   netplay_client->m_timebase_frame++;
 }
 
+// called from ---CPU--- thread
+void NetPlayClient::OnFrameEnd(Core::System& system)
+{
+  std::lock_guard lk(crit_netplay_client);
+  if (!netplay_client || !netplay_client->m_rollback)
+    return;
+
+  // The frame ends inside the VI event, where the state can't be saved or loaded. The session
+  // outlives the game, and loading a state may need crit_netplay_client, so don't hold it there.
+  RollbackSession* const session = netplay_client->m_rollback.get();
+  system.GetCoreTiming().RunAtSafePoint([session] {
+    session->OnFrameBoundary();
+    Core::SetIsThrottlerTempDisabled(session->IsResimulating());
+  });
+}
+
 bool NetPlayClient::DoAllPlayersHaveGame()
 {
   std::lock_guard lkp(m_crit.players);
@@ -20,12 +20,20 @@
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayChunkedData.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRamHash.h"
+#include "Core/NetPlayRollback.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 
 class BootSessionData;
 
+namespace Core
+{
+class System;
+}
+
 namespace IOS::HLE::FS
 {
 class FileSystem;
@@ -169,6 +177,8 @@ public:
   const PlayerId& GetLocalPlayerId() const;
 
   static void SendTimeBase();
+  // Schedules the rollback frame boundary when the rollback network mode is used.
+  static void OnFrameEnd(Core::System& system);
   bool DoAllPlayersHaveGame();
   
   void AdjustPlayerPadBufferSize(u32 buffer);
@@ -233,6 +243,9 @@ protected:
   std::array<Common::SPSCQueue<GCPadStatus>, 4> m_pad_buffer;
   std::array<Common::SPSCQueue<WiimoteEmu::SerializedWiimoteState>, 4> m_wiimote_buffer;
 
+  // Replaces m_pad_buffer in the rollback network mode.
+  std::unique_ptr<RollbackSession> m_rollback;
+
   std::array<GCPadStatus, 4> m_last_pad_status{};
   std::array<bool, 4> m_first_pad_status_received{};
 
@@ -288,7 +301,10 @@ private:
   void SyncSaveDataResponse(bool success);
   void SyncCodeResponse(bool success);
 
+  GCPadStatus ReadLocalPad(int local_pad) const;
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  bool GetRollbackPad(int pad_nb, GCPadStatus* pad_status);
+  void CreateRollbackSession();
   void SendPadHostPoll(PadIndex pad_num);
 
   bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
@@ -314,6 +330,8 @@ private:
   void OnChunkedDataEnd(sf::Packet& packet);
   void OnChunkedDataPayload(sf::Packet& packet);
   void OnChunkedDataAbort(sf::Packet& packet);
+  void SendChunkedDataProgress(u32 cid, u64 progress);
+  void SendChunkedDataMissing(u32 cid, const std::vector<u32>& missing);
   void OnPadMapping(sf::Packet& packet);
   void OnWiimoteMapping(sf::Packet& packet);
   void OnGBAConfig(sf::Packet& packet);
@@ -333,6 +351,7 @@ private:
   void OnPing(sf::Packet& packet);
   void OnPlayerPingData(sf::Packet& packet);
   void OnDesyncDetected(sf::Packet& packet);
+  void OnRamDesyncDetected(sf::Packet& packet);
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
   void OnSyncSaveDataRaw(sf::Packet& packet);
@@ -375,10 +394,21 @@ private:
   u16 m_sync_ar_codes_count = 0;
   u16 m_sync_ar_codes_success_count = 0;
   bool m_sync_ar_codes_complete = false;
-  std::unordered_map<u32, sf::Packet> m_chunked_data_receive_queue;
+  struct ChunkedDataReceive
+  {
+    std::vector<ChunkInfo> chunks;
+    std::vector<bool> received;
+    std::vector<u8> data;
+    u64 received_size = 0;
+    u32 retries = 0;
+    bool valid = true;
+  };
+  std::unordered_map<u32, ChunkedDataReceive> m_chunked_data_receive_queue;
+  std::unique_ptr<ChunkCache> m_chunk_cache;
 
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
+  RamHasher m_ram_hasher;
 
   std::unique_ptr<IOS::HLE::FS::FileSystem> m_wii_sync_fs;
   std::vector<u64> m_wii_sync_titles;
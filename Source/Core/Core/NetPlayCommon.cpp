@@ -4,6 +4,10 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <span>
+#include <thread>
 
 #include <fmt/format.h>
 #include <lzo/lzo1x.h>
@@ -18,6 +22,71 @@ namespace NetPlay
 constexpr u32 LZO_IN_LEN = 1024 * 64;
 constexpr u32 LZO_OUT_LEN = LZO_IN_LEN + (LZO_IN_LEN / 16) + 64 + 3;
 
+static size_t GetCompressionThreadCount()
+{
+  return std::max<unsigned int>(1, std::thread::hardware_concurrency());
+}
+
+// Compresses data in blocks of LZO_IN_LEN bytes, spread over as many threads as useful, and
+// appends them to the packet.
+static bool CompressBlocksIntoPacket(std::span<const u8> data, sf::Packet& packet)
+{
+  const size_t block_count = (data.size() + LZO_IN_LEN - 1) / LZO_IN_LEN;
+  std::vector<std::vector<u8>> blocks(block_count);
+  std::atomic<bool> failed = false;
+
+  const auto compress_range = [&](size_t start, size_t end) {
+    std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+    for (size_t i = start; i < end && !failed; ++i)
+    {
+      const size_t offset = i * LZO_IN_LEN;
+      const lzo_uint in_len =
+          static_cast<lzo_uint>(std::min<size_t>(LZO_IN_LEN, data.size() - offset));
+      lzo_uint out_len = 0;
+      blocks[i].resize(LZO_OUT_LEN);
+      if (lzo1x_1_compress(data.data() + offset, in_len, blocks[i].data(), &out_len,
+                           wrkmem.data()) != LZO_E_OK)
+      {
+        failed = true;
+        return;
+      }
+      blocks[i].resize(out_len);
+    }
+  };
+
+  const size_t threads = std::min(block_count, GetCompressionThreadCount());
+  if (threads <= 1)
+  {
+    compress_range(0, block_count);
+  }
+  else
+  {
+    std::vector<std::future<void>> futures(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+      futures[i] = std::async(std::launch::async, compress_range, i * block_count / threads,
+                              (i + 1) * block_count / threads);
+    }
+    for (std::future<void>& future : futures)
+      future.get();
+  }
+
+  if (failed)
+  {
+    PanicAlertFmtT("Internal LZO Error - compression failed");
+    return false;
+  }
+
+  // The size of each block, followed by its data
+  for (const std::vector<u8>& block : blocks)
+  {
+    packet << static_cast<u32>(block.size());
+    packet.append(block.data(), block.size());
+  }
+
+  return true;
+}
+
 bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
 {
   File::IOFile file(file_path, "rb");
@@ -33,52 +102,21 @@ bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
   if (size == 0)
     return true;
 
-  std::vector<u8> in_buffer(LZO_IN_LEN);
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
+  // Read the file a few blocks per thread at a time instead of all at once, so that large files
+  // like SD card images aren't held in memory both uncompressed and compressed.
+  const u64 batch_size = u64{LZO_IN_LEN} * 4 * GetCompressionThreadCount();
+  std::vector<u8> in_buffer(std::min(size, batch_size));
+  for (u64 offset = 0; offset < size; offset += in_buffer.size())
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // EOF
-
-    if (!file.ReadBytes(in_buffer.data(), cur_len))
+    in_buffer.resize(std::min(size - offset, batch_size));
+    if (!file.ReadBytes(in_buffer.data(), in_buffer.size()))
     {
       PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
       return false;
     }
 
-    if (lzo1x_1_compress(in_buffer.data(), cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
+    if (!CompressBlocksIntoPacket(in_buffer, packet))
       return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != LZO_IN_LEN)
-      break;
-
-    i += cur_len;
   }
 
   // Mark end of data
@@ -124,46 +162,8 @@ bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& pack
   if (size == 0)
     return true;
 
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
-  {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // end of buffer
-
-    if (lzo1x_1_compress(&in_buffer[i], cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != LZO_IN_LEN)
-      break;
-
-    i += cur_len;
-  }
+  if (!CompressBlocksIntoPacket(in_buffer, packet))
+    return false;
 
   // Mark end of data
   packet << static_cast<u32>(0);
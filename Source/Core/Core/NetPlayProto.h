@@ -107,8 +107,13 @@ struct NetSettings
   bool sync_codes = false;
   std::string save_data_region;
   bool golf_mode = false;
+  // Non-zero when the "rollback" network mode is used.
+  u32 rollback_frames = 0;
+  u32 rollback_sync_test_frames = 0;
   bool use_fma = false;
   bool hide_remote_gbas = false;
+  // Number of frames between RAM hash samples, or 0 if they are disabled.
+  u32 ram_hash_interval = 0;
 
   Sram sram;
 
@@ -148,6 +153,8 @@ enum class MessageID : u8
   ChunkedDataProgress = 0x43,
   ChunkedDataComplete = 0x44,
   ChunkedDataAbort = 0x45,
+  ChunkedDataMissing = 0x46,
+  ChunkedDataFailed = 0x47,
 
   PadSpectator = 0x5F,
   PadData = 0x60,
@@ -177,6 +184,8 @@ enum class MessageID : u8
 
   TimeBase = 0xB0,
   DesyncDetected = 0xB1,
+  RamHash = 0xB2,
+  RamDesyncDetected = 0xB3,
 
   ComputeGameDigest = 0xC0,
   GameDigestProgress = 0xC1,
@@ -227,7 +236,6 @@ enum class SyncCodeID : u8
 };
 
 constexpr u32 MAX_NAME_LENGTH = 30;
-constexpr size_t CHUNKED_DATA_UNIT_SIZE = 16384;
 constexpr u32 MAX_ENET_MTU = 1392;  // see https://github.com/lsalzman/enet/issues/132
 
 enum : u8
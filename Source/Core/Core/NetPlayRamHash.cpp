@@ -0,0 +1,91 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRamHash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <xxhash.h>
+
+namespace NetPlay
+{
+RamHashes HashRam(u32 frame, std::span<const u8> ram)
+{
+  RamHashes hashes;
+  hashes.frame = frame;
+  hashes.regions.reserve((ram.size() + RAM_HASH_REGION_SIZE - 1) / RAM_HASH_REGION_SIZE);
+  for (size_t offset = 0; offset < ram.size(); offset += RAM_HASH_REGION_SIZE)
+  {
+    const size_t size = std::min<size_t>(RAM_HASH_REGION_SIZE, ram.size() - offset);
+    hashes.regions.push_back(XXH3_64bits(ram.data() + offset, size));
+  }
+  hashes.combined = XXH3_64bits(hashes.regions.data(), hashes.regions.size() * sizeof(u64));
+  return hashes;
+}
+
+std::optional<RamDivergence> FindRamDivergence(const RamHashes& a, const RamHashes& b)
+{
+  if (a.combined == b.combined && a.regions.size() == b.regions.size())
+    return std::nullopt;
+
+  // Clients with different RAM sizes are reported as differing past the smaller one.
+  const size_t num_regions = std::max(a.regions.size(), b.regions.size());
+  std::optional<RamDivergence> divergence;
+  for (size_t i = 0; i < num_regions; ++i)
+  {
+    if (i < a.regions.size() && i < b.regions.size() && a.regions[i] == b.regions[i])
+      continue;
+
+    const u32 address = 0x80000000 + static_cast<u32>(i) * RAM_HASH_REGION_SIZE;
+    if (!divergence)
+    {
+      divergence.emplace();
+      divergence->begin_address = address;
+    }
+    divergence->end_address = address + RAM_HASH_REGION_SIZE;
+    ++divergence->num_regions;
+  }
+  return divergence;
+}
+
+RamHasher::RamHasher() = default;
+
+RamHasher::~RamHasher()
+{
+  Stop();
+}
+
+void RamHasher::Start(Callback callback)
+{
+  m_worker.Cancel();
+  m_callback = std::move(callback);
+  m_worker.Reset("RAM Hash Worker", [this](PendingSample sample) {
+    m_callback(HashRam(sample.frame, sample.ram));
+
+    std::lock_guard lk(m_spare_mutex);
+    m_spare_buffer = std::move(sample.ram);
+  });
+}
+
+void RamHasher::Stop()
+{
+  m_worker.Cancel();
+  m_worker.Shutdown();
+}
+
+void RamHasher::Sample(u32 frame, std::span<const u8> ram)
+{
+  Common::UniqueBuffer<u8> copy;
+  {
+    std::lock_guard lk(m_spare_mutex);
+    copy = std::move(m_spare_buffer);
+  }
+  if (copy.size() != ram.size())
+    copy.reset(ram.size());
+
+  std::memcpy(copy.data(), ram.data(), ram.size());
+  m_worker.EmplaceItem(PendingSample{frame, std::move(copy)});
+}
+}  // namespace NetPlay
@@ -0,0 +1,78 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Desync detection for NetPlay based on the contents of emulated RAM. Every few frames, each client
+// copies MEM1 and hashes it in fixed-size regions on a worker thread. The server compares the
+// hashes of all players, so that the first sampled frame where RAM differs is known together with
+// the addresses that differ, long before the desync becomes visible.
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+namespace NetPlay
+{
+constexpr u32 RAM_HASH_REGION_SIZE = 256 * 1024;
+
+struct RamHashes
+{
+  u32 frame = 0;
+  // Hash of all region hashes, which is enough to tell whether two samples match.
+  u64 combined = 0;
+  // One hash for every RAM_HASH_REGION_SIZE bytes of RAM.
+  std::vector<u64> regions;
+};
+
+struct RamDivergence
+{
+  // Emulated addresses of the first and last region that differ, as [begin, end).
+  u32 begin_address = 0;
+  u32 end_address = 0;
+  u32 num_regions = 0;
+};
+
+RamHashes HashRam(u32 frame, std::span<const u8> ram);
+// Returns the differing range of two samples of the same frame, or nothing if they match.
+std::optional<RamDivergence> FindRamDivergence(const RamHashes& a, const RamHashes& b);
+
+class RamHasher
+{
+public:
+  using Callback = std::function<void(RamHashes hashes)>;
+
+  RamHasher();
+  ~RamHasher();
+
+  RamHasher(const RamHasher&) = delete;
+  RamHasher& operator=(const RamHasher&) = delete;
+
+  // Starts the worker thread. callback is called on it with every finished sample.
+  void Start(Callback callback);
+  void Stop();
+
+  // Copies ram and hashes the copy on the worker thread. Must be called from the CPU thread, so
+  // that the copy is consistent.
+  void Sample(u32 frame, std::span<const u8> ram);
+
+private:
+  struct PendingSample
+  {
+    u32 frame;
+    Common::UniqueBuffer<u8> ram;
+  };
+
+  Common::WorkQueueThread<PendingSample> m_worker;
+  Callback m_callback;
+
+  std::mutex m_spare_mutex;
+  Common::UniqueBuffer<u8> m_spare_buffer;
+};
+}  // namespace NetPlay
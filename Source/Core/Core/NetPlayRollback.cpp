@@ -0,0 +1,292 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <xxhash.h>
+
+#include "Common/Logging/Log.h"
+#include "Common/Timer.h"
+
+namespace NetPlay
+{
+constexpr u64 NO_ROLLBACK = std::numeric_limits<u64>::max();
+
+RollbackSession::InputEntry& RollbackSession::PadHistory::GetEntry(u64 index)
+{
+  while (first_index + entries.size() <= index)
+    entries.emplace_back();
+  return entries[index - first_index];
+}
+
+RollbackSession::RollbackSession(u32 max_rollback_frames, u32 sync_test_frames,
+                                 Callbacks callbacks)
+    : m_max_rollback_frames(std::max(max_rollback_frames, 1u)),
+      m_sync_test_frames(sync_test_frames), m_callbacks(std::move(callbacks)),
+      m_rollback_frame(NO_ROLLBACK)
+{
+  // One snapshot for every frame that can be rolled back to, plus the current one.
+  m_snapshots.resize(std::max(m_max_rollback_frames, m_sync_test_frames) + 2);
+}
+
+void RollbackSession::OnFrameBoundary()
+{
+  u64 rollback_frame;
+  {
+    std::lock_guard lk(m_mutex);
+    ++m_frame;
+    rollback_frame = std::exchange(m_rollback_frame, NO_ROLLBACK);
+  }
+
+  const u64 current_frame = m_frame;
+  if (rollback_frame < current_frame)
+  {
+    if (LoadSnapshot(rollback_frame))
+    {
+      std::lock_guard lk(m_mutex);
+      m_resimulate_until = std::max(m_resimulate_until, current_frame);
+      ++m_stats.rollbacks;
+      m_stats.resimulated_frames += current_frame - rollback_frame;
+      m_stats.max_rollback_depth =
+          std::max<u32>(m_stats.max_rollback_depth, u32(current_frame - rollback_frame));
+      return;
+    }
+
+    ERROR_LOG_FMT(NETPLAY, "Could not roll back from frame {} to frame {}", current_frame,
+                  rollback_frame);
+  }
+
+  SaveSnapshot();
+
+  if (m_sync_test_frames != 0 && current_frame > m_last_sync_test_frame &&
+      current_frame > m_sync_test_frames)
+  {
+    m_last_sync_test_frame = current_frame;
+    const u64 target_frame = current_frame - m_sync_test_frames;
+    if (LoadSnapshot(target_frame))
+    {
+      std::lock_guard lk(m_mutex);
+      m_resimulate_until = current_frame;
+      m_stats.resimulated_frames += m_sync_test_frames;
+    }
+  }
+}
+
+bool RollbackSession::NeedsLocalInput(int pad) const
+{
+  std::lock_guard lk(m_mutex);
+  const PadHistory& history = m_pads[pad];
+  return history.confirmed_count <= history.next_poll;
+}
+
+void RollbackSession::AddLocalInput(int pad, const GCPadStatus& status)
+{
+  std::lock_guard lk(m_mutex);
+  AddConfirmedInput(pad, status);
+}
+
+void RollbackSession::AddRemoteInput(int pad, const GCPadStatus& status)
+{
+  std::lock_guard lk(m_mutex);
+  AddConfirmedInput(pad, status);
+}
+
+void RollbackSession::AddConfirmedInput(int pad, const GCPadStatus& status)
+{
+  PadHistory& history = m_pads[pad];
+  InputEntry& entry = history.GetEntry(history.confirmed_count++);
+  entry.status = status;
+  entry.confirmed = true;
+  history.last_confirmed = status;
+
+  if (entry.used && entry.used_status != status)
+  {
+    ++m_stats.mispredicted_inputs;
+    m_rollback_frame = std::min(m_rollback_frame, entry.used_frame);
+  }
+}
+
+bool RollbackSession::CanPoll(int pad) const
+{
+  std::lock_guard lk(m_mutex);
+  const PadHistory& history = m_pads[pad];
+  if (history.next_poll < history.confirmed_count)
+    return true;
+
+  // Predicting requires a snapshot to go back to.
+  if (m_sync_test_frames != 0 || !FindSnapshot(m_frame))
+    return false;
+
+  // Don't run further ahead of the oldest unconfirmed input than the snapshots reach.
+  for (const PadHistory& other : m_pads)
+  {
+    if (other.confirmed_count >= other.next_poll)
+      continue;
+
+    const InputEntry& oldest = other.entries[other.confirmed_count - other.first_index];
+    if (m_frame - oldest.used_frame >= m_max_rollback_frames)
+      return false;
+  }
+
+  return true;
+}
+
+GCPadStatus RollbackSession::Poll(int pad)
+{
+  std::lock_guard lk(m_mutex);
+  PadHistory& history = m_pads[pad];
+  InputEntry& entry = history.GetEntry(history.next_poll++);
+
+  if (!entry.confirmed)
+    ++m_stats.predicted_inputs;
+
+  entry.used = true;
+  entry.used_status = entry.confirmed ? entry.status : history.last_confirmed;
+  entry.used_frame = m_frame;
+  return entry.used_status;
+}
+
+bool RollbackSession::IsResimulating() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_frame < m_resimulate_until;
+}
+
+u64 RollbackSession::GetFrame() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_frame;
+}
+
+u64 RollbackSession::GetSnapshotHash(u64 frame) const
+{
+  const Snapshot* snapshot = FindSnapshot(frame);
+  return snapshot ? snapshot->hash : 0;
+}
+
+RollbackSession::Stats RollbackSession::GetStats() const
+{
+  std::lock_guard lk(m_mutex);
+  Stats stats = m_stats;
+  stats.frame = m_frame;
+  return stats;
+}
+
+void RollbackSession::SaveSnapshot()
+{
+  Snapshot& snapshot = GetSnapshotSlot(m_frame);
+  const bool is_resimulation = snapshot.valid && snapshot.frame == m_frame;
+  const u64 previous_hash = snapshot.hash;
+
+  const auto start = Clock::now();
+  snapshot.size = m_callbacks.save_state(snapshot.buffer);
+  const double save_ms = DT_ms(Clock::now() - start).count();
+
+  snapshot.frame = m_frame;
+  snapshot.valid = true;
+  snapshot.hash = 0;
+
+  {
+    std::lock_guard lk(m_mutex);
+    for (int pad = 0; pad < NUM_PADS; ++pad)
+      snapshot.next_poll[pad] = m_pads[pad].next_poll;
+    m_stats.last_save_ms = save_ms;
+  }
+
+  // In sync test mode, resimulated frames used exactly the same inputs as the first time, so their
+  // states have to match.
+  if (m_sync_test_frames != 0)
+  {
+    snapshot.hash = XXH3_64bits(snapshot.buffer.data(), snapshot.size);
+    if (is_resimulation)
+    {
+      bool desynced = false;
+      {
+        std::lock_guard lk(m_mutex);
+        ++m_stats.checked_frames;
+        if (snapshot.hash != previous_hash)
+        {
+          ++m_stats.desyncs;
+          desynced = true;
+        }
+      }
+
+      if (desynced)
+      {
+        ERROR_LOG_FMT(NETPLAY, "Resimulating frame {} produced a different state ({:016x} != {:016x})",
+                      m_frame, snapshot.hash, previous_hash);
+        if (m_callbacks.on_desync)
+          m_callbacks.on_desync(m_frame, previous_hash, snapshot.hash);
+      }
+    }
+  }
+
+  TrimHistory();
+}
+
+bool RollbackSession::LoadSnapshot(u64 frame)
+{
+  const Snapshot* snapshot = FindSnapshot(frame);
+  if (!snapshot)
+    return false;
+
+  const auto start = Clock::now();
+  if (!m_callbacks.load_state({snapshot->buffer.data(), snapshot->size}))
+    return false;
+  const double load_ms = DT_ms(Clock::now() - start).count();
+
+  std::lock_guard lk(m_mutex);
+  m_frame = frame;
+  for (int pad = 0; pad < NUM_PADS; ++pad)
+  {
+    // Polls after the snapshot haven't happened yet on the new timeline.
+    PadHistory& history = m_pads[pad];
+    history.next_poll = snapshot->next_poll[pad];
+    for (u64 i = history.next_poll; i < history.first_index + history.entries.size(); ++i)
+      history.entries[i - history.first_index].used = false;
+  }
+  m_stats.last_load_ms = load_ms;
+  return true;
+}
+
+void RollbackSession::TrimHistory()
+{
+  std::array<u64, NUM_PADS> keep_from;
+  keep_from.fill(std::numeric_limits<u64>::max());
+  for (const Snapshot& snapshot : m_snapshots)
+  {
+    if (!snapshot.valid)
+      continue;
+    for (int pad = 0; pad < NUM_PADS; ++pad)
+      keep_from[pad] = std::min(keep_from[pad], snapshot.next_poll[pad]);
+  }
+
+  std::lock_guard lk(m_mutex);
+  for (int pad = 0; pad < NUM_PADS; ++pad)
+  {
+    // Unconfirmed inputs are still needed to detect mispredictions.
+    PadHistory& history = m_pads[pad];
+    const u64 trim_to = std::min(keep_from[pad], history.confirmed_count);
+    while (history.first_index < trim_to && !history.entries.empty())
+    {
+      history.entries.pop_front();
+      ++history.first_index;
+    }
+  }
+}
+
+RollbackSession::Snapshot& RollbackSession::GetSnapshotSlot(u64 frame)
+{
+  return m_snapshots[frame % m_snapshots.size()];
+}
+
+const RollbackSession::Snapshot* RollbackSession::FindSnapshot(u64 frame) const
+{
+  const Snapshot& snapshot = m_snapshots[frame % m_snapshots.size()];
+  return snapshot.valid && snapshot.frame == frame ? &snapshot : nullptr;
+}
+}  // namespace NetPlay
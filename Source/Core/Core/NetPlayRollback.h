@@ -0,0 +1,147 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Rollback input handling for NetPlay. Instead of waiting for remote inputs, polls that don't have
+// a confirmed input yet repeat the last confirmed input of that pad. A snapshot of the emulated
+// state is kept for every recent frame, and when a remote input turns out to differ from what was
+// predicted, the snapshot of the frame it was used in is loaded and the frames after it are run
+// again with the real inputs.
+//
+// The session doesn't know about the emulator itself: it only sees frame boundaries, pad polls and
+// the save/load callbacks, which keeps it testable without booting a game.
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+class RollbackSession
+{
+public:
+  static constexpr int NUM_PADS = 4;
+
+  struct Callbacks
+  {
+    // Serializes the current emulated state into buffer, growing it if needed, and returns the
+    // number of bytes used.
+    std::function<size_t(Common::UniqueBuffer<u8>& buffer)> save_state;
+    // Restores a state created by save_state.
+    std::function<bool(std::span<const u8> state)> load_state;
+    // Called when a resimulated frame doesn't reproduce the state that was recorded for it.
+    std::function<void(u64 frame, u64 expected_hash, u64 actual_hash)> on_desync;
+  };
+
+  struct Stats
+  {
+    u64 frame = 0;
+    u64 rollbacks = 0;
+    u64 resimulated_frames = 0;
+    u32 max_rollback_depth = 0;
+    u64 predicted_inputs = 0;
+    u64 mispredicted_inputs = 0;
+    u64 checked_frames = 0;
+    u64 desyncs = 0;
+    double last_save_ms = 0;
+    double last_load_ms = 0;
+  };
+
+  // max_rollback_frames limits how far the emulation may run ahead of the confirmed inputs.
+  // If sync_test_frames is not zero, inputs are never predicted, and every frame the session goes
+  // back sync_test_frames frames and checks that running them again produces identical states.
+  RollbackSession(u32 max_rollback_frames, u32 sync_test_frames, Callbacks callbacks);
+
+  RollbackSession(const RollbackSession&) = delete;
+  RollbackSession& operator=(const RollbackSession&) = delete;
+
+  // Must be called at the start of every frame, at a point where the emulated state can be saved
+  // and loaded. Takes a snapshot, or loads an earlier one if a misprediction was found.
+  void OnFrameBoundary();
+
+  // Whether the input for the next poll of a local pad still has to be provided.
+  bool NeedsLocalInput(int pad) const;
+  void AddLocalInput(int pad, const GCPadStatus& status);
+  // Inputs of each pad must be added in the order they were polled on the remote side.
+  // May be called from any thread.
+  void AddRemoteInput(int pad, const GCPadStatus& status);
+
+  // Whether Poll() can return an input right now. If not, the caller has to wait for more remote
+  // inputs to arrive.
+  bool CanPoll(int pad) const;
+  // Returns the confirmed input for the next poll of pad, or a prediction.
+  GCPadStatus Poll(int pad);
+
+  bool IsResimulating() const;
+  u64 GetFrame() const;
+  // Hash of the snapshot taken at the start of frame, or 0 if it isn't available. Snapshots are
+  // only hashed in sync test mode.
+  u64 GetSnapshotHash(u64 frame) const;
+  Stats GetStats() const;
+
+private:
+  struct InputEntry
+  {
+    GCPadStatus status;
+    bool confirmed = false;
+    // Set once the entry has been returned by Poll().
+    bool used = false;
+    GCPadStatus used_status;
+    u64 used_frame = 0;
+  };
+
+  struct PadHistory
+  {
+    // entries[i] is the input of poll first_index + i.
+    std::deque<InputEntry> entries;
+    u64 first_index = 0;
+    u64 confirmed_count = 0;
+    u64 next_poll = 0;
+    GCPadStatus last_confirmed;
+
+    InputEntry& GetEntry(u64 index);
+  };
+
+  struct Snapshot
+  {
+    u64 frame = 0;
+    bool valid = false;
+    Common::UniqueBuffer<u8> buffer;
+    size_t size = 0;
+    u64 hash = 0;
+    std::array<u64, NUM_PADS> next_poll{};
+  };
+
+  void AddConfirmedInput(int pad, const GCPadStatus& status);
+  void SaveSnapshot();
+  bool LoadSnapshot(u64 frame);
+  void TrimHistory();
+  Snapshot& GetSnapshotSlot(u64 frame);
+  const Snapshot* FindSnapshot(u64 frame) const;
+
+  const u32 m_max_rollback_frames;
+  const u32 m_sync_test_frames;
+  Callbacks m_callbacks;
+
+  // Guards everything below except the snapshots, which are only used from the CPU thread.
+  mutable std::mutex m_mutex;
+  std::array<PadHistory, NUM_PADS> m_pads;
+  u64 m_frame = 0;
+  // Frame to roll back to at the next frame boundary, or NO_ROLLBACK.
+  u64 m_rollback_frame;
+  u64 m_resimulate_until = 0;
+  Stats m_stats;
+
+  // CPU thread only.
+  std::vector<Snapshot> m_snapshots;
+  u64 m_last_sync_test_frame = 0;
+};
+}  // namespace NetPlay
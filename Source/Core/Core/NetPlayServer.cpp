@@ -7,10 +7,12 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdio>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -562,6 +564,9 @@ unsigned int NetPlayServer::OnDisconnect(const Client& player)
   if (it != m_players.end())
     m_players.erase(it);
 
+  // The chunked data thread might be waiting for an answer from this player.
+  m_chunked_data_complete_event.Set();
+
   // alert other players of disconnect
   SendToClients(spac);
 
@@ -754,6 +759,22 @@ void NetPlayServer::SendChunkedToClients(sf::Packet&& packet, const PlayerId ski
   m_chunked_data_event.Set();
 }
 
+// Returns the first player whose value doesn't match any other player's, or 0 if there is none.
+template <typename T, typename Equal>
+static int FindOutlier(const std::vector<std::pair<PlayerId, T>>& values, Equal equal)
+{
+  for (const auto& pair : values)
+  {
+    if (std::ranges::all_of(values, [&](const std::pair<PlayerId, T>& other) {
+          return other.first == pair.first || !equal(other.second, pair.second);
+        }))
+    {
+      return pair.first;
+    }
+  }
+  return 0;
+}
+
 // called from ---NETPLAY--- thread
 unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 {
@@ -809,6 +830,43 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::ChunkedDataMissing:
+  {
+    u32 cid;
+    u32 count;
+    packet >> cid;
+    packet >> count;
+
+    std::vector<u32> missing;
+    for (u32 i = 0; i < count && !packet.endOfPacket(); ++i)
+    {
+      u32 index;
+      packet >> index;
+      missing.push_back(index);
+    }
+
+    {
+      std::lock_guard lk(m_crit.chunked_data_missing);
+      if (const auto it = m_chunked_data_missing.find(cid); it != m_chunked_data_missing.end())
+        it->second[player.pid] = std::move(missing);
+    }
+    m_chunked_data_complete_event.Set();
+  }
+  break;
+
+  case MessageID::ChunkedDataFailed:
+  {
+    u32 cid;
+    packet >> cid;
+
+    ERROR_LOG_FMT(NETPLAY, "Player {} failed to receive data chunk {}.", player.pid, cid);
+    m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
+    m_dialog->OnGameStartAborted();
+    ChunkedDataAbort();
+    m_start_pending = false;
+  }
+  break;
+
   case MessageID::ChunkedDataComplete:
   {
     u32 cid;
@@ -1134,18 +1192,7 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
             return pair.second == timebases[0].second;
           }))
       {
-        int pid_to_blame = 0;
-        for (auto pair : timebases)
-        {
-          if (std::ranges::all_of(timebases, [&](std::pair<PlayerId, u64> other) {
-                return other.first == pair.first || other.second != pair.second;
-              }))
-          {
-            // we are the only outlier
-            pid_to_blame = pair.first;
-            break;
-          }
-        }
+        const int pid_to_blame = FindOutlier(timebases, [](u64 a, u64 b) { return a == b; });
 
         sf::Packet spac;
         spac << MessageID::DesyncDetected;
@@ -1160,6 +1207,73 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::RamHash:
+  {
+    RamHashes hashes;
+    u32 num_regions;
+    packet >> hashes.frame;
+    hashes.combined = Common::PacketReadU64(packet);
+    packet >> num_regions;
+
+    // MEM1 is at most 64 MiB with the extended memory setting.
+    if (num_regions > 64 * 1024 * 1024 / RAM_HASH_REGION_SIZE)
+      break;
+
+    hashes.regions.resize(num_regions);
+    for (u64& region : hashes.regions)
+      region = Common::PacketReadU64(packet);
+
+    if (m_ram_desync_detected)
+      break;
+
+    const u32 frame = hashes.frame;
+    std::vector<std::pair<PlayerId, RamHashes>>& samples = m_ram_hashes_by_frame[frame];
+    samples.emplace_back(player.pid, std::move(hashes));
+    if (samples.size() >= m_players.size())
+    {
+      // Samples of a player arrive in order, so this is the first sampled frame that differs.
+      const auto matches = [](const RamHashes& a, const RamHashes& b) {
+        return !FindRamDivergence(a, b);
+      };
+      if (!std::ranges::all_of(samples, [&](const std::pair<PlayerId, RamHashes>& pair) {
+            return matches(pair.second, samples[0].second);
+          }))
+      {
+        const int pid_to_blame = FindOutlier(samples, matches);
+
+        // Report the range against a player that differs from the one to blame, or against the
+        // first player if nobody can be blamed.
+        const RamHashes* blamed = &samples[0].second;
+        for (const auto& [pid, sample] : samples)
+        {
+          if (pid == pid_to_blame)
+            blamed = &sample;
+        }
+        const auto other =
+            std::ranges::find_if(samples, [&](const std::pair<PlayerId, RamHashes>& pair) {
+              return !matches(pair.second, *blamed);
+            });
+        const RamDivergence divergence = *FindRamDivergence(*blamed, other->second);
+
+        INFO_LOG_FMT(NETPLAY, "RAM desync at frame {}: {:08x}-{:08x} ({} regions differ)", frame,
+                     divergence.begin_address, divergence.end_address, divergence.num_regions);
+
+        sf::Packet spac;
+        spac << MessageID::RamDesyncDetected;
+        spac << pid_to_blame;
+        spac << frame;
+        spac << divergence.begin_address;
+        spac << divergence.end_address;
+        spac << divergence.num_regions;
+        SendToClients(spac);
+
+        m_ram_desync_detected = true;
+      }
+      m_ram_hashes_by_frame.erase(frame);
+    }
+  }
+  break;
+
   case MessageID::GameDigestProgress:
   {
     int progress;
@@ -1414,6 +1528,15 @@ bool NetPlayServer::SetupNetSettings()
     return false;
   }
 
+  // Rollback only snapshots and replays the GameCube controller inputs. Wii Remote data is sent
+  // to the emulated Bluetooth stack, which a rollback can't take back.
+  if (Config::Get(Config::NETPLAY_NETWORK_MODE) == "rollback" &&
+      std::ranges::any_of(m_wiimote_map, [](PlayerId mapping) { return mapping > 0; }))
+  {
+    PanicAlertFmtT("Rollback can't be used while Wii Remotes are assigned to players.");
+    return false;
+  }
+
   INFO_LOG_FMT(NETPLAY, "Loading game settings for {:02x}.",
                fmt::join(m_selected_game_identifier.sync_hash, ""));
 
@@ -1525,8 +1648,15 @@ bool NetPlayServer::SetupNetSettings()
   settings.strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
   settings.sync_codes = Config::Get(Config::NETPLAY_SYNC_CODES);
   settings.golf_mode = Config::Get(Config::NETPLAY_NETWORK_MODE) == "golf";
+  if (Config::Get(Config::NETPLAY_NETWORK_MODE) == "rollback")
+  {
+    settings.rollback_frames = std::max(Config::Get(Config::NETPLAY_ROLLBACK_FRAMES), 1u);
+    settings.rollback_sync_test_frames = Config::Get(Config::NETPLAY_ROLLBACK_SYNC_TEST_FRAMES);
+  }
   settings.use_fma = DoAllPlayersHaveHardwareFMA();
   settings.hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
+  if (Config::Get(Config::NETPLAY_RAM_DESYNC_CHECK))
+    settings.ram_hash_interval = std::max(Config::Get(Config::NETPLAY_RAM_HASH_INTERVAL), 1u);
   settings.is_spectator = Config::Get(Config::NETPLAY_IS_SPECTATOR);
 
   // Unload GameINI to restore things to normal
@@ -1632,6 +1762,8 @@ bool NetPlayServer::StartGame()
 
   m_timebase_by_frame.clear();
   m_desync_detected = false;
+  m_ram_hashes_by_frame.clear();
+  m_ram_desync_detected = false;
   std::lock_guard lkg(m_crit.game);
   // only used as an identifier, not time value, so truncation is fine
   m_current_game = static_cast<u32>(Common::Timer::NowMs());
@@ -1737,6 +1869,9 @@ bool NetPlayServer::StartGame()
   spac << m_settings.golf_mode;
   spac << m_settings.use_fma;
   spac << m_settings.hide_remote_gbas;
+  spac << m_settings.rollback_frames;
+  spac << m_settings.rollback_sync_test_frames;
+  spac << m_settings.ram_hash_interval;
 
   for (size_t i = 0; i < sizeof(m_settings.sram); ++i)
     spac << m_settings.sram[i];
@@ -2484,31 +2619,43 @@ void NetPlayServer::ChunkedDataThreadFunc()
         break;
       auto& e = m_chunked_data_queue.Front();
       const u32 id = m_next_chunked_data_id++;
+      const std::span<const u8> data(static_cast<const u8*>(e.packet.getData()),
+                                     e.packet.getDataSize());
+      const std::vector<ChunkInfo> chunks = SplitIntoChunks(data);
 
       m_chunked_data_complete_count[id] = 0;
-      size_t player_count;
       {
-        std::vector<int> players;
-        if (e.target_mode == TargetMode::Only)
-        {
-          players.push_back(e.target_pid);
-        }
-        else
+        std::lock_guard lk(m_crit.chunked_data_missing);
+        m_chunked_data_missing[id];
+      }
+
+      std::vector<int> players;
+      if (e.target_mode == TargetMode::Only)
+      {
+        players.push_back(e.target_pid);
+      }
+      else
+      {
+        std::lock_guard lkp(m_crit.players);
+        for (auto& pl : std::views::values(m_players))
         {
-          for (auto& pl : std::views::values(m_players))
-          {
-            if (pl.pid != e.target_pid)
-              players.push_back(pl.pid);
-          }
+          if (pl.pid != e.target_pid)
+            players.push_back(pl.pid);
         }
-        player_count = players.size();
+      }
+      const size_t player_count = players.size();
 
-        INFO_LOG_FMT(NETPLAY, "Informing players {} of data chunk {} start.",
-                     fmt::join(players, ", "), id);
+      {
+        INFO_LOG_FMT(NETPLAY, "Informing players {} of data chunk {} start ({} chunks).",
+                     fmt::join(players, ", "), id, chunks.size());
 
+        // Players answer with the chunks that they don't have cached yet.
         sf::Packet pac;
         pac << MessageID::ChunkedDataStart;
         pac << id << e.title << u64{e.packet.getDataSize()};
+        pac << static_cast<u32>(chunks.size());
+        for (const ChunkInfo& chunk : chunks)
+          pac << chunk.hash.low << chunk.hash.high << chunk.size;
 
         ChunkedDataSend(std::move(pac), e.target_pid, e.target_mode);
 
@@ -2516,13 +2663,39 @@ void NetPlayServer::ChunkedDataThreadFunc()
           m_dialog->ShowChunkedProgressDialog(e.title, e.packet.getDataSize(), players);
       }
 
+      while (m_do_loop && !m_abort_chunked_data && !ChunkedDataHasAllMissingLists(id, players))
+        m_chunked_data_complete_event.Wait();
+
+      std::vector<std::vector<PlayerId>> recipients(chunks.size());
+      {
+        std::lock_guard lk(m_crit.chunked_data_missing);
+        for (const auto& [pid, missing] : m_chunked_data_missing[id])
+        {
+          for (const u32 index : missing)
+          {
+            if (index < chunks.size())
+              recipients[index].push_back(pid);
+          }
+        }
+        // Lists that arrive from now on ask for chunks again that didn't arrive intact.
+        m_chunked_data_missing[id].clear();
+      }
+
+      const auto make_payload_packet = [&](size_t index) {
+        const ChunkInfo& chunk = chunks[index];
+        sf::Packet pac;
+        pac << MessageID::ChunkedDataPayload;
+        pac << id;
+        pac << static_cast<u32>(index);
+        pac.append(data.data() + chunk.offset, chunk.size);
+        return pac;
+      };
+
       const bool enable_limit = Config::Get(Config::NETPLAY_ENABLE_CHUNKED_UPLOAD_LIMIT);
       const float bytes_per_second =
           (std::max(Config::Get(Config::NETPLAY_CHUNKED_UPLOAD_LIMIT), 1u) / 8.0f) * 1024.0f;
-      const std::chrono::duration<double> send_interval(CHUNKED_DATA_UNIT_SIZE / bytes_per_second);
       bool skip_wait = false;
-      size_t index = 0;
-      do
+      for (size_t index = 0; index < chunks.size(); ++index)
       {
         if (!m_do_loop)
           return;
@@ -2538,6 +2711,7 @@ void NetPlayServer::ChunkedDataThreadFunc()
         }
         if (e.target_mode == TargetMode::Only)
         {
+          std::lock_guard lkp(m_crit.players);
           if (!m_players.contains(e.target_pid))
           {
             skip_wait = true;
@@ -2545,26 +2719,34 @@ void NetPlayServer::ChunkedDataThreadFunc()
           }
         }
 
+        if (recipients[index].empty())
+          continue;
+
         auto start = std::chrono::steady_clock::now();
 
-        sf::Packet pac;
-        pac << MessageID::ChunkedDataPayload;
-        pac << id;
-        size_t len = std::min(CHUNKED_DATA_UNIT_SIZE, e.packet.getDataSize() - index);
-        pac.append(static_cast<const u8*>(e.packet.getData()) + index, len);
+        const ChunkInfo& chunk = chunks[index];
+        sf::Packet pac = make_payload_packet(index);
 
-        INFO_LOG_FMT(NETPLAY, "Sending data chunk of {} ({} bytes at {}/{}).", id, len, index,
-                     e.packet.getDataSize());
+        INFO_LOG_FMT(NETPLAY, "Sending data chunk of {} ({} bytes at {}/{}) to {} players.", id,
+                     chunk.size, chunk.offset, e.packet.getDataSize(), recipients[index].size());
 
-        ChunkedDataSend(std::move(pac), e.target_pid, e.target_mode);
-        index += CHUNKED_DATA_UNIT_SIZE;
+        if (recipients[index].size() == player_count)
+        {
+          ChunkedDataSend(std::move(pac), e.target_pid, e.target_mode);
+        }
+        else
+        {
+          for (const PlayerId pid : recipients[index])
+            SendAsync(sf::Packet(pac), pid, CHUNKED_DATA_CHANNEL);
+        }
 
         if (enable_limit)
         {
+          const std::chrono::duration<double> send_interval(chunk.size / bytes_per_second);
           std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
           std::this_thread::sleep_for(send_interval - delta);
         }
-      } while (index < e.packet.getDataSize());
+      }
 
       if (!m_abort_chunked_data)
       {
@@ -2578,8 +2760,36 @@ void NetPlayServer::ChunkedDataThreadFunc()
 
       while (m_chunked_data_complete_count[id] < player_count && m_do_loop &&
              !m_abort_chunked_data && !skip_wait)
+      {
         m_chunked_data_complete_event.Wait();
+
+        std::map<PlayerId, std::vector<u32>> requests;
+        {
+          std::lock_guard lk(m_crit.chunked_data_missing);
+          requests.swap(m_chunked_data_missing[id]);
+        }
+        for (const auto& [pid, missing] : requests)
+        {
+          INFO_LOG_FMT(NETPLAY, "Sending {} chunks of data chunk {} to player {} again.",
+                       missing.size(), id, pid);
+
+          for (const u32 index : missing)
+          {
+            if (index < chunks.size())
+              SendAsync(make_payload_packet(index), pid, CHUNKED_DATA_CHANNEL);
+          }
+
+          sf::Packet pac;
+          pac << MessageID::ChunkedDataEnd;
+          pac << id;
+          SendAsync(std::move(pac), pid, CHUNKED_DATA_CHANNEL);
+        }
+      }
       m_chunked_data_complete_count.erase(id);
+      {
+        std::lock_guard lk(m_crit.chunked_data_missing);
+        m_chunked_data_missing.erase(id);
+      }
       m_dialog->HideChunkedProgressDialog();
 
       m_chunked_data_queue.Pop();
@@ -2603,6 +2813,22 @@ void NetPlayServer::ChunkedDataSend(sf::Packet&& packet, const PlayerId pid,
   }
 }
 
+// called from ---Chunked Data--- thread
+bool NetPlayServer::ChunkedDataHasAllMissingLists(const u32 id, const std::vector<int>& players)
+{
+  // Players that left won't answer anymore.
+  std::vector<int> remaining_players;
+  {
+    std::lock_guard lkp(m_crit.players);
+    std::ranges::copy_if(players, std::back_inserter(remaining_players),
+                         [&](int pid) { return m_players.contains(pid); });
+  }
+
+  std::lock_guard lk(m_crit.chunked_data_missing);
+  const auto& missing = m_chunked_data_missing[id];
+  return std::ranges::all_of(remaining_players, [&](int pid) { return missing.contains(pid); });
+}
+
 void NetPlayServer::ChunkedDataAbort()
 {
   m_abort_chunked_data = true;
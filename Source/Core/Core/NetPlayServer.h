@@ -21,8 +21,10 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayChunkedData.h"
 #include "Core/NetPlayClient.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRamHash.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 #include "UICommon/NetPlayIndex.h"
@@ -154,6 +156,7 @@ private:
   void ChunkedDataThreadFunc();
   void ChunkedDataSend(sf::Packet&& packet, PlayerId pid, const TargetMode target_mode);
   void ChunkedDataAbort();
+  bool ChunkedDataHasAllMissingLists(u32 id, const std::vector<int>& players);
 
   void SetupIndex();
   bool PlayerHasControllerMapped(PlayerId pid) const;
@@ -189,6 +192,8 @@ private:
 
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
   bool m_desync_detected = false;
+  std::unordered_map<u32, std::vector<std::pair<PlayerId, RamHashes>>> m_ram_hashes_by_frame;
+  bool m_ram_desync_detected = false;
 
   struct
   {
@@ -197,6 +202,7 @@ private:
     std::recursive_mutex players;
     std::recursive_mutex async_queue_write;
     std::recursive_mutex chunked_data_queue_write;
+    std::recursive_mutex chunked_data_missing;
   } m_crit;
 
   Common::SPSCQueue<AsyncQueueEntry> m_async_queue;
@@ -210,6 +216,8 @@ private:
   std::thread m_chunked_data_thread;
   u32 m_next_chunked_data_id = 0;
   std::unordered_map<u32, unsigned int> m_chunked_data_complete_count;
+  // The chunks that each player doesn't have cached yet, by transfer ID.
+  std::unordered_map<u32, std::map<PlayerId, std::vector<u32>>> m_chunked_data_missing;
   bool m_abort_chunked_data = false;
 
   ENetHost* m_server = nullptr;
@@ -3,9 +3,12 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <algorithm>
+#include <bit>
 #include <span>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
@@ -50,6 +53,7 @@ void CachedInterpreter::Init()
 
 void CachedInterpreter::Shutdown()
 {
+  LogFusionCandidates();
   m_block_cache.Shutdown();
 }
 
@@ -206,6 +210,59 @@ s32 CachedInterpreter::CheckIdle(PowerPC::PowerPCState& ppc_state,
   return sizeof(AnyCallback) + sizeof(operands);
 }
 
+template <bool is_signed, bool immediate>
+void CachedInterpreter::RunCompareAndBranch(PowerPC::PowerPCState& ppc_state,
+                                            const CompareAndBranchOperands& operands)
+{
+  using T = std::conditional_t<is_signed, s32, u32>;
+  const T a = static_cast<T>(ppc_state.gpr[operands.ra]);
+  const T b = static_cast<T>(immediate ? operands.imm : ppc_state.gpr[operands.rb]);
+
+  u32 cr_field = a < b ? PowerPC::CR_LT : a > b ? PowerPC::CR_GT : PowerPC::CR_EQ;
+  if (ppc_state.GetXER_SO())
+    cr_field |= PowerPC::CR_SO;
+  ppc_state.cr.SetField(operands.crf, cr_field);
+
+  const bool taken = (ppc_state.cr.GetBit(operands.bi) != 0) == operands.branch_if_true;
+  ppc_state.pc = operands.branch_pc;
+  ppc_state.npc = taken ? operands.destination : operands.branch_pc + 4;
+}
+
+template <bool is_signed, bool immediate>
+s32 CachedInterpreter::CompareAndBranch(PowerPC::PowerPCState& ppc_state,
+                                        const CompareAndBranchOperands& operands)
+{
+  RunCompareAndBranch<is_signed, immediate>(ppc_state, operands);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed, bool immediate>
+s32 CachedInterpreter::LoadCompareAndBranch(PowerPC::PowerPCState& ppc_state,
+                                            const LoadCompareAndBranchOperands& operands)
+{
+  operands.func(operands.interpreter, operands.inst);
+  RunCompareAndBranch<is_signed, immediate>(ppc_state, operands);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::RotateAndMask(PowerPC::PowerPCState& ppc_state,
+                                     const RotateAndMaskOperands& operands)
+{
+  for (u32 i = 0; i < operands.length; ++i)
+    ppc_state.gpr[operands.ra[i]] = std::rotl(ppc_state.gpr[operands.rs[i]], operands.sh[i]) &
+                                    operands.masks[i];
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <std::size_t length>
+s32 CachedInterpreter::InterpretSequence(PowerPC::PowerPCState& ppc_state,
+                                         const InterpretSequenceOperands<length>& operands)
+{
+  for (std::size_t i = 0; i < length; ++i)
+    operands.funcs[i](operands.interpreter, operands.insts[i]);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   // CachedInterpreter inherits from JitBase and is considered a JIT by relevant code.
@@ -237,6 +294,183 @@ void CachedInterpreter::WriteEndBlock()
   }
 }
 
+static bool IsCompare(UGeckoInstruction inst)
+{
+  return inst.OPCD == 10 || inst.OPCD == 11 ||
+         (inst.OPCD == 31 && (inst.SUBOP10 == 0 || inst.SUBOP10 == 32));
+}
+
+// Conditional branches that only test a CR bit.
+static bool IsConditionalBranch(UGeckoInstruction inst)
+{
+  return inst.OPCD == 16 && !inst.LK && (inst.BO & BO_DONT_DECREMENT_FLAG) != 0 &&
+         (inst.BO & BO_DONT_CHECK_CONDITION) == 0;
+}
+
+static bool IsRotateAndMask(UGeckoInstruction inst)
+{
+  return inst.OPCD == 21 && !inst.Rc;
+}
+
+// Returns how many instructions at the start of ops a superinstruction other than
+// InterpretSequence covers.
+static std::size_t MatchSuperinstruction(std::span<const PPCAnalyst::CodeOp> ops)
+{
+  if (ops.empty() || ops[0].canEndBlock)
+    return 0;
+
+  if (ops.size() >= 2 && IsCompare(ops[0].inst) && IsConditionalBranch(ops[1].inst))
+    return 2;
+  if (ops.size() >= 3 && ops[0].opinfo->type == OpType::Load && IsCompare(ops[1].inst) &&
+      !ops[1].canEndBlock && IsConditionalBranch(ops[2].inst))
+  {
+    return 3;
+  }
+
+  std::size_t length = 0;
+  while (length < ops.size() && IsRotateAndMask(ops[length].inst))
+    ++length;
+  return length;
+}
+
+bool CachedInterpreter::CanFuseInstruction(const PPCAnalyst::CodeOp& op, bool is_first) const
+{
+  if (op.skip || (jo.memcheck && (op.opinfo->flags & FL_LOADSTORE) != 0) ||
+      ShouldHandleFPExceptionForInstruction(&op))
+  {
+    return false;
+  }
+  if (is_first)
+    return true;
+
+  // DoJit would write these checks after the superinstruction instead of before the instruction.
+  if ((op.opinfo->flags & FL_USE_FPU) != 0 && !js.firstFPInstructionFound)
+    return false;
+  return !HLE::TryReplaceFunction(m_ppc_symbol_db, op.address, PowerPC::CoreMode::JIT);
+}
+
+u32 CachedInterpreter::WriteSuperinstruction(u32 index)
+{
+  // Breakpoints and branch watch need each instruction to have its own callback.
+  if (IsDebuggingEnabled())
+    return 0;
+
+  const std::span<const PPCAnalyst::CodeOp> remaining{m_code_buffer.data() + index,
+                                                      code_block.m_num_instructions - index};
+  std::size_t fusable_count = 0;
+  while (fusable_count < std::min(remaining.size(), RotateAndMaskOperands::MAX_LENGTH) &&
+         CanFuseInstruction(remaining[fusable_count], fusable_count == 0))
+  {
+    ++fusable_count;
+  }
+  const std::span<const PPCAnalyst::CodeOp> ops = remaining.first(fusable_count);
+
+  auto& interpreter = m_system.GetInterpreter();
+  const std::size_t length = MatchSuperinstruction(ops);
+  if (length >= 2 && IsConditionalBranch(ops[length - 1].inst))
+  {
+    const UGeckoInstruction compare = ops[length - 2].inst;
+    const UGeckoInstruction branch = ops[length - 1].inst;
+    const u32 branch_pc = ops[length - 1].address;
+    const bool is_signed = compare.OPCD == 11 || (compare.OPCD == 31 && compare.SUBOP10 == 0);
+    const bool immediate = compare.OPCD != 31;
+
+    CompareAndBranchOperands operands{};
+    operands.ra = static_cast<u8>(compare.RA);
+    operands.rb = static_cast<u8>(compare.RB);
+    operands.crf = static_cast<u8>(compare.CRFD);
+    operands.bi = static_cast<u8>(branch.BI);
+    operands.imm = is_signed ? static_cast<u32>(compare.SIMM_16) : compare.UIMM;
+    operands.branch_pc = branch_pc;
+    operands.destination =
+        static_cast<u32>(SignExt16(s16(branch.BD << 2))) + (branch.AA ? 0 : branch_pc);
+    operands.branch_if_true = (branch.BO & BO_BRANCH_IF_TRUE) != 0;
+
+    if (length == 2)
+    {
+      Write(is_signed ? (immediate ? CallbackCast(CompareAndBranch<true, true>) :
+                                     CallbackCast(CompareAndBranch<true, false>)) :
+                        (immediate ? CallbackCast(CompareAndBranch<false, true>) :
+                                     CallbackCast(CompareAndBranch<false, false>)),
+            operands);
+    }
+    else
+    {
+      const LoadCompareAndBranchOperands load_operands{
+          operands, interpreter, Interpreter::GetInterpreterOp(ops[0].inst), ops[0].inst};
+      Write(is_signed ? (immediate ? CallbackCast(LoadCompareAndBranch<true, true>) :
+                                     CallbackCast(LoadCompareAndBranch<true, false>)) :
+                        (immediate ? CallbackCast(LoadCompareAndBranch<false, true>) :
+                                     CallbackCast(LoadCompareAndBranch<false, false>)),
+            load_operands);
+    }
+    return static_cast<u32>(length);
+  }
+  if (length != 0)
+  {
+    RotateAndMaskOperands operands{};
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      const UGeckoInstruction inst = ops[i].inst;
+      operands.masks[i] = MakeRotationMask(inst.MB, inst.ME);
+      operands.ra[i] = static_cast<u8>(inst.RA);
+      operands.rs[i] = static_cast<u8>(inst.RS);
+      operands.sh[i] = static_cast<u8>(inst.SH);
+    }
+    operands.length = static_cast<u32>(length);
+    Write(RotateAndMask, operands);
+    return static_cast<u32>(length);
+  }
+
+  if (ops.size() >= 2)
+    ++m_fusion_candidates[{ops[0].opinfo->opname, ops[1].opinfo->opname}];
+
+  // Fall back to interpreting the instructions up to the next one that ends the block or starts
+  // a superinstruction of its own.
+  std::size_t sequence_length = 0;
+  while (sequence_length < std::min<std::size_t>(ops.size(), 3) &&
+         !ops[sequence_length].canEndBlock &&
+         (sequence_length == 0 || MatchSuperinstruction(ops.subspan(sequence_length)) == 0))
+  {
+    ++sequence_length;
+  }
+  if (sequence_length == 2)
+  {
+    Write(InterpretSequence<2>,
+          {interpreter,
+           {Interpreter::GetInterpreterOp(ops[0].inst), Interpreter::GetInterpreterOp(ops[1].inst)},
+           {ops[0].inst, ops[1].inst}});
+    return 2;
+  }
+  if (sequence_length == 3)
+  {
+    Write(InterpretSequence<3>,
+          {interpreter,
+           {Interpreter::GetInterpreterOp(ops[0].inst), Interpreter::GetInterpreterOp(ops[1].inst),
+            Interpreter::GetInterpreterOp(ops[2].inst)},
+           {ops[0].inst, ops[1].inst, ops[2].inst}});
+    return 3;
+  }
+  return 0;
+}
+
+void CachedInterpreter::LogFusionCandidates() const
+{
+  if (m_fusion_candidates.empty())
+    return;
+
+  std::vector<std::pair<std::pair<const char*, const char*>, u32>> candidates(
+      m_fusion_candidates.begin(), m_fusion_candidates.end());
+  const auto middle = candidates.begin() + std::min<std::size_t>(candidates.size(), 16);
+  std::partial_sort(candidates.begin(), middle, candidates.end(),
+                    [](const auto& a, const auto& b) { return a.second > b.second; });
+
+  std::string text;
+  for (auto it = candidates.begin(); it != middle; ++it)
+    text += fmt::format("\n  {} {}: {}", it->first.first, it->first.second, it->second);
+  INFO_LOG_FMT(DYNA_REC, "Most compiled instruction pairs without a superinstruction:{}", text);
+}
+
 bool CachedInterpreter::SetEmitterStateToFreeCodeRegion()
 {
   const auto free = m_free_ranges.by_size_begin();
@@ -343,6 +577,7 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     Write(StartProfiledBlock, {js.curBlock->profile_data.get()});
 
+  u32 fused_instructions_left = 0;
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
@@ -372,9 +607,14 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         js.firstFPInstructionFound = true;
       }
 
+      if (fused_instructions_left != 0)
+      {
+        // Already run by the superinstruction of an earlier instruction.
+        --fused_instructions_left;
+      }
       // Instruction may cause a DSI Exception or Program Exception.
-      if ((jo.memcheck && (op.opinfo->flags & FL_LOADSTORE) != 0) ||
-          (!op.canEndBlock && ShouldHandleFPExceptionForInstruction(&op)))
+      else if ((jo.memcheck && (op.opinfo->flags & FL_LOADSTORE) != 0) ||
+               (!op.canEndBlock && ShouldHandleFPExceptionForInstruction(&op)))
       {
         const InterpretAndCheckExceptionsOperands operands = {
             {interpreter, Interpreter::GetInterpreterOp(op.inst), js.compilerPC, op.inst},
@@ -384,6 +624,10 @@ bool CachedInterpreter::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
                                CallbackCast(InterpretAndCheckExceptions<false>),
               operands);
       }
+      else if (const u32 length = WriteSuperinstruction(i); length != 0)
+      {
+        fused_instructions_left = length - 1;
+      }
       else
       {
         const InterpretOperands operands = {interpreter, Interpreter::GetInterpreterOp(op.inst),
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <map>
+#include <span>
+#include <utility>
 
 #include <rangeset/rangesizeset.h>
 
@@ -64,6 +68,13 @@ private:
   bool HandleFunctionHooking(u32 address);
   void WriteEndBlock();
 
+  // Writes a single callback for the instruction at the given index of the code buffer and the
+  // ones that follow it, if they form a sequence that can be fused. Returns how many instructions
+  // the callback runs, or 0 if nothing was written.
+  u32 WriteSuperinstruction(u32 index);
+  bool CanFuseInstruction(const PPCAnalyst::CodeOp& op, bool is_first) const;
+  void LogFusionCandidates() const;
+
   // Finds a free memory region and sets the code emitter to point at that region.
   // Returns false if no free memory region can be found.
   bool SetEmitterStateToFreeCodeRegion();
@@ -82,6 +93,11 @@ private:
   struct WriteBrokenBlockNPCOperands;
   struct CheckHaltOperands;
   struct CheckIdleOperands;
+  struct CompareAndBranchOperands;
+  struct LoadCompareAndBranchOperands;
+  struct RotateAndMaskOperands;
+  template <std::size_t length>
+  struct InterpretSequenceOperands;
 
   static s32 StartProfiledBlock(PowerPC::PowerPCState& ppc_state,
                                 const StartProfiledBlockOperands& operands);
@@ -112,8 +128,37 @@ private:
   static s32 CheckIdle(PowerPC::PowerPCState& ppc_state, const CheckIdleOperands& operands);
   static s32 CheckIdle(std::ostream& stream, const CheckIdleOperands& operands);
 
+  // Superinstructions, which each run a common sequence of instructions.
+  template <bool is_signed, bool immediate>
+  static void RunCompareAndBranch(PowerPC::PowerPCState& ppc_state,
+                                  const CompareAndBranchOperands& operands);
+  template <bool is_signed, bool immediate>
+  static s32 CompareAndBranch(PowerPC::PowerPCState& ppc_state,
+                              const CompareAndBranchOperands& operands);
+  template <bool is_signed, bool immediate>
+  static s32 CompareAndBranch(std::ostream& stream, const CompareAndBranchOperands& operands);
+  template <bool is_signed, bool immediate>
+  static s32 LoadCompareAndBranch(PowerPC::PowerPCState& ppc_state,
+                                  const LoadCompareAndBranchOperands& operands);
+  template <bool is_signed, bool immediate>
+  static s32 LoadCompareAndBranch(std::ostream& stream,
+                                  const LoadCompareAndBranchOperands& operands);
+  static s32 RotateAndMask(PowerPC::PowerPCState& ppc_state,
+                           const RotateAndMaskOperands& operands);
+  static s32 RotateAndMask(std::ostream& stream, const RotateAndMaskOperands& operands);
+  template <std::size_t length>
+  static s32 InterpretSequence(PowerPC::PowerPCState& ppc_state,
+                               const InterpretSequenceOperands<length>& operands);
+  template <std::size_t length>
+  static s32 InterpretSequence(std::ostream& stream,
+                               const InterpretSequenceOperands<length>& operands);
+
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges;
   CachedInterpreterBlockCache m_block_cache;
+
+  // How often each pair of adjacent instructions had to be compiled to separate callbacks, by
+  // opcode name. This shows which sequences would be worth adding a superinstruction for.
+  std::map<std::pair<const char*, const char*>, u32> m_fusion_candidates;
 };
 
 struct CachedInterpreter::StartProfiledBlockOperands
@@ -175,3 +220,46 @@ struct CachedInterpreter::CheckIdleOperands
   CoreTiming::CoreTimingManager& core_timing;
   u32 idle_pc;
 };
+
+// cmp, cmpl, cmpi or cmpli followed by a bc that only tests a CR bit.
+struct CachedInterpreter::CompareAndBranchOperands
+{
+  u8 ra;
+  u8 rb;
+  u8 crf;
+  u8 bi;
+  u32 imm;
+  u32 branch_pc;
+  u32 destination;
+  bool branch_if_true;
+  u32 : 32;
+};
+
+// An integer load followed by a compare and branch.
+struct CachedInterpreter::LoadCompareAndBranchOperands : CompareAndBranchOperands
+{
+  Interpreter& interpreter;
+  void (*func)(Interpreter&, UGeckoInstruction);  // Interpreter::Instruction
+  UGeckoInstruction inst;
+};
+
+// A chain of rlwinm instructions that don't update CR0.
+struct CachedInterpreter::RotateAndMaskOperands
+{
+  static constexpr std::size_t MAX_LENGTH = 4;
+
+  std::array<u32, MAX_LENGTH> masks;
+  std::array<u8, MAX_LENGTH> ra;
+  std::array<u8, MAX_LENGTH> rs;
+  std::array<u8, MAX_LENGTH> sh;
+  u32 length;
+};
+
+// Instructions without a superinstruction of their own, which are interpreted one after another.
+template <std::size_t length>
+struct CachedInterpreter::InterpretSequenceOperands
+{
+  Interpreter& interpreter;
+  std::array<void (*)(Interpreter&, UGeckoInstruction), length> funcs;
+  std::array<UGeckoInstruction, length> insts;
+};
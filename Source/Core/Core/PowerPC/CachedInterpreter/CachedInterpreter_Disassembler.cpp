@@ -90,6 +90,55 @@ s32 CachedInterpreter::CheckIdle(std::ostream& stream, const CheckIdleOperands&
   return sizeof(AnyCallback) + sizeof(operands);
 }
 
+template <bool is_signed, bool immediate>
+s32 CachedInterpreter::CompareAndBranch(std::ostream& stream,
+                                        const CompareAndBranchOperands& operands)
+{
+  fmt::println(stream,
+               "CompareAndBranch<is_signed={:5}, immediate={:5}>(ra={}, rb={}, imm=0x{:08x}, "
+               "crf={}, bi={}, branch_if_true={}, branch_pc=0x{:08x}, destination=0x{:08x})",
+               is_signed, immediate, operands.ra, operands.rb, operands.imm, operands.crf,
+               operands.bi, operands.branch_if_true, operands.branch_pc, operands.destination);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <bool is_signed, bool immediate>
+s32 CachedInterpreter::LoadCompareAndBranch(std::ostream& stream,
+                                            const LoadCompareAndBranchOperands& operands)
+{
+  fmt::println(stream,
+               "LoadCompareAndBranch<is_signed={:5}, immediate={:5}>(inst=0x{:08x}, ra={}, rb={}, "
+               "imm=0x{:08x}, crf={}, bi={}, branch_if_true={}, branch_pc=0x{:08x}, "
+               "destination=0x{:08x})",
+               is_signed, immediate, operands.inst.hex, operands.ra, operands.rb, operands.imm,
+               operands.crf, operands.bi, operands.branch_if_true, operands.branch_pc,
+               operands.destination);
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+s32 CachedInterpreter::RotateAndMask(std::ostream& stream, const RotateAndMaskOperands& operands)
+{
+  stream << "RotateAndMask(";
+  for (u32 i = 0; i < operands.length; ++i)
+  {
+    fmt::print(stream, "{}ra={}, rs={}, sh={}, mask=0x{:08x}", i == 0 ? "" : "; ", operands.ra[i],
+               operands.rs[i], operands.sh[i], operands.masks[i]);
+  }
+  stream << ")\n";
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
+template <std::size_t length>
+s32 CachedInterpreter::InterpretSequence(std::ostream& stream,
+                                         const InterpretSequenceOperands<length>& operands)
+{
+  fmt::print(stream, "InterpretSequence<length={}>(", length);
+  for (std::size_t i = 0; i < length; ++i)
+    fmt::print(stream, "{}inst=0x{:08x}", i == 0 ? "" : ", ", operands.insts[i].hex);
+  stream << ")\n";
+  return sizeof(AnyCallback) + sizeof(operands);
+}
+
 static std::once_flag s_sorted_lookup_flag;
 
 std::size_t CachedInterpreter::Disassemble(const JitBlock& block, std::ostream& stream)
@@ -115,6 +164,17 @@ std::size_t CachedInterpreter::Disassemble(const JitBlock& block, std::ostream&
       LOOKUP_KV(CachedInterpreter::CheckFPU),
       LOOKUP_KV(CachedInterpreter::CheckBreakpoint),
       LOOKUP_KV(CachedInterpreter::CheckIdle),
+      LOOKUP_KV(CachedInterpreter::CompareAndBranch<false, false>),
+      LOOKUP_KV(CachedInterpreter::CompareAndBranch<false, true>),
+      LOOKUP_KV(CachedInterpreter::CompareAndBranch<true, false>),
+      LOOKUP_KV(CachedInterpreter::CompareAndBranch<true, true>),
+      LOOKUP_KV(CachedInterpreter::LoadCompareAndBranch<false, false>),
+      LOOKUP_KV(CachedInterpreter::LoadCompareAndBranch<false, true>),
+      LOOKUP_KV(CachedInterpreter::LoadCompareAndBranch<true, false>),
+      LOOKUP_KV(CachedInterpreter::LoadCompareAndBranch<true, true>),
+      LOOKUP_KV(CachedInterpreter::RotateAndMask),
+      LOOKUP_KV(CachedInterpreter::InterpretSequence<2>),
+      LOOKUP_KV(CachedInterpreter::InterpretSequence<3>),
   });
 
 #undef LOOKUP_KV
@@ -36,6 +36,8 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Executes instructions until the end of the current block. Returns the cycles taken.
+  int SingleStepBlock();
 
   void Run() override;
   void ClearCache() override;
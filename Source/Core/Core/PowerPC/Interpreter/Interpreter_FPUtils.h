@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <bit>
 #include <cmath>
 #include <limits>
+#include <type_traits>
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
@@ -583,6 +585,28 @@ inline u32 ConvertToSingleFTZ(u64 x)
   }
 }
 
+// Scale factors of psq_lXX and psq_stXX, indexed by the 6-bit scale field of the GQR.
+extern const float m_dequantizeTable[64];
+extern const float m_quantizeTable[64];
+
+// used by psq_stXX operations to convert to an integer type.
+template <typename SType>
+inline SType ScaleAndClamp(double ps, u32 st_scale)
+{
+  const float conv_ps = float(ps) * m_quantizeTable[st_scale];
+  constexpr float min = float(std::numeric_limits<SType>::min());
+  constexpr float max = float(std::numeric_limits<SType>::max());
+
+  return SType(std::clamp(conv_ps, min, max));
+}
+
+// used by psq_lXX operations to convert from an integer type.
+template <typename SType>
+inline float Dequantize(std::make_unsigned_t<SType> value, u32 ld_scale)
+{
+  return float(SType(value)) * m_dequantizeTable[ld_scale];
+}
+
 inline u64 ConvertToDouble(u32 value)
 {
   // This is a little-endian re-implementation of the algorithm described in
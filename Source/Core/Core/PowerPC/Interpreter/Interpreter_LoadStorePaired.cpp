@@ -3,7 +3,6 @@
 
 #include "Core/PowerPC/Interpreter/Interpreter.h"
 
-#include <algorithm>
 #include <bit>
 #include <tuple>
 #include <type_traits>
@@ -19,7 +18,7 @@
 #include "Core/System.h"
 
 // dequantize table
-const float m_dequantizeTable[] = {
+const float m_dequantizeTable[64] = {
     1.0 / (1ULL << 0),  1.0 / (1ULL << 1),  1.0 / (1ULL << 2),  1.0 / (1ULL << 3),
     1.0 / (1ULL << 4),  1.0 / (1ULL << 5),  1.0 / (1ULL << 6),  1.0 / (1ULL << 7),
     1.0 / (1ULL << 8),  1.0 / (1ULL << 9),  1.0 / (1ULL << 10), 1.0 / (1ULL << 11),
@@ -39,7 +38,7 @@ const float m_dequantizeTable[] = {
 };
 
 // quantize table
-const float m_quantizeTable[] = {
+const float m_quantizeTable[64] = {
     (1ULL << 0),        (1ULL << 1),        (1ULL << 2),        (1ULL << 3),
     (1ULL << 4),        (1ULL << 5),        (1ULL << 6),        (1ULL << 7),
     (1ULL << 8),        (1ULL << 9),        (1ULL << 10),       (1ULL << 11),
@@ -58,16 +57,6 @@ const float m_quantizeTable[] = {
     1.0 / (1ULL << 4),  1.0 / (1ULL << 3),  1.0 / (1ULL << 2),  1.0 / (1ULL << 1),
 };
 
-template <typename SType>
-SType ScaleAndClamp(double ps, u32 st_scale)
-{
-  const float conv_ps = float(ps) * m_quantizeTable[st_scale];
-  constexpr float min = float(std::numeric_limits<SType>::min());
-  constexpr float max = float(std::numeric_limits<SType>::max());
-
-  return SType(std::clamp(conv_ps, min, max));
-}
-
 template <typename T>
 static T ReadUnpaired(PowerPC::MMU& mmu, u32 addr);
 
@@ -236,14 +225,14 @@ std::pair<double, double> LoadAndDequantize(PowerPC::MMU& mmu, u32 addr, u32 ins
   if (instW != 0)
   {
     const U value = ReadUnpaired<U>(mmu, addr);
-    ps0 = float(T(value)) * m_dequantizeTable[ld_scale];
+    ps0 = Dequantize<T>(value, ld_scale);
     ps1 = 1.0f;
   }
   else
   {
     const auto [first, second] = ReadPair<U>(mmu, addr);
-    ps0 = float(T(first)) * m_dequantizeTable[ld_scale];
-    ps1 = float(T(second)) * m_dequantizeTable[ld_scale];
+    ps0 = Dequantize<T>(first, ld_scale);
+    ps1 = Dequantize<T>(second, ld_scale);
   }
   // ps0 and ps1 always contain finite and normal numbers. So we can just cast them to double
   return {static_cast<double>(ps0), static_cast<double>(ps1)};
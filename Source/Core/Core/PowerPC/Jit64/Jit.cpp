@@ -3,10 +3,14 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <mutex>
 #include <span>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
@@ -25,6 +29,8 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -177,6 +183,8 @@ bool Jit64::BackPatch(SContext* ctx)
     return false;
   }
 
+  std::lock_guard lk(m_compiler_mutex);
+
   TrampolineInfo& info = it->second;
 
   u8* exceptionHandler = nullptr;
@@ -197,6 +205,8 @@ bool Jit64::BackPatch(SContext* ctx)
   js.generatingTrampoline = true;
   js.trampolineExceptionHandler = exceptionHandler;
   js.compilerPC = info.pc;
+  js.featureFlags = m_ppc_state.feature_flags;
+  js.accessState = m_mmu.GetOptimizableAccessState();
 
   // Generate the trampoline.
   const u8* trampoline = trampolines.GenerateTrampoline(info);
@@ -259,6 +269,17 @@ void Jit64::Init()
 
   RefreshConfig();
 
+  m_tiered_compilation = Config::Get(Config::MAIN_JIT_TIERED_COMPILATION);
+  m_tier_up_threshold = std::max(Config::Get(Config::MAIN_JIT_TIER_UP_THRESHOLD), 1u);
+  m_warm_start = Config::Get(Config::MAIN_JIT_WARM_START);
+  m_superblocks = Config::Get(Config::MAIN_JIT_SUPERBLOCKS);
+  m_superblock_threshold = Config::Get(Config::MAIN_JIT_SUPERBLOCK_THRESHOLD);
+  m_bound_entries = Config::Get(Config::MAIN_JIT_BOUND_ENTRIES);
+  m_evict_cold_blocks = Config::Get(Config::MAIN_JIT_EVICT_COLD_BLOCKS);
+  m_software_tlb = Config::Get(Config::MAIN_JIT_SOFTWARE_TLB);
+  m_ppc_state.software_tlb.Invalidate();
+  m_ppc_state.software_tlb.enabled = m_software_tlb;
+
   EnableBlockLink();
 
   jo.optimizeGatherPipe = true;
@@ -299,10 +320,57 @@ void Jit64::Init()
   EnableOptimization();
 
   ResetFreeMemoryRanges();
+
+  if (m_tiered_compilation || m_warm_start)
+  {
+    m_tier_up_code_buffer.resize(code_buffer_size);
+    m_tier_up_thread.Reset("JIT Tier-Up", [this](std::unique_ptr<TierUpJob> job) {
+      CompileTierUp(std::move(job));
+    });
+  }
+}
+
+bool Jit64::IsTieredCompilationEnabled() const
+{
+  return m_tiered_compilation && !IsDebuggingEnabled() && !Core::WantsDeterminism();
+}
+
+bool Jit64::IsWarmStartEnabled() const
+{
+  // Which blocks get compiled ahead of time depends on earlier sessions on this machine, and when
+  // they are published depends on the timing of the tier-up thread.
+  return m_warm_start && !IsDebuggingEnabled() && !Core::WantsDeterminism();
+}
+
+bool Jit64::IsSuperblockEnabled() const
+{
+  // Which blocks become superblocks depends on when the cache was last cleared.
+  return m_superblocks && !IsDebuggingEnabled() && !Core::WantsDeterminism();
+}
+
+bool Jit64::IsBoundEntryEnabled() const
+{
+  // The calls that profiling and debugging insert at the start of blocks clobber host registers.
+  return m_bound_entries && jo.enableBlocklink && !IsDebuggingEnabled() && !IsProfilingEnabled() &&
+         !m_im_here_debug;
+}
+
+bool Jit64::UseSoftwareTLB() const
+{
+  // The software TLB maps straight to memory, which would skip the data cache.
+  return m_software_tlb && !js.accessState.dcache_enabled;
 }
 
 void Jit64::ClearCache()
 {
+  std::lock_guard lk(m_compiler_mutex);
+
+  // Jobs that are still queued notice the new epoch and skip compilation.
+  ++m_code_space_epoch;
+  m_tier_up_needs_clear = false;
+  m_finished_tier_ups.clear();
+  m_block_heat.clear();
+
   blocks.Clear();
   blocks.ClearRangesToFree();
   trampolines.ClearCodeSpace();
@@ -336,8 +404,81 @@ void Jit64::ResetFreeMemoryRanges()
   m_free_ranges_far.insert(m_far_code.GetWritableCodePtr(), m_far_code.GetWritableCodeEnd());
 }
 
+void Jit64::AgeBlocks()
+{
+  // Blocks are only aged while code is being compiled, which is the only time they can be evicted.
+  // Blocks that run in between all end up in the next epoch.
+  constexpr auto EPOCH_LENGTH = std::chrono::seconds(1);
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_block_run_epoch_start < EPOCH_LENGTH)
+    return;
+
+  blocks.AgeBlocks(++m_block_run_epoch);
+  m_block_run_epoch_start = now;
+}
+
+bool Jit64::EvictColdBlocks()
+{
+  if (!m_evict_cold_blocks)
+    return false;
+
+  // Blocks that have run since the last epoch started must not count as the coldest ones.
+  FreeRanges();
+  blocks.AgeBlocks(++m_block_run_epoch);
+  m_block_run_epoch_start = std::chrono::steady_clock::now();
+
+  const std::size_t near_target = region_size / 4;
+  const std::size_t far_target = (jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE) / 4;
+  std::size_t free_near = m_free_ranges_near.get_stats().first;
+  std::size_t free_far = m_free_ranges_far.get_stats().first;
+  std::size_t evicted_blocks = 0;
+  std::size_t reclaimed_bytes = 0;
+  for (const JitBlock* block : blocks.GetBlocksByLastRun())
+  {
+    if (free_near >= near_target && free_far >= far_target)
+      break;
+
+    const std::size_t near_size = block->near_end - block->near_begin;
+    const std::size_t far_size = block->far_end - block->far_begin;
+    free_near += near_size;
+    free_far += far_size;
+    reclaimed_bytes += near_size + far_size;
+    ++evicted_blocks;
+
+    // Unlinks the block from the blocks that jump to it and queues its code space to be freed.
+    blocks.EraseSingleBlock(*block);
+  }
+  FreeRanges();
+
+  if (evicted_blocks == 0)
+    return false;
+
+  auto& counters = m_system.GetJitInterface().GetCodeSpaceCounters();
+  ++counters.evictions;
+  counters.evicted_blocks += evicted_blocks;
+  counters.reclaimed_bytes += reclaimed_bytes;
+  INFO_LOG_FMT(DYNA_REC, "Evicted {} cold blocks to reclaim {} bytes of code space",
+               evicted_blocks, reclaimed_bytes);
+  return true;
+}
+
+void Jit64::FlushCodeSpace()
+{
+  WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
+  ++m_system.GetJitInterface().GetCodeSpaceCounters().flushes;
+  ClearCache();
+}
+
 void Jit64::Shutdown()
 {
+  m_tier_up_thread.StopAndCancel();
+  m_finished_tier_ups.clear();
+  m_block_heat.clear();
+  m_block_profile.Close();
+  m_block_profile_game_id.clear();
+  m_next_profiled_block = 0;
+  m_ppc_state.software_tlb.enabled = false;
+
   FreeCodeSpace();
 
   auto& memory = m_system.GetMemory();
@@ -461,7 +602,7 @@ bool Jit64::Cleanup()
     did_something = true;
   }
 
-  if (m_ppc_state.feature_flags & FEATURE_FLAG_PERFMON)
+  if (js.featureFlags & FEATURE_FLAG_PERFMON)
   {
     ABI_PushRegistersAndAdjustStack({}, 0);
     ABI_CallFunctionCCCP(PowerPC::UpdatePerformanceMonitor, js.downcountAmount, js.numLoadStoreInst,
@@ -489,7 +630,7 @@ void Jit64::FakeBLCall(u32 after)
 
   // We may need to fake the BLR stack on inlined CALL instructions.
   // Else we can't return to this location any more.
-  MOV(64, R(RSCRATCH2), Imm64(u64(m_ppc_state.feature_flags) << 32 | after));
+  MOV(64, R(RSCRATCH2), Imm64(u64(js.featureFlags) << 32 | after));
   PUSH(RSCRATCH2);
   FixupBranch skip_exit = CALL();
   POP(RSCRATCH2);
@@ -527,7 +668,7 @@ void Jit64::MSRUpdated(const OpArg& msr, X64Reg scratch_reg)
   static_assert(UReg_MSR{}.IR.StartBit() == 5);
   static_assert(FEATURE_FLAG_MSR_DR == 1 << 0);
   static_assert(FEATURE_FLAG_MSR_IR == 1 << 1);
-  const u32 other_feature_flags = m_ppc_state.feature_flags & ~0x3;
+  const u32 other_feature_flags = js.featureFlags & ~0x3;
   if (msr.IsImm())
   {
     MOV(32, PPCSTATE(feature_flags), Imm32(other_feature_flags | ((msr.Imm32() >> 4) & 0x3)));
@@ -548,20 +689,105 @@ void Jit64::WriteExit(u32 destination, bool bl, u32 after)
   if (!m_enable_blr_optimization)
     bl = false;
 
-  Cleanup();
+  // This has to be checked before Cleanup, which may call functions that clobber host registers.
+  bool gprs_intact = !bl && AreFlushedGPRsIntact();
+  if (Cleanup())
+    gprs_intact = false;
 
   if (bl)
   {
-    MOV(64, R(RSCRATCH2), Imm64(u64(m_ppc_state.feature_flags) << 32 | after));
+    MOV(64, R(RSCRATCH2), Imm64(u64(js.featureFlags) << 32 | after));
     PUSH(RSCRATCH2);
   }
 
   SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
 
-  JustWriteExit(destination, bl, after);
+  JustWriteExit(destination, bl, after, gprs_intact);
+}
+
+bool Jit64::AreFlushedGPRsIntact() const
+{
+  if (!IsBoundEntryEnabled())
+    return false;
+
+  // Apart from the GPR flush itself, only an FPR flush may have been emitted since, which only
+  // uses XMM registers.
+  const u8* code = GetCodePtr();
+  const u8* gpr_flush_end = gpr.GetFlushEnd();
+  return gpr_flush_end == code ||
+         (fpr.GetFlushBegin() == gpr_flush_end && fpr.GetFlushEnd() == code);
+}
+
+u64 Jit64::WriteBoundEntryMoves(u32 destination)
+{
+  // Loops are the most common case, and the block being compiled isn't in the cache yet.
+  const JitBlock* dest = destination == js.blockStart ?
+                             js.curBlock :
+                             blocks.GetBlockFromStartAddress(destination, js.featureFlags);
+  if (!dest || dest->boundEntryState == 0)
+    return 0;
+
+  struct Move
+  {
+    preg_t preg;
+    X64Reg dest;
+    OpArg source;
+  };
+  std::array<Move, MAX_BOUND_ENTRY_GPRS> moves;
+  size_t num_moves = 0;
+  const u64 state = dest->boundEntryState;
+  const size_t num_registers = state & 7;
+  for (size_t i = 0; i < num_registers; ++i)
+  {
+    const preg_t preg = (state >> (3 + 5 * i)) & 0x1F;
+    const X64Reg dest_reg = gpr.GetEntryRegister(i);
+    const OpArg source = gpr.GetFlushedLocation(preg).value_or(PPCSTATE_GPR(preg));
+    if (!source.IsSimpleReg(dest_reg))
+      moves[num_moves++] = {preg, dest_reg, source};
+  }
+
+  size_t loads = 0;
+  // Every value is also in PowerPCState, so a host register that is still needed as a source can
+  // be overwritten once the moves that read it are switched to loading from there instead.
+  while (num_moves != 0)
+  {
+    size_t next = 0;
+    while (next < num_moves &&
+           std::any_of(moves.begin(), moves.begin() + num_moves, [&](const Move& other) {
+             return &other != &moves[next] && other.source.IsSimpleReg(moves[next].dest);
+           }))
+    {
+      ++next;
+    }
+    if (next == num_moves)
+    {
+      next = 0;
+      for (size_t i = 1; i < num_moves; ++i)
+      {
+        if (moves[i].source.IsSimpleReg(moves[next].dest))
+          moves[i].source = PPCSTATE_GPR(moves[i].preg);
+      }
+    }
+
+    const Move& move = moves[next];
+    if (!move.source.IsSimpleReg() && !move.source.IsImm())
+      ++loads;
+    MOV(32, R(move.dest), move.source);
+    moves[next] = moves[--num_moves];
+  }
+
+  // Only counted along with the block entries.
+  if (IsSuperblockEnabled() && loads != num_registers)
+  {
+    MOV(64, R(RSCRATCH),
+        ImmPtr(&m_system.GetJitInterface().GetBlockEntryCounters().register_loads_skipped));
+    ADD(64, MatR(RSCRATCH), Imm8(static_cast<u8>(num_registers - loads)));
+  }
+
+  return state;
 }
 
-void Jit64::JustWriteExit(u32 destination, bool bl, u32 after)
+void Jit64::JustWriteExit(u32 destination, bool bl, u32 after, bool gprs_intact)
 {
   // If nobody has taken care of this yet (this can be removed when all branches are done)
   JitBlock* b = js.curBlock;
@@ -593,6 +819,8 @@ void Jit64::JustWriteExit(u32 destination, bool bl, u32 after)
   {
     J_CC(CC_LE, asm_routines.do_timing);
 
+    if (gprs_intact)
+      linkData.boundEntryState = WriteBoundEntryMoves(destination);
     linkData.exitPtrs = GetWritableCodePtr();
     JMP(asm_routines.dispatcher_no_timing_check, Jump::Near);
   }
@@ -609,7 +837,7 @@ void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
 
   if (bl)
   {
-    MOV(64, R(RSCRATCH2), Imm64(u64(m_ppc_state.feature_flags) << 32 | after));
+    MOV(64, R(RSCRATCH2), Imm64(u64(js.featureFlags) << 32 | after));
     PUSH(RSCRATCH2);
   }
 
@@ -637,9 +865,9 @@ void Jit64::WriteBLRExit()
   bool disturbed = Cleanup();
   if (disturbed)
     MOV(32, R(RSCRATCH), PPCSTATE(pc));
-  if (m_ppc_state.feature_flags != 0)
+  if (js.featureFlags != 0)
   {
-    MOV(32, R(RSCRATCH2), Imm32(m_ppc_state.feature_flags));
+    MOV(32, R(RSCRATCH2), Imm32(js.featureFlags));
     SHL(64, R(RSCRATCH2), Imm8(32));
     OR(64, R(RSCRATCH), R(RSCRATCH2));
   }
@@ -748,11 +976,30 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
+  const bool warm_start = IsWarmStartEnabled();
+  if (warm_start)
+    PrecompileProfiledBlocks();
+
+  if (IsTieredCompilationEnabled())
+  {
+    RunTierZero(em_address);
+    return;
+  }
+
+  // If the block we are about to compile was just published, let the dispatcher run it instead.
+  if (warm_start && PublishTierUps() &&
+      blocks.GetBlockFromStartAddress(em_address, m_ppc_state.feature_flags))
+  {
+    return;
+  }
+
   Jit(em_address, true);
 }
 
 void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 {
+  std::lock_guard lk(m_compiler_mutex);
+
   CleanUpAfterStackFault();
 
   if (trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
@@ -760,10 +1007,13 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     if (!SConfig::GetInstance().bJITNoBlockCache)
     {
       WARN_LOG_FMT(DYNA_REC, "flushing trampoline code cache, please report if this happens a lot");
+      ++m_system.GetJitInterface().GetCodeSpaceCounters().flushes;
     }
     ClearCache();
   }
   FreeRanges();
+  if (m_evict_cold_blocks)
+    AgeBlocks();
 
   std::size_t block_size = m_code_buffer.size();
 
@@ -791,6 +1041,8 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     }
   }
 
+  SetSuperblockOption(em_address);
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
@@ -812,6 +1064,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     u8* near_start = GetWritableCodePtr();
     u8* far_start = m_far_code.GetWritableCodePtr();
 
+    SetCompileTimeState();
     JitBlock* b = blocks.AllocateBlock(em_address);
     if (DoJit(em_address, b, nextPC))
     {
@@ -833,20 +1086,37 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       b->far_end = far_end;
 
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block, m_code_buffer);
+      if (IsWarmStartEnabled())
+      {
+        m_block_profile.Record(em_address, js.featureFlags,
+                               std::span(m_code_buffer.data(), code_block.m_num_instructions));
+      }
 
 #ifdef JIT_LOG_GENERATED_CODE
       LogGeneratedCode();
 #endif
       return;
     }
+
+    // The block is already in the cache, so it has to be erased unless the whole cache is cleared.
+    // Its entry point gets overwritten when it's erased, which is only safe within free space.
+    b->normalEntry = near_start;
+    b->near_begin = b->near_end = nullptr;
+    b->far_begin = b->far_end = nullptr;
+    blocks.EraseSingleBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
-    WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
-    ClearCache();
+    // Make room by erasing the blocks that haven't run for the longest time, and only clear the
+    // entire JIT cache and retry once if that doesn't work.
+    if (EvictColdBlocks())
+    {
+      Jit(em_address, true);
+      return;
+    }
+    FlushCodeSpace();
     Jit(em_address, false);
     return;
   }
@@ -856,6 +1126,286 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   std::exit(-1);
 }
 
+void Jit64::RunTierZero(u32 em_address)
+{
+  CleanUpAfterStackFault();
+
+  const CPUEmuFeatureFlags feature_flags = m_ppc_state.feature_flags;
+
+  // If the block we are about to interpret was just published, let the dispatcher run it instead.
+  if (PublishTierUps() && blocks.GetBlockFromStartAddress(em_address, feature_flags))
+    return;
+
+  u32& heat = m_block_heat[u64{feature_flags} << 32 | em_address];
+  if (heat != TIER_UP_QUEUED && ++heat >= m_tier_up_threshold)
+  {
+    if (std::unique_ptr<TierUpJob> job = AnalyzeTierUp(em_address))
+    {
+      QueueTierUp(std::move(job));
+      heat = TIER_UP_QUEUED;
+    }
+    else
+    {
+      heat = 0;
+    }
+  }
+
+  m_ppc_state.downcount -= m_system.GetInterpreter().SingleStepBlock();
+
+  // The interpreter doesn't keep mem_ptr up to date when MSR.DR changes.
+  m_system.GetJitInterface().UpdateMembase();
+  ++m_system.GetJitInterface().GetTieredCompilationCounters().interpreted_blocks;
+}
+
+std::unique_ptr<Jit64::TierUpJob> Jit64::AnalyzeTierUp(u32 em_address)
+{
+  // Analysis goes through the MMU, so it has to happen on the CPU thread.
+  auto job = std::make_unique<TierUpJob>();
+  job->code_block.m_stats = &job->st;
+  job->code_block.m_gpa = &job->gpa;
+  job->code_block.m_fpa = &job->fpa;
+  SetSuperblockOption(em_address);
+  job->next_pc = analyzer.Analyze(em_address, &job->code_block, &m_tier_up_code_buffer,
+                                  m_tier_up_code_buffer.size());
+
+  // The interpreter raises the ISI when it tries to execute the block.
+  if (job->code_block.m_memory_exception)
+    return nullptr;
+
+  job->code_buffer.assign(m_tier_up_code_buffer.begin(),
+                          m_tier_up_code_buffer.begin() + job->code_block.m_num_instructions);
+  job->effective_address = em_address;
+  job->physical_address = m_mmu.JitCache_TranslateAddress(em_address).address;
+  job->feature_flags = m_ppc_state.feature_flags;
+  std::ranges::copy(m_ppc_state.gpr, job->gprs.begin());
+  for (size_t i = 0; i < job->gqrs.size(); ++i)
+    job->gqrs[i] = GQR(m_ppc_state, i);
+
+  // Rebuilding the DBAT table clears the block cache, which discards the jobs that were queued
+  // with the old copy.
+  if (!m_tier_up_dbat_table || m_tier_up_dbat_generation != m_mmu.GetDBATGeneration())
+  {
+    m_tier_up_dbat_table = std::make_shared<const PowerPC::BatTable>(m_mmu.GetDBATTable());
+    m_tier_up_dbat_generation = m_mmu.GetDBATGeneration();
+  }
+  job->dbat_table = m_tier_up_dbat_table;
+  job->access_state = m_mmu.GetOptimizableAccessState();
+  job->access_state.dbat_table = job->dbat_table.get();
+  return job;
+}
+
+void Jit64::FormSuperblock(Jit64& jit, u32 em_address)
+{
+  std::lock_guard lk(jit.m_compiler_mutex);
+
+  jit.js.superblockAddresses.insert(em_address);
+  ++jit.m_system.GetJitInterface().GetBlockEntryCounters().superblocks;
+
+  // The code of the block is still running, so its memory is only freed once the dispatcher has
+  // been reached, and the block gets recompiled the next time the dispatcher looks for it.
+  if (JitBlock* b = jit.blocks.GetBlockFromStartAddress(em_address, jit.m_ppc_state.feature_flags))
+    jit.blocks.EraseSingleBlock(*b);
+}
+
+void Jit64::SetSuperblockOption(u32 em_address)
+{
+  if (IsSuperblockEnabled() && js.superblockAddresses.contains(em_address))
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_SUPERBLOCK);
+  else
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_SUPERBLOCK);
+}
+
+void Jit64::QueueTierUp(std::unique_ptr<TierUpJob> job)
+{
+  job->queue_time = std::chrono::steady_clock::now();
+
+  {
+    std::lock_guard lk(m_compiler_mutex);
+    job->code_space_epoch = m_code_space_epoch;
+    job->invalidation_token = blocks.TrackInvalidations(job->code_block.m_physical_addresses);
+  }
+
+  m_tier_up_thread.Push(std::move(job));
+  ++m_system.GetJitInterface().GetTieredCompilationCounters().queued_blocks;
+}
+
+void Jit64::PrecompileProfiledBlocks()
+{
+  // The game ID isn't known yet when the JIT is initialized, and changes when the Wii Menu or the
+  // Homebrew Channel launch another title.
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id != m_block_profile_game_id)
+  {
+    m_block_profile_game_id = game_id;
+    m_block_profile.Close();
+    if (!game_id.empty())
+      m_block_profile.Open(JitBlockProfile::GetPath(game_id));
+    m_next_profiled_block = 0;
+  }
+
+  std::vector<JitBlockProfile::Block>& pending = m_block_profile.GetPendingBlocks();
+  for (u32 i = 0; i < PROFILED_BLOCKS_PER_CHECK && !pending.empty(); ++i)
+  {
+    if (m_next_profiled_block >= pending.size())
+      m_next_profiled_block = 0;
+
+    // Blocks stay pending until they can be analyzed with the address translation they were
+    // compiled with, and the game has loaded something at their address.
+    const JitBlockProfile::Block& block = pending[m_next_profiled_block];
+    bool done = false;
+    if (block.feature_flags == m_ppc_state.feature_flags)
+    {
+      const u64 key = u64{block.feature_flags} << 32 | block.effective_address;
+      const auto heat = m_block_heat.find(key);
+      if ((heat != m_block_heat.end() && heat->second == TIER_UP_QUEUED) ||
+          blocks.GetBlockFromStartAddress(block.effective_address, block.feature_flags))
+      {
+        done = true;
+      }
+      else if (const auto inst = m_mmu.TryReadInstruction(block.effective_address);
+               inst.valid && inst.hex == block.first_instruction)
+      {
+        // A block whose code has changed since it was recorded is dropped rather than checked
+        // again, since it would have to be analyzed every time.
+        done = true;
+        std::unique_ptr<TierUpJob> job = AnalyzeTierUp(block.effective_address);
+        if (job && JitBlockProfile::HashCode(job->code_buffer) == block.code_hash)
+        {
+          QueueTierUp(std::move(job));
+          m_block_heat[key] = TIER_UP_QUEUED;
+          ++m_system.GetJitInterface().GetTieredCompilationCounters().precompiled_blocks;
+        }
+      }
+    }
+
+    if (done)
+    {
+      pending[m_next_profiled_block] = pending.back();
+      pending.pop_back();
+    }
+    else
+    {
+      ++m_next_profiled_block;
+    }
+  }
+}
+
+void Jit64::CompileTierUp(std::unique_ptr<TierUpJob> job)
+{
+  std::lock_guard lk(m_compiler_mutex);
+
+  // The code space has been reset since the job was queued, so the job is stale. Clearing the
+  // cache has to be left to the CPU thread, since it may be executing code from the cache.
+  if (job->code_space_epoch == m_code_space_epoch && !trampolines.IsAlmostFull() &&
+      SetEmitterStateToFreeCodeRegion())
+  {
+    std::ranges::copy(job->code_buffer, m_code_buffer.begin());
+    code_block = job->code_block;
+    code_block.m_stats = &js.st;
+    code_block.m_gpa = &js.gpa;
+    code_block.m_fpa = &js.fpa;
+    js.st = job->st;
+    js.gpa = job->gpa;
+    js.fpa = job->fpa;
+    js.featureFlags = job->feature_flags;
+    js.compileTimeGPRs = job->gprs;
+    js.compileTimeGQRs = job->gqrs;
+    js.accessState = job->access_state;
+
+    u8* near_start = GetWritableCodePtr();
+    u8* far_start = m_far_code.GetWritableCodePtr();
+
+    job->block = blocks.AllocatePendingBlock(job->effective_address, job->physical_address,
+                                             job->feature_flags);
+    JitBlock& b = *job->block;
+    if (DoJit(job->effective_address, &b, job->next_pc))
+    {
+      u8* near_end = GetWritableCodePtr();
+      if (near_start != near_end)
+        m_free_ranges_near.erase(near_start, near_end);
+      u8* far_end = m_far_code.GetWritableCodePtr();
+      if (far_start != far_end)
+        m_free_ranges_far.erase(far_start, far_end);
+
+      b.near_begin = near_start;
+      b.near_end = near_end;
+      b.far_begin = far_start;
+      b.far_end = far_end;
+      job->compiled = true;
+    }
+  }
+
+  if (!job->compiled && job->code_space_epoch == m_code_space_epoch)
+    m_tier_up_needs_clear = true;
+
+  m_finished_tier_ups.push_back(std::move(job));
+}
+
+bool Jit64::PublishTierUps()
+{
+  // Don't wait for the tier-up thread. Whatever it is working on can be published next time.
+  std::unique_lock lk(m_compiler_mutex, std::try_to_lock);
+  if (!lk.owns_lock() || m_finished_tier_ups.empty())
+    return false;
+
+  auto& counters = m_system.GetJitInterface().GetTieredCompilationCounters();
+  const auto now = std::chrono::steady_clock::now();
+  bool published = false;
+  for (std::unique_ptr<TierUpJob>& job : m_finished_tier_ups)
+  {
+    const bool current = job->code_space_epoch == m_code_space_epoch;
+    const bool unmodified = blocks.StopTrackingInvalidations(job->invalidation_token,
+                                                             job->code_block.m_physical_addresses);
+    // The CPU thread may have compiled the same block itself in the meantime.
+    if (current && unmodified && job->compiled &&
+        !blocks.GetBlockFromStartAddress(job->effective_address, job->feature_flags))
+    {
+      JitBlock* b = blocks.AddPendingBlock(std::move(job->block));
+      blocks.FinalizeBlock(*b, jo.enableBlocklink, job->code_block, job->code_buffer);
+      if (IsWarmStartEnabled())
+        m_block_profile.Record(job->effective_address, job->feature_flags, job->code_buffer);
+      published = true;
+
+      const u64 latency_us =
+          std::chrono::duration_cast<std::chrono::microseconds>(now - job->queue_time).count();
+      ++counters.compiled_blocks;
+      counters.total_latency_us += latency_us;
+      if (latency_us > counters.max_latency_us)
+        counters.max_latency_us = latency_us;
+    }
+    else
+    {
+      // The code was modified while it was being compiled, or the block already exists. Its code
+      // space can be reused, unless the whole code space has been reset in the meantime.
+      if (current && job->compiled)
+      {
+        const JitBlock& b = *job->block;
+        if (b.near_begin != b.near_end)
+          m_free_ranges_near.insert(b.near_begin, b.near_end);
+        if (b.far_begin != b.far_end)
+          m_free_ranges_far.insert(b.far_begin, b.far_end);
+      }
+      ++counters.discarded_blocks;
+    }
+
+    // The block starts out cold again if it gets invalidated or was discarded.
+    if (current)
+      m_block_heat.erase(u64{job->feature_flags} << 32 | job->effective_address);
+  }
+  m_finished_tier_ups.clear();
+
+  // The stack has been reset by the dispatcher, so no code from the cache is running right now.
+  FreeRanges();
+  if (m_tier_up_needs_clear)
+  {
+    m_tier_up_needs_clear = false;
+    if (!EvictColdBlocks())
+      FlushCodeSpace();
+  }
+
+  return published;
+}
+
 bool Jit64::SetEmitterStateToFreeCodeRegion()
 {
   // Find the largest free memory blocks and set code emitters to point at them.
@@ -905,6 +1455,81 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     ABI_CallFunctionP(&JitBlock::ProfileData::BeginProfiling, b->profile_data.get());
 
+  // Load the first registers that the block reads, so that exits from other blocks which still
+  // have them in host registers can skip this.
+  std::array<preg_t, MAX_BOUND_ENTRY_GPRS> entry_gprs;
+  size_t num_entry_gprs = 0;
+  if (IsBoundEntryEnabled())
+  {
+    BitSet32 chosen;
+    for (u32 i = 0; i < code_block.m_num_instructions; i++)
+    {
+      for (int reg : m_code_buffer[i].regsIn & code_block.m_gpr_inputs & ~chosen)
+      {
+        if (num_entry_gprs < entry_gprs.size())
+          entry_gprs[num_entry_gprs++] = reg;
+        chosen[reg] = true;
+      }
+    }
+
+    u64 state = num_entry_gprs;
+    for (size_t i = 0; i < num_entry_gprs; i++)
+    {
+      MOV(32, R(gpr.GetEntryRegister(i)), PPCSTATE_GPR(entry_gprs[i]));
+      state |= u64{entry_gprs[i]} << (3 + 5 * i);
+    }
+    if (num_entry_gprs != 0)
+    {
+      b->boundEntry = GetWritableCodePtr();
+      b->boundEntryState = state;
+    }
+  }
+
+  if (m_evict_cold_blocks)
+  {
+    MOV(64, R(RSCRATCH), ImmPtr(&b->recently_run));
+    MOV(8, MatR(RSCRATCH), Imm8(1));
+  }
+
+  // The register cache only knows how many loads and stores it emitted once the block is done,
+  // so their counts are written into these immediates at the end.
+  u8* register_loads_imm = nullptr;
+  u8* register_stores_imm = nullptr;
+  if (IsSuperblockEnabled())
+  {
+    auto& counters = m_system.GetJitInterface().GetBlockEntryCounters();
+    MOV(64, R(RSCRATCH),
+        ImmPtr(code_block.m_superblock ? &counters.superblock_entries : &counters.block_entries));
+    ADD(64, MatR(RSCRATCH), Imm8(1));
+    MOV(64, R(RSCRATCH), ImmPtr(&counters.guest_instructions));
+    ADD(64, MatR(RSCRATCH), Imm32(code_block.m_num_instructions));
+    MOV(32, R(RSCRATCH2), Imm32(0));
+    register_loads_imm = GetWritableCodePtr() - sizeof(u32);
+    MOV(64, R(RSCRATCH), ImmPtr(&counters.register_loads));
+    ADD(64, MatR(RSCRATCH), R(RSCRATCH2));
+    MOV(32, R(RSCRATCH2), Imm32(0));
+    register_stores_imm = GetWritableCodePtr() - sizeof(u32);
+    MOV(64, R(RSCRATCH), ImmPtr(&counters.register_stores));
+    ADD(64, MatR(RSCRATCH), R(RSCRATCH2));
+
+    if (!code_block.m_superblock && m_superblock_threshold != 0)
+    {
+      b->superblock_countdown = m_superblock_threshold;
+      MOV(64, R(RSCRATCH), ImmPtr(&b->superblock_countdown));
+      SUB(32, MatR(RSCRATCH), Imm8(1));
+      FixupBranch hot = J_CC(CC_Z, Jump::Near);
+
+      SwitchToFarCode();
+      SetJumpTarget(hot);
+      MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+      ABI_PushRegistersAndAdjustStack({}, 0);
+      ABI_CallFunctionPC(FormSuperblock, this, js.blockStart);
+      ABI_PopRegistersAndAdjustStack({}, 0);
+      JMP(asm_routines.dispatcher_no_check, Jump::Near);
+      SwitchToNearCode();
+    }
+  }
+
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -914,6 +1539,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   // They use the information in gpa/fpa to preload commonly used registers.
   gpr.Start();
   fpr.Start();
+  gpr.SetEntryRegisters(std::span(entry_gprs.data(), num_entry_gprs));
 
   js.downcountAmount = 0;
   js.skipInstructions = 0;
@@ -943,7 +1569,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
       // the start of the block in case our guess turns out wrong.
       for (int gqr : gqr_static)
       {
-        u32 value = GQR(m_ppc_state, gqr);
+        u32 value = js.compileTimeGQRs[gqr];
         js.constantGqr[gqr] = value;
         CMP_or_TEST(32, PPCSTATE_SPR(SPR_GQR0 + gqr), Imm32(value));
         J_CC(CC_NZ, target);
@@ -1208,11 +1834,21 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     return false;
   }
 
+  if (register_loads_imm)
+  {
+    // The loads of the entry registers come before the register cache is started.
+    const u32 register_loads = static_cast<u32>(num_entry_gprs) + gpr.GetNumLoads();
+    const u32 register_stores = gpr.GetNumStores();
+    std::memcpy(register_loads_imm, &register_loads, sizeof(u32));
+    std::memcpy(register_stores_imm, &register_stores, sizeof(u32));
+  }
+
   return true;
 }
 
 void Jit64::EraseSingleBlock(const JitBlock& block)
 {
+  std::lock_guard lk(m_compiler_mutex);
   blocks.EraseSingleBlock(block);
   FreeRanges();
 }
@@ -1270,9 +1906,10 @@ void Jit64::IntializeSpeculativeConstants()
   const u8* target = nullptr;
   for (auto i : code_block.m_gpr_inputs)
   {
-    u32 compileTimeValue = m_ppc_state.gpr[i];
-    if (m_mmu.IsOptimizableGatherPipeWrite(compileTimeValue) ||
-        m_mmu.IsOptimizableGatherPipeWrite(compileTimeValue - 0x8000) ||
+    u32 compileTimeValue = js.compileTimeGPRs[i];
+    const bool dr = (js.featureFlags & FEATURE_FLAG_MSR_DR) != 0;
+    if (m_mmu.IsOptimizableGatherPipeWrite(compileTimeValue, dr, js.accessState) ||
+        m_mmu.IsOptimizableGatherPipeWrite(compileTimeValue - 0x8000, dr, js.accessState) ||
         compileTimeValue == 0xCC000000)
     {
       if (!target)
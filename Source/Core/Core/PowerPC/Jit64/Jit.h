@@ -17,11 +17,18 @@
 // ----------
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <rangeset/rangesizeset.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "Common/x64ABI.h"
 #include "Common/x64Emitter.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
@@ -32,6 +39,7 @@
 #include "Core/PowerPC/Jit64Common/Jit64AsmCommon.h"
 #include "Core/PowerPC/Jit64Common/TrampolineCache.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitBlockProfile.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
 
 class HostDisassembler;
@@ -66,6 +74,24 @@ public:
   void Jit(u32 em_address, bool clear_cache_and_retry_on_failure);
   bool DoJit(u32 em_address, JitBlock* b, u32 nextPC);
 
+  // When enabled, blocks that aren't compiled yet are interpreted until they have run often enough
+  // to be worth compiling, and are then compiled on a background thread.
+  bool IsTieredCompilationEnabled() const;
+  // Whether tiered compilation was configured when the JIT was initialized. Unlike
+  // IsTieredCompilationEnabled, this doesn't change while the JIT is running.
+  bool IsTieredCompilationConfigured() const { return m_tiered_compilation; }
+  // When enabled, the blocks compiled in earlier sessions of the same game are compiled on a
+  // background thread as soon as their code is in memory.
+  bool IsWarmStartEnabled() const;
+  // When enabled, blocks that run often are recompiled with PPCAnalyst::OPTION_SUPERBLOCK.
+  bool IsSuperblockEnabled() const;
+  // When enabled, blocks load the first few registers they read at their entry point, and exits
+  // that link to a block skip these loads if the values are still in host registers.
+  bool IsBoundEntryEnabled() const;
+  // When enabled, data accesses that can't use fastmem look up the page in the software TLB inline
+  // and only call into the MMU when it misses.
+  bool UseSoftwareTLB() const;
+
   void EraseSingleBlock(const JitBlock& block) override;
   std::vector<MemoryStats> GetMemoryStats() const override;
 
@@ -98,7 +124,9 @@ public:
   void MSRUpdated(const Gen::OpArg& msr, Gen::X64Reg scratch_reg);
   void FakeBLCall(u32 after);
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
-  void JustWriteExit(u32 destination, bool bl, u32 after);
+  // gprs_intact means that the host registers still hold the values that the last GPR flush wrote
+  // back, which lets the exit enter the destination block at its boundEntry.
+  void JustWriteExit(u32 destination, bool bl, u32 after, bool gprs_intact = false);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
   void WriteBLRExit();
   void WriteExceptionExit();
@@ -269,12 +297,69 @@ public:
   void eieio(UGeckoInstruction inst);
 
 private:
+  // A block that is compiled on the tier-up thread. Everything that depends on the state of the
+  // emulated CPU is captured on the CPU thread when the job is queued.
+  struct TierUpJob
+  {
+    u32 effective_address = 0;
+    u32 physical_address = 0;
+    u32 next_pc = 0;
+    CPUEmuFeatureFlags feature_flags{};
+    std::array<u32, 32> gprs{};
+    std::array<u32, 8> gqrs{};
+    PowerPC::MMU::OptimizableAccessState access_state;
+    // Keeps access_state.dbat_table alive while the job is queued.
+    std::shared_ptr<const PowerPC::BatTable> dbat_table;
+    PPCAnalyst::CodeBlock code_block;
+    PPCAnalyst::CodeBuffer code_buffer;
+    PPCAnalyst::BlockStats st{};
+    PPCAnalyst::BlockRegStats gpa{};
+    PPCAnalyst::BlockRegStats fpa{};
+    u64 code_space_epoch = 0;
+    u64 invalidation_token = 0;
+    std::chrono::steady_clock::time_point queue_time;
+
+    JitBaseBlockCache::PendingBlock block;
+    bool compiled = false;
+  };
+
+  // Marks a block in m_block_heat that has been handed to the tier-up thread.
+  static constexpr u32 TIER_UP_QUEUED = 0xFFFFFFFF;
+
+  // Checks this many blocks from the profile every time the dispatcher doesn't find a block.
+  static constexpr u32 PROFILED_BLOCKS_PER_CHECK = 32;
+
+  // Called by a block that has run often enough to be recompiled as a superblock.
+  static void FormSuperblock(Jit64& jit, u32 em_address);
+  void SetSuperblockOption(u32 em_address);
+
+  static constexpr size_t MAX_BOUND_ENTRY_GPRS = 6;
+
+  bool AreFlushedGPRsIntact() const;
+  // Moves the registers that the destination block loads at its entry point into place, and
+  // returns the boundEntryState to link with, or 0 if the destination isn't known.
+  u64 WriteBoundEntryMoves(u32 destination);
+
+  void RunTierZero(u32 em_address);
+  std::unique_ptr<TierUpJob> AnalyzeTierUp(u32 em_address);
+  void QueueTierUp(std::unique_ptr<TierUpJob> job);
+  void PrecompileProfiledBlocks();
+  void CompileTierUp(std::unique_ptr<TierUpJob> job);
+  bool PublishTierUps();
+
   void CompileInstruction(PPCAnalyst::CodeOp& op);
 
   bool HandleFunctionHooking(u32 address);
 
   void FreeRanges();
   void ResetFreeMemoryRanges();
+  // Starts a new epoch for JitBlock::last_run_epoch if the current one has lasted long enough.
+  void AgeBlocks();
+  // Erases the blocks that have gone the longest without running, until a quarter of the near
+  // and far code regions is free. Returns false if nothing was erased.
+  bool EvictColdBlocks();
+  // Clears the whole cache because the code space ran out.
+  void FlushCodeSpace();
 
   void LogGeneratedCode() const;
 
@@ -295,4 +380,33 @@ private:
   const bool m_im_here_log = false;
   std::map<u32, int> m_been_here;
   std::unique_ptr<HostDisassembler> m_disassembler;
+
+  bool m_tiered_compilation = false;
+  u32 m_tier_up_threshold = 0;
+  bool m_warm_start = false;
+  JitBlockProfile m_block_profile;
+  std::string m_block_profile_game_id;
+  std::size_t m_next_profiled_block = 0;
+  bool m_superblocks = false;
+  u32 m_superblock_threshold = 0;
+  bool m_bound_entries = false;
+  bool m_evict_cold_blocks = false;
+  bool m_software_tlb = false;
+  u32 m_block_run_epoch = 0;
+  std::chrono::steady_clock::time_point m_block_run_epoch_start;
+  // Incremented whenever the code space is reset, which invalidates all jobs queued before.
+  u64 m_code_space_epoch = 0;
+  // Set by the tier-up thread when it ran out of code space. Only the CPU thread may clear it.
+  bool m_tier_up_needs_clear = false;
+  // Number of times each block has been interpreted, keyed by feature flags and address.
+  std::unordered_map<u64, u32> m_block_heat;
+  // Scratch space for analyzing blocks on the CPU thread.
+  PPCAnalyst::CodeBuffer m_tier_up_code_buffer;
+  // A copy of the DBAT table for the tier-up thread, which can't read the live one. It is shared
+  // by all jobs until the MMU rebuilds the table.
+  std::shared_ptr<const PowerPC::BatTable> m_tier_up_dbat_table;
+  u32 m_tier_up_dbat_generation = 0;
+  std::vector<std::unique_ptr<TierUpJob>> m_finished_tier_ups;
+  // Declared last so that the thread is stopped before anything it uses is destroyed.
+  Common::WorkQueueThreadSP<std::unique_ptr<TierUpJob>> m_tier_up_thread;
 };
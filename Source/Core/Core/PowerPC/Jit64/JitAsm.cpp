@@ -218,9 +218,22 @@ void Jit64AsmRoutineManager::Generate()
   // If jitting triggered an ISI exception, MSR.DR may have changed
   MOV(64, R(RMEM), PPCSTATE(mem_ptr));
 
+  // With tiered compilation the block may have been interpreted instead, which takes cycles.
+  // Whether tiering is active can change without the routines being regenerated, so this only
+  // depends on whether it is configured.
+  const bool tiered_compilation = m_jit.IsTieredCompilationConfigured();
+  FixupBranch interpreted_bail;
+  if (tiered_compilation)
+  {
+    CMP(32, PPCSTATE(downcount), Imm8(0));
+    interpreted_bail = J_CC(CC_LE, Jump::Near);
+  }
+
   JMP(dispatcher_no_check, Jump::Near);
 
   SetJumpTarget(bail);
+  if (tiered_compilation)
+    SetJumpTarget(interpreted_bail);
   do_timing = GetCodePtr();
 
   // make sure npc contains the next pc (needed for exception checking in CoreTiming::Advance)
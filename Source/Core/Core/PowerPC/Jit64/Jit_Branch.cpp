@@ -85,10 +85,11 @@ void Jit64::WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction inst
     MOV(64, R(ABI_PARAM1), R(reg_a));
   MOV(64, R(ABI_PARAM2), Imm64(Core::FakeBranchWatchCollectionKey{origin, destination}));
   MOV(32, R(ABI_PARAM3), Imm32(inst.hex));
-  ABI_CallFunction(m_ppc_state.msr.IR ? (condition ? &Core::BranchWatch::HitVirtualTrue_fk :
-                                                     &Core::BranchWatch::HitVirtualFalse_fk) :
-                                        (condition ? &Core::BranchWatch::HitPhysicalTrue_fk :
-                                                     &Core::BranchWatch::HitPhysicalFalse_fk));
+  const bool ir = (js.featureFlags & FEATURE_FLAG_MSR_IR) != 0;
+  ABI_CallFunction(ir ? (condition ? &Core::BranchWatch::HitVirtualTrue_fk :
+                                     &Core::BranchWatch::HitVirtualFalse_fk) :
+                        (condition ? &Core::BranchWatch::HitPhysicalTrue_fk :
+                                     &Core::BranchWatch::HitPhysicalFalse_fk));
   ABI_PopRegistersAndAdjustStack(caller_save, 0);
 
   FixupBranch branch_out = J(Jump::Near);
@@ -120,8 +121,8 @@ void Jit64::WriteBranchWatchDestInRSCRATCH(u32 origin, UGeckoInstruction inst, X
   MOV(32, R(ABI_PARAM3), R(RSCRATCH));
   MOV(32, R(ABI_PARAM2), Imm32(origin));
   MOV(32, R(ABI_PARAM4), Imm32(inst.hex));
-  ABI_CallFunction(m_ppc_state.msr.IR ? &Core::BranchWatch::HitVirtualTrue :
-                                        &Core::BranchWatch::HitPhysicalTrue);
+  ABI_CallFunction((js.featureFlags & FEATURE_FLAG_MSR_IR) ? &Core::BranchWatch::HitVirtualTrue :
+                                                              &Core::BranchWatch::HitPhysicalTrue);
   ABI_PopRegistersAndAdjustStack(caller_save, 0);
 
   FixupBranch branch_out = J(Jump::Near);
@@ -286,6 +286,11 @@ void RegCache::Start()
   {
     m_regs[i] = PPCCachedReg{GetDefaultLocation(i)};
   }
+  m_flushed_locations.fill(std::nullopt);
+  m_flush_begin = nullptr;
+  m_flush_end = nullptr;
+  m_num_loads = 0;
+  m_num_stores = 0;
 }
 
 void RegCache::SetEmitter(XEmitter* emitter)
@@ -394,6 +399,14 @@ void RegCache::Flush(BitSet32 pregs, IgnoreDiscardedRegisters ignore_discarded_r
   ASSERT_MSG(DYNA_REC, std::ranges::none_of(m_xregs, &X64CachedReg::IsLocked),
              "Someone forgot to unlock a X64 reg");
 
+  // Consecutive flushes without any code in between count as one.
+  const u8* flush_begin = m_emitter->GetCodePtr();
+  if (flush_begin != m_flush_end)
+  {
+    m_flushed_locations.fill(std::nullopt);
+    m_flush_begin = flush_begin;
+  }
+
   for (preg_t i : pregs)
   {
     ASSERT_MSG(DYNA_REC, !m_regs[i].IsLocked(), "Someone forgot to unlock PPC reg {} (X64 reg {}).",
@@ -401,6 +414,13 @@ void RegCache::Flush(BitSet32 pregs, IgnoreDiscardedRegisters ignore_discarded_r
     ASSERT_MSG(DYNA_REC, !m_regs[i].IsRevertable(), "Register transaction is in progress for {}!",
                i);
 
+    // Host registers keep their contents after being written back, and immediates are still known.
+    if (m_regs[i].GetLocationType() != PPCCachedReg::LocationType::Default &&
+        m_regs[i].GetLocationType() != PPCCachedReg::LocationType::Discarded)
+    {
+      m_flushed_locations[i] = m_regs[i].Location();
+    }
+
     switch (m_regs[i].GetLocationType())
     {
     case PPCCachedReg::LocationType::Default:
@@ -421,6 +441,8 @@ void RegCache::Flush(BitSet32 pregs, IgnoreDiscardedRegisters ignore_discarded_r
       break;
     }
   }
+
+  m_flush_end = m_emitter->GetCodePtr();
 }
 
 void RegCache::Reset(BitSet32 pregs)
@@ -470,6 +492,19 @@ void RegCache::PreloadRegisters(BitSet32 to_preload)
   }
 }
 
+void RegCache::SetEntryRegisters(std::span<const preg_t> pregs)
+{
+  const auto order = GetAllocationOrder();
+  ASSERT(pregs.size() <= order.size());
+  for (size_t i = 0; i < pregs.size(); i++)
+  {
+    ASSERT_MSG(DYNA_REC, m_xregs[order[i]].IsFree(), "Entry register {} is already in use",
+               Common::ToUnderlying(order[i]));
+    m_xregs[order[i]].SetBoundTo(pregs[i], false);
+    m_regs[pregs[i]].SetBoundTo(order[i]);
+  }
+}
+
 BitSet32 RegCache::RegistersInUse() const
 {
   BitSet32 result;
@@ -517,6 +552,8 @@ void RegCache::BindToRegister(preg_t i, bool doLoad, bool makeDirty)
     if (doLoad)
     {
       ASSERT_MSG(DYNA_REC, !m_regs[i].IsDiscarded(), "Attempted to load a discarded value");
+      if (m_regs[i].GetLocationType() == PPCCachedReg::LocationType::Default)
+        ++m_num_loads;
       LoadRegister(i, xr);
     }
 
@@ -567,7 +604,10 @@ void RegCache::StoreFromRegister(preg_t i, FlushMode mode)
   }
 
   if (doStore)
+  {
     StoreRegister(i, GetDefaultLocation(i));
+    ++m_num_stores;
+  }
   if (mode == FlushMode::Full)
     m_regs[i].SetFlushed();
 }
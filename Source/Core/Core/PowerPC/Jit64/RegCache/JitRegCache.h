@@ -5,6 +5,7 @@
 
 #include <array>
 #include <cstddef>
+#include <optional>
 #include <span>
 #include <type_traits>
 #include <variant>
@@ -185,6 +186,25 @@ public:
   void PreloadRegisters(BitSet32 pregs);
   BitSet32 RegistersInUse() const;
 
+  // Marks the given registers as loaded into the first host registers of the allocation order,
+  // for blocks whose entry point loads them there before starting the register cache.
+  void SetEntryRegisters(std::span<const preg_t> pregs);
+  Gen::X64Reg GetEntryRegister(size_t index) const { return GetAllocationOrder()[index]; }
+
+  // Where the value of a register that was written back by the last Flush can still be found,
+  // other than its default location. Only meaningful as long as no code has been emitted between
+  // GetFlushEnd() and the current position of the emitter.
+  const std::optional<Gen::OpArg>& GetFlushedLocation(preg_t preg) const
+  {
+    return m_flushed_locations[preg];
+  }
+  const u8* GetFlushBegin() const { return m_flush_begin; }
+  const u8* GetFlushEnd() const { return m_flush_end; }
+
+  // How many loads from and stores to the default locations have been emitted since Start().
+  u32 GetNumLoads() const { return m_num_loads; }
+  u32 GetNumStores() const { return m_num_stores; }
+
 protected:
   friend class RCOpArg;
   friend class RCX64Reg;
@@ -226,4 +246,9 @@ protected:
   std::array<X64CachedReg, NUM_XREGS> m_xregs;
   std::array<RCConstraint, 32> m_constraints;
   Gen::XEmitter* m_emitter = nullptr;
+  std::array<std::optional<Gen::OpArg>, 32> m_flushed_locations;
+  const u8* m_flush_begin = nullptr;
+  const u8* m_flush_end = nullptr;
+  u32 m_num_loads = 0;
+  u32 m_num_stores = 0;
 };
@@ -14,7 +14,11 @@ JitBlockCache::JitBlockCache(JitBase& jit) : JitBaseBlockCache{jit}
 void JitBlockCache::WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest)
 {
   u8* location = source.exitPtrs;
-  const u8* address = dest ? dest->normalEntry : m_jit.GetAsmRoutines()->dispatcher_no_timing_check;
+  const u8* address = m_jit.GetAsmRoutines()->dispatcher_no_timing_check;
+  if (dest && source.boundEntryState != 0 && source.boundEntryState == dest->boundEntryState)
+    address = dest->boundEntry;
+  else if (dest)
+    address = dest->normalEntry;
   if (source.call)
   {
     Gen::XEmitter emit(location, location + 5);
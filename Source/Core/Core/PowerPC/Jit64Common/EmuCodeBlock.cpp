@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/Jit64Common/EmuCodeBlock.h"
 
+#include <array>
 #include <functional>
 #include <limits>
 
@@ -17,6 +18,7 @@
 #include "Core/PowerPC/Jit64/Jit.h"
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -131,8 +133,108 @@ FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_
   return J_CC(CC_Z, m_far_code.Enabled() ? Jump::Near : Jump::Short);
 }
 
+EmuCodeBlock::SoftwareTLBLookup
+EmuCodeBlock::BeginSoftwareTLBLookup(const OpArg& reg_value, X64Reg reg_addr, int accessSize,
+                                     bool write, BitSet32 registers_in_use)
+{
+  BitSet32 reserved;
+  reserved[reg_addr] = true;
+  if (reg_value.IsSimpleReg())
+    reserved[reg_value.GetSimpleReg()] = true;
+
+  // Prefer registers that don't have to be saved.
+  std::array<X64Reg, 2> temps;
+  size_t num_temps = 0;
+  for (const bool in_use : {false, true})
+  {
+    for (const X64Reg reg : {RSCRATCH, RSCRATCH_EXTRA, RSCRATCH2, R8})
+    {
+      if (num_temps < temps.size() && !reserved[reg] && registers_in_use[reg] == in_use)
+      {
+        temps[num_temps++] = reg;
+        reserved[reg] = true;
+      }
+    }
+  }
+
+  SoftwareTLBLookup lookup;
+  lookup.host = temps[0];
+  lookup.temp = temps[1];
+  lookup.write = write;
+  for (const X64Reg reg : temps)
+  {
+    if (registers_in_use[reg])
+    {
+      PUSH(reg);
+      lookup.pushed[reg] = true;
+    }
+  }
+
+  // The tag is the page of the last byte, so that accesses which cross a page always miss.
+  const X64Reg index = lookup.host;
+  const X64Reg tag = lookup.temp;
+  MOV(32, R(index), R(reg_addr));
+  if (accessSize == 8)
+    MOV(32, R(tag), R(reg_addr));
+  else
+    LEA(32, tag, MDisp(reg_addr, accessSize / 8 - 1));
+  SHR(32, R(index), Imm8(PowerPC::HW_PAGE_INDEX_SHIFT));
+  AND(32, R(tag), Imm32(static_cast<u32>(~PowerPC::HW_PAGE_MASK)));
+  AND(32, R(index), Imm32(PowerPC::SoftwareTLB::NUM_ENTRIES - 1));
+
+  if (write)
+  {
+    CMP(32, R(tag), MComplex(RPPCSTATE, index, SCALE_4, PPCSTATE_OFF(software_tlb.write.tags)));
+    lookup.miss = J_CC(CC_NE, Jump::Near);
+    MOV(64, R(lookup.host),
+        MComplex(RPPCSTATE, index, SCALE_8, PPCSTATE_OFF(software_tlb.write.host_offsets)));
+  }
+  else
+  {
+    CMP(32, R(tag), MComplex(RPPCSTATE, index, SCALE_4, PPCSTATE_OFF(software_tlb.read.tags)));
+    lookup.miss = J_CC(CC_NE, Jump::Near);
+    MOV(64, R(lookup.host),
+        MComplex(RPPCSTATE, index, SCALE_8, PPCSTATE_OFF(software_tlb.read.host_offsets)));
+  }
+
+  return lookup;
+}
+
+void EmuCodeBlock::EndSoftwareTLBLookup(const SoftwareTLBLookup& lookup, bool hit)
+{
+  if (m_jit.IsProfilingEnabled())
+  {
+    auto& counters = m_jit.m_system.GetJitInterface().GetSoftwareTLBCounters();
+    u64* counter;
+    if (lookup.write)
+      counter = hit ? &counters.write_hits : &counters.write_misses;
+    else
+      counter = hit ? &counters.read_hits : &counters.read_misses;
+    MOV(64, R(lookup.temp), ImmPtr(counter));
+    ADD(64, MatR(lookup.temp), Imm8(1));
+  }
+
+  if (lookup.pushed[lookup.temp])
+    POP(lookup.temp);
+  if (lookup.pushed[lookup.host])
+    POP(lookup.host);
+}
+
 void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int accessSize, s32 offset,
                                        bool swap, MovInfo* info)
+{
+  UnsafeWriteRegToMem(reg_value, MComplex(RMEM, reg_addr, SCALE_1, offset), accessSize, swap,
+                      info);
+}
+
+void EmuCodeBlock::UnsafeWriteRegToReg(Gen::X64Reg reg_value, Gen::X64Reg reg_addr, int accessSize,
+                                       s32 offset, bool swap, Gen::MovInfo* info)
+{
+  UnsafeWriteRegToReg(R(reg_value), reg_addr, accessSize, offset, swap, info);
+}
+
+void EmuCodeBlock::UnsafeWriteRegToMem(OpArg reg_value, const OpArg& dest, int accessSize,
+                                       bool swap, MovInfo* info)
 {
   if (info)
   {
@@ -140,7 +242,6 @@ void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acc
     info->nonAtomicSwapStore = false;
   }
 
-  OpArg dest = MComplex(RMEM, reg_addr, SCALE_1, offset);
   if (reg_value.IsImm())
   {
     if (swap)
@@ -157,12 +258,6 @@ void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acc
   }
 }
 
-void EmuCodeBlock::UnsafeWriteRegToReg(Gen::X64Reg reg_value, Gen::X64Reg reg_addr, int accessSize,
-                                       s32 offset, bool swap, Gen::MovInfo* info)
-{
-  UnsafeWriteRegToReg(R(reg_value), reg_addr, accessSize, offset, swap, info);
-}
-
 bool EmuCodeBlock::UnsafeLoadToReg(X64Reg reg_value, OpArg opAddress, int accessSize, s32 offset,
                                    bool signExtend, MovInfo* info)
 {
@@ -372,10 +467,25 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
 
   FixupBranch exit;
   const bool dr_set =
-      (flags & SAFE_LOADSTORE_DR_ON) || (m_jit.m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR);
-  const bool fast_check_address =
-      !force_slow_access && dr_set && m_jit.jo.fastmem_arena && !m_jit.m_ppc_state.m_enable_dcache;
-  if (fast_check_address)
+      (flags & SAFE_LOADSTORE_DR_ON) || (m_jit.js.featureFlags & FEATURE_FLAG_MSR_DR);
+  const bool use_software_tlb = !force_slow_access && dr_set && m_jit.UseSoftwareTLB();
+  const bool fast_check_address = !force_slow_access && !use_software_tlb && dr_set &&
+                                  m_jit.jo.fastmem_arena && !m_jit.js.accessState.dcache_enabled;
+  const bool has_fast_path = use_software_tlb || fast_check_address;
+  if (use_software_tlb)
+  {
+    const SoftwareTLBLookup lookup =
+        BeginSoftwareTLBLookup(R(reg_value), reg_addr, accessSize, false, registersInUse);
+    LoadAndSwap(accessSize, reg_value, MComplex(lookup.host, reg_addr, SCALE_1, 0), signExtend);
+    EndSoftwareTLBLookup(lookup, true);
+    if (m_far_code.Enabled())
+      SwitchToFarCode();
+    else
+      exit = J(Jump::Near);
+    SetJumpTarget(lookup.miss);
+    EndSoftwareTLBLookup(lookup, false);
+  }
+  else if (fast_check_address)
   {
     FixupBranch slow = CheckIfSafeAddress(R(reg_value), reg_addr, registersInUse);
     UnsafeLoadToReg(reg_value, R(reg_addr), accessSize, 0, signExtend);
@@ -426,7 +536,7 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     MOVZX(64, accessSize, reg_value, R(ABI_RETURN));
   }
 
-  if (fast_check_address)
+  if (has_fast_path)
   {
     if (m_far_code.Enabled())
     {
@@ -440,15 +550,19 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
 void EmuCodeBlock::SafeLoadToRegImmediate(X64Reg reg_value, u32 address, int accessSize,
                                           BitSet32 registersInUse, bool signExtend)
 {
+  const bool dr = (m_jit.js.featureFlags & FEATURE_FLAG_MSR_DR) != 0;
+
   // If the address is known to be RAM, just load it directly.
-  if (m_jit.jo.fastmem_arena && m_jit.m_mmu.IsOptimizableRAMAddress(address, accessSize))
+  if (m_jit.jo.fastmem_arena &&
+      m_jit.m_mmu.IsOptimizableRAMAddress(address, accessSize, dr, m_jit.js.accessState))
   {
     UnsafeLoadToReg(reg_value, Imm32(address), accessSize, 0, signExtend);
     return;
   }
 
   // If the address maps to an MMIO register, inline MMIO read code.
-  u32 mmioAddress = m_jit.m_mmu.IsOptimizableMMIOAccess(address, accessSize);
+  u32 mmioAddress =
+      m_jit.m_mmu.IsOptimizableMMIOAccess(address, accessSize, dr, m_jit.js.accessState);
   if (accessSize != 64 && mmioAddress)
   {
     auto& memory = m_jit.m_system.GetMemory();
@@ -546,10 +660,25 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   FixupBranch exit;
   const bool dr_set =
-      (flags & SAFE_LOADSTORE_DR_ON) || (m_jit.m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR);
-  const bool fast_check_address =
-      !force_slow_access && dr_set && m_jit.jo.fastmem_arena && !m_jit.m_ppc_state.m_enable_dcache;
-  if (fast_check_address)
+      (flags & SAFE_LOADSTORE_DR_ON) || (m_jit.js.featureFlags & FEATURE_FLAG_MSR_DR);
+  const bool use_software_tlb = !force_slow_access && dr_set && m_jit.UseSoftwareTLB();
+  const bool fast_check_address = !force_slow_access && !use_software_tlb && dr_set &&
+                                  m_jit.jo.fastmem_arena && !m_jit.js.accessState.dcache_enabled;
+  const bool has_fast_path = use_software_tlb || fast_check_address;
+  if (use_software_tlb)
+  {
+    const SoftwareTLBLookup lookup =
+        BeginSoftwareTLBLookup(reg_value, reg_addr, accessSize, true, registersInUse);
+    UnsafeWriteRegToMem(reg_value, MComplex(lookup.host, reg_addr, SCALE_1, 0), accessSize, swap);
+    EndSoftwareTLBLookup(lookup, true);
+    if (m_far_code.Enabled())
+      SwitchToFarCode();
+    else
+      exit = J(Jump::Near);
+    SetJumpTarget(lookup.miss);
+    EndSoftwareTLBLookup(lookup, false);
+  }
+  else if (fast_check_address)
   {
     FixupBranch slow = CheckIfSafeAddress(reg_value, reg_addr, registersInUse);
     UnsafeWriteRegToReg(reg_value, reg_addr, accessSize, 0, swap);
@@ -607,7 +736,7 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   MemoryExceptionCheck();
 
-  if (fast_check_address)
+  if (has_fast_path)
   {
     if (m_far_code.Enabled())
     {
@@ -634,9 +763,12 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
 {
   arg = FixImmediate(accessSize, arg);
 
+  const bool dr = (m_jit.js.featureFlags & FEATURE_FLAG_MSR_DR) != 0;
+
   // If we already know the address through constant folding, we can do some
   // fun tricks...
-  if (m_jit.jo.optimizeGatherPipe && m_jit.m_mmu.IsOptimizableGatherPipeWrite(address))
+  if (m_jit.jo.optimizeGatherPipe &&
+      m_jit.m_mmu.IsOptimizableGatherPipeWrite(address, dr, m_jit.js.accessState))
   {
     X64Reg arg_reg = RSCRATCH;
 
@@ -656,7 +788,8 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     m_jit.js.fifoBytesSinceCheck += accessSize >> 3;
     return false;
   }
-  else if (m_jit.jo.fastmem_arena && m_jit.m_mmu.IsOptimizableRAMAddress(address, accessSize))
+  else if (m_jit.jo.fastmem_arena &&
+           m_jit.m_mmu.IsOptimizableRAMAddress(address, accessSize, dr, m_jit.js.accessState))
   {
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
@@ -55,11 +55,31 @@ public:
 
   Gen::FixupBranch CheckIfSafeAddress(const Gen::OpArg& reg_value, Gen::X64Reg reg_addr,
                                       BitSet32 registers_in_use);
+
+  struct SoftwareTLBLookup
+  {
+    // Holds the offset from the guest address to the host address on a hit.
+    Gen::X64Reg host;
+    Gen::X64Reg temp;
+    BitSet32 pushed;
+    bool write;
+    Gen::FixupBranch miss;
+  };
+
+  // Looks up the page of an access in the software TLB. On a hit, the access can be made to
+  // MComplex(lookup.host, reg_addr, SCALE_1, 0). Otherwise, this jumps to lookup.miss. Both paths
+  // have to end with EndSoftwareTLBLookup, which restores the registers that were used.
+  SoftwareTLBLookup BeginSoftwareTLBLookup(const Gen::OpArg& reg_value, Gen::X64Reg reg_addr,
+                                           int accessSize, bool write, BitSet32 registers_in_use);
+  void EndSoftwareTLBLookup(const SoftwareTLBLookup& lookup, bool hit);
+
   // these return the address of the MOV, for backpatching
   void UnsafeWriteRegToReg(Gen::OpArg reg_value, Gen::X64Reg reg_addr, int accessSize,
                            s32 offset = 0, bool swap = true, Gen::MovInfo* info = nullptr);
   void UnsafeWriteRegToReg(Gen::X64Reg reg_value, Gen::X64Reg reg_addr, int accessSize,
                            s32 offset = 0, bool swap = true, Gen::MovInfo* info = nullptr);
+  void UnsafeWriteRegToMem(Gen::OpArg reg_value, const Gen::OpArg& dest, int accessSize,
+                           bool swap = true, Gen::MovInfo* info = nullptr);
 
   bool UnsafeLoadToReg(Gen::X64Reg reg_value, Gen::OpArg opAddress, int accessSize, s32 offset,
                        bool signExtend, Gen::MovInfo* info = nullptr);
@@ -420,10 +420,60 @@ void QuantizedMemoryRoutines::GenQuantizedStore(bool single, EQuantizeType type,
   }
 
   if (type == QUANTIZE_FLOAT)
-  {
     GenQuantizedStoreFloat(single, isInline);
+  else
+    GenQuantize(single, type, quantize);
+
+  int flags = isInline ? 0 :
+                         SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_PROLOG |
+                             SAFE_LOADSTORE_DR_ON | SAFE_LOADSTORE_NO_UPDATE_PC;
+  if (!single)
+    flags |= SAFE_LOADSTORE_NO_SWAP;
+
+  SafeWriteRegToReg(RSCRATCH, RSCRATCH_EXTRA, size, 0, QUANTIZED_REGS_TO_SAVE, flags);
+}
+
+void QuantizedMemoryRoutines::GenScalePair(decltype(m_quantizeTableS)& table, int quantize)
+{
+  // In: two single floats in XMM0 (the upper half must be zero), if quantize is -1, a
+  // quantization factor in RSCRATCH2
+  // Clobbers: RSCRATCH, RSCRATCH2, XMM1
+
+  if (quantize == 0)
+    return;
+
+  OpArg factors;
+  if (quantize == -1)
+  {
+    SHR(32, R(RSCRATCH2), Imm8(5));
+    LEA(64, RSCRATCH, MConst(table));
+    factors = MRegSum(RSCRATCH2, RSCRATCH);
+  }
+  else
+  {
+    factors = MConst(table, quantize * 2);
   }
-  else if (single)
+
+  if (cpu_info.bAVX)
+  {
+    // VEX-encoded instructions don't require aligned memory operands, so the pair can be used
+    // directly. This also reads the next pair (or the padding at the end of the table), but the
+    // upper half of XMM0 is zero and every factor is finite, so the upper half stays zero.
+    VMULPS(XMM0, XMM0, factors);
+  }
+  else
+  {
+    MOVQ_xmm(XMM1, factors);
+    MULPS(XMM0, R(XMM1));
+  }
+}
+
+void QuantizedMemoryRoutines::GenQuantize(bool single, EQuantizeType type, int quantize)
+{
+  // In: one or two single floats in XMM0, if quantize is -1, a quantization factor in RSCRATCH2
+  // Out: the value to store in RSCRATCH. Paired values are laid out to be stored without swapping.
+
+  if (single)
   {
     if (quantize == -1)
     {
@@ -464,18 +514,7 @@ void QuantizedMemoryRoutines::GenQuantizedStore(bool single, EQuantizeType type,
   }
   else
   {
-    if (quantize == -1)
-    {
-      SHR(32, R(RSCRATCH2), Imm8(5));
-      LEA(64, RSCRATCH, MConst(m_quantizeTableS));
-      MOVQ_xmm(XMM1, MRegSum(RSCRATCH2, RSCRATCH));
-      MULPS(XMM0, R(XMM1));
-    }
-    else if (quantize > 0)
-    {
-      MOVQ_xmm(XMM1, MConst(m_quantizeTableS, quantize * 2));
-      MULPS(XMM0, R(XMM1));
-    }
+    GenScalePair(m_quantizeTableS, quantize);
 
     bool hasPACKUSDW = cpu_info.bSSE4_1;
 
@@ -532,14 +571,6 @@ void QuantizedMemoryRoutines::GenQuantizedStore(bool single, EQuantizeType type,
       break;
     }
   }
-
-  int flags = isInline ? 0 :
-                         SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_PROLOG |
-                             SAFE_LOADSTORE_DR_ON | SAFE_LOADSTORE_NO_UPDATE_PC;
-  if (!single)
-    flags |= SAFE_LOADSTORE_NO_SWAP;
-
-  SafeWriteRegToReg(RSCRATCH, RSCRATCH_EXTRA, size, 0, QUANTIZED_REGS_TO_SAVE, flags);
 }
 
 void QuantizedMemoryRoutines::GenQuantizedStoreFloat(bool single, bool isInline)
@@ -595,6 +626,15 @@ void QuantizedMemoryRoutines::GenQuantizedLoad(bool single, EQuantizeType type,
                          SAFE_LOADSTORE_NO_FASTMEM | SAFE_LOADSTORE_NO_PROLOG |
                              SAFE_LOADSTORE_DR_ON | SAFE_LOADSTORE_NO_UPDATE_PC;
   SafeLoadToReg(RSCRATCH_EXTRA, R(RSCRATCH_EXTRA), size, 0, regsToSave, extend, flags);
+  GenDequantize(single, type, quantize);
+}
+
+void QuantizedMemoryRoutines::GenDequantize(bool single, EQuantizeType type, int quantize)
+{
+  // In: the loaded value in RSCRATCH_EXTRA (sign extended for single signed types), if quantize is
+  // -1, a quantization factor in RSCRATCH2
+  // Out: the dequantized floats in XMM0, with 1.0 as the second one for single loads
+
   if (!single && (type == QUANTIZE_U8 || type == QUANTIZE_S8))
   {
     // TODO: Support not swapping in safeLoadToReg to avoid bswapping twice
@@ -677,19 +717,7 @@ void QuantizedMemoryRoutines::GenQuantizedLoad(bool single, EQuantizeType type,
       break;
     }
     CVTDQ2PS(XMM0, R(XMM0));
-
-    if (quantize == -1)
-    {
-      SHR(32, R(RSCRATCH2), Imm8(5));
-      LEA(64, RSCRATCH, MConst(m_dequantizeTableS));
-      MOVQ_xmm(XMM1, MRegSum(RSCRATCH2, RSCRATCH));
-      MULPS(XMM0, R(XMM1));
-    }
-    else if (quantize > 0)
-    {
-      MOVQ_xmm(XMM1, MConst(m_dequantizeTableS, quantize * 2));
-      MULPS(XMM0, R(XMM1));
-    }
+    GenScalePair(m_dequantizeTableS, quantize);
   }
 }
 
@@ -18,7 +18,13 @@ public:
   void GenQuantizedLoad(bool single, EQuantizeType type, int quantize);
   void GenQuantizedStore(bool single, EQuantizeType type, int quantize);
 
+  // The conversions done by GenQuantizedLoad and GenQuantizedStore for the integer types, without
+  // the memory access. See the comments in the implementation for the ins and outs.
+  void GenDequantize(bool single, EQuantizeType type, int quantize);
+  void GenQuantize(bool single, EQuantizeType type, int quantize);
+
 private:
+  void GenScalePair(decltype(m_quantizeTableS)& table, int quantize);
   void GenQuantizedLoadFloat(bool single, bool isInline);
   void GenQuantizedStoreFloat(bool single, bool isInline);
 };
@@ -8,8 +8,10 @@
 alignas(16) extern const u8 pbswapShuffle1x4[16];
 alignas(16) extern const u8 pbswapShuffle2x4[16];
 alignas(16) extern const float m_one[4];
-alignas(16) extern const float m_quantizeTableS[128];
-alignas(16) extern const float m_dequantizeTableS[128];
+// Each scale has a pair of factors. The tables end with an unused pair so that the last pair can
+// be read as a 16-byte vector.
+alignas(16) extern const float m_quantizeTableS[130];
+alignas(16) extern const float m_dequantizeTableS[130];
 
 struct CommonAsmRoutinesBase
 {
@@ -231,6 +231,8 @@ bool JitBase::HandleStackFault()
 
   WARN_LOG_FMT(POWERPC, "BLR cache disabled due to excessive BL in the emulated program.");
 
+  std::lock_guard lk(m_compiler_mutex);
+
   UnprotectStack();
   m_enable_blr_optimization = false;
 
@@ -260,6 +262,15 @@ void JitBase::CleanUpAfterStackFault()
   }
 }
 
+void JitBase::SetCompileTimeState()
+{
+  js.featureFlags = m_ppc_state.feature_flags;
+  std::ranges::copy(m_ppc_state.gpr, js.compileTimeGPRs.begin());
+  for (size_t i = 0; i < js.compileTimeGQRs.size(); ++i)
+    js.compileTimeGQRs[i] = GQR(m_ppc_state, i);
+  js.accessState = m_mmu.GetOptimizableAccessState();
+}
+
 bool JitBase::CanMergeNextInstructions(int count) const
 {
   if (m_system.GetCPU().IsStepping() || js.instructionsLeft < count)
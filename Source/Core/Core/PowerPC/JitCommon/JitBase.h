@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <string_view>
 #include <unordered_set>
 #include <utility>
@@ -22,6 +23,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 namespace Core
@@ -127,9 +129,18 @@ protected:
 
     JitBlock* curBlock;
 
+    // The state that the block is being compiled for. Code generation must use these instead of
+    // the live PowerPC state, since blocks may be compiled on another thread.
+    CPUEmuFeatureFlags featureFlags;
+    std::array<u32, 32> compileTimeGPRs;
+    std::array<u32, 8> compileTimeGQRs;
+    PowerPC::MMU::OptimizableAccessState accessState;
+
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // Blocks that have run often enough to be recompiled with PPCAnalyst::OPTION_SUPERBLOCK.
+    std::unordered_set<u32> superblockAddresses;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -165,6 +176,10 @@ protected:
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
+  // Guards the code space, the block cache and the compiler state in js against JITs that compile
+  // on a background thread. Everything that touches these from the CPU thread must hold it.
+  mutable std::recursive_mutex m_compiler_mutex;
+
   static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JIT_SETTINGS;
 
   bool DoesConfigNeedRefresh() const;
@@ -176,6 +191,7 @@ protected:
   void ProtectStack();
   void UnprotectStack();
   void CleanUpAfterStackFault();
+  void SetCompileTimeState();
 
   bool CanMergeNextInstructions(int count) const;
   bool HasConstantCarry() const
@@ -199,6 +215,7 @@ public:
 
   bool IsProfilingEnabled() const { return m_enable_profiling; }
   bool IsDebuggingEnabled() const { return m_enable_debugging; }
+  std::recursive_mutex& GetCompilerMutex() const { return m_compiler_mutex; }
 
   static const u8* Dispatch(JitBase& jit);
   virtual JitBaseBlockCache* GetBlockCache() = 0;
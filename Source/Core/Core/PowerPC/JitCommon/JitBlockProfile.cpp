@@ -0,0 +1,129 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitBlockProfile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <xxhash.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+JitBlockProfile::JitBlockProfile() = default;
+
+JitBlockProfile::~JitBlockProfile()
+{
+  Close();
+}
+
+std::string JitBlockProfile::GetPath(const std::string& game_id)
+{
+  return File::GetUserPath(D_CACHE_IDX) + game_id + ".jitprofile";
+}
+
+u64 JitBlockProfile::HashCode(std::span<const PPCAnalyst::CodeOp> code)
+{
+  std::vector<u32> words;
+  words.reserve(code.size() * 2);
+  for (const PPCAnalyst::CodeOp& op : code)
+  {
+    words.push_back(op.address);
+    words.push_back(op.inst.hex);
+  }
+  return XXH3_64bits(words.data(), words.size() * sizeof(u32));
+}
+
+void JitBlockProfile::Open(const std::string& path)
+{
+  Close();
+
+  class Reader final : public Common::LinearDiskCacheReader<u64, u8>
+  {
+  public:
+    explicit Reader(std::unordered_map<u64, Block>* blocks) : m_blocks(*blocks) {}
+
+    void Read(const u64& key, const u8* value, u32 value_size) override
+    {
+      if (value_size != sizeof(Block))
+        return;
+
+      // Blocks that were recorded again because their code changed replace the older copy.
+      Block block;
+      std::memcpy(&block, value, sizeof(Block));
+      m_blocks[key] = block;
+    }
+
+  private:
+    std::unordered_map<u64, Block>& m_blocks;
+  };
+
+  Reader reader(&m_blocks);
+  const u32 count = m_disk_cache.OpenAndRead(path, reader);
+
+  // Rewrite the file if most of it is outdated copies of blocks.
+  if (count > 2 * m_blocks.size() + 1024)
+  {
+    m_disk_cache.Close();
+    File::Delete(path);
+    std::unordered_map<u64, Block> unused;
+    Reader empty_reader(&unused);
+    m_disk_cache.OpenAndRead(path, empty_reader);
+    for (const auto& [key, block] : m_blocks)
+      Append(key, block);
+  }
+
+  m_pending_blocks.reserve(m_blocks.size());
+  for (const auto& [key, block] : m_blocks)
+    m_pending_blocks.push_back(block);
+
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} JIT blocks from {}", m_blocks.size(), path);
+  m_open = true;
+}
+
+void JitBlockProfile::Close()
+{
+  if (!m_open)
+    return;
+
+  for (const u64 key : m_unsaved_keys)
+    Append(key, m_blocks[key]);
+  m_unsaved_keys.clear();
+
+  m_disk_cache.Sync();
+  m_disk_cache.Close();
+  m_blocks.clear();
+  m_recorded_keys.clear();
+  m_pending_blocks.clear();
+  m_open = false;
+}
+
+void JitBlockProfile::Record(u32 effective_address, CPUEmuFeatureFlags feature_flags,
+                             std::span<const PPCAnalyst::CodeOp> code)
+{
+  const u64 key = GetKey(effective_address, feature_flags);
+  if (!m_open || !m_recorded_keys.insert(key).second)
+    return;
+
+  // The analyzer can reorder instructions, so the first op isn't necessarily the entry point.
+  const auto entry = std::ranges::find(code, effective_address, &PPCAnalyst::CodeOp::address);
+  const Block block{effective_address, feature_flags, entry != code.end() ? entry->inst.hex : 0,
+                    static_cast<u32>(code.size()), HashCode(code)};
+
+  const auto it = m_blocks.find(key);
+  if (it != m_blocks.end() && it->second.code_hash == block.code_hash)
+    return;
+  if (it == m_blocks.end() && m_blocks.size() >= MAX_BLOCKS)
+    return;
+
+  m_blocks[key] = block;
+  m_unsaved_keys.push_back(key);
+}
+
+void JitBlockProfile::Append(u64 key, const Block& block)
+{
+  u8 value[sizeof(Block)];
+  std::memcpy(value, &block, sizeof(Block));
+  m_disk_cache.Append(key, value, sizeof(value));
+}
@@ -0,0 +1,75 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// A record of the blocks that a game has compiled in earlier sessions, so that the JIT can compile
+// them ahead of time once the game has loaded the same code again. Each block is identified by a
+// hash of its instructions, which keeps blocks from being compiled before their code is in memory,
+// and keeps the profile of one revision of a game from being applied to another.
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+
+class JitBlockProfile
+{
+public:
+  struct Block
+  {
+    u32 effective_address;
+    CPUEmuFeatureFlags feature_flags;
+    // Lets most blocks whose code isn't in memory be skipped without analyzing them.
+    u32 first_instruction;
+    u32 num_instructions;
+    u64 code_hash;
+  };
+
+  JitBlockProfile();
+  ~JitBlockProfile();
+
+  JitBlockProfile(const JitBlockProfile&) = delete;
+  JitBlockProfile& operator=(const JitBlockProfile&) = delete;
+
+  static std::string GetPath(const std::string& game_id);
+  static u64 HashCode(std::span<const PPCAnalyst::CodeOp> code);
+
+  // Loads the blocks recorded in earlier sessions. New blocks are appended to the same file by
+  // Close, so that recording them doesn't write to disk while the game is running.
+  void Open(const std::string& path);
+  void Close();
+
+  // Adds a block that has been compiled. Each block is recorded at most once per session.
+  void Record(u32 effective_address, CPUEmuFeatureFlags feature_flags,
+              std::span<const PPCAnalyst::CodeOp> code);
+
+  // The blocks loaded by Open that the JIT hasn't dealt with yet. The JIT removes blocks from this
+  // as it compiles them or finds that their code doesn't match.
+  std::vector<Block>& GetPendingBlocks() { return m_pending_blocks; }
+
+  std::size_t GetBlockCount() const { return m_blocks.size(); }
+
+private:
+  static constexpr std::size_t MAX_BLOCKS = 0x40000;
+
+  static u64 GetKey(u32 effective_address, CPUEmuFeatureFlags feature_flags)
+  {
+    return u64{feature_flags} << 32 | effective_address;
+  }
+
+  void Append(u64 key, const Block& block);
+
+  std::unordered_map<u64, Block> m_blocks;
+  std::unordered_set<u64> m_recorded_keys;
+  std::vector<u64> m_unsaved_keys;
+  std::vector<Block> m_pending_blocks;
+  Common::LinearDiskCache<u64, u8> m_disk_cache;
+  bool m_open = false;
+};
@@ -7,7 +7,6 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <ranges>
 #include <set>
 #include <span>
@@ -19,9 +18,12 @@
 #include "Core/Core.h"
 #include "Core/Host.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitSamplingProfiler.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -29,6 +31,23 @@
 
 using namespace Gen;
 
+// Calls f(first, last) for each page that contains any of the given addresses, with the first and
+// last address in that page.
+template <typename F>
+void JitBaseBlockCache::ForEachPageRange(const std::set<u32>& physical_addresses, F f)
+{
+  constexpr u32 page_mask = ~(PhysicalPageTable::PAGE_SIZE - 1);
+  auto it = physical_addresses.begin();
+  while (it != physical_addresses.end())
+  {
+    const u32 first = *it;
+    u32 last = first;
+    for (; it != physical_addresses.end() && (*it & page_mask) == (first & page_mask); ++it)
+      last = *it;
+    f(first, last);
+  }
+}
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
   return physical_addresses.lower_bound(address) !=
@@ -83,16 +102,23 @@ void JitBaseBlockCache::Clear()
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
-  for (auto& e : block_map)
-  {
-    DestroyBlock(e.second);
-  }
-  block_map.clear();
-  links_to.clear();
-  block_range_map.clear();
+  m_jit.js.superblockAddresses.clear();
+  m_physical_pages.ForEach([this](PhysicalPage& page) {
+    for (BlockEntry& entry : page.blocks)
+      DestroyBlock(*entry.block);
+  });
+  m_physical_pages.Clear();
+  m_incoming_links.Clear();
+  m_block_count = 0;
 
   valid_block.ClearAll();
 
+  // Everything that is being tracked is now invalid. Skipping an extra token makes sure that none
+  // of the outstanding tokens can be mistaken for one handed out after the clear.
+  m_invalidation_log_base += m_invalidation_log.size() + 1;
+  m_invalidation_log.clear();
+  m_tracked_invalidation_count = 0;
+
   if (m_entry_points_ptr)
     m_entry_points_arena.Clear();
 }
@@ -116,30 +142,52 @@ JitBlock** JitBaseBlockCache::GetFastBlockMapFallback()
 void JitBaseBlockCache::RunOnBlocks(const Core::CPUThreadGuard&,
                                     std::function<void(const JitBlock&)> f) const
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  m_physical_pages.ForEach([&f](const PhysicalPage& page) {
+    for (const BlockEntry& entry : page.blocks)
+      f(*entry.block);
+  });
 }
 
 void JitBaseBlockCache::WipeBlockProfilingData(const Core::CPUThreadGuard&)
 {
-  for (const auto& kv : block_map)
-  {
-    if (JitBlock::ProfileData* const profile_data = kv.second.profile_data.get())
-      *profile_data = {};
-  }
+  m_physical_pages.ForEach([](const PhysicalPage& page) {
+    for (const BlockEntry& entry : page.blocks)
+    {
+      if (JitBlock::ProfileData* const profile_data = entry.block->profile_data.get())
+        *profile_data = {};
+    }
+  });
   Host_JitProfileDataWiped();
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   const u32 physical_address = m_jit.m_mmu.JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physical_address, m_jit.IsProfilingEnabled())->second;
-  b.effectiveAddress = em_address;
-  b.physicalAddress = physical_address;
-  b.feature_flags = m_jit.m_ppc_state.feature_flags;
-  b.linkData.clear();
-  b.fast_block_map_index = 0;
-  return &b;
+  return AddPendingBlock(
+      AllocatePendingBlock(em_address, physical_address, m_jit.m_ppc_state.feature_flags));
+}
+
+JitBaseBlockCache::PendingBlock
+JitBaseBlockCache::AllocatePendingBlock(u32 em_address, u32 physical_address,
+                                        CPUEmuFeatureFlags feature_flags) const
+{
+  auto b = std::make_unique<JitBlock>(m_jit.IsProfilingEnabled());
+  b->effectiveAddress = em_address;
+  b->physicalAddress = physical_address;
+  b->feature_flags = feature_flags;
+  b->linkData.clear();
+  b->fast_block_map_index = 0;
+  return b;
+}
+
+JitBlock* JitBaseBlockCache::AddPendingBlock(PendingBlock pending_block)
+{
+  JitBlock& block = *pending_block;
+  m_physical_pages[block.physicalAddress].blocks.push_back(
+      {block.effectiveAddress, block.physicalAddress, block.feature_flags,
+       std::move(pending_block)});
+  ++m_block_count;
+  return &block;
 }
 
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
@@ -172,21 +220,29 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   }
 
   for (u32 addr : block.physical_addresses)
-  {
     valid_block.Set(addr / 32);
-    block_range_map[addr & BLOCK_RANGE_MAP_MASK].insert(&block);
-  }
+  ForEachPageRange(block.physical_addresses, [&](u32 first, u32 last) {
+    m_physical_pages[first].ranges.push_back({first, last, &block});
+  });
 
   if (block_link)
   {
-    for (const auto& e : block.linkData)
+    // linkData doesn't change after this point, so the exits can be linked into the lists.
+    for (JitBlock::LinkData& e : block.linkData)
     {
-      links_to[e.exitAddress].insert(&block);
+      e.source_block = &block;
+      AddIncomingLink(e);
     }
 
     LinkBlock(block);
   }
 
+  if (JitSamplingProfiler& profiler = m_jit.m_system.GetJitInterface().GetSamplingProfiler();
+      profiler.IsRunning())
+  {
+    profiler.RegisterBlock(block);
+  }
+
   const Common::Symbol* symbol = nullptr;
   if (Common::JitRegister::IsEnabled() &&
       (symbol = m_jit.m_ppc_symbol_db.GetSymbolFromAddr(block.effectiveAddress)) != nullptr)
@@ -215,12 +271,17 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, CPUEmuFeatureFla
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  const PhysicalPage* page = m_physical_pages.Find(translated_addr);
+  if (!page)
+    return nullptr;
+
+  for (const BlockEntry& entry : page->blocks)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.feature_flags == feature_flags)
-      return &b;
+    if (entry.physical_address == translated_addr && entry.effective_address == addr &&
+        entry.feature_flags == feature_flags)
+    {
+      return entry.block.get();
+    }
   }
 
   return nullptr;
@@ -327,6 +388,8 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
 
   if (destroy_block)
   {
+    RecordInvalidation(physical_address, length);
+
     // destroy JIT blocks
     ErasePhysicalRange(physical_address, length);
 
@@ -341,74 +404,143 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
         m_jit.js.noSpeculativeConstantsAddresses.erase(i);
+        m_jit.js.superblockAddresses.erase(i);
       }
     }
   }
 }
 
+void JitBaseBlockCache::RecordInvalidation(u32 physical_address, u32 length)
+{
+  if (m_tracked_invalidation_count != 0)
+    m_invalidation_log.emplace_back(physical_address, length);
+}
+
+u64 JitBaseBlockCache::TrackInvalidations(const std::set<u32>& physical_addresses)
+{
+  // The valid_block bits are what make InvalidateICacheInternal look for blocks in the first place,
+  // so they have to be set even though there is no block in the cache yet.
+  for (u32 addr : physical_addresses)
+    valid_block.Set(addr / 32);
+
+  ++m_tracked_invalidation_count;
+  return m_invalidation_log_base + m_invalidation_log.size();
+}
+
+bool JitBaseBlockCache::StopTrackingInvalidations(u64 token,
+                                                  const std::set<u32>& physical_addresses)
+{
+  // The cache has been cleared since tracking started.
+  if (token < m_invalidation_log_base)
+    return false;
+
+  bool invalidated = false;
+  for (size_t i = token - m_invalidation_log_base; i < m_invalidation_log.size(); ++i)
+  {
+    const auto [start, length] = m_invalidation_log[i];
+    const auto it = physical_addresses.lower_bound(start);
+    if (it != physical_addresses.end() && u64{*it} < u64{start} + length)
+    {
+      invalidated = true;
+      break;
+    }
+  }
+
+  if (--m_tracked_invalidation_count == 0)
+  {
+    m_invalidation_log_base += m_invalidation_log.size();
+    m_invalidation_log.clear();
+  }
+
+  return !invalidated;
+}
+
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  auto start = block_range_map.lower_bound(address & BLOCK_RANGE_MAP_MASK);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  const u64 end = u64{address} + length;
+  for (u64 page_address = address & ~(PhysicalPageTable::PAGE_SIZE - 1); page_address < end;
+       page_address += PhysicalPageTable::PAGE_SIZE)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    PhysicalPage* page = m_physical_pages.Find(static_cast<u32>(page_address));
+    if (!page)
+      continue;
+
+    size_t i = 0;
+    while (i < page->ranges.size())
     {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
+      const BlockRange& range = page->ranges[i];
+      if (range.first < end && range.last >= address &&
+          range.block->OverlapsPhysicalRange(address, length))
       {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & BLOCK_RANGE_MAP_MASK) != start->first)
-            block_range_map[addr & BLOCK_RANGE_MAP_MASK].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
+        // This removes the range, and another one takes its place.
+        RemoveBlock(*range.block);
       }
       else
       {
-        iter++;
+        ++i;
       }
     }
-
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
   }
 }
 
 void JitBaseBlockCache::EraseSingleBlock(const JitBlock& block)
 {
-  const auto equal_range = block_map.equal_range(block.physicalAddress);
-  const auto block_map_iter = std::ranges::find(equal_range.first, equal_range.second, &block,
-                                                [](const auto& kv) { return &kv.second; });
-  if (block_map_iter == equal_range.second) [[unlikely]]
+  PhysicalPage* page = m_physical_pages.Find(block.physicalAddress);
+  if (!page) [[unlikely]]
     return;
 
-  JitBlock& mutable_block = block_map_iter->second;
+  const auto it = std::ranges::find(page->blocks, &block,
+                                    [](const BlockEntry& entry) { return entry.block.get(); });
+  if (it == page->blocks.end()) [[unlikely]]
+    return;
 
-  for (const u32 addr : mutable_block.physical_addresses)
-    block_range_map[addr & BLOCK_RANGE_MAP_MASK].erase(&mutable_block);
+  RemoveBlock(*it->block);  // The original JitBlock reference is now dangling.
+}
 
-  DestroyBlock(mutable_block);
-  block_map.erase(block_map_iter);  // The original JitBlock reference is now dangling.
+void JitBaseBlockCache::AgeBlocks(u32 epoch)
+{
+  m_physical_pages.ForEach([epoch](const PhysicalPage& page) {
+    for (const BlockEntry& entry : page.blocks)
+    {
+      JitBlock& block = *entry.block;
+      if (block.recently_run)
+      {
+        block.last_run_epoch = epoch;
+        block.recently_run = 0;
+      }
+    }
+  });
+}
+
+std::vector<const JitBlock*> JitBaseBlockCache::GetBlocksByLastRun() const
+{
+  std::vector<const JitBlock*> result;
+  result.reserve(m_block_count);
+  m_physical_pages.ForEach([&result](const PhysicalPage& page) {
+    for (const BlockEntry& entry : page.blocks)
+      result.push_back(entry.block.get());
+  });
+  std::ranges::stable_sort(result, {}, &JitBlock::last_run_epoch);
+  return result;
+}
+
+void JitBaseBlockCache::RemoveBlock(JitBlock& block)
+{
+  ForEachPageRange(block.physical_addresses, [&](u32 first, u32) {
+    std::vector<BlockRange>& ranges = m_physical_pages.Find(first)->ranges;
+    const auto it = std::ranges::find(ranges, &block, &BlockRange::block);
+    *it = ranges.back();
+    ranges.pop_back();
+  });
+
+  DestroyBlock(block);
+
+  std::vector<BlockEntry>& blocks = m_physical_pages.Find(block.physicalAddress)->blocks;
+  const auto it = std::ranges::find(blocks, &block,
+                                    [](const BlockEntry& entry) { return entry.block.get(); });
+  *it = std::move(blocks.back());
+  blocks.pop_back();
+  --m_block_count;
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
@@ -445,14 +577,16 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
 void JitBaseBlockCache::LinkBlock(JitBlock& block)
 {
   LinkBlockExits(block);
-  const auto it = links_to.find(block.effectiveAddress);
-  if (it == links_to.end())
-    return;
 
-  for (JitBlock* b2 : it->second)
+  // Link the exits of other blocks which point to this block
+  for (JitBlock::LinkData* e = GetIncomingLinks(block.effectiveAddress); e;
+       e = e->next_to_same_address)
   {
-    if (block.feature_flags == b2->feature_flags)
-      LinkBlockExits(*b2);
+    if (!e->linkStatus && e->source_block->feature_flags == block.feature_flags)
+    {
+      WriteLinkBlock(*e, &block);
+      e->linkStatus = true;
+    }
   }
 }
 
@@ -465,23 +599,75 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
   }
 
   // Unlink all exits of other blocks which points to this block
-  const auto it = links_to.find(block.effectiveAddress);
-  if (it == links_to.end())
-    return;
-  for (JitBlock* sourceBlock : it->second)
+  for (JitBlock::LinkData* e = GetIncomingLinks(block.effectiveAddress); e;
+       e = e->next_to_same_address)
   {
-    if (sourceBlock->feature_flags != block.feature_flags)
-      continue;
+    if (e->source_block->feature_flags == block.feature_flags)
+    {
+      WriteLinkBlock(*e, nullptr);
+      e->linkStatus = false;
+    }
+  }
+}
 
-    for (auto& e : sourceBlock->linkData)
+void JitBaseBlockCache::AddIncomingLink(JitBlock::LinkData& link)
+{
+  std::vector<LinkListHead>& heads = m_incoming_links[link.exitAddress];
+  const auto it = std::ranges::find(heads, link.exitAddress, &LinkListHead::exit_address);
+  link.prev_to_same_address = nullptr;
+  if (it == heads.end())
+  {
+    link.next_to_same_address = nullptr;
+    heads.push_back({link.exitAddress, &link});
+  }
+  else
+  {
+    link.next_to_same_address = it->first;
+    it->first->prev_to_same_address = &link;
+    it->first = &link;
+  }
+}
+
+void JitBaseBlockCache::RemoveIncomingLink(JitBlock::LinkData& link)
+{
+  if (!link.source_block)
+    return;
+
+  if (link.next_to_same_address)
+    link.next_to_same_address->prev_to_same_address = link.prev_to_same_address;
+
+  if (link.prev_to_same_address)
+  {
+    link.prev_to_same_address->next_to_same_address = link.next_to_same_address;
+  }
+  else
+  {
+    std::vector<LinkListHead>& heads = *m_incoming_links.Find(link.exitAddress);
+    const auto it = std::ranges::find(heads, &link, &LinkListHead::first);
+    if (link.next_to_same_address)
     {
-      if (e.exitAddress == block.effectiveAddress)
-      {
-        WriteLinkBlock(e, nullptr);
-        e.linkStatus = false;
-      }
+      it->first = link.next_to_same_address;
+    }
+    else
+    {
+      *it = heads.back();
+      heads.pop_back();
     }
   }
+
+  link.source_block = nullptr;
+  link.prev_to_same_address = nullptr;
+  link.next_to_same_address = nullptr;
+}
+
+JitBlock::LinkData* JitBaseBlockCache::GetIncomingLinks(u32 em_address) const
+{
+  const std::vector<LinkListHead>* heads = m_incoming_links.Find(em_address);
+  if (!heads)
+    return nullptr;
+
+  const auto it = std::ranges::find(*heads, em_address, &LinkListHead::exit_address);
+  return it != heads->end() ? it->first : nullptr;
 }
 
 void JitBaseBlockCache::DestroyBlock(JitBlock& block)
@@ -504,14 +690,13 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
   UnlinkBlock(block);
 
   // Delete linking addresses
-  for (const auto& e : block.linkData)
+  for (JitBlock::LinkData& e : block.linkData)
+    RemoveIncomingLink(e);
+
+  if (JitSamplingProfiler& profiler = m_jit.m_system.GetJitInterface().GetSamplingProfiler();
+      profiler.IsRunning())
   {
-    auto it = links_to.find(e.exitAddress);
-    if (it == links_to.end())
-      continue;
-    it->second.erase(&block);
-    if (it->second.empty())
-      links_to.erase(it);
+    profiler.UnregisterBlock(block);
   }
 
   // Raise an signal if we are going to call this block again
@@ -8,12 +8,10 @@
 #include <chrono>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <memory>
 #include <set>
 #include <type_traits>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -41,8 +39,8 @@ struct JitBlockData
   // The effective address (PC) for the beginning of the block.
   u32 effectiveAddress;
   // The physical address of the code represented by this block.
-  // Various maps in the cache are indexed by this (block_map
-  // and valid_block in particular). This is useful because of
+  // Various tables in the cache are indexed by this (the block
+  // page table and valid_block in particular). This is useful because of
   // of the way the instruction cache works on PowerPC.
   u32 physicalAddress;
   // The number of PPC instructions represented by this block. Mostly
@@ -97,6 +95,15 @@ struct JitBlock : public JitBlockData
     u32 exitAddress;
     bool linkStatus;  // is it already linked?
     bool call;
+    // Identifies the registers that the exit leaves in host registers, matching the boundEntry of
+    // a block with the same boundEntryState. 0 if the exit only leaves registers in PowerPCState.
+    u64 boundEntryState = 0;
+
+    // All exits to the same address form an intrusive list, which is how the blocks that link to
+    // a block are found. These are only set while the block is in the cache.
+    JitBlock* source_block = nullptr;
+    LinkData* prev_to_same_address = nullptr;
+    LinkData* next_to_same_address = nullptr;
   };
   std::vector<LinkData> linkData;
 
@@ -108,6 +115,22 @@ struct JitBlock : public JitBlockData
   std::vector<std::pair<u32, UGeckoInstruction>> original_buffer;
 
   std::unique_ptr<ProfileData> profile_data;
+
+  // An entry point after the block has loaded some registers into host registers, for exits from
+  // other blocks that have already put them there. Identified by boundEntryState, which is
+  // specific to the JIT. Only valid if boundEntryState isn't 0.
+  u8* boundEntry = nullptr;
+  u64 boundEntryState = 0;
+
+  // Counted down by the block each time it runs, if the JIT forms superblocks from blocks that run
+  // often.
+  u32 superblock_countdown = 0;
+
+  // Set by the block each time it runs, if the JIT evicts the blocks that haven't run for a while
+  // when it runs out of code space. New blocks count as having run.
+  u8 recently_run = 1;
+  // The newest epoch in which the block was found to have run. See JitBaseBlockCache::AgeBlocks.
+  u32 last_run_epoch = 0;
 };
 
 typedef void (*CompiledCode)();
@@ -142,6 +165,57 @@ public:
   bool Test(u32 bit) const { return (m_valid_block[bit / 32] & (1u << (bit % 32))) != 0; }
 };
 
+// A table with an entry for each 4 KiB page of the 32-bit address space. Entries are allocated
+// in chunks of 4 MiB when a page in the chunk is first used, so only the parts of the address
+// space that actually contain code take up memory.
+template <typename T>
+class JitPageTable final
+{
+public:
+  static constexpr u32 PAGE_SHIFT = 12;
+  static constexpr u32 PAGE_SIZE = 1u << PAGE_SHIFT;
+  static constexpr u32 CHUNK_SHIFT = 22;
+  static constexpr u32 PAGES_PER_CHUNK = 1u << (CHUNK_SHIFT - PAGE_SHIFT);
+
+  // Returns nullptr if nothing has been stored in the chunk containing the address.
+  T* Find(u32 address) const
+  {
+    Chunk* chunk = m_chunks[address >> CHUNK_SHIFT].get();
+    return chunk ? &(*chunk)[(address >> PAGE_SHIFT) % PAGES_PER_CHUNK] : nullptr;
+  }
+
+  T& operator[](u32 address)
+  {
+    std::unique_ptr<Chunk>& chunk = m_chunks[address >> CHUNK_SHIFT];
+    if (!chunk)
+      chunk = std::make_unique<Chunk>();
+    return (*chunk)[(address >> PAGE_SHIFT) % PAGES_PER_CHUNK];
+  }
+
+  template <typename F>
+  void ForEach(F f) const
+  {
+    for (const std::unique_ptr<Chunk>& chunk : m_chunks)
+    {
+      if (chunk)
+      {
+        for (T& page : *chunk)
+          f(page);
+      }
+    }
+  }
+
+  void Clear()
+  {
+    for (std::unique_ptr<Chunk>& chunk : m_chunks)
+      chunk.reset();
+  }
+
+private:
+  using Chunk = std::array<T, PAGES_PER_CHUNK>;
+  std::array<std::unique_ptr<Chunk>, (1ULL << 32) / (1ULL << CHUNK_SHIFT)> m_chunks;
+};
+
 class JitBaseBlockCache
 {
 public:
@@ -164,9 +238,16 @@ public:
   JitBlock** GetFastBlockMapFallback();
   void RunOnBlocks(const Core::CPUThreadGuard& guard, std::function<void(const JitBlock&)> f) const;
   void WipeBlockProfilingData(const Core::CPUThreadGuard& guard);
-  std::size_t GetBlockCount() const { return block_map.size(); }
+  std::size_t GetBlockCount() const { return m_block_count; }
+
+  // A block that has been allocated but not yet added to the cache. Blocks that are compiled on
+  // another thread are allocated like this, so that they can be added once the CPU thread is ready.
+  using PendingBlock = std::unique_ptr<JitBlock>;
 
   JitBlock* AllocateBlock(u32 em_address);
+  PendingBlock AllocatePendingBlock(u32 em_address, u32 physical_address,
+                                    CPUEmuFeatureFlags feature_flags) const;
+  JitBlock* AddPendingBlock(PendingBlock pending_block);
   void FinalizeBlock(JitBlock& block, bool block_link, const PPCAnalyst::CodeBlock& code_block,
                      const PPCAnalyst::CodeBuffer& code_buffer);
 
@@ -186,8 +267,19 @@ public:
   void ErasePhysicalRange(u32 address, u32 length);
   void EraseSingleBlock(const JitBlock& block);
 
+  // Moves the blocks that have run since the last call into the given epoch.
+  void AgeBlocks(u32 epoch);
+  // Returns all blocks, ordered from the one that has gone the longest without running.
+  std::vector<const JitBlock*> GetBlocksByLastRun() const;
+
   u32* GetBlockBitSet() const;
 
+  // Records all invalidations from now on, so that code that is being compiled elsewhere can be
+  // checked against them before it is added to the cache. Every call must be paired with a call to
+  // StopTrackingInvalidations, which returns false if any of the given addresses were invalidated.
+  u64 TrackInvalidations(const std::set<u32>& physical_addresses);
+  bool StopTrackingInvalidations(u64 token, const std::set<u32>& physical_addresses);
+
 protected:
   virtual void DestroyBlock(JitBlock& block);
 
@@ -201,25 +293,64 @@ private:
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
+  void RecordInvalidation(u32 physical_address, u32 length);
+
+  void AddIncomingLink(JitBlock::LinkData& link);
+  void RemoveIncomingLink(JitBlock::LinkData& link);
+  JitBlock::LinkData* GetIncomingLinks(u32 em_address) const;
+  void RemoveBlock(JitBlock& block);
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, CPUEmuFeatureFlags feature_flags);
 
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address, u32 msr);
 
-  // links_to hold all exit points of all valid blocks in a reverse way.
-  // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  // A block whose entry point is in a page. The addresses and flags are copies of the ones in the
+  // block, so that looking up a block doesn't have to touch the blocks that don't match.
+  struct BlockEntry
+  {
+    u32 effective_address;
+    u32 physical_address;
+    CPUEmuFeatureFlags feature_flags;
+    std::unique_ptr<JitBlock> block;
+  };
+
+  // The first and last instruction a block occupies within a page. There can be addresses in
+  // between that aren't part of the block if the block skips over some instructions.
+  struct BlockRange
+  {
+    u32 first;
+    u32 last;
+    JitBlock* block;
+  };
+
+  struct PhysicalPage
+  {
+    // The blocks with an entry point in this page. This is where the blocks are owned.
+    std::vector<BlockEntry> blocks;
+    // All blocks with instructions in this page. This is used for invalidation.
+    std::vector<BlockRange> ranges;
+  };
 
-  // Map indexed by the physical address of the entry point.
-  // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  // The first exit to an effective address. The remaining exits are linked from it.
+  struct LinkListHead
+  {
+    u32 exit_address;
+    JitBlock::LinkData* first;
+  };
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
-  static constexpr u32 BLOCK_RANGE_MAP_MASK = ~(0x100 - 1);
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  using PhysicalPageTable = JitPageTable<PhysicalPage>;
+
+  template <typename F>
+  static void ForEachPageRange(const std::set<u32>& physical_addresses, F f);
+
+  // Blocks and their occupied ranges indexed by physical address.
+  PhysicalPageTable m_physical_pages;
+  std::size_t m_block_count = 0;
+
+  // The exits of all linked blocks, indexed by the effective address they lead to. This is used to
+  // find the blocks which link to an address.
+  JitPageTable<std::vector<LinkListHead>> m_incoming_links;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
@@ -235,4 +366,10 @@ private:
   // in case the shm memory region couldn't be allocated.
   std::array<JitBlock*, FAST_BLOCK_MAP_FALLBACK_ELEMENTS>
       m_fast_block_map_fallback{};  // start_addr & mask -> number
+
+  // Physical ranges (start, length) invalidated while any code is being tracked. The tokens handed
+  // out by TrackInvalidations are indices into this log, offset by the entries dropped so far.
+  std::vector<std::pair<u32, u32>> m_invalidation_log;
+  u64 m_invalidation_log_base = 0;
+  u32 m_tracked_invalidation_count = 0;
 };
@@ -0,0 +1,438 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitSamplingProfiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Core/GeckoCode.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+#ifdef __linux__
+#include <csignal>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Core/MachineContext.h"
+
+// Only newer versions of glibc define this.
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace
+{
+std::atomic<JitSamplingProfiler*> s_active_profiler = nullptr;
+
+#ifdef __linux__
+void SignalHandler(int, siginfo_t*, void* raw_context)
+{
+  JitSamplingProfiler* profiler = s_active_profiler.load(std::memory_order_acquire);
+  if (!profiler)
+    return;
+
+#if _M_X86_64
+  profiler->TakeSample(static_cast<ucontext_t*>(raw_context)->uc_mcontext.CTX_RIP);
+#elif _M_ARM_64
+  profiler->TakeSample(static_cast<ucontext_t*>(raw_context)->uc_mcontext.CTX_PC);
+#else
+  profiler->TakeSample(0);
+#endif
+}
+#endif
+
+struct Function
+{
+  u32 address;
+  std::string name;
+};
+
+Function GetFunction(const PPCSymbolDB& symbol_db, u32 address)
+{
+  if (const Common::Symbol* symbol = symbol_db.GetSymbolFromAddr(address))
+    return {symbol->address, symbol->name};
+  if (address >= Gecko::INSTALLER_BASE_ADDRESS && address < Gecko::INSTALLER_END_ADDRESS)
+    return {Gecko::INSTALLER_BASE_ADDRESS, "[Gecko codes]"};
+  return {address, fmt::format("{:08x}", address)};
+}
+
+// Resolves a stack from m_stacks to functions, outermost first.
+std::vector<Function> ResolveStack(const PPCSymbolDB& symbol_db, std::span<const u32> stack)
+{
+  std::vector<Function> functions;
+  for (u32 return_address : stack.first(stack.size() - 1))
+  {
+    if (return_address != 0)
+      functions.push_back(GetFunction(symbol_db, return_address - 4));
+  }
+  const Function leaf = GetFunction(symbol_db, stack.back());
+
+  // LR only adds a frame if the function that is running hasn't set up a stack frame. Otherwise it
+  // points into the function itself or is the return address that the walk already found.
+  if (!functions.empty() && stack.size() >= 2 && stack[stack.size() - 2] != 0)
+  {
+    const u32 lr_function = functions.back().address;
+    if (lr_function == leaf.address ||
+        (functions.size() >= 2 && lr_function == functions[functions.size() - 2].address))
+    {
+      functions.pop_back();
+    }
+  }
+
+  functions.push_back(leaf);
+  return functions;
+}
+}  // namespace
+
+JitSamplingProfiler::JitSamplingProfiler() = default;
+
+JitSamplingProfiler::~JitSamplingProfiler()
+{
+  Stop();
+}
+
+bool JitSamplingProfiler::IsSupported()
+{
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool JitSamplingProfiler::Start(Core::System& system, u32 samples_per_second)
+{
+#ifdef __linux__
+  Stop();
+
+  m_stacks.clear();
+  m_block_samples.clear();
+  m_sample_count = 0;
+  m_host_sample_count = 0;
+
+  m_ppc_state = &system.GetPPCState();
+  auto& memory = system.GetMemory();
+  m_ram = memory.GetRAM();
+  m_ram_size = memory.GetRamSizeReal();
+  m_exram = memory.GetEXRAM();
+  m_exram_size = memory.GetExRamSizeReal();
+
+  if (!m_samples)
+    m_samples = std::make_unique<Sample[]>(SAMPLE_BUFFER_SIZE);
+  m_write_index = 0;
+  m_read_index = 0;
+  m_dropped_samples = 0;
+
+  // The handler stays installed once the profiler has been used, since a signal from the timer
+  // can still be pending after the timer is deleted.
+  static bool s_handler_installed = false;
+  if (!s_handler_installed)
+  {
+    struct sigaction action = {};
+    action.sa_sigaction = &SignalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0)
+    {
+      ERROR_LOG_FMT(DYNA_REC, "Failed to install the SIGPROF handler: {}", std::strerror(errno));
+      return false;
+    }
+    s_handler_installed = true;
+  }
+
+  // Only the CPU time of this thread counts, so that samples aren't wasted on the CPU thread
+  // waiting for the GPU thread.
+  sigevent event = {};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &m_timer) != 0)
+  {
+    ERROR_LOG_FMT(DYNA_REC, "Failed to create the profiling timer: {}", std::strerror(errno));
+    return false;
+  }
+
+  const u64 interval_ns = 1'000'000'000 / std::clamp<u32>(samples_per_second, 1, 10'000);
+  m_interval_us = static_cast<u32>(interval_ns / 1000);
+  itimerspec spec = {};
+  spec.it_interval.tv_sec = static_cast<time_t>(interval_ns / 1'000'000'000);
+  spec.it_interval.tv_nsec = static_cast<long>(interval_ns % 1'000'000'000);
+  spec.it_value = spec.it_interval;
+
+  s_active_profiler.store(this, std::memory_order_release);
+  m_running = true;
+  if (timer_settime(m_timer, 0, &spec, nullptr) != 0)
+  {
+    ERROR_LOG_FMT(DYNA_REC, "Failed to start the profiling timer: {}", std::strerror(errno));
+    Stop();
+    return false;
+  }
+
+  INFO_LOG_FMT(DYNA_REC, "Sampling the CPU thread every {} us", m_interval_us);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void JitSamplingProfiler::Stop()
+{
+  if (!m_running)
+    return;
+
+#ifdef __linux__
+  timer_delete(m_timer);
+#endif
+  s_active_profiler.store(nullptr, std::memory_order_release);
+
+  ProcessSamples();
+  m_host_ranges.clear();
+  m_running = false;
+
+  const u64 dropped_samples = m_dropped_samples;
+  INFO_LOG_FMT(DYNA_REC, "Took {} samples of the CPU thread ({} dropped)", m_sample_count,
+               dropped_samples);
+}
+
+void JitSamplingProfiler::RegisterBlock(const JitBlock& block)
+{
+  const auto add = [&](const u8* begin, const u8* end) {
+    if (begin != end)
+    {
+      m_host_ranges[reinterpret_cast<uintptr_t>(begin)] = {reinterpret_cast<uintptr_t>(end),
+                                                           block.effectiveAddress};
+    }
+  };
+  add(block.near_begin, block.near_end);
+  add(block.far_begin, block.far_end);
+}
+
+void JitSamplingProfiler::UnregisterBlock(const JitBlock& block)
+{
+  // The samples taken in the code of the block have to be attributed while it still belongs to it.
+  ProcessSamples();
+
+  const auto remove = [&](const u8* begin, const u8* end) {
+    const auto it = m_host_ranges.find(reinterpret_cast<uintptr_t>(begin));
+    if (it != m_host_ranges.end() && it->second.end == reinterpret_cast<uintptr_t>(end) &&
+        it->second.effective_address == block.effectiveAddress)
+    {
+      m_host_ranges.erase(it);
+    }
+  };
+  remove(block.near_begin, block.near_end);
+  remove(block.far_begin, block.far_end);
+}
+
+bool JitSamplingProfiler::ReadGuestWord(u32 address, u32* value) const
+{
+  // This runs in a signal handler, so only the usual mappings of MEM1 and MEM2 are read directly,
+  // without going through the MMU.
+  const u8* base;
+  u32 size;
+  switch (address >> 28)
+  {
+  case 0x8:
+  case 0xC:
+    base = m_ram;
+    size = m_ram_size;
+    break;
+  case 0x9:
+  case 0xD:
+    base = m_exram;
+    size = m_exram_size;
+    break;
+  default:
+    return false;
+  }
+
+  const u32 offset = address & 0x0FFFFFFF;
+  if (!base || (address & 3) != 0 || offset >= size)
+    return false;
+
+  u32 word;
+  std::memcpy(&word, base + offset, sizeof(word));
+  *value = Common::swap32(word);
+  return true;
+}
+
+void JitSamplingProfiler::TakeSample(uintptr_t host_pc)
+{
+  const u32 write_index = m_write_index.load(std::memory_order_relaxed);
+  if (write_index - m_read_index.load(std::memory_order_acquire) >= SAMPLE_BUFFER_SIZE)
+  {
+    m_dropped_samples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Sample& sample = m_samples[write_index % SAMPLE_BUFFER_SIZE];
+  sample.host_pc = host_pc;
+  sample.guest_pc = m_ppc_state->pc;
+
+  // Walks the back chain like Dolphin_Debugger::GetCallstack. The JIT may be holding a newer value
+  // of r1 in a host register, but r1 only changes in the prologues and epilogues of functions.
+  u32 num_frames = 0;
+  sample.frames[num_frames++] = LR(*m_ppc_state);
+  u32 frame;
+  if (ReadGuestWord(m_ppc_state->gpr[1], &frame))
+  {
+    u32 return_address;
+    while (num_frames < MAX_STACK_DEPTH && frame != 0 &&
+           ReadGuestWord(frame + 4, &return_address) && return_address != 0)
+    {
+      sample.frames[num_frames++] = return_address;
+      if (!ReadGuestWord(frame, &frame))
+        break;
+    }
+  }
+  sample.num_frames = num_frames;
+
+  m_write_index.store(write_index + 1, std::memory_order_release);
+}
+
+void JitSamplingProfiler::ProcessSamples()
+{
+  if (!m_samples)
+    return;
+
+  const u32 write_index = m_write_index.load(std::memory_order_acquire);
+  u32 read_index = m_read_index.load(std::memory_order_relaxed);
+  for (; read_index != write_index; ++read_index)
+    ProcessSample(m_samples[read_index % SAMPLE_BUFFER_SIZE]);
+  m_read_index.store(read_index, std::memory_order_release);
+}
+
+void JitSamplingProfiler::ProcessSample(const Sample& sample)
+{
+  std::vector<u32> stack(std::make_reverse_iterator(sample.frames.begin() + sample.num_frames),
+                         std::make_reverse_iterator(sample.frames.begin()));
+
+  auto it = m_host_ranges.upper_bound(sample.host_pc);
+  if (it != m_host_ranges.begin() && sample.host_pc < (--it)->second.end)
+  {
+    stack.push_back(it->second.effective_address);
+    ++m_block_samples[it->second.effective_address];
+  }
+  else
+  {
+    // The dispatcher, or host code called from a block. The PC is usually the start of the block.
+    stack.push_back(sample.guest_pc);
+    stack.push_back(HOST_FRAME);
+    ++m_host_sample_count;
+  }
+
+  ++m_stacks[std::move(stack)];
+  ++m_sample_count;
+}
+
+void JitSamplingProfiler::WriteFoldedStacks(std::FILE* file, const PPCSymbolDB& symbol_db) const
+{
+  // Many distinct return addresses belong to the same functions.
+  std::map<std::string, u64> folded_stacks;
+  for (const auto& [stack, count] : m_stacks)
+  {
+    const bool host = stack.back() == HOST_FRAME;
+    std::string line;
+    for (const Function& function :
+         ResolveStack(symbol_db, std::span(stack).first(stack.size() - host)))
+    {
+      if (!line.empty())
+        line += ';';
+      line += function.name;
+      std::ranges::replace(line.end() - function.name.size(), line.end(), ';', ':');
+    }
+    if (host)
+      line += ";[host]";
+    folded_stacks[std::move(line)] += count;
+  }
+
+  for (const auto& [line, count] : folded_stacks)
+    fmt::print(file, "{} {}\n", line, count);
+}
+
+void JitSamplingProfiler::WriteTopFunctions(std::FILE* file, const PPCSymbolDB& symbol_db,
+                                            std::size_t count) const
+{
+  const u64 dropped_samples = m_dropped_samples;
+  fmt::print(file, "{} samples, one per {} us of CPU time of the CPU thread ({} dropped)\n",
+             m_sample_count, m_interval_us, dropped_samples);
+  if (m_sample_count == 0)
+    return;
+  const auto percent = [this](u64 samples) { return 100.0 * samples / m_sample_count; };
+  fmt::print(file, "{:.2f}% in the dispatcher or host code called from JIT blocks\n\n",
+             percent(m_host_sample_count));
+
+  struct FunctionStats
+  {
+    std::string name;
+    u64 self = 0;
+    u64 self_host = 0;
+    u64 total = 0;
+  };
+  std::unordered_map<u32, FunctionStats> functions;
+  for (const auto& [stack, samples] : m_stacks)
+  {
+    const bool host = stack.back() == HOST_FRAME;
+    const std::vector<Function> resolved =
+        ResolveStack(symbol_db, std::span(stack).first(stack.size() - host));
+    for (auto it = resolved.begin(); it != resolved.end(); ++it)
+    {
+      FunctionStats& stats = functions[it->address];
+      if (stats.name.empty())
+        stats.name = it->name;
+      // Recursive functions only count once.
+      if (std::none_of(resolved.begin(), it,
+                       [&](const Function& function) { return function.address == it->address; }))
+      {
+        stats.total += samples;
+      }
+    }
+    FunctionStats& leaf = functions[resolved.back().address];
+    leaf.self += samples;
+    if (host)
+      leaf.self_host += samples;
+  }
+
+  std::vector<std::pair<u32, const FunctionStats*>> sorted_functions;
+  for (const auto& [address, stats] : functions)
+    sorted_functions.emplace_back(address, &stats);
+  std::ranges::sort(sorted_functions, [](const auto& a, const auto& b) {
+    return std::tie(a.second->self, a.second->total) > std::tie(b.second->self, b.second->total);
+  });
+
+  fmt::print(file, "   Self   Total    Host  Address   Function\n");
+  for (const auto& [address, stats] :
+       std::span(sorted_functions).first(std::min(count, sorted_functions.size())))
+  {
+    fmt::print(file, "{:6.2f}% {:6.2f}% {:6.2f}%  {:08x}  {}\n", percent(stats->self),
+               percent(stats->total), percent(stats->self_host), address, stats->name);
+  }
+
+  std::vector<std::pair<u32, u64>> sorted_blocks(m_block_samples.begin(), m_block_samples.end());
+  std::ranges::sort(sorted_blocks,
+                    [](const auto& a, const auto& b) { return a.second > b.second; });
+
+  fmt::print(file, "\n  Block  Address   Function\n");
+  for (const auto& [address, samples] :
+       std::span(sorted_blocks).first(std::min(count, sorted_blocks.size())))
+  {
+    fmt::print(file, "{:6.2f}%  {:08x}  {}\n", percent(samples), address,
+               GetFunction(symbol_db, address).name);
+  }
+}
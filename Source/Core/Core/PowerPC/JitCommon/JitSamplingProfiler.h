@@ -0,0 +1,125 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// A sampling profiler for the guest code that the JIT runs. The CPU thread is interrupted at a
+// fixed rate of its CPU time, and each sample is attributed to the JIT block whose host code was
+// running, and to the guest call stack at that point. Unlike the JIT block profiling, this doesn't
+// change the generated code, and it also accounts for the time spent in host code that blocks call
+// (MMIO, HLE, interpreter fallbacks).
+//
+// The samples are taken by a SIGPROF handler, so this is only supported on Linux.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class PPCSymbolDB;
+struct JitBlock;
+
+namespace Core
+{
+class System;
+}
+namespace PowerPC
+{
+struct PowerPCState;
+}
+
+class JitSamplingProfiler
+{
+public:
+  JitSamplingProfiler();
+  ~JitSamplingProfiler();
+
+  JitSamplingProfiler(const JitSamplingProfiler&) = delete;
+  JitSamplingProfiler& operator=(const JitSamplingProfiler&) = delete;
+
+  static bool IsSupported();
+
+  // The thread that calls Start is the one that gets sampled, so these have to be called on the
+  // CPU thread. Start discards the results of the previous run.
+  bool Start(Core::System& system, u32 samples_per_second);
+  void Stop();
+  bool IsRunning() const { return m_running; }
+
+  // The block cache tells the profiler where the host code of each block is while it runs.
+  void RegisterBlock(const JitBlock& block);
+  void UnregisterBlock(const JitBlock& block);
+
+  // Attributes the samples that have been taken so far. This has to happen before the host code
+  // of a block can be reused, and often enough that the sample buffer doesn't fill up.
+  void ProcessSamples();
+
+  u64 GetSampleCount() const { return m_sample_count; }
+
+  // Records the state of the CPU thread. Called by the signal handler.
+  void TakeSample(uintptr_t host_pc);
+
+  // Writes one line per distinct guest call stack, in the format that flamegraph.pl reads.
+  void WriteFoldedStacks(std::FILE* file, const PPCSymbolDB& symbol_db) const;
+  // Writes the guest functions and JIT blocks with the most samples.
+  void WriteTopFunctions(std::FILE* file, const PPCSymbolDB& symbol_db, std::size_t count) const;
+
+private:
+  static constexpr std::size_t MAX_STACK_DEPTH = 16;
+  static constexpr u32 SAMPLE_BUFFER_SIZE = 0x4000;
+  // Marks samples that were taken outside of the code of JIT blocks. Instruction addresses are
+  // aligned, so this can't be one.
+  static constexpr u32 HOST_FRAME = 0xFFFFFFFF;
+
+  struct Sample
+  {
+    uintptr_t host_pc;
+    u32 guest_pc;
+    u32 num_frames;
+    // Return addresses, innermost first.
+    std::array<u32, MAX_STACK_DEPTH> frames;
+  };
+
+  struct HostRange
+  {
+    uintptr_t end;
+    u32 effective_address;
+  };
+
+  bool ReadGuestWord(u32 address, u32* value) const;
+  void ProcessSample(const Sample& sample);
+
+  bool m_running = false;
+  u32 m_interval_us = 0;
+
+  // Used by the signal handler.
+  const PowerPC::PowerPCState* m_ppc_state = nullptr;
+  const u8* m_ram = nullptr;
+  u32 m_ram_size = 0;
+  const u8* m_exram = nullptr;
+  u32 m_exram_size = 0;
+  std::unique_ptr<Sample[]> m_samples;
+  std::atomic<u32> m_write_index = 0;
+  std::atomic<u32> m_read_index = 0;
+  std::atomic<u64> m_dropped_samples = 0;
+
+  std::map<uintptr_t, HostRange> m_host_ranges;
+
+  // Call stacks as guest addresses, outermost first. The last address is the start of the block
+  // that was running, or the PC if the sample was taken in host code (followed by HOST_FRAME).
+  std::map<std::vector<u32>, u64> m_stacks;
+  std::unordered_map<u32, u64> m_block_samples;
+  u64 m_sample_count = 0;
+  u64 m_host_sample_count = 0;
+
+#ifdef __linux__
+  timer_t m_timer{};
+#endif
+};
@@ -18,6 +18,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitSamplingProfiler.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -31,7 +32,8 @@
 #include "Core/PowerPC/JitArm64/Jit.h"
 #endif
 
-JitInterface::JitInterface(Core::System& system) : m_system(system)
+JitInterface::JitInterface(Core::System& system)
+    : m_system(system), m_sampling_profiler(std::make_unique<JitSamplingProfiler>())
 {
 }
 
@@ -50,6 +52,11 @@ void JitInterface::DoState(PointerWrap& p)
 
 CPUCoreBase* JitInterface::InitJitCore(PowerPC::CPUCore core)
 {
+  m_tiered_compilation_counters.Reset();
+  m_block_entry_counters.Reset();
+  m_code_space_counters.Reset();
+  m_software_tlb_counters.Reset();
+
   switch (core)
   {
 #ifdef _M_X86_64
@@ -188,6 +195,30 @@ void JitInterface::WipeBlockProfilingData(const Core::CPUThreadGuard& guard)
     m_jit->GetBlockCache()->WipeBlockProfilingData(guard);
 }
 
+bool JitInterface::StartSamplingProfiler(const Core::CPUThreadGuard& guard, u32 samples_per_second)
+{
+  if (!m_jit || !m_sampling_profiler->Start(m_system, samples_per_second))
+    return false;
+
+  // Blocks that are compiled from now on are registered by the block cache.
+  m_jit->GetBlockCache()->RunOnBlocks(
+      guard, [this](const JitBlock& block) { m_sampling_profiler->RegisterBlock(block); });
+  return true;
+}
+
+void JitInterface::StopSamplingProfiler()
+{
+  m_sampling_profiler->Stop();
+}
+
+void JitInterface::SamplingProfileDump(std::FILE* folded_stacks_file,
+                                       std::FILE* top_functions_file) const
+{
+  const PPCSymbolDB& symbol_db = m_system.GetPPCSymbolDB();
+  m_sampling_profiler->WriteFoldedStacks(folded_stacks_file, symbol_db);
+  m_sampling_profiler->WriteTopFunctions(top_functions_file, symbol_db, 50);
+}
+
 void JitInterface::RunOnBlocks(const Core::CPUThreadGuard& guard,
                                std::function<void(const JitBlock&)> f) const
 {
@@ -231,8 +262,11 @@ void JitInterface::ClearCache(const Core::CPUThreadGuard&)
 
 void JitInterface::ClearSafe()
 {
-  if (m_jit)
-    m_jit->GetBlockCache()->Clear();
+  if (!m_jit)
+    return;
+
+  std::lock_guard lk(m_jit->GetCompilerMutex());
+  m_jit->GetBlockCache()->Clear();
 }
 
 void JitInterface::EraseSingleBlock(const JitBlock& block)
@@ -264,14 +298,20 @@ std::size_t JitInterface::DisassembleFarCode(const JitBlock& block, std::ostream
 
 void JitInterface::InvalidateICache(u32 address, u32 size, bool forced)
 {
-  if (m_jit)
-    m_jit->GetBlockCache()->InvalidateICache(address, size, forced);
+  if (!m_jit)
+    return;
+
+  std::lock_guard lk(m_jit->GetCompilerMutex());
+  m_jit->GetBlockCache()->InvalidateICache(address, size, forced);
 }
 
 void JitInterface::InvalidateICacheLine(u32 address)
 {
-  if (m_jit)
-    m_jit->GetBlockCache()->InvalidateICacheLine(address);
+  if (!m_jit)
+    return;
+
+  std::lock_guard lk(m_jit->GetCompilerMutex());
+  m_jit->GetBlockCache()->InvalidateICacheLine(address);
 }
 
 void JitInterface::InvalidateICacheLines(u32 address, u32 count)
@@ -305,6 +345,7 @@ void JitInterface::CompileExceptionCheck(ExceptionType type)
   if (!m_jit)
     return;
 
+  std::lock_guard lk(m_jit->GetCompilerMutex());
   std::unordered_set<u32>* exception_addresses = nullptr;
 
   switch (type)
@@ -347,8 +388,49 @@ void JitInterface::CompileExceptionCheckFromJIT(JitInterface& jit_interface, Exc
   jit_interface.CompileExceptionCheck(type);
 }
 
+void JitInterface::TieredCompilationCounters::Reset()
+{
+  interpreted_blocks = 0;
+  queued_blocks = 0;
+  compiled_blocks = 0;
+  discarded_blocks = 0;
+  precompiled_blocks = 0;
+  total_latency_us = 0;
+  max_latency_us = 0;
+}
+
+void JitInterface::BlockEntryCounters::Reset()
+{
+  block_entries = 0;
+  superblock_entries = 0;
+  superblocks = 0;
+  guest_instructions = 0;
+  register_loads = 0;
+  register_stores = 0;
+  register_loads_skipped = 0;
+}
+
+void JitInterface::CodeSpaceCounters::Reset()
+{
+  flushes = 0;
+  evictions = 0;
+  evicted_blocks = 0;
+  reclaimed_bytes = 0;
+}
+
+void JitInterface::SoftwareTLBCounters::Reset()
+{
+  read_hits = 0;
+  read_misses = 0;
+  write_hits = 0;
+  write_misses = 0;
+  fills = 0;
+}
+
 void JitInterface::Shutdown()
 {
+  m_sampling_profiler->Stop();
+
   if (m_jit)
   {
     m_jit->Shutdown();
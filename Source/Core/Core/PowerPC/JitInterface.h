@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
@@ -19,6 +20,7 @@ class CPUCoreBase;
 class PointerWrap;
 class JitBase;
 struct JitBlock;
+class JitSamplingProfiler;
 
 namespace Core
 {
@@ -92,6 +94,86 @@ public:
   void CompileExceptionCheck(ExceptionType type);
   static void CompileExceptionCheckFromJIT(JitInterface& jit_interface, ExceptionType type);
 
+  // Counters for JITs that interpret new code and compile it on a background thread once it gets
+  // hot. They live here rather than in the JIT so that other threads can read them at any time.
+  struct TieredCompilationCounters
+  {
+    void Reset();
+
+    std::atomic<u64> interpreted_blocks = 0;
+    std::atomic<u64> queued_blocks = 0;
+    std::atomic<u64> compiled_blocks = 0;
+    std::atomic<u64> discarded_blocks = 0;
+    // Blocks that were queued because they were compiled in an earlier session.
+    std::atomic<u64> precompiled_blocks = 0;
+    // Time from queueing a block until it is available to the CPU thread.
+    std::atomic<u64> total_latency_us = 0;
+    std::atomic<u64> max_latency_us = 0;
+  };
+  TieredCompilationCounters& GetTieredCompilationCounters()
+  {
+    return m_tiered_compilation_counters;
+  }
+
+  // Counters for how blocks are entered. They are incremented by the generated code without
+  // synchronization, and only while the JIT forms superblocks.
+  struct BlockEntryCounters
+  {
+    void Reset();
+
+    // Entries into blocks that aren't superblocks, whether from the dispatcher or a link.
+    u64 block_entries = 0;
+    u64 superblock_entries = 0;
+    std::atomic<u64> superblocks = 0;
+    // Guest instructions and GPR loads and stores of the blocks that were entered. Each entry adds
+    // the whole block, so these overcount whenever an earlier exit of the block is taken.
+    u64 guest_instructions = 0;
+    u64 register_loads = 0;
+    u64 register_stores = 0;
+    // Loads of guest registers that blocks skipped because the exit they came from had already
+    // left the registers in host registers.
+    u64 register_loads_skipped = 0;
+  };
+  BlockEntryCounters& GetBlockEntryCounters() { return m_block_entry_counters; }
+
+  // Counters for what the JIT did when it ran out of code space.
+  struct CodeSpaceCounters
+  {
+    void Reset();
+
+    // Times the whole cache was cleared.
+    std::atomic<u64> flushes = 0;
+    // Times the blocks that had gone the longest without running were evicted instead.
+    std::atomic<u64> evictions = 0;
+    std::atomic<u64> evicted_blocks = 0;
+    std::atomic<u64> reclaimed_bytes = 0;
+  };
+  CodeSpaceCounters& GetCodeSpaceCounters() { return m_code_space_counters; }
+
+  // Counters for the software TLB that data accesses look up when they can't use fastmem. The hits
+  // and misses are incremented by the generated code without synchronization, and only while JIT
+  // profiling is enabled.
+  struct SoftwareTLBCounters
+  {
+    void Reset();
+
+    u64 read_hits = 0;
+    u64 read_misses = 0;
+    u64 write_hits = 0;
+    u64 write_misses = 0;
+    // Pages that the MMU entered after a miss.
+    std::atomic<u64> fills = 0;
+  };
+  SoftwareTLBCounters& GetSoftwareTLBCounters() { return m_software_tlb_counters; }
+
+  // Samples the CPU thread to find the guest functions that the JIT spends its time in. Start and
+  // stop it on the CPU thread.
+  bool StartSamplingProfiler(const Core::CPUThreadGuard& guard, u32 samples_per_second);
+  void StopSamplingProfiler();
+  JitSamplingProfiler& GetSamplingProfiler() { return *m_sampling_profiler; }
+  // Writes the samples as folded stacks for flame graphs, and a table of the hottest functions.
+  void SamplingProfileDump(std::FILE* folded_stacks_file, std::FILE* top_functions_file) const;
+
   /// used for the page fault unit test, don't use outside of tests!
   void SetJit(std::unique_ptr<JitBase> jit);
 
@@ -100,4 +182,9 @@ public:
 private:
   std::unique_ptr<JitBase> m_jit;
   Core::System& m_system;
+  TieredCompilationCounters m_tiered_compilation_counters;
+  BlockEntryCounters m_block_entry_counters;
+  CodeSpaceCounters m_code_space_counters;
+  SoftwareTLBCounters m_software_tlb_counters;
+  std::unique_ptr<JitSamplingProfiler> m_sampling_profiler;
 };
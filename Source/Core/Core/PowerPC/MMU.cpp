@@ -918,22 +918,37 @@ std::optional<ReadResult<std::string>> MMU::HostTryReadString(const Core::CPUThr
   return ReadResult<std::string>(c->translated, std::move(s));
 }
 
-bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size) const
+MMU::OptimizableAccessState MMU::GetOptimizableAccessState() const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  return {.dcache_enabled = m_ppc_state.m_enable_dcache,
+          .mem_checks_active = m_power_pc.GetMemChecks().HasAny(),
+          .dbat_table = &m_dbat_table};
+}
+
+bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size,
+                                  const bool msr_dr) const
+{
+  return IsOptimizableRAMAddress(address, access_size, msr_dr, GetOptimizableAccessState());
+}
+
+bool MMU::IsOptimizableRAMAddress(const u32 address, const u32 access_size, const bool msr_dr,
+                                  const OptimizableAccessState& state) const
+{
+  if (state.mem_checks_active)
     return false;
 
-  if (!m_ppc_state.msr.DR)
+  if (!msr_dr)
     return false;
 
-  if (m_ppc_state.m_enable_dcache)
+  if (state.dcache_enabled)
     return false;
 
   // We store whether an access can be optimized to an unchecked access
   // in dbat_table.
+  const BatTable& dbat_table = *state.dbat_table;
   const u32 last_byte_address = address + (access_size >> 3) - 1;
-  const u32 bat_result_1 = m_dbat_table[address >> BAT_INDEX_SHIFT];
-  const u32 bat_result_2 = m_dbat_table[last_byte_address >> BAT_INDEX_SHIFT];
+  const u32 bat_result_1 = dbat_table[address >> BAT_INDEX_SHIFT];
+  const u32 bat_result_2 = dbat_table[last_byte_address >> BAT_INDEX_SHIFT];
   return (bat_result_1 & bat_result_2 & BAT_PHYSICAL_BIT) != 0;
 }
 
@@ -1209,22 +1224,28 @@ void MMU::TouchDCacheLine(u32 address, bool store)
     m_ppc_state.dCache.Touch(m_memory, address, store);
 }
 
-u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
+u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size, bool msr_dr) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  return IsOptimizableMMIOAccess(address, access_size, msr_dr, GetOptimizableAccessState());
+}
+
+u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size, bool msr_dr,
+                                 const OptimizableAccessState& state) const
+{
+  if (state.mem_checks_active)
     return 0;
 
-  if (!m_ppc_state.msr.DR)
+  if (!msr_dr)
     return 0;
 
-  if (m_ppc_state.m_enable_dcache)
+  if (state.dcache_enabled)
     return 0;
 
   // Translate address
   // If we also optimize for TLB mappings, we'd have to clear the
   // JitCache on each TLB invalidation.
   bool wi = false;
-  if (!TranslateBatAddress(m_dbat_table, &address, &wi))
+  if (!TranslateBatAddress(*state.dbat_table, &address, &wi))
     return 0;
 
   // Check whether the address is an aligned address of an MMIO register.
@@ -1235,19 +1256,25 @@ u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
   return address;
 }
 
-bool MMU::IsOptimizableGatherPipeWrite(u32 address) const
+bool MMU::IsOptimizableGatherPipeWrite(u32 address, bool msr_dr) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  return IsOptimizableGatherPipeWrite(address, msr_dr, GetOptimizableAccessState());
+}
+
+bool MMU::IsOptimizableGatherPipeWrite(u32 address, bool msr_dr,
+                                       const OptimizableAccessState& state) const
+{
+  if (state.mem_checks_active)
     return false;
 
-  if (!m_ppc_state.msr.DR)
+  if (!msr_dr)
     return false;
 
   // Translate address, only check BAT mapping.
   // If we also optimize for TLB mappings, we'd have to clear the
   // JitCache on each TLB invalidation.
   bool wi = false;
-  if (!TranslateBatAddress(m_dbat_table, &address, &wi))
+  if (!TranslateBatAddress(*state.dbat_table, &address, &wi))
     return false;
 
   // Check whether the translated address equals the address in WPAR.
@@ -1319,6 +1346,8 @@ void MMU::GenerateISIException(u32 effective_address)
 
 void MMU::SDRUpdated()
 {
+  m_ppc_state.software_tlb.Invalidate();
+
   const auto sdr = UReg_SDR1{m_ppc_state.spr[SPR_SDR]};
   const u32 htabmask = sdr.htabmask;
 
@@ -1424,8 +1453,89 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[PowerPC::DATA_TLB_INDEX][entry_index].Invalidate();
   m_ppc_state.tlb[PowerPC::INST_TLB_INDEX][entry_index].Invalidate();
+
+  // tlbie only looks at the page index bits that select the TLB set, so every software TLB entry
+  // for a page with the same bits has to go.
+  SoftwareTLB& software_tlb = m_ppc_state.software_tlb;
+  for (u32 i = entry_index; i < SoftwareTLB::NUM_ENTRIES; i += HW_PAGE_INDEX_MASK + 1)
+  {
+    software_tlb.read.tags[i] = SoftwareTLB::INVALID_TAG;
+    software_tlb.write.tags[i] = SoftwareTLB::INVALID_TAG;
+  }
+  software_tlb.read.rejected_page = SoftwareTLB::INVALID_TAG;
+  software_tlb.write.rejected_page = SoftwareTLB::INVALID_TAG;
 }
 
+template <XCheckTLBFlag flag>
+void MMU::FillSoftwareTLB(u32 effective_address)
+{
+  static_assert(flag == XCheckTLBFlag::Read || flag == XCheckTLBFlag::Write);
+
+  SoftwareTLB& software_tlb = m_ppc_state.software_tlb;
+  if (!software_tlb.enabled || !m_ppc_state.msr.DR || m_ppc_state.m_enable_dcache)
+    return;
+
+  // Accesses that faulted or hit a memcheck have to keep going through the MMU.
+  if (m_ppc_state.Exceptions & EXCEPTION_DSI)
+    return;
+
+  SoftwareTLB::Table& table =
+      flag == XCheckTLBFlag::Write ? software_tlb.write : software_tlb.read;
+  const u32 page = effective_address & ~HW_PAGE_MASK;
+  if (page == table.rejected_page)
+    return;
+
+  const auto translated_addr = TranslateAddress<flag>(page);
+  if (!translated_addr.Success())
+    return;
+
+  // Write-through and cache-inhibited stores can have side effects (see WriteToHardware).
+  if (flag == XCheckTLBFlag::Write && translated_addr.wi)
+  {
+    table.rejected_page = page;
+    return;
+  }
+
+  const u32 physical_page = translated_addr.address;
+  u8* host_page;
+  if (m_memory.GetL1Cache() && (physical_page >> 28) == 0xE &&
+      physical_page < 0xE0000000 + m_memory.GetL1CacheSize())
+  {
+    host_page = &m_memory.GetL1Cache()[physical_page & 0x0FFFFFFF];
+  }
+  else if (m_memory.GetRAM() && (physical_page & 0xF8000000) == 0x00000000)
+  {
+    host_page = &m_memory.GetRAM()[physical_page & m_memory.GetRamMask()];
+  }
+  else if (m_memory.GetEXRAM() && (physical_page >> 28) == 0x1 &&
+           (physical_page & 0x0FFFFFFF) < m_memory.GetExRamSizeReal())
+  {
+    host_page = &m_memory.GetEXRAM()[physical_page & 0x0FFFFFFF];
+  }
+  else if (m_memory.GetFakeVMEM() && (physical_page & 0xFE000000) == 0x7E000000)
+  {
+    host_page = &m_memory.GetFakeVMEM()[physical_page & m_memory.GetFakeVMemMask()];
+  }
+  else
+  {
+    // MMIO, the EFB and the gather pipe.
+    table.rejected_page = page;
+    return;
+  }
+
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(page, HW_PAGE_SIZE))
+    return;
+
+  const u32 index = (page >> HW_PAGE_INDEX_SHIFT) & (SoftwareTLB::NUM_ENTRIES - 1);
+  table.tags[index] = page;
+  table.host_offsets[index] = reinterpret_cast<uintptr_t>(host_page) - page;
+
+  m_system.GetJitInterface().GetSoftwareTLBCounters().fills++;
+}
+
+template void MMU::FillSoftwareTLB<XCheckTLBFlag::Read>(u32 effective_address);
+template void MMU::FillSoftwareTLB<XCheckTLBFlag::Write>(u32 effective_address);
+
 // Page Address Translation
 template <const XCheckTLBFlag flag>
 MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress address, bool* wi)
@@ -1649,11 +1759,14 @@ void MMU::DBATUpdated()
     UpdateFakeMMUBat(m_dbat_table, 0x40000000);
     UpdateFakeMMUBat(m_dbat_table, 0x70000000);
   }
+  ++m_dbat_generation;
 
 #ifndef _ARCH_32
   m_memory.UpdateLogicalMemory(m_dbat_table);
 #endif
 
+  m_ppc_state.software_tlb.Invalidate();
+
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   m_system.GetJitInterface().ClearSafe();
 }
@@ -1705,46 +1818,61 @@ void ClearDCacheLineFromJit(MMU& mmu, u32 address)
 }
 u32 ReadU8FromJit(MMU& mmu, u32 address)
 {
-  return mmu.Read_U8(address);
+  const u32 var = mmu.Read_U8(address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Read>(address);
+  return var;
 }
 u32 ReadU16FromJit(MMU& mmu, u32 address)
 {
-  return mmu.Read_U16(address);
+  const u32 var = mmu.Read_U16(address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Read>(address);
+  return var;
 }
 u32 ReadU32FromJit(MMU& mmu, u32 address)
 {
-  return mmu.Read_U32(address);
+  const u32 var = mmu.Read_U32(address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Read>(address);
+  return var;
 }
 u64 ReadU64FromJit(MMU& mmu, u32 address)
 {
-  return mmu.Read_U64(address);
+  const u64 var = mmu.Read_U64(address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Read>(address);
+  return var;
 }
 void WriteU8FromJit(MMU& mmu, u32 var, u32 address)
 {
   mmu.Write_U8(var, address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Write>(address);
 }
 void WriteU16FromJit(MMU& mmu, u32 var, u32 address)
 {
   mmu.Write_U16(var, address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Write>(address);
 }
 void WriteU32FromJit(MMU& mmu, u32 var, u32 address)
 {
   mmu.Write_U32(var, address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Write>(address);
 }
 void WriteU64FromJit(MMU& mmu, u64 var, u32 address)
 {
   mmu.Write_U64(var, address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Write>(address);
 }
 void WriteU16SwapFromJit(MMU& mmu, u32 var, u32 address)
 {
   mmu.Write_U16_Swap(var, address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Write>(address);
 }
 void WriteU32SwapFromJit(MMU& mmu, u32 var, u32 address)
 {
   mmu.Write_U32_Swap(var, address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Write>(address);
 }
 void WriteU64SwapFromJit(MMU& mmu, u64 var, u32 address)
 {
   mmu.Write_U64_Swap(var, address);
+  mmu.FillSoftwareTLB<XCheckTLBFlag::Write>(address);
 }
 }  // namespace PowerPC
@@ -242,12 +242,34 @@ public:
   void DBATUpdated();
   void IBATUpdated();
 
+  // Enters the page of a data access into the software TLB if a hit can be handled by the JIT
+  // without the checks that the MMU does. Called after the access has been made.
+  template <XCheckTLBFlag flag>
+  void FillSoftwareTLB(u32 effective_address);
+
+  // Everything besides MSR.DR that the IsOptimizable* functions depend on. The JIT captures it on
+  // the CPU thread for blocks that it compiles on another thread.
+  struct OptimizableAccessState
+  {
+    bool dcache_enabled = false;
+    bool mem_checks_active = false;
+    const BatTable* dbat_table = nullptr;
+  };
+  // Returns the live state, which may only be used on the CPU thread.
+  OptimizableAccessState GetOptimizableAccessState() const;
+
   // Result changes based on the BAT registers and MSR.DR.  Returns whether
   // it's safe to optimize a read or write to this address to an unguarded
   // memory access.  Does not consider page tables.
-  bool IsOptimizableRAMAddress(u32 address, u32 access_size) const;
-  u32 IsOptimizableMMIOAccess(u32 address, u32 access_size) const;
-  bool IsOptimizableGatherPipeWrite(u32 address) const;
+  bool IsOptimizableRAMAddress(u32 address, u32 access_size, bool msr_dr) const;
+  u32 IsOptimizableMMIOAccess(u32 address, u32 access_size, bool msr_dr) const;
+  bool IsOptimizableGatherPipeWrite(u32 address, bool msr_dr) const;
+  bool IsOptimizableRAMAddress(u32 address, u32 access_size, bool msr_dr,
+                               const OptimizableAccessState& state) const;
+  u32 IsOptimizableMMIOAccess(u32 address, u32 access_size, bool msr_dr,
+                              const OptimizableAccessState& state) const;
+  bool IsOptimizableGatherPipeWrite(u32 address, bool msr_dr,
+                                    const OptimizableAccessState& state) const;
 
   TranslateResult JitCache_TranslateAddress(u32 address);
 
@@ -255,6 +277,8 @@ public:
 
   BatTable& GetIBATTable() { return m_ibat_table; }
   BatTable& GetDBATTable() { return m_dbat_table; }
+  // Changes whenever the DBAT table is rebuilt, so that copies of it can be kept up to date.
+  u32 GetDBATGeneration() const { return m_dbat_generation; }
 
 private:
   enum class TranslateAddressResultEnum : u8
@@ -327,6 +351,7 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+  u32 m_dbat_generation = 0;
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
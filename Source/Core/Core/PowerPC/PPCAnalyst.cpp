@@ -43,6 +43,10 @@ namespace PPCAnalyst
 {
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+// Used instead of BRANCH_FOLLOWING_THRESHOLD for blocks analyzed with OPTION_SUPERBLOCK.
+constexpr u32 SUPERBLOCK_FOLLOWING_THRESHOLD = 8;
+// Calls beyond BRANCH_FOLLOWING_THRESHOLD are only followed into leaf functions up to this size.
+constexpr u32 SUPERBLOCK_MAX_LEAF_INSTRUCTIONS = 16;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
@@ -225,6 +229,30 @@ static bool InstructionCanEndBlock(const CodeOp& op)
           GetSPRIndex(op.inst) == SPR_MMCR1);
 }
 
+// Checks whether the function at the given address returns within a few instructions, without
+// branching or doing anything else that would end a block on the way.
+static bool IsSmallLeafFunction(PowerPC::MMU& mmu, u32 address)
+{
+  for (u32 i = 0; i < SUPERBLOCK_MAX_LEAF_INSTRUCTIONS; ++i, address += 4)
+  {
+    const auto result = mmu.TryReadInstruction(address);
+    if (!result.valid)
+      return false;
+
+    const UGeckoInstruction inst = result.hex;
+    if (inst.OPCD == 19 && inst.SUBOP10 == 16 && !inst.LK &&
+        (inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION))
+    {
+      return true;
+    }
+
+    const GekkoOPInfo* opinfo = PPCTables::GetOpInfo(inst, address);
+    if (opinfo->type == OpType::Branch || (opinfo->flags & FL_ENDBLOCK))
+      return false;
+  }
+  return false;
+}
+
 bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
 {
   const GekkoOPInfo* a_info = a.opinfo;
@@ -828,10 +856,21 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   u32 numFollows = 0;
   u32 num_inst = 0;
 
-  const bool enable_follow = m_enable_branch_following;
+  const bool superblock = HasOption(OPTION_SUPERBLOCK);
+  const bool enable_follow = m_enable_branch_following || superblock;
+  const u32 follow_threshold =
+      superblock ? SUPERBLOCK_FOLLOWING_THRESHOLD : BRANCH_FOLLOWING_THRESHOLD;
+  block->m_superblock = superblock;
 
   auto& system = Core::System::GetInstance();
   auto& mmu = system.GetMMU();
+
+  // Superblocks spend the follows beyond the usual threshold on calls only if the call can be
+  // followed all the way back to the caller.
+  const auto can_follow_call = [&](u32 target) {
+    return !superblock || numFollows < BRANCH_FOLLOWING_THRESHOLD ||
+           (numFollows + 1 < follow_threshold && IsSmallLeafFunction(mmu, target));
+  };
   for (std::size_t i = 0; i < block_size; ++i)
   {
     auto result = mmu.TryReadInstruction(address);
@@ -869,29 +908,35 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       if (inst.OPCD == 18 && block_size > 1)
       {
         // Always follow BX instructions.
-        follow = true;
-        if (inst.LK)
+        if (!inst.LK || can_follow_call(code[i].branchTo))
         {
-          found_call = true;
-          caller = i;
+          follow = true;
+          if (inst.LK)
+          {
+            found_call = true;
+            caller = i;
+          }
         }
       }
       else if (inst.OPCD == 16 && (inst.BO & BO_DONT_DECREMENT_FLAG) &&
                (inst.BO & BO_DONT_CHECK_CONDITION) && block_size > 1)
       {
         // Always follow unconditional BCX instructions, but they are very rare.
-        follow = true;
-        if (inst.LK)
+        if (!inst.LK || can_follow_call(code[i].branchTo))
         {
-          found_call = true;
-          caller = i;
+          follow = true;
+          if (inst.LK)
+          {
+            found_call = true;
+            caller = i;
+          }
         }
       }
       else if (inst.OPCD == 19 && inst.SUBOP10 == 16 && !inst.LK && found_call)
       {
         code[i].branchTo = code[caller].address + 4;
         if ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION) &&
-            numFollows < BRANCH_FOLLOWING_THRESHOLD)
+            numFollows < follow_threshold)
         {
           // bclrx with unconditional branch = return
           // Follow it if we can propagate the LR value of the last CALL instruction.
@@ -945,7 +990,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
-    if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (follow && numFollows < follow_threshold)
     {
       // Follow the unconditional branch.
       numFollows++;
@@ -130,6 +130,9 @@ struct CodeBlock
 
   // Which memory locations are occupied by this block.
   std::set<u32> m_physical_addresses;
+
+  // Was this block analyzed with OPTION_SUPERBLOCK?
+  bool m_superblock = false;
 };
 
 class PPCAnalyzer
@@ -171,6 +174,10 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // For blocks that run often: follow more unconditional branches, and follow calls into small
+    // leaf functions along with their returns, even if branch following is disabled otherwise.
+    OPTION_SUPERBLOCK = (1 << 7),
   };
 
   // Option setting/getting
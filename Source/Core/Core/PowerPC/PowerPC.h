@@ -68,6 +68,42 @@ struct TLBEntry
   void Invalidate() { tag.fill(INVALID_TAG); }
 };
 
+// A direct-mapped cache of translations from effective pages to host memory, for data accesses
+// made with MSR.DR set. The JIT looks up accesses in it inline before calling into the MMU, and the
+// MMU fills it. Only pages that are backed by memory and that have no memchecks are entered, so a
+// hit can skip all of the MMU's checks.
+struct SoftwareTLB
+{
+  static constexpr u32 NUM_ENTRIES = 1024;
+  // Tags are page addresses, which never have the lowest bit set.
+  static constexpr u32 INVALID_TAG = 1;
+
+  struct Table
+  {
+    std::array<u32, NUM_ENTRIES> tags;
+    // Adding an effective address in the page to this gives its host address.
+    std::array<uintptr_t, NUM_ENTRIES> host_offsets;
+    // The last page that was found to not be backed by memory, usually MMIO. Accesses to it keep
+    // missing, so this saves translating it again after each one.
+    u32 rejected_page;
+  };
+
+  SoftwareTLB() { Invalidate(); }
+
+  void Invalidate()
+  {
+    read.tags.fill(INVALID_TAG);
+    write.tags.fill(INVALID_TAG);
+    read.rejected_page = INVALID_TAG;
+    write.rejected_page = INVALID_TAG;
+  }
+
+  // Set by the JIT that uses it, so that the MMU doesn't fill it otherwise.
+  bool enabled = false;
+  Table read;
+  Table write;
+};
+
 struct PairedSingle
 {
   u64 PS0AsU64() const { return ps0; }
@@ -176,6 +212,7 @@ struct PowerPCState
   u8* mem_ptr = nullptr;
 
   std::array<std::array<TLBEntry, TLB_SIZE / TLB_WAYS>, NUM_TLBS> tlb;
+  SoftwareTLB software_tlb;
 
   u32 pagetable_base = 0;
   u32 pagetable_hashmask = 0;
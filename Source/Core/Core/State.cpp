@@ -4,8 +4,10 @@
 #include "Core/State.h"
 
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <filesystem>
+#include <functional>
 #include <locale>
 #include <map>
 #include <memory>
@@ -17,7 +19,6 @@
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 
-#include <lz4.h>
 #include <lzo/lzo1x.h>
 
 #include "Common/ChunkFile.h"
@@ -33,10 +34,13 @@
 #include "Common/WorkQueueThread.h"
 
 #include "Core/AchievementManager.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/DSPEmulator.h"
 #include "Core/GeckoCode.h"
+#include "Core/HW/DSP.h"
 #include "Core/HW/HW.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/Wiimote.h"
@@ -44,8 +48,12 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayProto.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateCompression.h"
+#include "Core/StateDelta.h"
+#include "Core/StateRewind.h"
 #include "Core/System.h"
 
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -77,6 +85,8 @@ struct CompressAndDumpState_args
   Common::UniqueBuffer<u8> buffer;
   std::string filename;
   std::shared_ptr<Common::Event> state_write_done_event;
+  CompressionType compression_type = CompressionType::Uncompressed;
+  int zstd_level = DEFAULT_STATE_ZSTD_LEVEL;
 };
 
 // Protects against simultaneous reads and writes to the final savestate location from multiple
@@ -130,12 +140,19 @@ enum
 
 static bool s_use_compression = true;
 
+static RewindBuffer s_rewind_buffer;
+static std::atomic<bool> s_rewind_capture_pending = false;
+
 void EnableCompression(bool compression)
 {
   s_use_compression = compression;
 }
 
-static void DoState(Core::System& system, PointerWrap& p)
+// end_section is called at the end of each top-level section of the state. Sections are compared
+// separately when creating deltas (see StateDelta.h), so the parts whose size changes from frame
+// to frame are kept apart from the emulated memory.
+static void DoState(Core::System& system, PointerWrap& p,
+                    const std::function<void()>& end_section = [] {})
 {
   bool is_wii = system.IsWii() || system.IsMIOS();
   const bool is_wii_currently = is_wii;
@@ -172,23 +189,28 @@ static void DoState(Core::System& system, PointerWrap& p)
   // state load, and the frame number must be up-to-date.
   system.GetMovie().DoState(p);
   p.DoMarker("Movie");
+  end_section();
 
   // Begin with video backend, so that it gets a chance to clear its caches and writeback modified
   // things to RAM
   g_video_backend->DoState(p);
   p.DoMarker("video_backend");
+  end_section();
 
   // CoreTiming needs to be restored before restoring Hardware because
   // the controller code might need to schedule an event if the controller has changed.
   system.GetCoreTiming().DoState(p);
   p.DoMarker("CoreTiming");
+  end_section();
 
   // HW needs to be restored before PowerPC because the data cache might need to be flushed.
   HW::DoState(system, p);
   p.DoMarker("HW");
+  end_section();
 
   system.GetPowerPC().DoState(p);
   p.DoMarker("PowerPC");
+  end_section();
 
   if (system.IsWii())
     Wiimote::DoState(p);
@@ -225,24 +247,153 @@ void LoadFromBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer)
       true);
 }
 
+// Must be called on the CPU thread. Grows buffer if needed and returns the number of bytes used.
+// If sections isn't null, it receives where the sections of the state end.
+static size_t SerializeToBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer,
+                                StateSections* sections = nullptr)
+{
+  // The size of a state rarely changes while a game is running, so try writing into the existing
+  // buffer first instead of always doing a separate measuring pass. If the buffer is too small,
+  // the PointerWrap switches to measure mode and we end up with the required size.
+  u8* ptr = buffer.data();
+  const auto end_section = [&] {
+    if (sections)
+      sections->push_back(ptr - buffer.data());
+  };
+
+  if (sections)
+    sections->clear();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  DoState(system, p, end_section);
+
+  const size_t size = ptr - buffer.data();
+  if (!p.IsWriteMode())
+  {
+    buffer.reset(size);
+    ptr = buffer.data();
+    if (sections)
+      sections->clear();
+    PointerWrap p_retry(&ptr, buffer.size(), PointerWrap::Mode::Write);
+    DoState(system, p_retry, end_section);
+  }
+
+  end_section();
+  return size;
+}
+
 void SaveToBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer)
+{
+  Core::RunOnCPUThread(system, [&] { SerializeToBuffer(system, buffer); }, true);
+}
+
+// Snapshots are taken on the CPU thread without going through Core::PauseAndLock, so the threads
+// that it would pause have to be stopped here. This also syncs the GPU, which matters in
+// deterministic dual core mode.
+static void PauseAndLockForSnapshot(Core::System& system, bool do_lock)
+{
+  system.GetDSP().GetDSPEmulator()->PauseAndLock(do_lock);
+  system.GetFifo().PauseAndLock(do_lock, true);
+}
+
+size_t SaveSnapshot(Core::System& system, Common::UniqueBuffer<u8>& buffer)
+{
+  PauseAndLockForSnapshot(system, true);
+  const size_t size = SerializeToBuffer(system, buffer);
+  PauseAndLockForSnapshot(system, false);
+  return size;
+}
+
+bool LoadSnapshot(Core::System& system, std::span<const u8> snapshot)
+{
+  PauseAndLockForSnapshot(system, true);
+  u8* ptr = const_cast<u8*>(snapshot.data());
+  PointerWrap p(&ptr, snapshot.size(), PointerWrap::Mode::Read);
+  DoState(system, p);
+  PauseAndLockForSnapshot(system, false);
+  return p.IsReadMode();
+}
+
+static bool IsRewindAllowed()
+{
+  return Config::Get(Config::MAIN_REWIND_ENABLED) && !NetPlay::IsNetPlayRunning() &&
+         !AchievementManager::GetInstance().IsHardcoreModeActive();
+}
+
+static void CaptureRewindState(Core::System& system)
 {
+  Core::RunOnCPUThread(
+      system,
+      [&system] {
+        const auto start = Clock::now();
+        Common::UniqueBuffer<u8> buffer = s_rewind_buffer.TakeSpareBuffer();
+        StateSections sections;
+        SerializeToBuffer(system, buffer, &sections);
+        s_rewind_buffer.Push(system.GetMovie().GetCurrentFrame(), std::move(buffer),
+                             std::move(sections), DT_ms(Clock::now() - start).count());
+      },
+      true);
+
+  s_rewind_capture_pending.store(false);
+}
+
+void OnFrameEnd(Core::System& system)
+{
+  if (!IsRewindAllowed() || s_rewind_capture_pending.load())
+    return;
+
+  if (s_rewind_buffer.HasCaptureForFrame(system.GetMovie().GetCurrentFrame()))
+    return;
+
+  // Serializing from inside the VI event would leave CoreTiming in an inconsistent state, so take
+  // the capture from the host thread at the next point where the CPU thread can be paused.
+  s_rewind_capture_pending.store(true);
+  Core::QueueHostJob(&CaptureRewindState);
+}
+
+void RewindStepBack(Core::System& system)
+{
+  if (!Config::Get(Config::MAIN_REWIND_ENABLED))
+    return;
+
+  if (!IsRewindAllowed())
+  {
+    OSD::AddMessage("Rewinding is disabled in Netplay and RetroAchievements hardcore mode");
+    return;
+  }
+
+  bool restored = false;
+  u64 restored_frame = 0;
   Core::RunOnCPUThread(
       system,
       [&] {
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-        DoState(system, p_measure);
+        const u64 current_frame = system.GetMovie().GetCurrentFrame();
+        const u64 interval = s_rewind_buffer.GetFrameInterval();
+        const u64 target_frame = current_frame > interval ? current_frame - interval : 0;
 
-        const size_t new_buffer_size = ptr - (u8*)(nullptr);
-        if (new_buffer_size > buffer.size())
-          buffer.reset(new_buffer_size);
+        Common::UniqueBuffer<u8> buffer;
+        if (!s_rewind_buffer.Restore(target_frame, buffer, &restored_frame))
+          return;
 
-        ptr = buffer.data();
-        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+        u8* ptr = buffer.data();
+        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
         DoState(system, p);
+        if (p.IsReadMode())
+        {
+          s_rewind_buffer.DiscardAfter(restored_frame);
+          restored = true;
+        }
       },
       true);
+
+  if (restored)
+    OSD::AddMessage(fmt::format("Rewound to frame {}", restored_frame));
+  else
+    OSD::AddMessage("No earlier rewind state is available");
+}
+
+RewindStats GetRewindStats()
+{
+  return s_rewind_buffer.GetStats();
 }
 
 namespace
@@ -309,50 +460,64 @@ static std::vector<SlotWithTimestamp> GetUsedSlotsWithTimestamp()
   return result;
 }
 
-static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f)
+static bool CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f)
 {
-  u64 total_bytes_compressed = 0;
-
-  while (true)
+  const Common::UniqueBuffer<u8> compressed = CompressLZ4Stream({raw_buffer, size});
+  if (compressed.empty())
   {
-    const u64 bytes_left_to_compress = size - total_bytes_compressed;
+    PanicAlertFmtT("Internal LZ4 Error - compression failed");
+    return false;
+  }
 
-    const int bytes_to_compress =
-        static_cast<int>(std::min(static_cast<u64>(LZ4_MAX_INPUT_SIZE), bytes_left_to_compress));
-    Common::UniqueBuffer<char> compressed_buffer(LZ4_compressBound(bytes_to_compress));
-    const int compressed_len = LZ4_compress_default(
-        reinterpret_cast<const char*>(raw_buffer) + total_bytes_compressed, compressed_buffer.get(),
-        bytes_to_compress, int(compressed_buffer.size()));
+  return f.WriteBytes(compressed.data(), compressed.size());
+}
 
-    if (compressed_len == 0)
-    {
-      PanicAlertFmtT("Internal LZ4 Error - compression failed");
-      break;
-    }
+static bool CompressBufferToFileChunked(const u8* raw_buffer, u64 size, File::IOFile& f,
+                                        CompressionType compression_type, int zstd_level)
+{
+  const Common::UniqueBuffer<u8> compressed =
+      CompressChunked({raw_buffer, size}, compression_type, zstd_level);
+  if (compressed.empty())
+  {
+    PanicAlertFmtT("Internal error - chunked state compression failed");
+    return false;
+  }
+
+  return f.WriteBytes(compressed.data(), compressed.size());
+}
 
-    // The size of the data to write is 'compressed_len'
-    f.WriteArray(&compressed_len, 1);
-    f.WriteBytes(compressed_buffer.get(), compressed_len);
+static CompressionType GetConfiguredCompressionType()
+{
+  if (!s_use_compression)
+    return CompressionType::Uncompressed;
 
-    total_bytes_compressed += bytes_to_compress;
-    if (total_bytes_compressed == size)
-      break;
+  const CompressionType type = Config::Get(Config::MAIN_STATE_COMPRESSION_TYPE);
+  switch (type)
+  {
+  case CompressionType::Uncompressed:
+  case CompressionType::LZ4:
+  case CompressionType::ChunkedLZ4:
+  case CompressionType::ChunkedZstd:
+    return type;
+  default:
+    return CompressionType::ChunkedLZ4;
   }
 }
 
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
+static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size,
+                                 CompressionType compression_type)
 {
   StateExtendedBaseHeader& base_header = extended_header.base_header;
   base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
+  base_header.compression_type = compression_type;
   base_header.payload_offset = COMPRESSED_DATA_OFFSET;
   base_header.uncompressed_size = uncompressed_size;
 
   // If more fields are added to StateExtendedHeader, set them here.
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+static void WriteHeadersToFile(size_t uncompressed_size, CompressionType compression_type,
+                               File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -364,7 +529,7 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
   StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
+  CreateExtendedHeader(extended_header, uncompressed_size, compression_type);
 
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
@@ -398,12 +563,37 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  const CompressionType compression_type = save_args.compression_type;
+  WriteHeadersToFile(buffer_size, compression_type, f);
 
-  if (s_use_compression)
-    CompressBufferToFile(buffer_data, buffer_size, f);
-  else
+  const auto compression_start = Clock::now();
+  bool compressed = true;
+  switch (compression_type)
+  {
+  case CompressionType::LZ4:
+    compressed = CompressBufferToFile(buffer_data, buffer_size, f);
+    break;
+  case CompressionType::ChunkedLZ4:
+  case CompressionType::ChunkedZstd:
+    compressed = CompressBufferToFileChunked(buffer_data, buffer_size, f, compression_type,
+                                             save_args.zstd_level);
+    break;
+  default:
     f.WriteBytes(buffer_data, buffer_size);
+    break;
+  }
+  INFO_LOG_FMT(CORE, "Wrote {} byte state with {} in {:.2f} ms ({} bytes on disk)", buffer_size,
+               GetCompressionTypeName(compression_type, save_args.zstd_level),
+               DT_ms(Clock::now() - compression_start).count(), f.Tell());
+
+  // A file with headers but no payload must not replace the previous state.
+  if (!compressed)
+  {
+    f.Close();
+    File::Delete(temp_filename);
+    Core::DisplayMessage("Failed to compress state file", 2000);
+    return;
+  }
 
   if (!f.IsGood())
     Core::DisplayMessage("Failed to write state file", 2000);
@@ -493,6 +683,8 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           CompressAndDumpState_args save_args;
           save_args.buffer = std::move(current_buffer);
           save_args.filename = filename;
+          save_args.compression_type = GetConfiguredCompressionType();
+          save_args.zstd_level = Config::Get(Config::MAIN_STATE_ZSTD_LEVEL);
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -652,58 +844,57 @@ u64 GetUnixTimeOfSlot(int slot)
 
 static bool DecompressLZ4(Common::UniqueBuffer<u8>& raw_buffer, u64 size, File::IOFile& f)
 {
-  raw_buffer.reset(size);
-
-  u64 total_bytes_read = 0;
-  while (true)
+  const u64 position = f.Tell();
+  const u64 file_size = f.GetSize();
+  if (position > file_size)
   {
-    s32 compressed_data_len;
-    if (!f.ReadArray(&compressed_data_len, 1))
-    {
-      PanicAlertFmt("Could not read state data length");
-      return false;
-    }
-
-    if (compressed_data_len <= 0)
-    {
-      PanicAlertFmtT("Internal LZ4 Error - Tried decompressing {0} bytes", compressed_data_len);
-      return false;
-    }
+    PanicAlertFmt("Could not read state data");
+    return false;
+  }
 
-    Common::UniqueBuffer<char> compressed_data(compressed_data_len);
-    if (!f.ReadBytes(compressed_data.get(), compressed_data_len))
-    {
-      PanicAlertFmt("Could not read state data");
-      return false;
-    }
+  Common::UniqueBuffer<u8> compressed(static_cast<size_t>(file_size - position));
+  if (!f.ReadBytes(compressed.data(), compressed.size()))
+  {
+    PanicAlertFmt("Could not read state data");
+    return false;
+  }
 
-    u32 max_decompress_size =
-        static_cast<u32>(std::min((u64)LZ4_MAX_INPUT_SIZE, size - total_bytes_read));
+  raw_buffer.reset(size);
+  if (!DecompressLZ4Stream(compressed, raw_buffer))
+  {
+    PanicAlertFmtT("Internal LZ4 Error - decompression failed");
+    return false;
+  }
 
-    int bytes_read = LZ4_decompress_safe(
-        compressed_data.get(), reinterpret_cast<char*>(raw_buffer.data()) + total_bytes_read,
-        compressed_data_len, max_decompress_size);
+  return true;
+}
 
-    if (bytes_read < 0)
-    {
-      PanicAlertFmtT("Internal LZ4 Error - decompression failed ({0}, {1}, {2})", bytes_read,
-                     compressed_data_len, max_decompress_size);
-      return false;
-    }
+static bool DecompressChunkedFromFile(Common::UniqueBuffer<u8>& raw_buffer, u64 size,
+                                      CompressionType compression_type, File::IOFile& f)
+{
+  const u64 position = f.Tell();
+  const u64 file_size = f.GetSize();
+  if (position > file_size)
+  {
+    PanicAlertFmt("Could not read state data");
+    return false;
+  }
 
-    total_bytes_read += static_cast<u64>(bytes_read);
+  Common::UniqueBuffer<u8> compressed(static_cast<size_t>(file_size - position));
+  if (!f.ReadBytes(compressed.data(), compressed.size()))
+  {
+    PanicAlertFmt("Could not read state data");
+    return false;
+  }
 
-    if (total_bytes_read == size)
-    {
-      return true;
-    }
-    else if (total_bytes_read > size)
-    {
-      PanicAlertFmtT("Internal LZ4 Error - payload size mismatch ({0} / {1}))", total_bytes_read,
-                     size);
-      return false;
-    }
+  raw_buffer.reset(size);
+  if (!DecompressChunked(compressed, compression_type, raw_buffer))
+  {
+    PanicAlertFmtT("Internal error - chunked state decompression failed");
+    return false;
   }
+
+  return true;
 }
 
 static bool ValidateHeaders(const StateHeader& header)
@@ -793,7 +984,10 @@ static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<
 
   Common::UniqueBuffer<u8> buffer;
 
-  switch (extended_header.base_header.compression_type)
+  const auto decompression_start = Clock::now();
+  const auto compression_type =
+      static_cast<CompressionType>(extended_header.base_header.compression_type);
+  switch (compression_type)
   {
   case CompressionType::LZ4:
   {
@@ -803,6 +997,18 @@ static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<
 
     break;
   }
+  case CompressionType::ChunkedLZ4:
+  case CompressionType::ChunkedZstd:
+  {
+    Core::DisplayMessage("Decompressing State...", OSD::Duration::SHORT);
+    if (!DecompressChunkedFromFile(buffer, extended_header.base_header.uncompressed_size,
+                                   compression_type, f))
+    {
+      return;
+    }
+
+    break;
+  }
   case CompressionType::Uncompressed:
   {
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
@@ -831,6 +1037,10 @@ static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<
     return;
   }
 
+  INFO_LOG_FMT(CORE, "Read {} byte state with {} in {:.2f} ms", buffer.size(),
+               GetCompressionTypeName(compression_type),
+               DT_ms(Clock::now() - decompression_start).count());
+
   // all good
   ret_data.swap(buffer);
 }
@@ -925,6 +1135,10 @@ void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
 
 void Init(Core::System& system)
 {
+  s_rewind_capture_pending.store(false);
+  s_rewind_buffer.Reset(Config::Get(Config::MAIN_REWIND_FRAME_INTERVAL),
+                        u64(Config::Get(Config::MAIN_REWIND_MEMORY_MB)) * 1024 * 1024);
+
   s_save_thread.Reset("Savestate Worker", [&system](CompressAndDumpState_args args) {
     CompressAndDumpState(system, args);
 
@@ -942,6 +1156,7 @@ void Init(Core::System& system)
 void Shutdown()
 {
   s_save_thread.Shutdown();
+  s_rewind_buffer.Shutdown();
 
   std::lock_guard lk(s_undo_load_buffer_mutex);
   s_undo_load_buffer.reset();
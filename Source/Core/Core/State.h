@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <span>
 #include <string>
 #include <type_traits>
 
@@ -20,6 +21,8 @@ class System;
 
 namespace State
 {
+struct RewindStats;
+
 // number of states
 static const u32 NUM_STATES = 10;
 
@@ -55,6 +58,9 @@ enum CompressionType : u16
 {
   Uncompressed = 0,
   LZ4 = 1,
+  // Independently compressed chunks preceded by a chunk table, see StateCompression.h.
+  ChunkedLZ4 = 2,
+  ChunkedZstd = 3,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
 };
@@ -109,6 +115,20 @@ void LoadAs(Core::System& system, const std::string& filename);
 void SaveToBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer);
 void LoadFromBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer);
 
+// Snapshots for rollback. These run directly on the CPU thread, which must be at a point where the
+// emulated state is consistent (see CoreTimingManager::RunAtSafePoint). They pause the GPU and DSP
+// threads themselves. Unlike LoadFromBuffer, loading a snapshot isn't blocked during NetPlay.
+// buffer is reused between calls and can be larger than the returned size.
+size_t SaveSnapshot(Core::System& system, Common::UniqueBuffer<u8>& buffer);
+bool LoadSnapshot(Core::System& system, std::span<const u8> snapshot);
+
+// Rewind. OnFrameEnd is called on the CPU thread at the end of every frame and schedules a capture
+// into the in-memory rewind buffer when one is due. RewindStepBack goes back at least one capture
+// interval and drops the history after the restored point.
+void OnFrameEnd(Core::System& system);
+void RewindStepBack(Core::System& system);
+RewindStats GetRewindStats();
+
 void LoadLastSaved(Core::System& system, int i = 1);
 void SaveFirstSaved(Core::System& system);
 void UndoSaveState(Core::System& system);
@@ -0,0 +1,293 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateCompression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lz4.h>
+#include <zstd.h>
+
+#include "Common/Logging/Log.h"
+
+namespace State
+{
+// Runs function(index) for every index in [0, count), spread over as many threads as useful.
+template <typename Function>
+static void ParallelForEachChunk(size_t count, Function function)
+{
+  const size_t threads =
+      std::min<size_t>(count, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+  if (threads <= 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+      function(i);
+    return;
+  }
+
+  std::vector<std::future<void>> futures(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    futures[i] = std::async(
+        std::launch::async,
+        [&function](size_t start, size_t end) {
+          for (size_t j = start; j < end; ++j)
+            function(j);
+        },
+        i * count / threads, (i + 1) * count / threads);
+  }
+
+  for (std::future<void>& future : futures)
+    future.get();
+}
+
+bool IsChunkedCompressionType(CompressionType type)
+{
+  return type == CompressionType::ChunkedLZ4 || type == CompressionType::ChunkedZstd;
+}
+
+std::string GetCompressionTypeName(CompressionType type, int zstd_level)
+{
+  switch (type)
+  {
+  case CompressionType::Uncompressed:
+    return "uncompressed";
+  case CompressionType::LZ4:
+    return "lz4";
+  case CompressionType::ChunkedLZ4:
+    return "chunked-lz4";
+  case CompressionType::ChunkedZstd:
+    return zstd_level == 0 ? "chunked-zstd" : fmt::format("chunked-zstd-{}", zstd_level);
+  default:
+    return fmt::format("unknown-{}", static_cast<u16>(type));
+  }
+}
+
+static size_t CompressBound(CompressionType type, size_t size)
+{
+  if (type == CompressionType::ChunkedZstd)
+    return ZSTD_compressBound(size);
+  return static_cast<size_t>(LZ4_compressBound(static_cast<int>(size)));
+}
+
+// Returns the compressed size, or 0 on failure.
+static size_t CompressChunk(CompressionType type, int zstd_level, std::span<const u8> in,
+                            std::span<u8> out)
+{
+  if (type == CompressionType::ChunkedZstd)
+  {
+    const size_t result = ZSTD_compress(out.data(), out.size(), in.data(), in.size(), zstd_level);
+    return ZSTD_isError(result) ? 0 : result;
+  }
+
+  const int result = LZ4_compress_default(reinterpret_cast<const char*>(in.data()),
+                                          reinterpret_cast<char*>(out.data()),
+                                          static_cast<int>(in.size()), static_cast<int>(out.size()));
+  return result <= 0 ? 0 : static_cast<size_t>(result);
+}
+
+static bool DecompressChunk(CompressionType type, std::span<const u8> in, std::span<u8> out)
+{
+  if (type == CompressionType::ChunkedZstd)
+  {
+    const size_t result = ZSTD_decompress(out.data(), out.size(), in.data(), in.size());
+    return !ZSTD_isError(result) && result == out.size();
+  }
+
+  const int result = LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()),
+                                         reinterpret_cast<char*>(out.data()),
+                                         static_cast<int>(in.size()), static_cast<int>(out.size()));
+  return result >= 0 && static_cast<size_t>(result) == out.size();
+}
+
+Common::UniqueBuffer<u8> CompressChunked(std::span<const u8> data, CompressionType type,
+                                         int zstd_level)
+{
+  if (!IsChunkedCompressionType(type))
+    return {};
+
+  const size_t chunk_count = (data.size() + STATE_CHUNK_SIZE - 1) / STATE_CHUNK_SIZE;
+  const size_t bound = CompressBound(type, STATE_CHUNK_SIZE);
+
+  std::vector<Common::UniqueBuffer<u8>> chunks(chunk_count);
+  std::vector<u32> compressed_sizes(chunk_count);
+  std::atomic<bool> success = true;
+
+  ParallelForEachChunk(chunk_count, [&](size_t i) {
+    const std::span<const u8> in =
+        data.subspan(i * STATE_CHUNK_SIZE,
+                     std::min<size_t>(STATE_CHUNK_SIZE, data.size() - i * STATE_CHUNK_SIZE));
+    chunks[i].reset(bound);
+    const size_t compressed_size = CompressChunk(type, zstd_level, in, chunks[i]);
+    if (compressed_size == 0)
+      success.store(false, std::memory_order_relaxed);
+    compressed_sizes[i] = static_cast<u32>(compressed_size);
+  });
+
+  if (!success.load())
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress state with {}",
+                  GetCompressionTypeName(type, zstd_level));
+    return {};
+  }
+
+  const ChunkTableHeader table_header{STATE_CHUNK_SIZE, static_cast<u32>(chunk_count)};
+  const size_t table_size = sizeof(table_header) + chunk_count * sizeof(u32);
+  size_t total_size = table_size;
+  for (const u32 compressed_size : compressed_sizes)
+    total_size += compressed_size;
+
+  Common::UniqueBuffer<u8> result(total_size);
+  u8* out = result.data();
+  std::memcpy(out, &table_header, sizeof(table_header));
+  out += sizeof(table_header);
+  std::memcpy(out, compressed_sizes.data(), chunk_count * sizeof(u32));
+  out += chunk_count * sizeof(u32);
+  for (size_t i = 0; i < chunk_count; ++i)
+  {
+    std::memcpy(out, chunks[i].data(), compressed_sizes[i]);
+    out += compressed_sizes[i];
+  }
+
+  return result;
+}
+
+bool DecompressChunked(std::span<const u8> compressed, CompressionType type, std::span<u8> out)
+{
+  if (!IsChunkedCompressionType(type))
+    return false;
+
+  ChunkTableHeader table_header;
+  if (compressed.size() < sizeof(table_header))
+  {
+    ERROR_LOG_FMT(CORE, "State chunk table is truncated");
+    return false;
+  }
+  std::memcpy(&table_header, compressed.data(), sizeof(table_header));
+
+  const u64 chunk_size = table_header.chunk_size;
+  const u64 chunk_count = table_header.chunk_count;
+  if (chunk_size == 0 || chunk_count != (out.size() + chunk_size - 1) / chunk_size ||
+      compressed.size() < sizeof(table_header) + chunk_count * sizeof(u32))
+  {
+    ERROR_LOG_FMT(CORE, "State chunk table is corrupted ({} chunks of {} bytes for {} bytes)",
+                  chunk_count, chunk_size, out.size());
+    return false;
+  }
+
+  // Turn the compressed sizes into offsets so that every chunk can be located independently.
+  std::vector<u32> compressed_sizes(chunk_count);
+  std::memcpy(compressed_sizes.data(), compressed.data() + sizeof(table_header),
+              chunk_count * sizeof(u32));
+  std::vector<u64> offsets(chunk_count);
+  u64 offset = sizeof(table_header) + chunk_count * sizeof(u32);
+  for (size_t i = 0; i < chunk_count; ++i)
+  {
+    offsets[i] = offset;
+    offset += compressed_sizes[i];
+  }
+  if (offset > compressed.size())
+  {
+    ERROR_LOG_FMT(CORE, "State chunk data is truncated ({} / {} bytes)", compressed.size(), offset);
+    return false;
+  }
+
+  std::atomic<bool> success = true;
+  ParallelForEachChunk(chunk_count, [&](size_t i) {
+    const u64 out_offset = i * chunk_size;
+    const std::span<u8> out_chunk =
+        out.subspan(out_offset, std::min<u64>(chunk_size, out.size() - out_offset));
+    if (!DecompressChunk(type, compressed.subspan(offsets[i], compressed_sizes[i]), out_chunk))
+      success.store(false, std::memory_order_relaxed);
+  });
+
+  if (!success.load())
+  {
+    ERROR_LOG_FMT(CORE, "Failed to decompress state chunks");
+    return false;
+  }
+
+  return true;
+}
+
+Common::UniqueBuffer<u8> CompressLZ4Stream(std::span<const u8> data)
+{
+  // Every block needs at least its size and one byte, even the one block of an empty payload.
+  const size_t block_count =
+      std::max<size_t>(1, (data.size() + LZ4_MAX_INPUT_SIZE - 1) / LZ4_MAX_INPUT_SIZE);
+  Common::UniqueBuffer<u8> buffer(
+      block_count * (sizeof(s32) + LZ4_compressBound(LZ4_MAX_INPUT_SIZE)));
+
+  size_t in_offset = 0;
+  size_t out_offset = 0;
+  do
+  {
+    const int block_size =
+        static_cast<int>(std::min<size_t>(LZ4_MAX_INPUT_SIZE, data.size() - in_offset));
+    u8* const out = buffer.data() + out_offset + sizeof(s32);
+    const s32 compressed_size = LZ4_compress_default(
+        reinterpret_cast<const char*>(data.data() + in_offset), reinterpret_cast<char*>(out),
+        block_size, LZ4_compressBound(block_size));
+    if (compressed_size <= 0)
+    {
+      ERROR_LOG_FMT(CORE, "Failed to compress state with {}",
+                    GetCompressionTypeName(CompressionType::LZ4));
+      return {};
+    }
+
+    std::memcpy(buffer.data() + out_offset, &compressed_size, sizeof(s32));
+    out_offset += sizeof(s32) + compressed_size;
+    in_offset += block_size;
+  } while (in_offset < data.size());
+
+  Common::UniqueBuffer<u8> result(out_offset);
+  std::memcpy(result.data(), buffer.data(), out_offset);
+  return result;
+}
+
+bool DecompressLZ4Stream(std::span<const u8> compressed, std::span<u8> out)
+{
+  size_t in_offset = 0;
+  size_t out_offset = 0;
+  while (out_offset < out.size())
+  {
+    s32 compressed_size;
+    if (compressed.size() - in_offset < sizeof(s32))
+    {
+      ERROR_LOG_FMT(CORE, "State data is truncated");
+      return false;
+    }
+    std::memcpy(&compressed_size, compressed.data() + in_offset, sizeof(s32));
+    in_offset += sizeof(s32);
+
+    if (compressed_size <= 0 || compressed.size() - in_offset < static_cast<u32>(compressed_size))
+    {
+      ERROR_LOG_FMT(CORE, "Invalid LZ4 block of {} bytes in state", compressed_size);
+      return false;
+    }
+
+    const int max_size =
+        static_cast<int>(std::min<size_t>(LZ4_MAX_INPUT_SIZE, out.size() - out_offset));
+    const int decompressed_size = LZ4_decompress_safe(
+        reinterpret_cast<const char*>(compressed.data() + in_offset),
+        reinterpret_cast<char*>(out.data() + out_offset), compressed_size, max_size);
+    if (decompressed_size <= 0)
+    {
+      ERROR_LOG_FMT(CORE, "LZ4 decompression of state failed ({}, {}, {})", decompressed_size,
+                    compressed_size, max_size);
+      return false;
+    }
+
+    in_offset += compressed_size;
+    out_offset += decompressed_size;
+  }
+
+  return true;
+}
+}  // namespace State
@@ -0,0 +1,56 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Chunked savestate compression. The payload is split into independent chunks which are
+// compressed and decompressed in parallel. A chunk table placed in front of the compressed data
+// records where every chunk starts, so no chunk has to wait for the previous one to be decoded.
+
+#pragma once
+
+#include <span>
+#include <string>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "Core/State.h"
+
+namespace State
+{
+struct ChunkTableHeader
+{
+  u32 chunk_size;
+  u32 chunk_count;
+  // Followed by chunk_count u32 values holding the compressed size of each chunk,
+  // then by the compressed chunks themselves.
+};
+static_assert(sizeof(ChunkTableHeader) == 8);
+
+// The uncompressed size of every chunk except the last one.
+constexpr u32 STATE_CHUNK_SIZE = 4 * 1024 * 1024;
+
+constexpr int DEFAULT_STATE_ZSTD_LEVEL = 3;
+
+bool IsChunkedCompressionType(CompressionType type);
+
+// Returns a short human-readable name such as "chunked-zstd-3", used for logging and benchmarking.
+// The level is only part of the name for zstd, and only if it is known (non-zero).
+std::string GetCompressionTypeName(CompressionType type, int zstd_level = 0);
+
+// Compresses data into a chunk table followed by the compressed chunks.
+// Returns an empty buffer on failure.
+Common::UniqueBuffer<u8> CompressChunked(std::span<const u8> data, CompressionType type,
+                                         int zstd_level = DEFAULT_STATE_ZSTD_LEVEL);
+
+// Decompresses the output of CompressChunked into out, which must be exactly as large as the
+// original data.
+bool DecompressChunked(std::span<const u8> compressed, CompressionType type, std::span<u8> out);
+
+// The format of CompressionType::LZ4 states: blocks of up to LZ4_MAX_INPUT_SIZE bytes, each
+// preceded by its compressed size as an s32, compressed and decompressed one after another.
+// Returns an empty buffer on failure.
+Common::UniqueBuffer<u8> CompressLZ4Stream(std::span<const u8> data);
+
+// Decompresses the output of CompressLZ4Stream into out, which must be exactly as large as the
+// original data. Bytes after the last block are ignored.
+bool DecompressLZ4Stream(std::span<const u8> compressed, std::span<u8> out);
+}  // namespace State
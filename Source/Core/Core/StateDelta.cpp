@@ -0,0 +1,133 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/Logging/Log.h"
+
+namespace State
+{
+// Returns the given section of a state, or an empty span if the state doesn't have it.
+static std::span<const u8> GetSection(std::span<const u8> state, std::span<const u64> sections,
+                                      size_t index)
+{
+  if (index >= sections.size())
+    return {};
+
+  const u64 begin = index == 0 ? 0 : sections[index - 1];
+  const u64 end = sections[index];
+  if (begin > end || end > state.size())
+    return {};
+
+  return state.subspan(begin, end - begin);
+}
+
+void CreateDelta(std::span<const u8> base, std::span<const u64> base_sections,
+                 std::span<const u8> current, std::span<const u64> current_sections,
+                 StateDelta& delta)
+{
+  delta.sections.assign(current_sections.begin(), current_sections.end());
+  delta.pages.clear();
+  delta.data.clear();
+
+  u32 page = 0;
+  for (size_t i = 0; i < current_sections.size(); ++i)
+  {
+    const std::span<const u8> section = GetSection(current, current_sections, i);
+    const std::span<const u8> base_section = GetSection(base, base_sections, i);
+
+    for (size_t offset = 0; offset < section.size(); offset += DELTA_PAGE_SIZE, ++page)
+    {
+      const size_t length = std::min(DELTA_PAGE_SIZE, section.size() - offset);
+      const u8* const current_page = section.data() + offset;
+
+      if (offset + length <= base_section.size() &&
+          std::memcmp(current_page, base_section.data() + offset, length) == 0)
+      {
+        continue;
+      }
+
+      delta.pages.push_back(page);
+      delta.data.insert(delta.data.end(), current_page, current_page + length);
+    }
+  }
+}
+
+bool ApplyDelta(std::span<const u8> base, std::span<const u64> base_sections,
+                const StateDelta& delta, Common::UniqueBuffer<u8>& out)
+{
+  const u64 size = delta.GetSize();
+  if (out.size() != size)
+    out.reset(size);
+
+  auto next_page = delta.pages.begin();
+  size_t data_offset = 0;
+  u32 page = 0;
+  u64 begin = 0;
+  for (size_t i = 0; i < delta.sections.size(); ++i)
+  {
+    const u64 end = delta.sections[i];
+    if (end < begin)
+    {
+      ERROR_LOG_FMT(CORE, "State delta section {} ends before it begins", i);
+      return false;
+    }
+
+    const std::span<const u8> base_section = GetSection(base, base_sections, i);
+    const size_t section_size = end - begin;
+    u8* const out_section = out.data() + begin;
+    const size_t base_length = std::min(base_section.size(), section_size);
+    if (base_length != 0)
+      std::memcpy(out_section, base_section.data(), base_length);
+
+    for (size_t offset = 0; offset < section_size; offset += DELTA_PAGE_SIZE, ++page)
+    {
+      const size_t length = std::min(DELTA_PAGE_SIZE, section_size - offset);
+      if (next_page != delta.pages.end() && *next_page == page)
+      {
+        if (data_offset + length > delta.data.size())
+        {
+          ERROR_LOG_FMT(CORE, "State delta data is truncated");
+          return false;
+        }
+
+        std::memcpy(out_section + offset, delta.data.data() + data_offset, length);
+        data_offset += length;
+        ++next_page;
+      }
+      else if (offset + length > base_section.size())
+      {
+        // Every page that extends past the end of the base section must be stored in the delta.
+        ERROR_LOG_FMT(CORE, "State delta does not cover the data past the end of its base");
+        return false;
+      }
+    }
+
+    begin = end;
+  }
+
+  if (next_page != delta.pages.end())
+  {
+    ERROR_LOG_FMT(CORE, "State delta page {} is out of range ({} pages)", *next_page, page);
+    return false;
+  }
+
+  return true;
+}
+
+void CreateDelta(std::span<const u8> base, std::span<const u8> current, StateDelta& delta)
+{
+  const u64 base_size = base.size();
+  const u64 current_size = current.size();
+  CreateDelta(base, {&base_size, 1}, current, {&current_size, 1}, delta);
+}
+
+bool ApplyDelta(std::span<const u8> base, const StateDelta& delta, Common::UniqueBuffer<u8>& out)
+{
+  const u64 base_size = base.size();
+  return ApplyDelta(base, {&base_size, 1}, delta, out);
+}
+}  // namespace State
@@ -0,0 +1,65 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Incremental savestates. A delta only stores the pages of a serialized state that differ from a
+// base snapshot, which makes frequent rolling states (rewind, replay checkpoints) cheap to keep.
+//
+// The pages are compared section by section. Some parts of a state (the movie input log, the
+// texture cache, the event queue) change size from frame to frame, and comparing at fixed offsets
+// would make everything after them, including the emulated RAM, look changed.
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+constexpr size_t DELTA_PAGE_SIZE = 4096;
+
+// The offsets at which the consecutive sections of a serialized state end, in ascending order.
+// The last one is the size of the state.
+using StateSections = std::vector<u64>;
+
+inline u64 GetStateSize(std::span<const u64> sections)
+{
+  return sections.empty() ? 0 : sections.back();
+}
+
+struct StateDelta
+{
+  // Sections of the serialized state this delta reconstructs.
+  StateSections sections;
+  // Indices of the pages that differ from the base, in ascending order. Every section starts on a
+  // new page, so the pages of all sections are numbered one after another.
+  std::vector<u32> pages;
+  // Contents of those pages, back to back. Only the last page of a section can be partial.
+  std::vector<u8> data;
+
+  u64 GetSize() const { return GetStateSize(sections); }
+
+  // Approximate memory used by this delta.
+  size_t GetMemoryUsage() const
+  {
+    return sections.size() * sizeof(u64) + pages.size() * sizeof(u32) + data.size();
+  }
+};
+
+// Fills delta with the pages of current that differ from the same section of base. Pages past the
+// end of the corresponding base section are always stored. The vectors inside delta are reused to
+// avoid reallocating every frame.
+void CreateDelta(std::span<const u8> base, std::span<const u64> base_sections,
+                 std::span<const u8> current, std::span<const u64> current_sections,
+                 StateDelta& delta);
+
+// Reconstructs the serialized state described by delta into out.
+bool ApplyDelta(std::span<const u8> base, std::span<const u64> base_sections,
+                const StateDelta& delta, Common::UniqueBuffer<u8>& out);
+
+// The same for states that are compared as a single section.
+void CreateDelta(std::span<const u8> base, std::span<const u8> current, StateDelta& delta);
+bool ApplyDelta(std::span<const u8> base, const StateDelta& delta, Common::UniqueBuffer<u8>& out);
+}  // namespace State
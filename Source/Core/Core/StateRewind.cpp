@@ -0,0 +1,340 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateRewind.h"
+
+#include <algorithm>
+#include <span>
+
+#include "Common/Logging/Log.h"
+#include "Core/State.h"
+#include "Core/StateCompression.h"
+#include "Core/StateDelta.h"
+
+namespace State
+{
+// A delta is always made against the newest keyframe, so a long run of deltas keeps growing.
+// Start a new keyframe after this many deltas, or once a delta is a sizable part of the state.
+constexpr u32 MAX_DELTAS_PER_KEYFRAME = 15;
+constexpr u64 MAX_DELTA_FRACTION = 4;
+
+RewindBuffer::RewindBuffer() = default;
+
+RewindBuffer::~RewindBuffer()
+{
+  Shutdown();
+}
+
+void RewindBuffer::Reset(u32 frame_interval, u64 memory_budget)
+{
+  m_worker.Cancel();
+  m_worker.Reset("Rewind Worker",
+                 [this](PendingCapture capture) { CompressCapture(std::move(capture)); });
+  LogSessionStats();
+
+  std::lock_guard lk(m_mutex);
+  m_entries.clear();
+  m_first_slot = 0;
+  m_interval = std::max<u32>(frame_interval, 1);
+  m_memory_budget = memory_budget;
+  m_memory_usage = 0;
+  m_num_states = 0;
+  m_spare_buffer.reset();
+  m_keyframe_state.reset();
+  m_keyframe_buffer_size = 0;
+  m_keyframe_sections.clear();
+  m_has_keyframe = false;
+  m_deltas_since_keyframe = 0;
+  m_has_requested_slot.store(false);
+  m_last_state_size = 0;
+  m_last_delta_size = 0;
+}
+
+void RewindBuffer::Shutdown()
+{
+  m_worker.Cancel();
+  m_worker.Shutdown();
+  LogSessionStats();
+}
+
+void RewindBuffer::LogSessionStats()
+{
+  std::lock_guard lk(m_mutex);
+  if (m_total_keyframes == 0 && m_total_deltas == 0)
+    return;
+
+  INFO_LOG_FMT(CORE,
+               "Rewind stored {} keyframes ({} forced by large deltas) and {} deltas of {} KiB on "
+               "average, for {} KiB states",
+               m_total_keyframes, m_forced_keyframes, m_total_deltas,
+               m_total_deltas != 0 ? m_total_delta_size / m_total_deltas / 1024 : 0,
+               m_last_state_size / 1024);
+  m_total_keyframes = 0;
+  m_total_deltas = 0;
+  m_forced_keyframes = 0;
+  m_total_delta_size = 0;
+}
+
+Common::UniqueBuffer<u8> RewindBuffer::TakeSpareBuffer()
+{
+  std::lock_guard lk(m_mutex);
+  m_memory_usage -= m_spare_buffer.size();
+  return std::move(m_spare_buffer);
+}
+
+bool RewindBuffer::HasCaptureForFrame(u64 frame) const
+{
+  return m_has_requested_slot.load() && m_newest_requested_slot.load() == frame / m_interval;
+}
+
+void RewindBuffer::Push(u64 frame, Common::UniqueBuffer<u8> state, StateSections sections,
+                        double capture_ms)
+{
+  m_newest_requested_slot.store(frame / m_interval);
+  m_has_requested_slot.store(true);
+  m_last_capture_ms.store(capture_ms, std::memory_order_relaxed);
+  m_worker.EmplaceItem(PendingCapture{frame, std::move(state), std::move(sections)});
+}
+
+void RewindBuffer::CompressCapture(PendingCapture capture)
+{
+  const auto start = Clock::now();
+  const size_t size = GetStateSize(capture.sections);
+  const std::span<const u8> state{capture.state.data(), size};
+  const u64 slot = capture.frame / m_interval;
+
+  {
+    // A capture that isn't newer than the history means the emulated timeline was changed
+    // (by rewinding or loading another state), so everything after it is stale.
+    std::lock_guard lk(m_mutex);
+    if (!m_entries.empty() && slot < m_first_slot + m_entries.size())
+      DiscardFromSlot(slot);
+  }
+
+  Entry entry;
+  entry.frame = capture.frame;
+  entry.sections = std::move(capture.sections);
+
+  bool make_keyframe = !m_has_keyframe || m_deltas_since_keyframe >= MAX_DELTAS_PER_KEYFRAME;
+  bool forced_keyframe = false;
+  if (!make_keyframe)
+  {
+    StateDelta delta;
+    CreateDelta({m_keyframe_state.data(), GetStateSize(m_keyframe_sections)}, m_keyframe_sections,
+                state, entry.sections, delta);
+    if (delta.data.size() > size / MAX_DELTA_FRACTION)
+    {
+      make_keyframe = true;
+      forced_keyframe = true;
+    }
+    else
+    {
+      entry.type = EntryType::Delta;
+      entry.pages = std::move(delta.pages);
+      entry.page_data_size = delta.data.size();
+      entry.compressed = CompressChunked(delta.data, CompressionType::ChunkedLZ4);
+      ++m_deltas_since_keyframe;
+    }
+  }
+
+  if (make_keyframe)
+  {
+    entry.type = EntryType::Keyframe;
+    entry.compressed = CompressChunked(state, CompressionType::ChunkedLZ4);
+    std::swap(m_keyframe_state, capture.state);
+    m_keyframe_sections = entry.sections;
+    m_keyframe_slot = slot;
+    m_has_keyframe = true;
+    m_deltas_since_keyframe = 0;
+  }
+
+  if (entry.compressed.empty() && (entry.type == EntryType::Keyframe || entry.page_data_size != 0))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress rewind state for frame {}", capture.frame);
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_mutex);
+    if (m_entries.empty())
+      m_first_slot = slot;
+    while (m_first_slot + m_entries.size() < slot)
+      m_entries.emplace_back();
+
+    m_memory_usage += entry.GetMemoryUsage();
+    ++m_num_states;
+
+    m_last_state_size = size;
+    if (entry.type == EntryType::Keyframe)
+    {
+      m_last_delta_size = 0;
+      ++m_total_keyframes;
+      if (forced_keyframe)
+        ++m_forced_keyframes;
+    }
+    else
+    {
+      m_last_delta_size = entry.page_data_size;
+      ++m_total_deltas;
+      m_total_delta_size += entry.page_data_size;
+    }
+    m_entries.emplace_back(std::move(entry));
+
+    // The uncompressed keyframe and the spare buffer count towards the budget too.
+    m_memory_usage -= m_keyframe_buffer_size + m_spare_buffer.size();
+    m_spare_buffer = std::move(capture.state);
+    m_keyframe_buffer_size = m_keyframe_state.size();
+    m_memory_usage += m_keyframe_buffer_size + m_spare_buffer.size();
+
+    EvictOldEntries();
+  }
+
+  m_last_compress_ms.store(DT_ms(Clock::now() - start).count(), std::memory_order_relaxed);
+}
+
+void RewindBuffer::EvictOldEntries()
+{
+  while (m_memory_usage > m_memory_budget && !m_entries.empty())
+  {
+    // Entries before the second keyframe can only be dropped together, since the deltas need
+    // their keyframe. Never drop the group that new deltas are being made against.
+    const auto next_keyframe =
+        std::find_if(m_entries.begin() + 1, m_entries.end(),
+                     [](const Entry& entry) { return entry.type == EntryType::Keyframe; });
+    if (next_keyframe == m_entries.end())
+    {
+      // Force a new keyframe so that this group can be evicted next time.
+      m_deltas_since_keyframe = MAX_DELTAS_PER_KEYFRAME;
+      return;
+    }
+
+    const size_t count = next_keyframe - m_entries.begin();
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (m_entries.front().type != EntryType::Empty)
+        --m_num_states;
+      m_memory_usage -= m_entries.front().GetMemoryUsage();
+      m_entries.pop_front();
+    }
+    m_first_slot += count;
+  }
+}
+
+void RewindBuffer::DiscardFromSlot(u64 slot)
+{
+  const size_t keep = slot > m_first_slot ? static_cast<size_t>(slot - m_first_slot) : 0;
+  while (m_entries.size() > keep)
+  {
+    if (m_entries.back().type != EntryType::Empty)
+      --m_num_states;
+    m_memory_usage -= m_entries.back().GetMemoryUsage();
+    m_entries.pop_back();
+  }
+
+  if (m_has_keyframe && m_keyframe_slot >= slot)
+  {
+    m_has_keyframe = false;
+    m_keyframe_state.reset();
+    m_memory_usage -= m_keyframe_buffer_size;
+    m_keyframe_buffer_size = 0;
+    m_keyframe_sections.clear();
+  }
+}
+
+void RewindBuffer::DiscardAfter(u64 frame)
+{
+  m_worker.WaitForCompletion();
+
+  std::lock_guard lk(m_mutex);
+  DiscardFromSlot(frame / m_interval + 1);
+  m_newest_requested_slot.store(frame / m_interval);
+}
+
+bool RewindBuffer::DecompressKeyframe(const Entry& keyframe, Common::UniqueBuffer<u8>& out) const
+{
+  out.reset(GetStateSize(keyframe.sections));
+  return DecompressChunked(keyframe.compressed, CompressionType::ChunkedLZ4, out);
+}
+
+bool RewindBuffer::Restore(u64 frame, Common::UniqueBuffer<u8>& out, u64* restored_frame)
+{
+  // Make sure the worker isn't touching the newest keyframe while we read it.
+  m_worker.WaitForCompletion();
+
+  std::lock_guard lk(m_mutex);
+  if (m_entries.empty() || frame / m_interval < m_first_slot)
+    return false;
+
+  size_t index = std::min<size_t>(frame / m_interval - m_first_slot, m_entries.size() - 1);
+  while (m_entries[index].type == EntryType::Empty || m_entries[index].frame > frame)
+  {
+    if (index == 0)
+      return false;
+    --index;
+  }
+
+  const Entry& entry = m_entries[index];
+  *restored_frame = entry.frame;
+
+  if (entry.type == EntryType::Keyframe)
+    return DecompressKeyframe(entry, out);
+
+  size_t keyframe_index = index;
+  while (m_entries[keyframe_index].type != EntryType::Keyframe)
+  {
+    if (keyframe_index == 0)
+      return false;
+    --keyframe_index;
+  }
+
+  Common::UniqueBuffer<u8> keyframe_buffer;
+  std::span<const u8> keyframe_state;
+  if (m_has_keyframe && m_keyframe_slot == m_first_slot + keyframe_index)
+  {
+    keyframe_state = {m_keyframe_state.data(), GetStateSize(m_keyframe_sections)};
+  }
+  else
+  {
+    if (!DecompressKeyframe(m_entries[keyframe_index], keyframe_buffer))
+      return false;
+    keyframe_state = keyframe_buffer;
+  }
+
+  StateDelta delta;
+  delta.sections = entry.sections;
+  delta.pages = entry.pages;
+  delta.data.resize(entry.page_data_size);
+  if (entry.page_data_size != 0 &&
+      !DecompressChunked(entry.compressed, CompressionType::ChunkedLZ4, delta.data))
+  {
+    return false;
+  }
+
+  return ApplyDelta(keyframe_state, m_entries[keyframe_index].sections, delta, out);
+}
+
+RewindStats RewindBuffer::GetStats() const
+{
+  RewindStats stats;
+  stats.last_capture_ms = m_last_capture_ms.load(std::memory_order_relaxed);
+  stats.last_compress_ms = m_last_compress_ms.load(std::memory_order_relaxed);
+
+  std::lock_guard lk(m_mutex);
+  stats.num_states = m_num_states;
+  stats.num_keyframes = std::ranges::count(m_entries, EntryType::Keyframe, &Entry::type);
+  stats.num_deltas = std::ranges::count(m_entries, EntryType::Delta, &Entry::type);
+  stats.memory_usage = m_memory_usage;
+  stats.last_state_size = m_last_state_size;
+  stats.last_delta_size = m_last_delta_size;
+  stats.total_keyframes = m_total_keyframes;
+  stats.total_deltas = m_total_deltas;
+  stats.forced_keyframes = m_forced_keyframes;
+  stats.total_delta_size = m_total_delta_size;
+  if (!m_entries.empty())
+  {
+    stats.oldest_frame = m_entries.front().frame;
+    stats.newest_frame = m_entries.back().frame;
+  }
+  return stats;
+}
+}  // namespace State
@@ -0,0 +1,156 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// In-memory rewind history. Serialized states are handed over from the CPU thread and compressed
+// on a worker thread: every few captures a full keyframe is stored, and the captures in between
+// only keep the pages that changed since that keyframe (see StateDelta.h).
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+#include "Core/StateDelta.h"
+
+namespace State
+{
+struct RewindStats
+{
+  size_t num_states = 0;
+  // How the stored captures are split between keyframes and deltas.
+  size_t num_keyframes = 0;
+  size_t num_deltas = 0;
+  u64 memory_usage = 0;
+  u64 oldest_frame = 0;
+  u64 newest_frame = 0;
+  // Time the CPU thread spent serializing the last capture.
+  double last_capture_ms = 0;
+  // Time the worker thread spent compressing the last capture.
+  double last_compress_ms = 0;
+  // Uncompressed sizes of the last capture and, if it was stored as a delta, of its changed pages.
+  u64 last_state_size = 0;
+  u64 last_delta_size = 0;
+  // Captures since the last Reset(), including evicted ones. Keyframes are either due after
+  // a number of deltas or forced because a delta was too large.
+  u64 total_keyframes = 0;
+  u64 total_deltas = 0;
+  u64 forced_keyframes = 0;
+  u64 total_delta_size = 0;
+};
+
+class RewindBuffer
+{
+public:
+  RewindBuffer();
+  ~RewindBuffer();
+
+  RewindBuffer(const RewindBuffer&) = delete;
+  RewindBuffer& operator=(const RewindBuffer&) = delete;
+
+  // Drops all history and restarts the worker. Captures are bucketed by frame_interval, so that
+  // looking up a frame is a constant-time index computation. Older captures are evicted to stay
+  // within memory_budget.
+  void Reset(u32 frame_interval, u64 memory_budget);
+  void Shutdown();
+
+  // Takes ownership of a serialized state. Only the bytes up to the end of the last section are
+  // used. Captures that are older than the newest stored capture replace the history after them.
+  void Push(u64 frame, Common::UniqueBuffer<u8> state, StateSections sections, double capture_ms);
+
+  // Returns a buffer that the worker no longer needs, so that captures can be serialized without
+  // faulting in a fresh allocation every time. May be empty.
+  Common::UniqueBuffer<u8> TakeSpareBuffer();
+
+  u32 GetFrameInterval() const { return m_interval; }
+
+  // Returns whether a capture for the given frame's bucket is already stored or pending.
+  bool HasCaptureForFrame(u64 frame) const;
+
+  // Reconstructs the newest state captured at or before frame.
+  bool Restore(u64 frame, Common::UniqueBuffer<u8>& out, u64* restored_frame);
+
+  // Drops every capture newer than frame.
+  void DiscardAfter(u64 frame);
+
+  RewindStats GetStats() const;
+
+private:
+  enum class EntryType
+  {
+    Empty,
+    Keyframe,
+    Delta,
+  };
+
+  struct Entry
+  {
+    EntryType type = EntryType::Empty;
+    u64 frame = 0;
+    StateSections sections;
+    // For keyframes, the compressed state. For deltas, the compressed page data.
+    Common::UniqueBuffer<u8> compressed;
+    // Delta only.
+    std::vector<u32> pages;
+    u64 page_data_size = 0;
+
+    size_t GetMemoryUsage() const
+    {
+      return compressed.size() + sections.size() * sizeof(u64) + pages.size() * sizeof(u32);
+    }
+  };
+
+  struct PendingCapture
+  {
+    u64 frame;
+    Common::UniqueBuffer<u8> state;
+    StateSections sections;
+  };
+
+  void CompressCapture(PendingCapture capture);
+  void LogSessionStats();
+  void EvictOldEntries();
+  void DiscardFromSlot(u64 slot);
+  bool DecompressKeyframe(const Entry& keyframe, Common::UniqueBuffer<u8>& out) const;
+
+  Common::WorkQueueThread<PendingCapture> m_worker;
+
+  mutable std::mutex m_mutex;
+  // m_entries[i] holds the capture for slot m_first_slot + i, where slot = frame / m_interval.
+  std::deque<Entry> m_entries;
+  u64 m_first_slot = 0;
+  u32 m_interval = 1;
+  u64 m_memory_budget = 0;
+  // The compressed entries, the spare buffer and the uncompressed keyframe.
+  u64 m_memory_usage = 0;
+  size_t m_num_states = 0;
+  Common::UniqueBuffer<u8> m_spare_buffer;
+  // The size of m_keyframe_state, for the memory usage. Unlike the buffer, this is guarded by
+  // m_mutex.
+  u64 m_keyframe_buffer_size = 0;
+
+  // Worker thread only: the uncompressed state of the newest keyframe, which deltas are made from.
+  Common::UniqueBuffer<u8> m_keyframe_state;
+  StateSections m_keyframe_sections;
+  u64 m_keyframe_slot = 0;
+  bool m_has_keyframe = false;
+  u32 m_deltas_since_keyframe = 0;
+
+  std::atomic<u64> m_newest_requested_slot = 0;
+  std::atomic<bool> m_has_requested_slot = false;
+  std::atomic<double> m_last_capture_ms = 0;
+  std::atomic<double> m_last_compress_ms = 0;
+
+  // Guarded by m_mutex.
+  u64 m_last_state_size = 0;
+  u64 m_last_delta_size = 0;
+  u64 m_total_keyframes = 0;
+  u64 m_total_deltas = 0;
+  u64 m_forced_keyframes = 0;
+  u64 m_total_delta_size = 0;
+};
+}  // namespace State
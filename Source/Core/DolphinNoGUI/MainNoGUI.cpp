@@ -15,6 +15,7 @@
 #include <Windows.h>
 #endif
 
+#include "Common/Profiler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
@@ -214,6 +215,10 @@ int main(const int argc, char* argv[])
                 "macos"
 #endif
       });
+  parser->add_option("--trace")
+      .action("store")
+      .metavar("<file>")
+      .help("Write the last profiler zones of each thread to a Chrome trace file on exit");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -308,6 +313,13 @@ int main(const int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
+  std::string trace_path;
+  if (options.is_set("trace"))
+  {
+    trace_path = static_cast<const char*>(options.get("trace"));
+    Common::ProfilerTrace::Start();
+  }
+
   if (!BootManager::BootCore(Core::System::GetInstance(), std::move(boot), wsi))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -324,6 +336,13 @@ int main(const int argc, char* argv[])
   Core::Shutdown(Core::System::GetInstance());
   s_platform.reset();
 
+  if (!trace_path.empty())
+  {
+    Common::ProfilerTrace::Stop();
+    if (!Common::ProfilerTrace::WriteChromeTrace(trace_path))
+      fprintf(stderr, "Could not write the trace to %s\n", trace_path.c_str());
+  }
+
   return 0;
 }
 
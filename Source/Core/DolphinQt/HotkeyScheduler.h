@@ -50,6 +50,7 @@ signals:
   void StateSaveFile();
   void StateLoadUndo();
   void StateSaveUndo();
+  void StateRewind();
   void StartRecording();
   void PlayRecording();
   void ExportRecording();
@@ -43,6 +43,7 @@
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayProto.h"
+#include "Core/PowerPC/JitCommon/JitSamplingProfiler.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
@@ -165,6 +166,13 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_search_instruction->setEnabled(running);
   m_jit_wipe_profiling_data->setEnabled(jit_exists);
   m_jit_write_cache_log_dump->setEnabled(jit_exists);
+  m_jit_sample_functions->setEnabled(running && jit_exists);
+  if (!running)
+  {
+    // The profiler stops along with the emulation.
+    const QSignalBlocker blocker(m_jit_sample_functions);
+    m_jit_sample_functions->setChecked(false);
+  }
 
   // Symbols
   m_symbols->setEnabled(running);
@@ -241,6 +249,48 @@ void MenuBar::OnWriteJitBlockLogDump()
   }
 }
 
+void MenuBar::OnToggleJitSampling(bool enabled)
+{
+  auto& system = Core::System::GetInstance();
+  auto& jit_interface = system.GetJitInterface();
+  if (enabled)
+  {
+    bool started = false;
+    Core::RunOnCPUThread(
+        system,
+        [&] { started = jit_interface.StartSamplingProfiler(Core::CPUThreadGuard{system}, 1000); },
+        true);
+    if (!started)
+    {
+      const QSignalBlocker blocker(m_jit_sample_functions);
+      m_jit_sample_functions->setChecked(false);
+      ModalMessageBox::warning(this, tr("Error"), tr("Failed to start sampling the CPU thread."));
+    }
+    return;
+  }
+
+  Core::RunOnCPUThread(system, [&] { jit_interface.StopSamplingProfiler(); }, true);
+
+  const std::string path = fmt::format("{}{}_samples", File::GetUserPath(D_DUMPDEBUG_JITBLOCKS_IDX),
+                                       SConfig::GetInstance().GetGameID());
+  const std::string folded_stacks_filename = path + ".folded";
+  const std::string top_functions_filename = path + ".txt";
+  File::IOFile folded_stacks_file(folded_stacks_filename, "w");
+  File::IOFile top_functions_file(top_functions_filename, "w");
+  if (!folded_stacks_file || !top_functions_file)
+  {
+    ModalMessageBox::warning(
+        this, tr("Error"),
+        tr("Failed to open \"%1\" for writing.").arg(QString::fromStdString(path)));
+    return;
+  }
+  jit_interface.SamplingProfileDump(folded_stacks_file.GetHandle(), top_functions_file.GetHandle());
+  ModalMessageBox::information(this, tr("Success"),
+                               tr("Wrote to \"%1\" and \"%2\".")
+                                   .arg(QString::fromStdString(folded_stacks_filename))
+                                   .arg(QString::fromStdString(top_functions_filename)));
+}
+
 void MenuBar::AddFileMenu()
 {
   QMenu* file_menu = addMenu(tr("&File"));
@@ -947,6 +997,12 @@ void MenuBar::AddJITMenu()
   m_jit_write_cache_log_dump =
       m_jit->addAction(tr("Write JIT Block Log Dump"), this, &MenuBar::OnWriteJitBlockLogDump);
 
+  // Writes the results when it is turned off again.
+  m_jit_sample_functions = m_jit->addAction(tr("Sample Guest Functions"));
+  m_jit_sample_functions->setCheckable(true);
+  m_jit_sample_functions->setVisible(JitSamplingProfiler::IsSupported());
+  connect(m_jit_sample_functions, &QAction::toggled, this, &MenuBar::OnToggleJitSampling);
+
   m_jit->addSeparator();
 
   m_jit_off = m_jit->addAction(tr("JIT Off (JIT Core)"));
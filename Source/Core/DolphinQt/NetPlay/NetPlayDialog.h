@@ -164,7 +164,9 @@ private:
   QAction* m_golf_mode_action;
   QAction* m_golf_mode_overlay_action;
   QAction* m_fixed_delay_action;
+  QAction* m_rollback_action;
   QAction* m_hide_remote_gbas_action;
+  QAction* m_ram_desync_check_action;
   QCheckBox* m_brawlmusic_off;
   QCheckBox* m_is_spectator;
   QPushButton* m_quit_button;
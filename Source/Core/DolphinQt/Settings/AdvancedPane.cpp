@@ -91,6 +91,53 @@ void AdvancedPane::CreateLayout()
          "needed.<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>"));
   cpu_options_group_layout->addWidget(m_accurate_cpu_cache_checkbox);
 
+  m_tiered_compilation_checkbox = new ConfigBool(tr("Compile JIT Blocks in the Background"),
+                                                 Config::MAIN_JIT_TIERED_COMPILATION);
+  m_tiered_compilation_checkbox->SetDescription(
+      tr("Interprets code the first few times it runs and recompiles it on a separate thread, "
+         "which reduces stuttering when new code is encountered.<br>Has no effect in netplay, "
+         "during movie recording or while debugging.<br><br><dolphin_emphasis>If unsure, leave "
+         "this unchecked.</dolphin_emphasis>"));
+  cpu_options_group_layout->addWidget(m_tiered_compilation_checkbox);
+
+  m_warm_start_checkbox =
+      new ConfigBool(tr("Precompile Code from Earlier Sessions"), Config::MAIN_JIT_WARM_START);
+  m_warm_start_checkbox->SetDescription(
+      tr("Remembers which code each game ran in earlier sessions and compiles it on a separate "
+         "thread as soon as the game has loaded it again, which reduces stuttering in the first "
+         "minutes of play.<br>Has no effect in netplay, during movie recording or while "
+         "debugging.<br><br><dolphin_emphasis>If unsure, leave this "
+         "unchecked.</dolphin_emphasis>"));
+  cpu_options_group_layout->addWidget(m_warm_start_checkbox);
+
+  m_superblocks_checkbox =
+      new ConfigBool(tr("Merge Frequently Run JIT Blocks"), Config::MAIN_JIT_SUPERBLOCKS);
+  m_superblocks_checkbox->SetDescription(
+      tr("Recompiles code that runs often into larger blocks that follow more branches and "
+         "include small functions they call, which reduces the time spent jumping between "
+         "blocks.<br>Has no effect in netplay, during movie recording or while debugging.<br><br>"
+         "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>"));
+  cpu_options_group_layout->addWidget(m_superblocks_checkbox);
+
+  m_bound_entries_checkbox = new ConfigBool(tr("Keep Registers Loaded Between JIT Blocks"),
+                                            Config::MAIN_JIT_BOUND_ENTRIES);
+  m_bound_entries_checkbox->SetDescription(
+      tr("Lets a JIT block that jumps directly to another block leave values in host registers "
+         "for it, so that the next block doesn't have to load them from memory again.<br>Has no "
+         "effect while debugging.<br><br><dolphin_emphasis>If unsure, leave this "
+         "unchecked.</dolphin_emphasis>"));
+  cpu_options_group_layout->addWidget(m_bound_entries_checkbox);
+
+  m_evict_cold_blocks_checkbox = new ConfigBool(tr("Evict Unused JIT Code When the Cache Is Full"),
+                                                Config::MAIN_JIT_EVICT_COLD_BLOCKS);
+  m_evict_cold_blocks_checkbox->SetDescription(
+      tr("When the JIT runs out of space for compiled code, frees the code that has gone the "
+         "longest without running instead of clearing all of it, which avoids a stutter while "
+         "everything is compiled again.<br><br>Adds a small cost to every JIT block that runs, "
+         "to track which code is still in use.<br><br><dolphin_emphasis>If unsure, leave this "
+         "unchecked.</dolphin_emphasis>"));
+  cpu_options_group_layout->addWidget(m_evict_cold_blocks_checkbox);
+
   auto* const timing_group = new QGroupBox(tr("Timing"));
   main_layout->addWidget(timing_group);
   auto* timing_group_layout = new QVBoxLayout{timing_group};
@@ -315,6 +362,11 @@ void AdvancedPane::Update()
   m_cpu_emulation_engine_combobox->setEnabled(is_uninitialized);
   m_enable_mmu_checkbox->setEnabled(is_uninitialized);
   m_pause_on_panic_checkbox->setEnabled(is_uninitialized);
+  m_tiered_compilation_checkbox->setEnabled(is_uninitialized);
+  m_warm_start_checkbox->setEnabled(is_uninitialized);
+  m_superblocks_checkbox->setEnabled(is_uninitialized);
+  m_bound_entries_checkbox->setEnabled(is_uninitialized);
+  m_evict_cold_blocks_checkbox->setEnabled(is_uninitialized);
 
   {
     QFont bf = font();
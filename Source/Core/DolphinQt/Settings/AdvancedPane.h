@@ -38,6 +38,11 @@ private:
   ConfigBool* m_enable_mmu_checkbox;
   ConfigBool* m_pause_on_panic_checkbox;
   ConfigBool* m_accurate_cpu_cache_checkbox;
+  ConfigBool* m_tiered_compilation_checkbox;
+  ConfigBool* m_warm_start_checkbox;
+  ConfigBool* m_superblocks_checkbox;
+  ConfigBool* m_bound_entries_checkbox;
+  ConfigBool* m_evict_cold_blocks_checkbox;
   ConfigBool* m_cpu_clock_override_checkbox;
   ConfigFloatSlider* m_cpu_clock_override_slider;
   QLabel* m_cpu_label;
@@ -123,6 +123,8 @@ void WiiPane::ConnectLayout()
   connect(m_sd_card_checkbox, &QCheckBox::toggled, this, &WiiPane::OnSaveConfig);
   connect(m_allow_sd_writes_checkbox, &QCheckBox::toggled, this, &WiiPane::OnSaveConfig);
   connect(m_sync_sd_folder_checkbox, &QCheckBox::toggled, this, &WiiPane::OnSaveConfig);
+  connect(m_incremental_sd_sync_checkbox, &QCheckBox::toggled, this, &WiiPane::OnSaveConfig);
+  connect(m_virtual_sd_card_checkbox, &QCheckBox::toggled, this, &WiiPane::OnSaveConfig);
   connect(m_sd_card_size_combo, &QComboBox::currentIndexChanged, this, &WiiPane::OnSaveConfig);
 
   // Whitelisted USB Passthrough Devices
@@ -240,7 +242,19 @@ void WiiPane::CreateSDCard()
   m_sync_sd_folder_checkbox = new QCheckBox(tr("Automatically Sync with Folder"));
   m_sync_sd_folder_checkbox->setToolTip(
       tr("Synchronizes the SD Card with the SD Sync Folder when starting and ending emulation."));
-  sd_settings_group_layout->addWidget(m_sync_sd_folder_checkbox, row, 0, 1, 2);
+  m_incremental_sd_sync_checkbox = new QCheckBox(tr("Only Sync Changes"));
+  m_incremental_sd_sync_checkbox->setToolTip(
+      tr("Only copies the files that changed since the last sync instead of the whole SD Card."));
+  sd_settings_group_layout->addWidget(m_sync_sd_folder_checkbox, row, 0, 1, 1);
+  sd_settings_group_layout->addWidget(m_incremental_sd_sync_checkbox, row, 1, 1, 1);
+  ++row;
+
+  m_virtual_sd_card_checkbox = new QCheckBox(tr("Use Folder Directly"));
+  m_virtual_sd_card_checkbox->setToolTip(
+      tr("Emulates the SD Card from the SD Sync Folder without packing it into the SD Card file. "
+         "Only the files the game changes are written back when emulation ends.\n\n"
+         "Not used during NetPlay or when recording inputs."));
+  sd_settings_group_layout->addWidget(m_virtual_sd_card_checkbox, row, 0, 1, 2);
   ++row;
 
   {
@@ -390,6 +404,7 @@ void WiiPane::OnEmulationStateChanged(bool running)
   m_sound_mode_choice->setEnabled(!running);
   m_sd_pack_button->setEnabled(!running);
   m_sd_unpack_button->setEnabled(!running);
+  m_virtual_sd_card_checkbox->setEnabled(!running);
   m_wiimote_motor->setEnabled(!running);
   m_wiimote_speaker_volume->setEnabled(!running);
   m_wiimote_ir_sensitivity->setEnabled(!running);
@@ -411,6 +426,9 @@ void WiiPane::LoadConfig()
   m_sd_card_checkbox->setChecked(Settings::Instance().IsSDCardInserted());
   m_allow_sd_writes_checkbox->setChecked(Config::Get(Config::MAIN_ALLOW_SD_WRITES));
   m_sync_sd_folder_checkbox->setChecked(Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC));
+  m_incremental_sd_sync_checkbox->setChecked(
+      Config::Get(Config::MAIN_WII_SD_CARD_INCREMENTAL_SYNC));
+  m_virtual_sd_card_checkbox->setChecked(Config::Get(Config::MAIN_WII_SD_CARD_VIRTUAL_FOLDER));
 
   const u64 sd_card_size = Config::Get(Config::MAIN_WII_SD_CARD_FILESIZE);
   for (size_t i = 0; i < sd_size_combo_entries.size(); ++i)
@@ -452,6 +470,10 @@ void WiiPane::OnSaveConfig()
   Config::SetBase(Config::MAIN_ALLOW_SD_WRITES, m_allow_sd_writes_checkbox->isChecked());
   Config::SetBase(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC,
                   m_sync_sd_folder_checkbox->isChecked());
+  Config::SetBase(Config::MAIN_WII_SD_CARD_INCREMENTAL_SYNC,
+                  m_incremental_sd_sync_checkbox->isChecked());
+  Config::SetBase(Config::MAIN_WII_SD_CARD_VIRTUAL_FOLDER,
+                  m_virtual_sd_card_checkbox->isChecked());
 
   const int sd_card_size_index = m_sd_card_size_combo->currentIndex();
   if (sd_card_size_index >= 0 &&
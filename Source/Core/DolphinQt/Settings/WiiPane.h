@@ -64,6 +64,8 @@ private:
   QCheckBox* m_sd_card_checkbox;
   QCheckBox* m_allow_sd_writes_checkbox;
   QCheckBox* m_sync_sd_folder_checkbox;
+  QCheckBox* m_incremental_sd_sync_checkbox;
+  QCheckBox* m_virtual_sd_card_checkbox;
   QComboBox* m_sd_card_size_combo;
   QLineEdit* m_sd_raw_edit;
   QLineEdit* m_sd_sync_folder_edit;
@@ -0,0 +1,254 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/CPUBenchCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <picojson.h>
+
+#include "AudioCommon/AudioCommon.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/ScopeGuard.h"
+#include "Common/StringUtil.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+namespace
+{
+struct CPUCoreName
+{
+  PowerPC::CPUCore core;
+  std::string_view name;
+};
+
+constexpr CPUCoreName CPU_CORE_NAMES[] = {
+    {PowerPC::CPUCore::Interpreter, "interpreter"},
+    {PowerPC::CPUCore::CachedInterpreter, "cachedinterpreter"},
+    {PowerPC::CPUCore::JIT64, "jit64"},
+    {PowerPC::CPUCore::JITARM64, "jitarm64"},
+};
+
+struct BenchmarkResult
+{
+  std::string_view core;
+  double host_seconds = 0;
+  double emulated_seconds = 0;
+  bool ok = false;
+};
+}  // namespace
+
+static std::string_view GetCPUCoreName(PowerPC::CPUCore core)
+{
+  const auto it = std::ranges::find(CPU_CORE_NAMES, core, &CPUCoreName::core);
+  return it != std::end(CPU_CORE_NAMES) ? it->name : "unknown";
+}
+
+static void DispatchJobsWhile(Core::System& system, Core::State state)
+{
+  while (Core::GetState(system) == state)
+  {
+    Core::HostDispatchJobs(system);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+static u64 GetTicks(Core::System& system)
+{
+  u64 ticks = 0;
+  Core::RunOnCPUThread(system, [&] { ticks = system.GetCoreTiming().GetTicks(); }, true);
+  return ticks;
+}
+
+static BenchmarkResult RunBenchmark(const std::string& path, PowerPC::CPUCore core,
+                                    double seconds)
+{
+  BenchmarkResult result;
+  result.core = GetCPUCoreName(core);
+
+  Config::SetCurrent(Config::MAIN_CPU_CORE, core);
+
+  Core::System& system = Core::System::GetInstance();
+  const WindowSystemInfo wsi(WindowSystemType::Headless, nullptr, nullptr, nullptr);
+  if (!BootManager::BootCore(system, BootParameters::GenerateFromFile(path), wsi))
+    return result;
+
+  Common::ScopeGuard shutdown_guard([&system] {
+    Core::Stop(system);
+    Core::Shutdown(system);
+  });
+
+  DispatchJobsWhile(system, Core::State::Starting);
+  if (!Core::IsRunning(system))
+    return result;
+
+  // The time that the core spends compiling is included, as it's part of what the core costs.
+  const u64 start_ticks = GetTicks(system);
+  const auto start_time = Clock::now();
+  const auto end_time = start_time + std::chrono::duration_cast<DT>(DT_s(seconds));
+  while (Clock::now() < end_time && Core::IsRunning(system))
+  {
+    Core::HostDispatchJobs(system);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  if (!Core::IsRunning(system))
+    return result;
+
+  const u64 end_ticks = GetTicks(system);
+  result.host_seconds = DT_s(Clock::now() - start_time).count();
+  result.emulated_seconds = static_cast<double>(end_ticks - start_ticks) /
+                            system.GetSystemTimers().GetTicksPerSecond();
+  result.ok = true;
+  return result;
+}
+
+int CPUBenchCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: cpubench [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the DOL, ELF or disc image to run.")
+      .metavar("FILE");
+
+  parser.add_option("-c", "--cores")
+      .type("string")
+      .action("store")
+      .help("Optional. Comma-separated list of CPU cores to measure "
+            "(interpreter, cachedinterpreter, jit64, jitarm64). Default: all available cores.")
+      .metavar("CORES");
+
+  parser.add_option("-t", "--seconds")
+      .type("double")
+      .action("store")
+      .set_default(10)
+      .help("Optional. How long to run the input under each core, in seconds. Default: 10.")
+      .metavar("SECONDS");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("Optional. User folder path, to keep the configuration used for the benchmark "
+            "separate.")
+      .metavar("PATH");
+
+  parser.add_option("-j", "--json")
+      .action("store_true")
+      .help("Optional. Print the results as JSON.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string& input_file_path = options["input"];
+  if (input_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<PowerPC::CPUCore> cores;
+  if (options.is_set("cores"))
+  {
+    for (const std::string& name : SplitString(options["cores"], ','))
+    {
+      const auto it = std::ranges::find(CPU_CORE_NAMES, name, &CPUCoreName::name);
+      if (it == std::end(CPU_CORE_NAMES) ||
+          std::ranges::find(PowerPC::AvailableCPUCores(), it->core) ==
+              PowerPC::AvailableCPUCores().end())
+      {
+        fmt::print(std::cerr, "Error: Unavailable CPU core \"{}\"\n", name);
+        return EXIT_FAILURE;
+      }
+      cores.push_back(it->core);
+    }
+  }
+  else
+  {
+    cores.assign(PowerPC::AvailableCPUCores().begin(), PowerPC::AvailableCPUCores().end());
+  }
+
+  const double seconds = std::max(0.1, static_cast<double>(options.get("seconds")));
+
+  UICommon::SetUserDirectory(options.is_set("user") ? options["user"] : std::string());
+  UICommon::Init();
+  UICommon::InitControllers(WindowSystemInfo{});
+  Common::ScopeGuard ui_common_guard([] {
+    UICommon::ShutdownControllers();
+    UICommon::Shutdown();
+  });
+
+  // Only the CPU core should differ between runs, so everything else that could affect the
+  // result is fixed.
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, std::string("Null"));
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+  Config::SetCurrent(Config::MAIN_DSP_HLE, true);
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+
+  std::vector<BenchmarkResult> results;
+  for (const PowerPC::CPUCore core : cores)
+    results.push_back(RunBenchmark(input_file_path, core, seconds));
+
+  bool all_ok = true;
+  if (options.is_set_by_user("json"))
+  {
+    picojson::array json_results;
+    for (const BenchmarkResult& result : results)
+    {
+      picojson::object json;
+      json["core"] = picojson::value(std::string(result.core));
+      json["host_seconds"] = picojson::value(result.host_seconds);
+      json["emulated_seconds"] = picojson::value(result.emulated_seconds);
+      json["ok"] = picojson::value(result.ok);
+      json_results.emplace_back(std::move(json));
+      all_ok &= result.ok;
+    }
+    std::cout << picojson::value(json_results) << '\n';
+  }
+  else
+  {
+    fmt::print(std::cout, "{:<18} {:>12} {:>14} {:>10}\n", "Core", "Host (s)", "Emulated (s)",
+               "Speed");
+    for (const BenchmarkResult& result : results)
+    {
+      if (!result.ok)
+      {
+        fmt::print(std::cout, "{:<18} FAILED TO RUN\n", result.core);
+        all_ok = false;
+        continue;
+      }
+      fmt::print(std::cout, "{:<18} {:>12.2f} {:>14.2f} {:>9.1f}%\n", result.core,
+                 result.host_seconds, result.emulated_seconds,
+                 result.emulated_seconds / result.host_seconds * 100);
+    }
+  }
+
+  return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
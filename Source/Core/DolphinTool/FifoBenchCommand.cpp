@@ -0,0 +1,383 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/FifoBenchCommand.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <picojson.h>
+
+#include "AudioCommon/AudioCommon.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/ScopeGuard.h"
+#include "Common/StringUtil.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/PipelineStageTimers.h"
+
+namespace DolphinTool
+{
+namespace
+{
+struct BackendName
+{
+  std::string_view name;
+  std::string_view config_name;
+  bool software = false;
+  bool vector_pixel_kernels = true;
+};
+
+// Only the backends that run without a GPU, so that the results don't depend on the driver.
+// software-scalar is the software backend without its vectorized pixel kernels, to compare with.
+constexpr BackendName BACKEND_NAMES[] = {
+    {"null", "Null"},
+    {"software", "Software Renderer", true},
+    {"software-scalar", "Software Renderer", true, false},
+};
+
+struct BenchmarkResult
+{
+  std::string file;
+  std::string_view backend;
+  // The number of software rasterizer threads, or 0 if the configured number was used.
+  int sw_threads = 0;
+  u32 frames = 0;
+  double host_seconds = 0;
+  // FPS relative to the run of the same log with the fewest software rasterizer threads.
+  double scaling = 0;
+  VideoCommon::PipelineStageTotals stages;
+  bool ok = false;
+};
+
+// Counts the frames that the FIFO player starts writing and measures the frames after the warmup.
+// The callback runs on the CPU thread, the results are read on the host thread once done is set.
+struct FrameCounter
+{
+  u32 warmup_frames = 0;
+  u32 measured_frames = 0;
+
+  u32 frames_started = 0;
+  TimePoint start_time;
+  TimePoint end_time;
+  VideoCommon::PipelineStageTotals stages;
+  std::atomic<bool> done = false;
+
+  void OnFrameWritten()
+  {
+    if (done.load(std::memory_order_relaxed))
+      return;
+
+    // Frame N starting means that frame N - 1 has been written completely.
+    ++frames_started;
+    if (frames_started == warmup_frames + 1)
+    {
+      VideoCommon::PipelineStageTimers::Reset();
+      start_time = Clock::now();
+    }
+    else if (frames_started == warmup_frames + measured_frames + 1)
+    {
+      end_time = Clock::now();
+      stages = VideoCommon::PipelineStageTimers::GetTotals();
+      done.store(true, std::memory_order_release);
+    }
+  }
+};
+}  // namespace
+
+static void DispatchJobsWhile(Core::System& system, Core::State state)
+{
+  while (Core::GetState(system) == state)
+  {
+    Core::HostDispatchJobs(system);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+static BenchmarkResult RunBenchmark(const std::string& path, const BackendName& backend,
+                                    int sw_threads, u32 warmup_frames, u32 frames)
+{
+  BenchmarkResult result;
+  result.file = path;
+  result.backend = backend.name;
+  result.sw_threads = sw_threads;
+
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, std::string(backend.config_name));
+  Config::SetCurrent(Config::GFX_SW_VECTOR_PIXEL_KERNELS, backend.vector_pixel_kernels);
+  if (sw_threads != 0)
+    Config::SetCurrent(Config::GFX_SW_RASTERIZER_THREADS, sw_threads);
+
+  Core::System& system = Core::System::GetInstance();
+  FrameCounter counter;
+  counter.warmup_frames = warmup_frames;
+  counter.measured_frames = frames;
+  system.GetFifoPlayer().SetFrameWrittenCallback([&counter] { counter.OnFrameWritten(); });
+  Common::ScopeGuard callback_guard(
+      [&system] { system.GetFifoPlayer().SetFrameWrittenCallback(nullptr); });
+
+  const WindowSystemInfo wsi(WindowSystemType::Headless, nullptr, nullptr, nullptr);
+  if (!BootManager::BootCore(system, BootParameters::GenerateFromFile(path), wsi))
+    return result;
+
+  Common::ScopeGuard shutdown_guard([&system] {
+    Core::Stop(system);
+    Core::Shutdown(system);
+  });
+
+  DispatchJobsWhile(system, Core::State::Starting);
+
+  while (!counter.done.load(std::memory_order_acquire) && Core::IsRunning(system))
+  {
+    Core::HostDispatchJobs(system);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  if (!counter.done.load(std::memory_order_acquire))
+    return result;
+
+  result.frames = frames;
+  result.host_seconds = DT_s(counter.end_time - counter.start_time).count();
+  result.stages = counter.stages;
+  result.ok = true;
+  return result;
+}
+
+static picojson::value ToJson(const BenchmarkResult& result)
+{
+  picojson::object stages;
+  for (std::size_t i = 0; i < VideoCommon::NUM_PIPELINE_STAGES; ++i)
+  {
+    picojson::object stage;
+    stage["ms"] = picojson::value(static_cast<double>(result.stages.nanoseconds[i]) / 1000000.0);
+    stage["calls"] = picojson::value(static_cast<double>(result.stages.calls[i]));
+
+    const auto name = VideoCommon::PipelineStageTimers::GetName(
+        static_cast<VideoCommon::PipelineStage>(i));
+    stages[std::string(name)] = picojson::value(std::move(stage));
+  }
+
+  picojson::object json;
+  json["file"] = picojson::value(result.file);
+  json["backend"] = picojson::value(std::string(result.backend));
+  if (result.sw_threads != 0)
+  {
+    json["sw_threads"] = picojson::value(static_cast<double>(result.sw_threads));
+    json["scaling"] = picojson::value(result.scaling);
+  }
+  json["frames"] = picojson::value(static_cast<double>(result.frames));
+  json["host_seconds"] = picojson::value(result.host_seconds);
+  json["fps"] = picojson::value(result.ok ? result.frames / result.host_seconds : 0.0);
+  json["stages"] = picojson::value(std::move(stages));
+  json["ok"] = picojson::value(result.ok);
+  return picojson::value(std::move(json));
+}
+
+static void PrintTable(const BenchmarkResult& result)
+{
+  if (result.sw_threads != 0)
+    fmt::print(std::cout, "{} ({}, {} threads)\n", result.file, result.backend, result.sw_threads);
+  else
+    fmt::print(std::cout, "{} ({})\n", result.file, result.backend);
+  if (!result.ok)
+  {
+    fmt::print(std::cout, "  FAILED TO RUN\n\n");
+    return;
+  }
+
+  fmt::print(std::cout, "  {} frames in {:.2f} s, {:.1f} FPS\n", result.frames,
+             result.host_seconds, result.frames / result.host_seconds);
+  if (result.sw_threads != 0)
+    fmt::print(std::cout, "  {:.2f}x the FPS of the fewest threads\n", result.scaling);
+  fmt::print(std::cout, "  {:<24} {:>12} {:>12} {:>12}\n", "Stage", "Total (ms)", "ms/frame",
+             "Calls");
+  for (std::size_t i = 0; i < VideoCommon::NUM_PIPELINE_STAGES; ++i)
+  {
+    const double ms = static_cast<double>(result.stages.nanoseconds[i]) / 1000000.0;
+    fmt::print(std::cout, "  {:<24} {:>12.2f} {:>12.3f} {:>12}\n",
+               VideoCommon::PipelineStageTimers::GetName(
+                   static_cast<VideoCommon::PipelineStage>(i)),
+               ms, ms / result.frames, result.stages.calls[i]);
+  }
+  fmt::print(std::cout, "\n");
+}
+
+int FifoBenchCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: fifobench [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("append")
+      .help("Path to a FIFO log (.dff) to play. Can be given more than once.")
+      .metavar("FILE");
+
+  parser.add_option("-b", "--backends")
+      .type("string")
+      .action("store")
+      .set_default("null,software")
+      .help("Optional. Comma-separated list of video backends to measure (null, software, "
+            "software-scalar). Default: null,software.")
+      .metavar("BACKENDS");
+
+  parser.add_option("-t", "--sw-threads")
+      .type("string")
+      .action("store")
+      .help("Optional. Comma-separated list of software rasterizer thread counts to measure the "
+            "software backends with, e.g. 1,2,4,8, to report how it scales. Default: the "
+            "configured count.")
+      .metavar("COUNTS");
+
+  parser.add_option("-f", "--frames")
+      .type("int")
+      .action("store")
+      .set_default(100)
+      .help("Optional. How many frames to measure for each log and backend. Logs shorter than "
+            "this are looped. Default: 100.")
+      .metavar("FRAMES");
+
+  parser.add_option("-w", "--warmup")
+      .type("int")
+      .action("store")
+      .set_default(5)
+      .help("Optional. How many frames to play before measuring, so that shaders and textures "
+            "are already cached. Default: 5.")
+      .metavar("FRAMES");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("Optional. User folder path, to keep the configuration used for the benchmark "
+            "separate.")
+      .metavar("PATH");
+
+  parser.add_option("-j", "--json")
+      .action("store_true")
+      .help("Optional. Print the results as JSON.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  std::list<std::string> input_file_paths;
+  if (options.is_set_by_user("input"))
+    input_file_paths = options.all("input");
+  if (input_file_paths.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<const BackendName*> backends;
+  for (const std::string& name : SplitString(options["backends"], ','))
+  {
+    const auto it = std::ranges::find(BACKEND_NAMES, name, &BackendName::name);
+    if (it == std::end(BACKEND_NAMES))
+    {
+      fmt::print(std::cerr, "Error: Unsupported video backend \"{}\"\n", name);
+      return EXIT_FAILURE;
+    }
+    backends.push_back(it);
+  }
+
+  // 0 stands for the configured count.
+  std::vector<int> sw_thread_counts;
+  if (options.is_set_by_user("sw_threads"))
+  {
+    for (const std::string& count : SplitString(options["sw_threads"], ','))
+    {
+      int value;
+      if (!TryParse(count, &value) || value <= 0)
+      {
+        fmt::print(std::cerr, "Error: Invalid software rasterizer thread count \"{}\"\n", count);
+        return EXIT_FAILURE;
+      }
+      sw_thread_counts.push_back(value);
+    }
+    std::ranges::sort(sw_thread_counts);
+  }
+  if (sw_thread_counts.empty())
+    sw_thread_counts.push_back(0);
+
+  const u32 frames = static_cast<u32>(std::max(1, static_cast<int>(options.get("frames"))));
+  const u32 warmup_frames = static_cast<u32>(std::max(0, static_cast<int>(options.get("warmup"))));
+
+  UICommon::SetUserDirectory(options.is_set("user") ? options["user"] : std::string());
+  UICommon::Init();
+  UICommon::InitControllers(WindowSystemInfo{});
+  Common::ScopeGuard ui_common_guard([] {
+    UICommon::ShutdownControllers();
+    UICommon::Shutdown();
+  });
+
+  // Only the log and the video backend should differ between runs, so everything else that could
+  // affect the result is fixed.
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+  Config::SetCurrent(Config::MAIN_DSP_HLE, true);
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+
+  VideoCommon::PipelineStageTimers::SetEnabled(true);
+  Common::ScopeGuard timers_guard([] { VideoCommon::PipelineStageTimers::SetEnabled(false); });
+
+  std::vector<BenchmarkResult> results;
+  for (const std::string& path : input_file_paths)
+  {
+    for (const BackendName* backend : backends)
+    {
+      if (!backend->software)
+      {
+        results.push_back(RunBenchmark(path, *backend, 0, warmup_frames, frames));
+        continue;
+      }
+
+      const std::size_t first = results.size();
+      for (const int sw_threads : sw_thread_counts)
+        results.push_back(RunBenchmark(path, *backend, sw_threads, warmup_frames, frames));
+
+      const BenchmarkResult& baseline = results[first];
+      for (std::size_t i = first; i < results.size(); ++i)
+      {
+        if (baseline.ok && results[i].ok)
+          results[i].scaling = baseline.host_seconds / results[i].host_seconds;
+      }
+    }
+  }
+
+  const bool all_ok = std::ranges::all_of(results, &BenchmarkResult::ok);
+  if (options.is_set_by_user("json"))
+  {
+    picojson::array json_results;
+    for (const BenchmarkResult& result : results)
+      json_results.push_back(ToJson(result));
+    std::cout << picojson::value(json_results) << '\n';
+  }
+  else
+  {
+    for (const BenchmarkResult& result : results)
+      PrintTable(result);
+  }
+
+  return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
@@ -0,0 +1,211 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/SDBenchCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Core/IOS/SDIO/SDCardBackend.h"
+#include "Core/IOS/SDIO/SDCardCache.h"
+#include "Core/IOS/SDIO/SDCardTrace.h"
+
+namespace DolphinTool
+{
+namespace
+{
+struct BenchmarkResult
+{
+  std::string mode;
+  u64 reads = 0;
+  u64 bytes_read = 0;
+  double total_ms = 0;
+  double average_us = 0;
+  double p99_us = 0;
+  double max_us = 0;
+  IOS::HLE::SDCardCache::Stats cache_stats;
+  bool ok = true;
+};
+}  // namespace
+
+static BenchmarkResult RunBenchmark(const std::string& mode, IOS::HLE::SDCardBackend& card,
+                                    const std::vector<IOS::HLE::SDCardAccess>& trace,
+                                    bool realtime)
+{
+  BenchmarkResult result;
+  result.mode = mode;
+
+  std::vector<double> latencies_us;
+  std::vector<u8> buffer;
+  for (const IOS::HLE::SDCardAccess& access : trace)
+  {
+    // Writes are skipped so that the image is left untouched.
+    if (access.is_write)
+      continue;
+
+    // Idle time between accesses is what lets read-ahead get ahead of the reads.
+    if (realtime)
+      std::this_thread::sleep_for(std::chrono::microseconds(access.delay_us));
+
+    buffer.resize(access.size);
+    const auto start = Clock::now();
+    result.ok &= card.Read(access.offset, buffer.data(), access.size);
+    latencies_us.push_back(DT_us(Clock::now() - start).count());
+
+    ++result.reads;
+    result.bytes_read += access.size;
+  }
+
+  if (latencies_us.empty())
+    return result;
+
+  for (const double latency : latencies_us)
+    result.total_ms += latency / 1000;
+  result.average_us = result.total_ms * 1000 / latencies_us.size();
+  std::ranges::sort(latencies_us);
+  result.p99_us = latencies_us[latencies_us.size() * 99 / 100];
+  result.max_us = latencies_us.back();
+  return result;
+}
+
+int SDBenchCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: sdbench [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the SD card image FILE to read from.")
+      .metavar("FILE");
+
+  parser.add_option("-t", "--trace")
+      .type("string")
+      .action("store")
+      .help("Path to an SD card access TRACE recorded with Core/WiiSDCardAccessTrace.")
+      .metavar("TRACE");
+
+  parser.add_option("-c", "--cache_mb")
+      .type("int")
+      .action("store")
+      .set_default(32)
+      .help("Optional. Size of the read cache in MiB. Default: 32.")
+      .metavar("SIZE");
+
+  parser.add_option("-r", "--realtime")
+      .action("store_true")
+      .help("Optional. Wait between accesses as long as the emulated software did.");
+
+  parser.add_option("-j", "--json")
+      .action("store_true")
+      .help("Optional. Print the results as JSON.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string& input_file_path = options["input"];
+  if (input_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::optional<std::vector<IOS::HLE::SDCardAccess>> trace =
+      IOS::HLE::LoadSDCardTrace(options["trace"]);
+  if (!trace)
+  {
+    fmt::print(std::cerr, "Error: Unable to read trace\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto open_image = [&]() -> std::unique_ptr<IOS::HLE::SDCardBackend> {
+    File::IOFile file(input_file_path, "rb");
+    if (!file)
+      return nullptr;
+    return std::make_unique<IOS::HLE::SDCardImage>(std::move(file));
+  };
+
+  std::unique_ptr<IOS::HLE::SDCardBackend> image = open_image();
+  std::unique_ptr<IOS::HLE::SDCardBackend> cached_image = open_image();
+  if (!image || !cached_image)
+  {
+    fmt::print(std::cerr, "Error: Unable to open input file\n");
+    return EXIT_FAILURE;
+  }
+
+  const bool realtime = options.is_set_by_user("realtime");
+  const u64 cache_size = std::max(1, static_cast<int>(options.get("cache_mb"))) * 1024ULL * 1024;
+
+  std::vector<BenchmarkResult> results;
+  // The uncached run goes first, so that it also warms up the cache of the host OS.
+  results.push_back(RunBenchmark("uncached", *image, *trace, realtime));
+  {
+    IOS::HLE::SDCardCache cache(std::move(cached_image), cache_size);
+    results.push_back(RunBenchmark("cached", cache, *trace, realtime));
+    results.back().cache_stats = cache.GetStats();
+  }
+
+  bool all_ok = true;
+  if (options.is_set_by_user("json"))
+  {
+    picojson::array json_results;
+    for (const BenchmarkResult& result : results)
+    {
+      picojson::object json;
+      json["mode"] = picojson::value(result.mode);
+      json["reads"] = picojson::value(static_cast<double>(result.reads));
+      json["bytes_read"] = picojson::value(static_cast<double>(result.bytes_read));
+      json["total_ms"] = picojson::value(result.total_ms);
+      json["average_us"] = picojson::value(result.average_us);
+      json["p99_us"] = picojson::value(result.p99_us);
+      json["max_us"] = picojson::value(result.max_us);
+      json["cache_hits"] = picojson::value(static_cast<double>(result.cache_stats.hits));
+      json["cache_misses"] = picojson::value(static_cast<double>(result.cache_stats.misses));
+      json["read_ahead_blocks"] =
+          picojson::value(static_cast<double>(result.cache_stats.read_ahead_blocks));
+      json["read_ahead_hits"] =
+          picojson::value(static_cast<double>(result.cache_stats.read_ahead_hits));
+      json["ok"] = picojson::value(result.ok);
+      json_results.emplace_back(std::move(json));
+      all_ok &= result.ok;
+    }
+    std::cout << picojson::value(json_results) << '\n';
+  }
+  else
+  {
+    fmt::print(std::cout, "Trace: {} accesses, {} reads ({} bytes)\n", trace->size(),
+               results[0].reads, results[0].bytes_read);
+    fmt::print(std::cout, "{:<10} {:>10} {:>10} {:>10} {:>10} {:>8} {:>8} {:>12}\n", "Mode",
+               "Total (ms)", "Avg (us)", "p99 (us)", "Max (us)", "Hits", "Misses",
+               "Read-ahead");
+    for (const BenchmarkResult& result : results)
+    {
+      const IOS::HLE::SDCardCache::Stats& stats = result.cache_stats;
+      fmt::print(std::cout,
+                 "{:<10} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f} {:>8} {:>8} {:>12}{}\n",
+                 result.mode, result.total_ms, result.average_us, result.p99_us, result.max_us,
+                 stats.hits, stats.misses,
+                 fmt::format("{}/{}", stats.read_ahead_hits, stats.read_ahead_blocks),
+                 result.ok ? "" : "  READ FAILED");
+      all_ok &= result.ok;
+    }
+  }
+
+  return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
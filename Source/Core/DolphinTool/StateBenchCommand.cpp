@@ -0,0 +1,214 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/StateBenchCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <picojson.h>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
+#include "Core/State.h"
+#include "Core/StateCompression.h"
+
+namespace DolphinTool
+{
+namespace
+{
+struct BenchmarkResult
+{
+  std::string mode;
+  u64 compressed_size = 0;
+  double save_ms = 0;
+  double load_ms = 0;
+  bool matches = false;
+};
+}  // namespace
+
+static Common::UniqueBuffer<u8> Compress(std::span<const u8> data, State::CompressionType type,
+                                         int zstd_level)
+{
+  switch (type)
+  {
+  case State::CompressionType::Uncompressed:
+  {
+    // Uncompressed states are written straight from the serialization buffer, so the copy is
+    // only a stand-in for the memory traffic of the write.
+    Common::UniqueBuffer<u8> copy(data.size());
+    std::memcpy(copy.data(), data.data(), data.size());
+    return copy;
+  }
+  case State::CompressionType::LZ4:
+    return State::CompressLZ4Stream(data);
+  default:
+    return State::CompressChunked(data, type, zstd_level);
+  }
+}
+
+static bool Decompress(std::span<const u8> compressed, State::CompressionType type,
+                       std::span<u8> out)
+{
+  switch (type)
+  {
+  case State::CompressionType::Uncompressed:
+    if (compressed.size() != out.size())
+      return false;
+    std::memcpy(out.data(), compressed.data(), out.size());
+    return true;
+  case State::CompressionType::LZ4:
+    return State::DecompressLZ4Stream(compressed, out);
+  default:
+    return State::DecompressChunked(compressed, type, out);
+  }
+}
+
+static BenchmarkResult RunBenchmark(const Common::UniqueBuffer<u8>& data,
+                                    State::CompressionType type, int zstd_level, int iterations)
+{
+  BenchmarkResult result;
+  result.mode = State::GetCompressionTypeName(type, zstd_level);
+  result.save_ms = result.load_ms = std::numeric_limits<double>::max();
+
+  Common::UniqueBuffer<u8> decompressed(data.size());
+  for (int i = 0; i < iterations; ++i)
+  {
+    const auto save_start = Clock::now();
+    const Common::UniqueBuffer<u8> compressed = Compress(data, type, zstd_level);
+    result.save_ms = std::min(result.save_ms, DT_ms(Clock::now() - save_start).count());
+    result.compressed_size = compressed.size();
+
+    const auto load_start = Clock::now();
+    result.matches = Decompress(compressed, type, decompressed);
+    result.load_ms = std::min(result.load_ms, DT_ms(Clock::now() - load_start).count());
+  }
+
+  result.matches = result.matches && std::equal(data.begin(), data.end(), decompressed.begin());
+  return result;
+}
+
+int StateBenchCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: statebench [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to an uncompressed savestate or memory dump FILE to use as the payload.")
+      .metavar("FILE");
+
+  parser.add_option("-l", "--zstd_levels")
+      .type("string")
+      .action("store")
+      .set_default("1,3,9")
+      .help("Optional. Comma-separated list of zstd levels to measure. Default: 1,3,9.")
+      .metavar("LEVELS");
+
+  parser.add_option("-n", "--iterations")
+      .type("int")
+      .action("store")
+      .set_default(3)
+      .help("Optional. Number of runs per mode; the fastest run is reported. Default: 3.")
+      .metavar("COUNT");
+
+  parser.add_option("-j", "--json")
+      .action("store_true")
+      .help("Optional. Print the results as JSON.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string& input_file_path = options["input"];
+  if (input_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<int> zstd_levels;
+  for (const std::string& level_str : SplitString(options["zstd_levels"], ','))
+  {
+    int level;
+    if (!TryParse(level_str, &level))
+    {
+      fmt::print(std::cerr, "Error: Invalid zstd level \"{}\"\n", level_str);
+      return EXIT_FAILURE;
+    }
+    zstd_levels.push_back(level);
+  }
+
+  const int iterations = std::max(1, static_cast<int>(options.get("iterations")));
+
+  File::IOFile file(input_file_path, "rb");
+  Common::UniqueBuffer<u8> data(file.GetSize());
+  if (!file || !file.ReadBytes(data.data(), data.size()))
+  {
+    fmt::print(std::cerr, "Error: Unable to read input file\n");
+    return EXIT_FAILURE;
+  }
+
+  // The single-threaded LZ4 stream that states used before chunked compression, and no
+  // compression at all, are the baselines for the chunked modes.
+  std::vector<BenchmarkResult> results;
+  results.push_back(RunBenchmark(data, State::CompressionType::Uncompressed, 0, iterations));
+  results.push_back(RunBenchmark(data, State::CompressionType::LZ4, 0, iterations));
+  const BenchmarkResult legacy = results.back();
+  results.push_back(RunBenchmark(data, State::CompressionType::ChunkedLZ4, 0, iterations));
+  for (const int level : zstd_levels)
+    results.push_back(RunBenchmark(data, State::CompressionType::ChunkedZstd, level, iterations));
+
+  bool all_matched = true;
+  if (options.is_set_by_user("json"))
+  {
+    picojson::array json_results;
+    for (const BenchmarkResult& result : results)
+    {
+      picojson::object json;
+      json["mode"] = picojson::value(result.mode);
+      json["uncompressed_size"] = picojson::value(static_cast<double>(data.size()));
+      json["compressed_size"] = picojson::value(static_cast<double>(result.compressed_size));
+      json["save_ms"] = picojson::value(result.save_ms);
+      json["load_ms"] = picojson::value(result.load_ms);
+      json["save_speedup"] = picojson::value(legacy.save_ms / result.save_ms);
+      json["load_speedup"] = picojson::value(legacy.load_ms / result.load_ms);
+      json["round_trip_ok"] = picojson::value(result.matches);
+      json_results.emplace_back(std::move(json));
+      all_matched &= result.matches;
+    }
+    std::cout << picojson::value(json_results) << '\n';
+  }
+  else
+  {
+    fmt::print(std::cout, "Payload: {} bytes, {} chunk(s) of {} bytes\n", data.size(),
+               (data.size() + State::STATE_CHUNK_SIZE - 1) / State::STATE_CHUNK_SIZE,
+               State::STATE_CHUNK_SIZE);
+    fmt::print(std::cout, "{:<16} {:>12} {:>8} {:>10} {:>10} {:>8} {:>8}\n", "Mode", "Size",
+               "Ratio", "Save (ms)", "Load (ms)", "Save x", "Load x");
+    for (const BenchmarkResult& result : results)
+    {
+      const double ratio =
+          data.empty() ? 0.0 : static_cast<double>(result.compressed_size) / data.size();
+      fmt::print(std::cout, "{:<16} {:>12} {:>8.3f} {:>10.2f} {:>10.2f} {:>8.2f} {:>8.2f}{}\n",
+                 result.mode, result.compressed_size, ratio, result.save_ms, result.load_ms,
+                 legacy.save_ms / result.save_ms, legacy.load_ms / result.load_ms,
+                 result.matches ? "" : "  ROUND TRIP FAILED");
+      all_matched &= result.matches;
+    }
+  }
+
+  return all_matched ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
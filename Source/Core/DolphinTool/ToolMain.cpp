@@ -14,16 +14,21 @@
 #include "Common/StringUtil.h"
 #include "Core/Core.h"
 
+#include "DolphinTool/CPUBenchCommand.h"
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/ExtractCommand.h"
+#include "DolphinTool/FifoBenchCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/SDBenchCommand.h"
+#include "DolphinTool/StateBenchCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static void PrintUsage()
 {
   fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
                         "\n"
-                        "commands supported: [convert, verify, header, extract]\n");
+                        "commands supported: [convert, verify, header, extract, statebench, sdbench, "
+                        "cpubench, fifobench]\n");
 }
 
 #ifdef _WIN32
@@ -52,6 +57,14 @@ int main(int argc, char* argv[])
     return DolphinTool::HeaderCommand(args);
   else if (command_str == "extract")
     return DolphinTool::Extract(args);
+  else if (command_str == "statebench")
+    return DolphinTool::StateBenchCommand(args);
+  else if (command_str == "sdbench")
+    return DolphinTool::SDBenchCommand(args);
+  else if (command_str == "cpubench")
+    return DolphinTool::CPUBenchCommand(args);
+  else if (command_str == "fifobench")
+    return DolphinTool::FifoBenchCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
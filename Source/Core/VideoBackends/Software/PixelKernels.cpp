@@ -0,0 +1,142 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Software/PixelKernels.h"
+
+#include <cstring>
+
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#include "Common/Logging/Log.h"
+
+namespace PixelKernels
+{
+CombineFunction Combine = Scalar::Combine;
+FilterFunction FilterTexels = Scalar::FilterTexels;
+
+void Init(bool allow_vector)
+{
+#ifdef _M_X86_64
+  if (allow_vector && cpu_info.bAVX2)
+  {
+    Combine = AVX2::Combine;
+    FilterTexels = AVX2::FilterTexels;
+    INFO_LOG_FMT(VIDEO, "Software renderer: using AVX2 pixel kernels");
+    return;
+  }
+#endif
+
+  Combine = Scalar::Combine;
+  FilterTexels = Scalar::FilterTexels;
+}
+
+namespace Scalar
+{
+void Combine(const CombinerInputs& inputs, const CombinerParams& params,
+             std::array<s16, 4>* result)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    const s32 c = inputs.c[i] + (inputs.c[i] >> 7);
+
+    s32 temp = inputs.a[i] * (256 - c) + inputs.b[i] * c;
+    temp <<= params.left_shift[i];
+    temp += params.round[i];
+    temp = (temp ^ params.negate_before_shift[i]) - params.negate_before_shift[i];
+    temp >>= 8;
+    temp = (temp ^ params.negate_after_shift[i]) - params.negate_after_shift[i];
+
+    const s32 value = ((inputs.d[i] + params.bias[i]) << params.left_shift[i]) + temp;
+    (*result)[i] = static_cast<s16>(value >> params.right_shift[i]);
+  }
+}
+
+void FilterTexels(const u8 (*texels)[4], const u32* weights, u32 shift, u8* sample)
+{
+  for (int channel = 0; channel < 4; channel++)
+  {
+    u32 sum = 0;
+    for (int i = 0; i < 4; i++)
+      sum += texels[i][channel] * weights[i];
+    sample[channel] = static_cast<u8>(sum >> shift);
+  }
+}
+}  // namespace Scalar
+
+#ifdef _M_X86_64
+namespace AVX2
+{
+FUNCTION_TARGET_AVX2
+static inline __m128i LoadLanes(const std::array<s16, 4>& lanes)
+{
+  return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(lanes.data())));
+}
+
+template <typename T>
+FUNCTION_TARGET_AVX2 static inline __m128i LoadParam(const std::array<T, 4>& values)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data()));
+}
+
+FUNCTION_TARGET_AVX2
+void Combine(const CombinerInputs& inputs, const CombinerParams& params,
+             std::array<s16, 4>* result)
+{
+  const __m128i a = LoadLanes(inputs.a);
+  const __m128i b = LoadLanes(inputs.b);
+  __m128i c = LoadLanes(inputs.c);
+  const __m128i d = LoadLanes(inputs.d);
+  const __m128i left_shift = LoadParam(params.left_shift);
+  const __m128i negate_before_shift = LoadParam(params.negate_before_shift);
+  const __m128i negate_after_shift = LoadParam(params.negate_after_shift);
+
+  c = _mm_add_epi32(c, _mm_srli_epi32(c, 7));
+
+  // a * (256 - c) + b * c, with each product pair computed by one multiply-add
+  const __m128i ab = _mm_or_si128(a, _mm_slli_epi32(b, 16));
+  const __m128i weights =
+      _mm_or_si128(_mm_sub_epi32(_mm_set1_epi32(256), c), _mm_slli_epi32(c, 16));
+  __m128i temp = _mm_madd_epi16(ab, weights);
+
+  temp = _mm_sllv_epi32(temp, left_shift);
+  temp = _mm_add_epi32(temp, LoadParam(params.round));
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before_shift), negate_before_shift);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_after_shift), negate_after_shift);
+
+  __m128i value = _mm_sllv_epi32(_mm_add_epi32(d, LoadParam(params.bias)), left_shift);
+  value = _mm_add_epi32(value, temp);
+  value = _mm_srav_epi32(value, LoadParam(params.right_shift));
+
+  // The values always fit in 16 bits, so saturating doesn't change them.
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(result->data()), _mm_packs_epi32(value, value));
+}
+
+FUNCTION_TARGET_AVX2
+void FilterTexels(const u8 (*texels)[4], const u32* weights, u32 shift, u8* sample)
+{
+  u32 texel_bits[4];
+  std::memcpy(texel_bits, texels, sizeof(texel_bits));
+
+  // Interleave the channels of two texels so that one multiply-add weighs both of them.
+  const __m128i texels01 = _mm_cvtepu8_epi16(_mm_unpacklo_epi8(
+      _mm_cvtsi32_si128(static_cast<int>(texel_bits[0])),
+      _mm_cvtsi32_si128(static_cast<int>(texel_bits[1]))));
+  const __m128i texels23 = _mm_cvtepu8_epi16(_mm_unpacklo_epi8(
+      _mm_cvtsi32_si128(static_cast<int>(texel_bits[2])),
+      _mm_cvtsi32_si128(static_cast<int>(texel_bits[3]))));
+  const __m128i weights01 = _mm_set1_epi32(static_cast<int>(weights[0] | weights[1] << 16));
+  const __m128i weights23 = _mm_set1_epi32(static_cast<int>(weights[2] | weights[3] << 16));
+
+  __m128i sum = _mm_add_epi32(_mm_madd_epi16(texels01, weights01),
+                              _mm_madd_epi16(texels23, weights23));
+  sum = _mm_srl_epi32(sum, _mm_cvtsi32_si128(static_cast<int>(shift)));
+
+  // The channels are at most 255 after the shift, so saturating doesn't change them.
+  sum = _mm_packus_epi16(_mm_packus_epi32(sum, sum), sum);
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(sum));
+  std::memcpy(sample, &result, sizeof(result));
+}
+}  // namespace AVX2
+#endif
+}  // namespace PixelKernels
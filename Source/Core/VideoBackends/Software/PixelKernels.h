@@ -0,0 +1,67 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "Common/CommonTypes.h"
+
+// The per-pixel arithmetic of the TEV and the texture sampler, with vectorized versions that are
+// chosen at runtime. All versions must give exactly the same results as the scalar one.
+namespace PixelKernels
+{
+// The inputs and settings of one TEV stage. Lanes are in the same order as the Tev's registers:
+// alpha, blue, green, red.
+struct CombinerInputs
+{
+  // a, b and c are 8 bits and d is 11 bits signed, like the hardware's inputs.
+  std::array<s16, 4> a;
+  std::array<s16, 4> b;
+  std::array<s16, 4> c;
+  std::array<s16, 4> d;
+};
+
+struct CombinerParams
+{
+  std::array<s32, 4> bias;
+  std::array<s32, 4> round;
+  std::array<u32, 4> left_shift;
+  std::array<u32, 4> right_shift;
+  // All bits set for lanes that subtract. Alpha negates before dropping the fraction, the colors
+  // negate after it.
+  std::array<s32, 4> negate_before_shift;
+  std::array<s32, 4> negate_after_shift;
+};
+
+// Computes (d + bias + lerp(a, b, c)) * scale for each lane, without clamping.
+using CombineFunction = void (*)(const CombinerInputs& inputs, const CombinerParams& params,
+                                 std::array<s16, 4>* result);
+
+// Computes sum(texels[i] * weights[i]) >> shift for each channel. Each weight must fit in 15 bits
+// and the sum of the weights must not be more than 1 << shift.
+using FilterFunction = void (*)(const u8 (*texels)[4], const u32* weights, u32 shift, u8* sample);
+
+extern CombineFunction Combine;
+extern FilterFunction FilterTexels;
+
+// Selects the fastest versions that this CPU supports. If allow_vector is false, the scalar
+// versions are used, so that the vectorized ones can be compared against them.
+void Init(bool allow_vector = true);
+
+namespace Scalar
+{
+void Combine(const CombinerInputs& inputs, const CombinerParams& params,
+             std::array<s16, 4>* result);
+void FilterTexels(const u8 (*texels)[4], const u32* weights, u32 shift, u8* sample);
+}  // namespace Scalar
+
+#ifdef _M_X86_64
+namespace AVX2
+{
+void Combine(const CombinerInputs& inputs, const CombinerParams& params,
+             std::array<s16, 4>* result);
+void FilterTexels(const u8 (*texels)[4], const u32* weights, u32 shift, u8* sample);
+}  // namespace AVX2
+#endif
+}  // namespace PixelKernels
@@ -10,8 +10,10 @@
 
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
+#include "Core/Config/GraphicsSettings.h"
 
 #include "VideoBackends/Software/Clipper.h"
+#include "VideoBackends/Software/PixelKernels.h"
 #include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/SWEfbInterface.h"
@@ -97,6 +99,7 @@ bool VideoSoftware::Initialize(const WindowSystemInfo& wsi)
     return false;
 
   Clipper::Init();
+  PixelKernels::Init(Config::Get(Config::GFX_SW_VECTOR_PIXEL_KERNELS));
   Rasterizer::Init();
 
   return InitializeShared(std::make_unique<SWGfx>(std::move(window)),
@@ -108,5 +111,6 @@ bool VideoSoftware::Initialize(const WindowSystemInfo& wsi)
 void VideoSoftware::Shutdown()
 {
   ShutdownShared();
+  Rasterizer::Shutdown();
 }
 }  // namespace SW
@@ -12,12 +12,10 @@
 
 #include "Core/System.h"
 
-#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/SWEfbInterface.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/XFMemory.h"
 
@@ -77,25 +75,26 @@ void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
   }
 }
 
-void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
+PixelKernels::CombinerParams Tev::GetCombinerParams(const TevStageCombiner::ColorCombiner& cc,
+                                                    const TevStageCombiner::AlphaCombiner& ac)
 {
-  for (int i = BLU_C; i <= RED_C; i++)
+  PixelKernels::CombinerParams params;
+  for (int i = ALP_C; i <= RED_C; i++)
   {
-    const InputRegType& InputReg = inputs[i];
-
-    const u16 c = InputReg.c + (InputReg.c >> 7);
-
-    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-    temp <<= s_ScaleLShiftLUT[cc.scale];
-    temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
-    temp >>= 8;
-    temp = cc.op == TevOp::Sub ? -temp : temp;
-
-    s32 result = ((InputReg.d + s_BiasLUT[cc.bias]) << s_ScaleLShiftLUT[cc.scale]) + temp;
-    result = result >> s_ScaleRShiftLUT[cc.scale];
-
-    Reg[cc.dest][i] = result;
+    const bool alpha = i == ALP_C;
+    const TevBias bias = alpha ? ac.bias : cc.bias;
+    const TevOp op = alpha ? ac.op : cc.op;
+    const TevScale scale = alpha ? ac.scale : cc.scale;
+
+    params.bias[i] = s_BiasLUT[bias];
+    params.round[i] = (scale == TevScale::Divide2) ? 0 : (op == TevOp::Sub) ? 127 : 128;
+    params.left_shift[i] = s_ScaleLShiftLUT[scale];
+    params.right_shift[i] = s_ScaleRShiftLUT[scale];
+    // Alpha rounds the negated value, while the colors negate the rounded value.
+    params.negate_before_shift[i] = (alpha && op == TevOp::Sub) ? -1 : 0;
+    params.negate_after_shift[i] = (!alpha && op == TevOp::Sub) ? -1 : 0;
   }
+  return params;
 }
 
 void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
@@ -137,23 +136,6 @@ void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const Inpu
   }
 }
 
-void Tev::DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
-{
-  const InputRegType& InputReg = inputs[ALP_C];
-
-  const u16 c = InputReg.c + (InputReg.c >> 7);
-
-  s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-  temp <<= s_ScaleLShiftLUT[ac.scale];
-  temp += (ac.scale == TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
-  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
-
-  s32 result = ((InputReg.d + s_BiasLUT[ac.bias]) << s_ScaleLShiftLUT[ac.scale]) + temp;
-  result = result >> s_ScaleRShiftLUT[ac.scale];
-
-  Reg[ac.dest].a = result;
-}
-
 void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
 {
   u32 a, b;
@@ -389,7 +371,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  ++counters.tev_pixels_in;
 
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
@@ -507,10 +489,29 @@ void Tev::Draw()
     inputs[ALP_C].c = m_AlphaInputLUT[ac.c].a;
     inputs[ALP_C].d = m_AlphaInputLUT[ac.d].a;
 
+    // Compute the regular result of all channels at once, and replace it for the ones that
+    // compare.
+    PixelKernels::CombinerInputs lanes;
+    for (int i = ALP_C; i <= RED_C; i++)
+    {
+      lanes.a[i] = inputs[i].a;
+      lanes.b[i] = inputs[i].b;
+      lanes.c[i] = inputs[i].c;
+      lanes.d[i] = inputs[i].d;
+    }
+    std::array<s16, 4> combined;
+    PixelKernels::Combine(lanes, GetCombinerParams(cc, ac), &combined);
+
     if (cc.bias != TevBias::Compare)
-      DrawColorRegular(cc, inputs);
+    {
+      Reg[cc.dest].b = combined[BLU_C];
+      Reg[cc.dest].g = combined[GRN_C];
+      Reg[cc.dest].r = combined[RED_C];
+    }
     else
+    {
       DrawColorCompare(cc, inputs);
+    }
 
     if (cc.clamp)
     {
@@ -526,7 +527,7 @@ void Tev::Draw()
     }
 
     if (ac.bias != TevBias::Compare)
-      DrawAlphaRegular(ac, inputs);
+      Reg[ac.dest].a = combined[ALP_C];
     else
       DrawAlphaCompare(ac, inputs);
 
@@ -651,33 +652,40 @@ void Tev::Draw()
       break;
     }
 
-    // lerp from output to fog color
+    // lerp from output to fog color, alpha is blended with itself so that it stays the same
     const u32 fogInt = (u32)(fog * 256);
     const u32 invFog = 256 - fogInt;
 
-    output[RED_C] = (output[RED_C] * invFog + fogInt * bpmem.fog.color.r) >> 8;
-    output[GRN_C] = (output[GRN_C] * invFog + fogInt * bpmem.fog.color.g) >> 8;
-    output[BLU_C] = (output[BLU_C] * invFog + fogInt * bpmem.fog.color.b) >> 8;
+    const u8 texels[4][4] = {
+        {output[ALP_C], output[BLU_C], output[GRN_C], output[RED_C]},
+        {output[ALP_C], static_cast<u8>(bpmem.fog.color.b), static_cast<u8>(bpmem.fog.color.g),
+         static_cast<u8>(bpmem.fog.color.r)},
+        {},
+        {}};
+    const u32 weights[4] = {invFog, fogInt, 0, 0};
+    PixelKernels::FilterTexels(texels, weights, 8, output);
   }
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    ++counters.perf_pixels[PQ_ZCOMP_INPUT];
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    ++counters.perf_pixels[PQ_ZCOMP_OUTPUT];
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  counters.bbox_left = std::min(counters.bbox_left, static_cast<u16>(Position[0] & ~1));
+  counters.bbox_right = std::max(counters.bbox_right, static_cast<u16>(Position[0] | 1));
+  counters.bbox_top = std::min(counters.bbox_top, static_cast<u16>(Position[1] & ~1));
+  counters.bbox_bottom = std::max(counters.bbox_bottom, static_cast<u16>(Position[1] | 1));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  ++counters.tev_pixels_out;
+  ++counters.perf_pixels[PQ_BLEND_INPUT];
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
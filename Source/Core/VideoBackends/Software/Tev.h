@@ -6,7 +6,9 @@
 #include <array>
 
 #include "Common/EnumMap.h"
+#include "VideoBackends/Software/PixelKernels.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -206,9 +208,9 @@ class Tev
 
   void SetRasColor(RasColorChan colorChan, u32 swaptable);
 
-  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
+  static PixelKernels::CombinerParams GetCombinerParams(const TevStageCombiner::ColorCombiner& cc,
+                                                       const TevStageCombiner::AlphaCombiner& ac);
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
@@ -222,6 +224,22 @@ public:
   s32 TextureLod[16]{};
   bool TextureLinear[16]{};
 
+  // What this Tev drew since the rasterizer last added it to the shared counters. The tiles of a
+  // draw are drawn by several Tevs at once, so they don't update the shared counters directly.
+  struct Counters
+  {
+    // Pixels, not quads.
+    std::array<u32, PQ_NUM_MEMBERS> perf_pixels{};
+    u32 rasterized_pixels = 0;
+    u32 tev_pixels_in = 0;
+    u32 tev_pixels_out = 0;
+    u16 bbox_left = 0xffff;
+    u16 bbox_right = 0;
+    u16 bbox_top = 0xffff;
+    u16 bbox_bottom = 0;
+  };
+  Counters counters;
+
   enum
   {
     ALP_C,
@@ -10,6 +10,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/PipelineStageTimers.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace
@@ -314,6 +315,7 @@ void IndexGenerator::Start(u16* index_ptr)
 
 void IndexGenerator::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices)
 {
+  VideoCommon::ScopedPipelineStage stage(VideoCommon::PipelineStage::IndexGeneration);
   m_index_buffer_current =
       m_primitive_table[primitive](m_index_buffer_current, num_vertices, m_base_index);
   m_base_index += num_vertices;
@@ -321,6 +323,7 @@ void IndexGenerator::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vert
 
 void IndexGenerator::AddExternalIndices(const u16* indices, u32 num_indices, u32 num_vertices)
 {
+  VideoCommon::ScopedPipelineStage stage(VideoCommon::PipelineStage::IndexGeneration);
   std::memcpy(m_index_buffer_current, indices, sizeof(u16) * num_indices);
   m_index_buffer_current += num_indices;
   m_base_index += num_vertices;
@@ -9,6 +9,9 @@
 #include <implot.h>
 
 #include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/State.h"
+#include "Core/StateRewind.h"
 #include "VideoCommon/VideoConfig.h"
 
 PerformanceMetrics g_perf_metrics;
@@ -337,5 +340,30 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     ImGui::End();
   }
 
+  if (g_ActiveConfig.bShowFTimes && Config::Get(Config::MAIN_REWIND_ENABLED))
+  {
+    const State::RewindStats rewind_stats = State::GetRewindStats();
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), set_next_position_condition,
+                            ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (ImGui::Begin("RewindStats", nullptr, imgui_flags))
+    {
+      clamp_window_position();
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Rewind:%4zu", rewind_stats.num_states);
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "key:%4zu dif:%4zu", rewind_stats.num_keyframes,
+                         rewind_stats.num_deltas);
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "dif:%6.1lfKiB",
+                         rewind_stats.last_delta_size / 1024.0);
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "save:%6.2lfms", rewind_stats.last_capture_ms);
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "pack:%6.2lfms", rewind_stats.last_compress_ms);
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "mem:%6.1lfMiB",
+                         rewind_stats.memory_usage / (1024.0 * 1024.0));
+    }
+    ImGui::End();
+  }
+
   ImGui::PopStyleVar(2);
 }
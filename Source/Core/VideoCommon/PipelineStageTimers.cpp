@@ -0,0 +1,104 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/PipelineStageTimers.h"
+
+#include <chrono>
+
+namespace VideoCommon
+{
+std::atomic<bool> PipelineStageTimers::s_enabled = false;
+
+static std::array<std::atomic<u64>, NUM_PIPELINE_STAGES> s_nanoseconds;
+static std::array<std::atomic<u64>, NUM_PIPELINE_STAGES> s_calls;
+
+// The innermost stage that is running on this thread, and when it was last entered or resumed.
+static thread_local PipelineStage t_current_stage = PipelineStage::Count;
+static thread_local u64 t_stage_start_ns = 0;
+
+static u64 NowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static void AddTime(PipelineStage stage, u64 nanoseconds)
+{
+  s_nanoseconds[static_cast<std::size_t>(stage)].fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void PipelineStageTimers::SetEnabled(bool enabled)
+{
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void PipelineStageTimers::Reset()
+{
+  for (std::size_t i = 0; i < NUM_PIPELINE_STAGES; ++i)
+  {
+    s_nanoseconds[i].store(0, std::memory_order_relaxed);
+    s_calls[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+PipelineStageTotals PipelineStageTimers::GetTotals()
+{
+  PipelineStageTotals totals;
+  for (std::size_t i = 0; i < NUM_PIPELINE_STAGES; ++i)
+  {
+    totals.nanoseconds[i] = s_nanoseconds[i].load(std::memory_order_relaxed);
+    totals.calls[i] = s_calls[i].load(std::memory_order_relaxed);
+  }
+  return totals;
+}
+
+std::string_view PipelineStageTimers::GetName(PipelineStage stage)
+{
+  switch (stage)
+  {
+  case PipelineStage::OpcodeDecoding:
+    return "opcode_decoding";
+  case PipelineStage::VertexLoading:
+    return "vertex_loading";
+  case PipelineStage::IndexGeneration:
+    return "index_generation";
+  case PipelineStage::TextureDecoding:
+    return "texture_decoding";
+  case PipelineStage::TextureHashing:
+    return "texture_hashing";
+  case PipelineStage::TextureCacheLookup:
+    return "texture_cache_lookup";
+  case PipelineStage::ShaderUidGeneration:
+    return "shader_uid_generation";
+  case PipelineStage::Drawing:
+    return "drawing";
+  default:
+    return "unknown";
+  }
+}
+
+void PipelineStageTimers::Enter(PipelineStage stage, PipelineStage* parent)
+{
+  const u64 now = NowNs();
+
+  // Pause the stage that this one runs inside of.
+  *parent = t_current_stage;
+  if (t_current_stage != PipelineStage::Count)
+    AddTime(t_current_stage, now - t_stage_start_ns);
+
+  t_current_stage = stage;
+  t_stage_start_ns = now;
+}
+
+void PipelineStageTimers::Leave(PipelineStage stage, PipelineStage parent)
+{
+  const u64 now = NowNs();
+
+  AddTime(stage, now - t_stage_start_ns);
+  s_calls[static_cast<std::size_t>(stage)].fetch_add(1, std::memory_order_relaxed);
+
+  t_current_stage = parent;
+  t_stage_start_ns = now;
+}
+}  // namespace VideoCommon
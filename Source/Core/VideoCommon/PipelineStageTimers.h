@@ -0,0 +1,84 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+enum class PipelineStage : u32
+{
+  OpcodeDecoding,
+  VertexLoading,
+  IndexGeneration,
+  TextureDecoding,
+  TextureHashing,
+  TextureCacheLookup,
+  ShaderUidGeneration,
+  Drawing,
+  Count,
+};
+
+constexpr std::size_t NUM_PIPELINE_STAGES = static_cast<std::size_t>(PipelineStage::Count);
+
+struct PipelineStageTotals
+{
+  std::array<u64, NUM_PIPELINE_STAGES> nanoseconds{};
+  std::array<u64, NUM_PIPELINE_STAGES> calls{};
+};
+
+// Measures how much time the video pipeline spends in each stage, for benchmarking. Stages that
+// run inside another stage, like vertex loading inside opcode decoding, are only counted for the
+// inner stage, so the totals add up to the time spent in all of them. While disabled, a stage only
+// costs a relaxed atomic load.
+class PipelineStageTimers
+{
+public:
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+  static void Reset();
+  static PipelineStageTotals GetTotals();
+
+  // A lowercase identifier, for reports.
+  static std::string_view GetName(PipelineStage stage);
+
+private:
+  friend class ScopedPipelineStage;
+
+  static void Enter(PipelineStage stage, PipelineStage* parent);
+  static void Leave(PipelineStage stage, PipelineStage parent);
+
+  static std::atomic<bool> s_enabled;
+};
+
+class ScopedPipelineStage
+{
+public:
+  explicit ScopedPipelineStage(PipelineStage stage)
+      : m_stage(stage), m_enabled(PipelineStageTimers::IsEnabled())
+  {
+    if (m_enabled)
+      PipelineStageTimers::Enter(m_stage, &m_parent);
+  }
+  ~ScopedPipelineStage()
+  {
+    if (m_enabled)
+      PipelineStageTimers::Leave(m_stage, m_parent);
+  }
+
+  ScopedPipelineStage(const ScopedPipelineStage&) = delete;
+  ScopedPipelineStage& operator=(const ScopedPipelineStage&) = delete;
+
+private:
+  PipelineStage m_stage;
+  PipelineStage m_parent = PipelineStage::Count;
+  bool m_enabled;
+};
+}  // namespace VideoCommon
@@ -10,6 +10,8 @@
 
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/SystemTimers.h"
+#include "Core/IOS/SDIO/SDCardCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/System.h"
 
 #include "VideoCommon/BPFunctions.h"
@@ -90,6 +92,12 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Textures decoded", "%d", this_frame.num_textures_decoded);
+  draw_statistic("Texture decode time", "%.2f ms", this_frame.texture_decode_us / 1000.0);
+  draw_statistic("Texture lookups", "%d", this_frame.num_texture_lookups);
+  draw_statistic("Texture hash probes", "%d", this_frame.num_texture_hash_probes);
+  draw_statistic("Texture overlap scans", "%d (%d candidates)",
+                 this_frame.num_texture_overlap_scans, this_frame.num_texture_overlap_candidates);
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
@@ -115,6 +123,119 @@ void Statistics::Display() const
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
+  const IOS::HLE::SDCardCache::Stats sd_stats = IOS::HLE::GetSDCardCacheStats();
+  if (sd_stats.hits + sd_stats.misses != 0)
+  {
+    draw_statistic("SD cache hits:", "%llu", static_cast<unsigned long long>(sd_stats.hits));
+    draw_statistic("SD cache misses:", "%llu", static_cast<unsigned long long>(sd_stats.misses));
+    draw_statistic("SD read-ahead used:", "%llu/%llu",
+                   static_cast<unsigned long long>(sd_stats.read_ahead_hits),
+                   static_cast<unsigned long long>(sd_stats.read_ahead_blocks));
+  }
+
+  const JitInterface::TieredCompilationCounters& jit_counters =
+      Core::System::GetInstance().GetJitInterface().GetTieredCompilationCounters();
+  const u64 interpreted_blocks = jit_counters.interpreted_blocks;
+  const u64 precompiled_blocks = jit_counters.precompiled_blocks;
+  if (interpreted_blocks != 0 || precompiled_blocks != 0)
+  {
+    const u64 compiled_blocks = jit_counters.compiled_blocks;
+    if (interpreted_blocks != 0)
+    {
+      draw_statistic("JIT interpreted blocks:", "%llu",
+                     static_cast<unsigned long long>(interpreted_blocks));
+    }
+    if (precompiled_blocks != 0)
+    {
+      draw_statistic("JIT precompiled blocks:", "%llu",
+                     static_cast<unsigned long long>(precompiled_blocks));
+    }
+    draw_statistic("JIT tier-ups:", "%llu/%llu (%llu discarded)",
+                   static_cast<unsigned long long>(compiled_blocks),
+                   static_cast<unsigned long long>(jit_counters.queued_blocks.load()),
+                   static_cast<unsigned long long>(jit_counters.discarded_blocks.load()));
+    if (compiled_blocks != 0)
+    {
+      const u64 average_latency_us = jit_counters.total_latency_us / compiled_blocks;
+      draw_statistic("JIT tier-up latency:", "%llu us avg, %llu us max",
+                     static_cast<unsigned long long>(average_latency_us),
+                     static_cast<unsigned long long>(jit_counters.max_latency_us.load()));
+    }
+  }
+
+  const JitInterface::BlockEntryCounters& block_entry_counters =
+      Core::System::GetInstance().GetJitInterface().GetBlockEntryCounters();
+  const u64 block_entries = block_entry_counters.block_entries;
+  const u64 superblock_entries = block_entry_counters.superblock_entries;
+  if (block_entries != 0 || superblock_entries != 0)
+  {
+    const u64 total_entries = block_entries + superblock_entries;
+    draw_statistic("JIT block entries:", "%llu (%.1f%% superblocks)",
+                   static_cast<unsigned long long>(total_entries),
+                   100.0 * superblock_entries / total_entries);
+    draw_statistic("JIT superblocks:", "%llu",
+                   static_cast<unsigned long long>(block_entry_counters.superblocks.load()));
+    const u64 guest_instructions = block_entry_counters.guest_instructions;
+    const u64 register_loads = block_entry_counters.register_loads;
+    const u64 register_stores = block_entry_counters.register_stores;
+    if (guest_instructions != 0)
+    {
+      draw_statistic("JIT guest instructions:", "%llu (%.1f per block entry)",
+                     static_cast<unsigned long long>(guest_instructions),
+                     static_cast<double>(guest_instructions) / total_entries);
+      draw_statistic("JIT register loads:", "%llu (%.2f per instruction)",
+                     static_cast<unsigned long long>(register_loads),
+                     static_cast<double>(register_loads) / guest_instructions);
+      draw_statistic("JIT register stores:", "%llu (%.2f per instruction)",
+                     static_cast<unsigned long long>(register_stores),
+                     static_cast<double>(register_stores) / guest_instructions);
+    }
+    const u64 register_loads_skipped = block_entry_counters.register_loads_skipped;
+    if (register_loads_skipped != 0)
+    {
+      draw_statistic("JIT register loads skipped:", "%llu (%.1f%% of loads, %.2f per block entry)",
+                     static_cast<unsigned long long>(register_loads_skipped),
+                     register_loads != 0 ? 100.0 * register_loads_skipped / register_loads : 0.0,
+                     static_cast<double>(register_loads_skipped) / total_entries);
+    }
+  }
+
+  const JitInterface::CodeSpaceCounters& code_space_counters =
+      Core::System::GetInstance().GetJitInterface().GetCodeSpaceCounters();
+  const u64 code_space_flushes = code_space_counters.flushes;
+  const u64 code_space_evictions = code_space_counters.evictions;
+  if (code_space_flushes != 0 || code_space_evictions != 0)
+  {
+    draw_statistic("JIT cache flushes:", "%llu",
+                   static_cast<unsigned long long>(code_space_flushes));
+    draw_statistic("JIT cold block evictions:", "%llu (%llu blocks, %llu KiB reclaimed)",
+                   static_cast<unsigned long long>(code_space_evictions),
+                   static_cast<unsigned long long>(code_space_counters.evicted_blocks.load()),
+                   static_cast<unsigned long long>(code_space_counters.reclaimed_bytes / 1024));
+  }
+
+  const JitInterface::SoftwareTLBCounters& software_tlb_counters =
+      Core::System::GetInstance().GetJitInterface().GetSoftwareTLBCounters();
+  const u64 software_tlb_reads =
+      software_tlb_counters.read_hits + software_tlb_counters.read_misses;
+  const u64 software_tlb_writes =
+      software_tlb_counters.write_hits + software_tlb_counters.write_misses;
+  if (software_tlb_reads != 0 || software_tlb_writes != 0)
+  {
+    draw_statistic("JIT software TLB reads:", "%llu (%.1f%% hits)",
+                   static_cast<unsigned long long>(software_tlb_reads),
+                   software_tlb_reads != 0 ?
+                       100.0 * software_tlb_counters.read_hits / software_tlb_reads :
+                       0.0);
+    draw_statistic("JIT software TLB writes:", "%llu (%.1f%% hits)",
+                   static_cast<unsigned long long>(software_tlb_writes),
+                   software_tlb_writes != 0 ?
+                       100.0 * software_tlb_counters.write_hits / software_tlb_writes :
+                       0.0);
+    draw_statistic("JIT software TLB fills:", "%llu",
+                   static_cast<unsigned long long>(software_tlb_counters.fills.load()));
+  }
+
   ImGui::Columns(1);
 
   ImGui::End();
@@ -62,6 +62,14 @@ struct Statistics
     int bytes_index_streamed = 0;
     int bytes_uniform_streamed = 0;
 
+    int num_textures_decoded = 0;
+    int texture_decode_us = 0;
+
+    int num_texture_lookups = 0;
+    int num_texture_hash_probes = 0;
+    int num_texture_overlap_scans = 0;
+    int num_texture_overlap_candidates = 0;
+
     int num_triangles_clipped = 0;
     int num_triangles_in = 0;
     int num_triangles_rejected = 0;
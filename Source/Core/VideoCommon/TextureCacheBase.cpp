@@ -4,9 +4,11 @@
 #include "VideoCommon/TextureCacheBase.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -46,6 +48,7 @@
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/PipelineStageTimers.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/ShaderCache.h"
@@ -62,6 +65,10 @@ static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
+// Textures that are hashed completely are split into chunks from this size on. The chunks always
+// have the same size, so the hash doesn't depend on the number of threads.
+static const u32 CHUNKED_HASH_MIN_SIZE = 256 * 1024;
+static const u32 HASH_CHUNK_SIZE = 64 * 1024;
 
 static int xfb_count = 0;
 
@@ -91,6 +98,39 @@ void TextureCacheBase::CheckTempSize(size_t required_size)
   m_temp = static_cast<u8*>(Common::AllocateAlignedMemory(m_temp_size, 16));
 }
 
+u64 TextureCacheBase::HashTextureData(const u8* data, u32 size, u32 samples)
+{
+  if (samples != 0 || size < CHUNKED_HASH_MIN_SIZE)
+    return Common::GetHash64(data, size, samples);
+
+  const u32 num_chunks = (size + HASH_CHUNK_SIZE - 1) / HASH_CHUNK_SIZE;
+  m_chunk_hashes.resize(num_chunks);
+  m_decode_pool.Run(num_chunks, [&](u32 chunk, u32) {
+    const u32 offset = chunk * HASH_CHUNK_SIZE;
+    m_chunk_hashes[chunk] =
+        Common::GetHash64(data + offset, std::min(HASH_CHUNK_SIZE, size - offset), 0);
+  });
+
+  // Multiply by a prime number to mix the hash up a bit, like for EFB copies with a stride.
+  u64 hash = size;
+  for (const u64 chunk_hash : m_chunk_hashes)
+    hash = (hash * 397) ^ chunk_hash;
+  return hash;
+}
+
+void TextureCacheBase::DecodeTextureLevel(u8* dst, const u8* src, u32 width, u32 height,
+                                          TextureFormat format, const u8* tlut,
+                                          TLUTFormat tlut_format)
+{
+  const auto start_time = Clock::now();
+
+  TexDecoder_Decode(dst, src, width, height, format, tlut, tlut_format, &m_decode_pool);
+
+  const auto decode_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      Clock::now() - start_time);
+  ADDSTAT(g_stats.this_frame.texture_decode_us, static_cast<int>(decode_time.count()));
+}
+
 TextureCacheBase::TextureCacheBase()
 {
   SetBackupConfig(g_ActiveConfig);
@@ -113,6 +153,8 @@ void TextureCacheBase::Shutdown()
 
   // For correctness, we need to invalidate textures before the gpu context starts shutting down.
   Invalidate();
+
+  m_decode_pool.Stop();
 }
 
 TextureCacheBase::~TextureCacheBase()
@@ -129,6 +171,8 @@ bool TextureCacheBase::Initialize()
     return false;
   }
 
+  m_decode_pool.Start("Texture Decoder", m_backup_config.texture_decode_threads);
+
   return true;
 }
 
@@ -139,8 +183,9 @@ void TextureCacheBase::Invalidate()
 
   for (auto& bind : m_bound_textures)
     bind.reset();
-  m_textures_by_hash.clear();
+  m_textures_by_hash.Clear();
   m_textures_by_address.clear();
+  m_largest_texture_size = 0;
 
   m_texture_pool.clear();
 }
@@ -171,15 +216,22 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  if (config.GetTextureDecodeThreads() != m_backup_config.texture_decode_threads)
+    m_decode_pool.Start("Texture Decoder", config.GetTextureDecodeThreads());
+
   SetBackupConfig(config);
 }
 
 void TextureCacheBase::Cleanup(int _frameCount)
 {
+  u32 largest_texture_size = 0;
+
   TexAddrCache::iterator iter = m_textures_by_address.begin();
   TexAddrCache::iterator tcend = m_textures_by_address.end();
   while (iter != tcend)
   {
+    largest_texture_size = std::max(largest_texture_size, iter->second->size_in_bytes);
+
     if (iter->second->frameCount == FRAMECOUNT_INVALID)
     {
       iter->second->frameCount = _frameCount;
@@ -213,6 +265,7 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter;
     }
   }
+  m_largest_texture_size = largest_texture_size;
 
   TexPool::iterator iter2 = m_texture_pool.begin();
   TexPool::iterator tcend2 = m_texture_pool.end();
@@ -259,6 +312,7 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   m_backup_config.graphics_mods = config.bGraphicMods;
   m_backup_config.graphics_mod_change_count =
       config.graphics_mod_config ? config.graphics_mod_config->GetChangeCount() : 0;
+  m_backup_config.texture_decode_threads = config.GetTextureDecodeThreads();
 }
 
 bool TextureCacheBase::DidLinkedAssetsChange(const TCacheEntry& entry)
@@ -335,7 +389,7 @@ RcTcacheEntry TextureCacheBase::ApplyPaletteToEntry(RcTcacheEntry& entry, const
     g_gfx->EndUtilityDrawing();
   }
 
-  m_textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  AddTextureByAddress(decoded_entry->addr, decoded_entry);
 
   return decoded_entry;
 }
@@ -381,7 +435,7 @@ RcTcacheEntry TextureCacheBase::ReinterpretEntry(const RcTcacheEntry& existing_e
   g_gfx->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  m_textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  AddTextureByAddress(reinterpreted_entry->addr, reinterpreted_entry);
 
   return reinterpreted_entry;
 }
@@ -605,14 +659,13 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
         textures_by_address_list.emplace_back(it.first, id);
       }
     }
-    for (const auto& it : m_textures_by_hash)
-    {
-      if (ShouldSaveEntry(it.second))
+    m_textures_by_hash.ForEachEntry([&](u64 hash, const RcTcacheEntry& entry) {
+      if (ShouldSaveEntry(entry))
       {
-        const u32 id = AddCacheEntryToMap(it.second);
-        textures_by_hash_list.emplace_back(it.first, id);
+        const u32 id = AddCacheEntryToMap(entry);
+        textures_by_hash_list.emplace_back(hash, id);
       }
-    }
+    });
     for (u32 i = 0; i < m_bound_textures.size(); i++)
     {
       const auto& tentry = m_bound_textures[i];
@@ -704,7 +757,6 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
     auto tex = DeserializeTexture(p);
     auto entry =
         std::make_shared<TCacheEntry>(std::move(tex->texture), std::move(tex->framebuffer));
-    entry->textures_by_hash_iter = m_textures_by_hash.end();
     entry->DoState(p);
     if (entry->texture && commit_state)
       id_map.emplace(i, entry);
@@ -735,7 +787,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     auto& entry = GetEntry(id);
     if (entry)
-      m_textures_by_address.emplace(addr, entry);
+      AddTextureByAddress(addr, entry);
   }
 
   // Fill in hash map.
@@ -749,7 +801,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     auto& entry = GetEntry(id);
     if (entry)
-      entry->textures_by_hash_iter = m_textures_by_hash.emplace(hash, entry);
+      AddTextureByHash(hash, entry);
   }
 
   // Clear bound textures
@@ -839,6 +891,7 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
   auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlap_candidates);
     auto& entry = iter.first->second;
     if (entry != entry_to_update && entry->IsCopy() &&
         !entry->references.contains(entry_to_update.get()) &&
@@ -1337,21 +1390,25 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
                                                             MemoryUpdate::Type::TextureMap);
   }
 
-  // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
-  // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
   u32 palette_size = 0;
-  if (texture_info.GetPaletteSize())
   {
-    palette_size = *texture_info.GetPaletteSize();
-    full_hash =
-        base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
-                                      textureCacheSafetyColorSampleSize);
-  }
-  else
-  {
-    full_hash = base_hash;
+    VideoCommon::ScopedPipelineStage stage(VideoCommon::PipelineStage::TextureHashing);
+
+    // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more
+    // data from the low tmem bank than it should)
+    base_hash = HashTextureData(texture_info.GetData(), texture_info.GetTextureSize(),
+                                textureCacheSafetyColorSampleSize);
+    if (texture_info.GetPaletteSize())
+    {
+      palette_size = *texture_info.GetPaletteSize();
+      full_hash = base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(),
+                                                *texture_info.GetPaletteSize(),
+                                                textureCacheSafetyColorSampleSize);
+    }
+    else
+    {
+      full_hash = base_hash;
+    }
   }
 
   // Search the texture cache for textures by address
@@ -1381,6 +1438,10 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
   //
   // For efb copies, the entry created in CopyRenderTargetToTexture always has to be used, or else
   // it was done in vain.
+  std::optional<VideoCommon::ScopedPipelineStage> lookup_stage;
+  lookup_stage.emplace(VideoCommon::PipelineStage::TextureCacheLookup);
+  INCSTAT(g_stats.this_frame.num_texture_lookups);
+
   auto iter_range = m_textures_by_address.equal_range(texture_info.GetRawAddress());
   TexAddrCache::iterator iter = iter_range.first;
   TexAddrCache::iterator oldest_entry = iter;
@@ -1529,28 +1590,31 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
   {
-    auto hash_range = m_textures_by_hash.equal_range(full_hash);
-    TexHashCache::iterator hash_iter = hash_range.first;
-    while (hash_iter != hash_range.second)
-    {
-      RcTcacheEntry& entry = hash_iter->second;
+    // DoPartialTextureUpdates only removes EFB copies and temporary textures from the cache,
+    // which are never in m_textures_by_hash, so it doesn't modify the index while it's searched.
+    RcTcacheEntry found_entry;
+    const u32 probes = m_textures_by_hash.ForEach(full_hash, [&](RcTcacheEntry entry) {
       // All parameters, except the address, need to match here
       if (entry->format == full_format && entry->native_levels >= texture_info.GetLevelCount() &&
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
-        entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
-                                        texture_info.GetTlutFormat());
-        if (entry)
-        {
-          entry->texture->FinishedRendering();
-          return entry;
-        }
+        found_entry = DoPartialTextureUpdates(entry, texture_info.GetTlutAddress(),
+                                              texture_info.GetTlutFormat());
       }
-      ++hash_iter;
+      return found_entry != nullptr;
+    });
+    ADDSTAT(g_stats.this_frame.num_texture_hash_probes, probes);
+
+    if (found_entry)
+    {
+      found_entry->texture->FinishedRendering();
+      return found_entry;
     }
   }
 
+  lookup_stage.reset();
+
   // If at least one entry was not used for the same frame, overwrite the oldest one
   if (temp_frameCount != 0x7fffffff)
   {
@@ -1700,9 +1764,10 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
       dst_buffer = m_temp;
       if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        DecodeTextureLevel(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
+                           texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
+                           texture_info.GetTlutFormat());
+        INCSTAT(g_stats.this_frame.num_textures_decoded);
       }
       else
       {
@@ -1736,9 +1801,9 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        DecodeTextureLevel(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
+                           mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
+                           texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
         entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
 
@@ -1768,18 +1833,19 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     }
   }
 
-  const auto iter = m_textures_by_address.emplace(texture_info.GetRawAddress(), entry);
+  const TextureAndTLUTFormat full_format(texture_info.GetTextureFormat(),
+                                         texture_info.GetTlutFormat());
+  entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
+                              full_format, false);
+
+  const auto iter = AddTextureByAddress(texture_info.GetRawAddress(), entry);
   if (safety_color_sample_size == 0 ||
       std::max(texture_info.GetTextureSize(), creation_info.palette_size) <=
           (u32)safety_color_sample_size * 8)
   {
-    entry->textures_by_hash_iter = m_textures_by_hash.emplace(creation_info.full_hash, entry);
+    AddTextureByHash(creation_info.full_hash, entry);
   }
 
-  const TextureAndTLUTFormat full_format(texture_info.GetTextureFormat(),
-                                         texture_info.GetTlutFormat());
-  entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
-                              full_format, false);
   entry->SetDimensions(texture_info.GetRawWidth(), texture_info.GetRawHeight(),
                        texture_info.GetLevelCount());
   entry->SetHashes(creation_info.base_hash, creation_info.full_hash);
@@ -1868,7 +1934,7 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  m_textures_by_address.emplace(entry->addr, entry);
+  AddTextureByAddress(entry->addr, entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(m_textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -1940,6 +2006,7 @@ void TextureCacheBase::StitchXFBCopy(RcTcacheEntry& stitched_entry)
   auto iter = FindOverlappingTextures(stitched_entry->addr, stitched_entry->size_in_bytes);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlap_candidates);
     // Currently, this checks the stride of the VRAM copy against the VI request. Therefore, for
     // interlaced modes, VRAM copies won't be considered candidates. This is okay for now, because
     // our force progressive hack means that an XFB copy should always have a matching stride. If
@@ -2408,6 +2475,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   auto iter = FindOverlappingTextures(dstAddr, covered_range);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlap_candidates);
     RcTcacheEntry& overlapping_entry = iter.first->second;
 
     if (overlapping_entry->addr == dstAddr && overlapping_entry->is_xfb_copy)
@@ -2454,11 +2522,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
 
       // Do not load textures by hash, if they were at least partly overwritten by an efb copy.
       // In this case, comparing the hash is not enough to check, if two textures are identical.
-      if (overlapping_entry->textures_by_hash_iter != m_textures_by_hash.end())
-      {
-        m_textures_by_hash.erase(overlapping_entry->textures_by_hash_iter);
-        overlapping_entry->textures_by_hash_iter = m_textures_by_hash.end();
-      }
+      RemoveTextureByHash(overlapping_entry);
     }
     ++iter.first;
   }
@@ -2481,7 +2545,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    m_textures_by_address.emplace(dstAddr, std::move(entry));
+    AddTextureByAddress(dstAddr, std::move(entry));
   }
 }
 
@@ -2540,6 +2604,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
     auto range = FindOverlappingTextures(entry->addr, covered_range);
     for (auto iter = range.first; iter != range.second; ++iter)
     {
+      INCSTAT(g_stats.this_frame.num_texture_overlap_candidates);
       auto& overlapping_entry = iter->second;
       if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy &&
           overlapping_entry->OverlapsMemoryRange(entry->addr, covered_range))
@@ -2638,7 +2703,6 @@ RcTcacheEntry TextureCacheBase::AllocateCacheEntry(const TextureConfig& config)
 
   auto cacheEntry =
       std::make_shared<TCacheEntry>(std::move(alloc->texture), std::move(alloc->framebuffer));
-  cacheEntry->textures_by_hash_iter = m_textures_by_hash.end();
   cacheEntry->id = m_last_entry_id++;
   return cacheEntry;
 }
@@ -2708,20 +2772,41 @@ TextureCacheBase::TexAddrCache::iterator TextureCacheBase::GetTexCacheIter(TCach
   return m_textures_by_address.end();
 }
 
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::AddTextureByAddress(u32 addr,
+                                                                              RcTcacheEntry entry)
+{
+  m_largest_texture_size = std::max(m_largest_texture_size, entry->size_in_bytes);
+  return m_textures_by_address.emplace(addr, std::move(entry));
+}
+
+void TextureCacheBase::AddTextureByHash(u64 hash, const RcTcacheEntry& entry)
+{
+  m_textures_by_hash.Insert(hash, entry);
+  entry->textures_by_hash_key = hash;
+}
+
+void TextureCacheBase::RemoveTextureByHash(const RcTcacheEntry& entry)
+{
+  if (!entry->textures_by_hash_key)
+    return;
+
+  m_textures_by_hash.Erase(*entry->textures_by_hash_key, entry);
+  entry->textures_by_hash_key.reset();
+}
+
 std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
   // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
-  u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
+  // which end after the given addr. But no texture in the cache is larger than the largest one,
+  // so we look for all textures which have a start address bigger than addr minus its size.
+  // But this yields false-positives which must be checked later on.
+  const u32 lower_addr = addr > m_largest_texture_size ? addr - m_largest_texture_size : 0;
   auto begin = m_textures_by_address.lower_bound(lower_addr);
   auto end = m_textures_by_address.upper_bound(addr + size_in_bytes);
 
+  INCSTAT(g_stats.this_frame.num_texture_overlap_scans);
+
   return std::make_pair(begin, end);
 }
 
@@ -2733,11 +2818,7 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
 
   RcTcacheEntry& entry = iter->second;
 
-  if (entry->textures_by_hash_iter != m_textures_by_hash.end())
-  {
-    m_textures_by_hash.erase(entry->textures_by_hash_iter);
-    entry->textures_by_hash_iter = m_textures_by_hash.end();
-  }
+  RemoveTextureByHash(entry);
 
   // If this is a pending EFB copy, we don't want to flush it here.
   // Why? Because let's say a game is rendering a bloom-type effect, using EFB copies to essentially
@@ -3097,6 +3178,8 @@ int TCacheEntry::HashSampleSize() const
 
 u64 TCacheEntry::CalculateHash() const
 {
+  VideoCommon::ScopedPipelineStage stage(VideoCommon::PipelineStage::TextureHashing);
+
   const u32 bytes_per_row = BytesPerRow();
   const u32 hash_sample_size = HashSampleSize();
 
@@ -3106,7 +3189,7 @@ u64 TCacheEntry::CalculateHash() const
   u8* ptr = memory.GetPointerForRange(addr, size_in_bytes);
   if (memory_stride == bytes_per_row)
   {
-    return Common::GetHash64(ptr, size_in_bytes, hash_sample_size);
+    return g_texture_cache->HashTextureData(ptr, size_in_bytes, hash_sample_size);
   }
   else
   {
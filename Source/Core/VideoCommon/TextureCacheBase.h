@@ -20,6 +20,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/Assets/CustomAsset.h"
@@ -27,6 +28,7 @@
 #include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureHashIndex.h"
 #include "VideoCommon/TextureInfo.h"
 #include "VideoCommon/TextureUtils.h"
 #include "VideoCommon/VideoEvents.h"
@@ -152,9 +154,9 @@ struct TCacheEntry
   // used to delete textures which haven't been used for TEXTURE_KILL_THRESHOLD frames
   int frameCount = FRAMECOUNT_INVALID;
 
-  // Keep an iterator to the entry in m_textures_by_hash, so it does not need to be searched when
-  // removing the cache entry
-  std::multimap<u64, std::shared_ptr<TCacheEntry>>::iterator textures_by_hash_iter;
+  // The hash this entry is stored with in m_textures_by_hash, if it is in there. hash can change
+  // while the entry is in the cache, so it can't be used to remove the entry.
+  std::optional<u64> textures_by_hash_key;
 
   // This is used to keep track of both:
   //   * efb copies used by this partially updated texture
@@ -293,6 +295,10 @@ public:
 
   void ScaleTextureCacheEntryTo(RcTcacheEntry& entry, u32 new_width, u32 new_height);
 
+  // Hashes texture data in emulated memory. Large textures that are hashed completely are split
+  // into chunks that are hashed on the decode threads.
+  u64 HashTextureData(const u8* data, u32 size, u32 samples);
+
   // Flushes all pending EFB copies to emulated RAM.
   void FlushEFBCopies();
 
@@ -340,7 +346,7 @@ protected:
 
 private:
   using TexAddrCache = std::multimap<u32, RcTcacheEntry>;
-  using TexHashCache = std::multimap<u64, RcTcacheEntry>;
+  using TexHashCache = VideoCommon::TextureHashIndex<RcTcacheEntry>;
 
   using TexPool = std::unordered_multimap<TextureConfig, TexPoolEntry>;
 
@@ -369,11 +375,20 @@ private:
 
   void CheckTempSize(size_t required_size);
 
+  // Decodes one level of a texture on the CPU, using the decode threads for large levels.
+  void DecodeTextureLevel(u8* dst, const u8* src, u32 width, u32 height, TextureFormat format,
+                          const u8* tlut, TLUTFormat tlut_format);
+
   RcTcacheEntry AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
+  // The address and size of the entry must be set already.
+  TexAddrCache::iterator AddTextureByAddress(u32 addr, RcTcacheEntry entry);
+  void AddTextureByHash(u64 hash, const RcTcacheEntry& entry);
+  void RemoveTextureByHash(const RcTcacheEntry& entry);
+
   // Return all possible overlapping textures. As addr+size of the textures is not
   // indexed, this may return false positives.
   std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
@@ -411,6 +426,10 @@ private:
   // but it's possible for invalidated TCache entries to live on elsewhere
   TexAddrCache m_textures_by_address;
 
+  // No texture in m_textures_by_address is larger than this, which limits how far back
+  // FindOverlappingTextures has to look. It is recalculated in Cleanup().
+  u32 m_largest_texture_size = 0;
+
   // m_textures_by_hash is an alternative view of the texture cache
   // All textures in here will also be in m_textures_by_address
   TexHashCache m_textures_by_hash;
@@ -438,6 +457,7 @@ private:
     bool arbitrary_mipmap_detection;
     bool graphics_mods;
     u32 graphics_mod_change_count;
+    u32 texture_decode_threads;
   };
   BackupConfig m_backup_config = {};
 
@@ -461,6 +481,10 @@ private:
   // readbacks, saving the overhead of allocating a new buffer every time.
   std::unique_ptr<AbstractStagingTexture> m_readback_texture;
 
+  // Threads that decode and hash large textures along with the GPU thread.
+  Common::ThreadPool m_decode_pool;
+  std::vector<u64> m_chunk_hashes;
+
   void OnFrameEnd();
 
   Common::EventHook m_frame_event =
@@ -11,6 +11,11 @@
 #include "Common/EnumFormatter.h"
 #include "Common/SpanUtils.h"
 
+namespace Common
+{
+class ThreadPool;
+}
+
 enum
 {
   TMEM_SIZE = 1024 * 1024,
@@ -189,8 +194,9 @@ int TexDecoder_GetEFBCopyBlockHeightInTexels(EFBCopyFormat format);
 int TexDecoder_GetPaletteSize(TextureFormat fmt);
 TextureFormat TexDecoder_GetEFBCopyBaseFormat(EFBCopyFormat format);
 
+// With a pool, large textures are split into bands of block rows that are decoded in parallel.
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
-                       const u8* tlut, TLUTFormat tlutfmt);
+                       const u8* tlut, TLUTFormat tlutfmt, Common::ThreadPool* pool = nullptr);
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height);
 void TexDecoder_DecodeTexel(u8* dst, std::span<const u8> src, int s, int t, int imageWidth,
@@ -9,10 +9,13 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
+#include "Common/Profiler.h"
 #include "Common/SpanUtils.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoCommon/LookUpTables.h"
+#include "VideoCommon/PipelineStageTimers.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureDecoder_Util.h"
 #include "VideoCommon/sfont.inc"
@@ -298,10 +301,43 @@ static void TexDecoder_DrawOverlay(u8* dst, int width, int height, TextureFormat
   }
 }
 
+// Textures smaller than this are decoded on the calling thread, as waking up the pool would
+// cost more than decoding them.
+constexpr int MIN_PARALLEL_DECODE_TEXELS = 128 * 128;
+// The number of texels that one band of a texture should have at least.
+constexpr int MIN_DECODE_BAND_TEXELS = 64 * 64;
+
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
-                       const u8* tlut, TLUTFormat tlutfmt)
+                       const u8* tlut, TLUTFormat tlutfmt, Common::ThreadPool* pool)
 {
-  _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
+  PROFILE_ZONE("Texture decode");
+  VideoCommon::ScopedPipelineStage stage(VideoCommon::PipelineStage::TextureDecoding);
+
+  if (pool == nullptr || pool->GetThreadCount() == 1 ||
+      width * height < MIN_PARALLEL_DECODE_TEXELS)
+  {
+    _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
+  }
+  else
+  {
+    // The blocks of a texture are stored row by row, so a band of block rows is contiguous in
+    // both the source and the decoded texture. Use a few bands per thread so that threads that
+    // finish early can take over some of the work.
+    const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+    const int block_rows = height / block_height;
+    const int min_band_rows = std::max(MIN_DECODE_BAND_TEXELS / (width * block_height), 1);
+    const int band_rows =
+        std::max(block_rows / static_cast<int>(pool->GetThreadCount() * 4), min_band_rows);
+    const int num_bands = (block_rows + band_rows - 1) / band_rows;
+
+    pool->Run(num_bands, [&](u32 band, u32) {
+      const int first_row = static_cast<int>(band) * band_rows * block_height;
+      const int rows = std::min(band_rows * block_height, height - first_row);
+      _TexDecoder_DecodeImpl(reinterpret_cast<u32*>(dst) + first_row * width,
+                             src + TexDecoder_GetTextureSizeInBytes(width, first_row, texformat),
+                             width, rows, texformat, tlut, tlutfmt);
+    });
+  }
 
   if (TexFmt_Overlay_Enable)
     TexDecoder_DrawOverlay(dst, width, height, texformat);
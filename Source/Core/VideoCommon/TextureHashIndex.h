@@ -0,0 +1,153 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+// A multimap from texture hashes to values, stored in one flat array with linear probing. Values
+// with the same hash follow each other in the order they were inserted. Erasing shifts the
+// following values back instead of leaving tombstones, so lookups only ever probe live values.
+template <typename T>
+class TextureHashIndex
+{
+public:
+  std::size_t Size() const { return m_size; }
+
+  void Clear()
+  {
+    m_slots.clear();
+    m_size = 0;
+  }
+
+  void Insert(u64 hash, T value)
+  {
+    // Keep the load factor at or below 3/4, so that probe sequences stay short.
+    if ((m_size + 1) * 4 > m_slots.size() * 3)
+      Grow();
+
+    std::size_t pos = GetHomeSlot(hash);
+    while (m_slots[pos].used)
+      pos = (pos + 1) & m_mask;
+
+    m_slots[pos] = {hash, std::move(value), true};
+    ++m_size;
+  }
+
+  // Removes one value that was stored with hash and compares equal to value. Returns false if
+  // there is no such value.
+  bool Erase(u64 hash, const T& value)
+  {
+    if (m_slots.empty())
+      return false;
+
+    for (std::size_t pos = GetHomeSlot(hash); m_slots[pos].used; pos = (pos + 1) & m_mask)
+    {
+      if (m_slots[pos].hash == hash && m_slots[pos].value == value)
+      {
+        EraseSlot(pos);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Calls function(value) for each value stored with hash, until it returns true. The index must
+  // not be modified by function. Returns the number of slots that were looked at, for statistics.
+  template <typename Function>
+  u32 ForEach(u64 hash, Function function) const
+  {
+    if (m_slots.empty())
+      return 0;
+
+    u32 probes = 0;
+    for (std::size_t pos = GetHomeSlot(hash); m_slots[pos].used; pos = (pos + 1) & m_mask)
+    {
+      ++probes;
+      if (m_slots[pos].hash == hash && function(m_slots[pos].value))
+        break;
+    }
+    return probes;
+  }
+
+  // Calls function(hash, value) for every value, in no particular order.
+  template <typename Function>
+  void ForEachEntry(Function function) const
+  {
+    for (const Slot& slot : m_slots)
+    {
+      if (slot.used)
+        function(slot.hash, slot.value);
+    }
+  }
+
+private:
+  struct Slot
+  {
+    u64 hash = 0;
+    T value{};
+    bool used = false;
+  };
+
+  std::size_t GetHomeSlot(u64 hash) const
+  {
+    // Texture hashes are usually well distributed, but mix them anyway so that hashes which only
+    // differ in their upper bits don't end up in the same slot.
+    return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ULL) >> m_shift) & m_mask;
+  }
+
+  void Grow()
+  {
+    std::vector<Slot> old_slots = std::move(m_slots);
+
+    const std::size_t new_capacity = old_slots.empty() ? 64 : old_slots.size() * 2;
+    m_slots = std::vector<Slot>(new_capacity);
+    m_mask = new_capacity - 1;
+    m_shift = 64;
+    for (std::size_t capacity = new_capacity; capacity > 1; capacity /= 2)
+      --m_shift;
+
+    // Moving the slots in array order keeps values with the same hash in insertion order, except
+    // for chains that wrapped around the end of the old array.
+    for (Slot& slot : old_slots)
+    {
+      if (!slot.used)
+        continue;
+
+      std::size_t pos = GetHomeSlot(slot.hash);
+      while (m_slots[pos].used)
+        pos = (pos + 1) & m_mask;
+      m_slots[pos] = std::move(slot);
+    }
+  }
+
+  void EraseSlot(std::size_t pos)
+  {
+    // Move back each following value that is allowed to be in the freed slot, which is the case
+    // when its home slot isn't between the freed slot and its current one.
+    for (std::size_t next = (pos + 1) & m_mask; m_slots[next].used; next = (next + 1) & m_mask)
+    {
+      const std::size_t home = GetHomeSlot(m_slots[next].hash);
+      if (((next - home) & m_mask) >= ((next - pos) & m_mask))
+      {
+        m_slots[pos] = std::move(m_slots[next]);
+        pos = next;
+      }
+    }
+
+    m_slots[pos] = {};
+    --m_size;
+  }
+
+  std::vector<Slot> m_slots;
+  std::size_t m_size = 0;
+  std::size_t m_mask = 0;
+  u32 m_shift = 64;
+};
+}  // namespace VideoCommon
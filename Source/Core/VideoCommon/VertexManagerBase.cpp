@@ -32,6 +32,7 @@
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/PerfQueryBase.h"
+#include "VideoCommon/PipelineStageTimers.h"
 #include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Statistics.h"
@@ -806,7 +807,16 @@ void VertexManagerBase::UpdatePipelineConfig()
     m_pipeline_config_changed = true;
   }
 
-  VertexShaderUid vs_uid = GetVertexShaderUid();
+  VertexShaderUid vs_uid;
+  PixelShaderUid ps_uid;
+  GeometryShaderUid gs_uid;
+  {
+    VideoCommon::ScopedPipelineStage stage(VideoCommon::PipelineStage::ShaderUidGeneration);
+    vs_uid = GetVertexShaderUid();
+    ps_uid = GetPixelShaderUid();
+    gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
+  }
+
   if (vs_uid != m_current_pipeline_config.vs_uid)
   {
     m_current_pipeline_config.vs_uid = vs_uid;
@@ -814,7 +824,6 @@ void VertexManagerBase::UpdatePipelineConfig()
     m_pipeline_config_changed = true;
   }
 
-  PixelShaderUid ps_uid = GetPixelShaderUid();
   if (ps_uid != m_current_pipeline_config.ps_uid)
   {
     m_current_pipeline_config.ps_uid = ps_uid;
@@ -822,7 +831,6 @@ void VertexManagerBase::UpdatePipelineConfig()
     m_pipeline_config_changed = true;
   }
 
-  GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
   if (gs_uid != m_current_pipeline_config.gs_uid)
   {
     m_current_pipeline_config.gs_uid = gs_uid;
@@ -1090,7 +1098,10 @@ void VertexManagerBase::RenderDrawCall(
   if (PerfQueryBase::ShouldEmulate())
     g_perf_query->EnableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
 
-  DrawCurrentBatch(base_index, m_index_generator.GetIndexLen(), base_vertex);
+  {
+    VideoCommon::ScopedPipelineStage stage(VideoCommon::PipelineStage::Drawing);
+    DrawCurrentBatch(base_index, m_index_generator.GetIndexLen(), base_vertex);
+  }
 
   // Track the total emulated state draws
   INCSTAT(g_stats.this_frame.num_draw_calls);
@@ -136,6 +136,8 @@ void VideoConfig::Refresh()
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
+  iTextureDecodeThreads = Config::Get(Config::GFX_TEXTURE_DECODE_THREADS);
+  iSWRasterizerThreads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
   bCPUCull = Config::Get(Config::GFX_CPU_CULL);
 
   texture_filtering_mode = Config::Get(Config::GFX_ENHANCE_FORCE_TEXTURE_FILTERING);
@@ -273,6 +275,24 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
     return 1;
 }
 
+u32 VideoConfig::GetTextureDecodeThreads() const
+{
+  if (iTextureDecodeThreads > 0)
+    return static_cast<u32>(iTextureDecodeThreads);
+
+  // Decoding is mostly limited by memory bandwidth, so more than a few threads don't help.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 2, 1, 4));
+}
+
+u32 VideoConfig::GetSWRasterizerThreads() const
+{
+  if (iSWRasterizerThreads > 0)
+    return static_cast<u32>(iSWRasterizerThreads);
+
+  // Leave a thread for the CPU thread and one for the rest of the system.
+  return static_cast<u32>(std::max(cpu_info.num_cores - 2, 1));
+}
+
 void CheckForConfigChanges()
 {
   const ShaderHostConfig old_shader_host_config = ShaderHostConfig::GetCurrent();
@@ -345,6 +345,14 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of threads that large textures are decoded and hashed on, including the GPU thread.
+  // 0 or less uses an automatic number based on the CPU threads.
+  int iTextureDecodeThreads = 0;
+
+  // Number of threads that the software renderer draws pixels on, including the GPU thread.
+  // 0 or less uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads = 0;
+
   // Loading custom drivers on Android
   std::string customDriverLibraryName;
 
@@ -393,6 +401,8 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetTextureDecodeThreads() const;
+  u32 GetSWRasterizerThreads() const;
 
   float GetCustomAspectRatio() const { return (float)custom_aspect_width / custom_aspect_height; }
 };
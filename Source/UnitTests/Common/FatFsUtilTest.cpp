@@ -0,0 +1,123 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+// clang-format off
+#include "ff.h"
+#include "diskio.h"
+// clang-format on
+
+#include "Common/CommonTypes.h"
+#include "Common/FatFsUtil.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+
+namespace
+{
+// Writes to the SD image the way the emulated SD card does.
+class GuestFatFsCallbacks : public Common::FatFsCallbacks
+{
+public:
+  explicit GuestFatFsCallbacks(const std::string& image_path) : m_image(image_path, "r+b") {}
+
+  int DiskRead(u8 pdrv, u8* buff, u32 sector, unsigned int count) override
+  {
+    return m_image.Seek(u64(sector) * 512, File::SeekOrigin::Begin) &&
+                   m_image.ReadBytes(buff, count * 512) ?
+               RES_OK :
+               RES_ERROR;
+  }
+
+  int DiskWrite(u8 pdrv, const u8* buff, u32 sector, unsigned int count) override
+  {
+    Common::MarkSDImageDirty(u64(sector) * 512, count * 512);
+    return m_image.Seek(u64(sector) * 512, File::SeekOrigin::Begin) &&
+                   m_image.WriteBytes(buff, count * 512) ?
+               RES_OK :
+               RES_ERROR;
+  }
+
+  int DiskIOCtl(u8 pdrv, u8 cmd, void* buff) override
+  {
+    if (cmd == GET_SECTOR_COUNT)
+      *static_cast<LBA_t*>(buff) = m_image.GetSize() / 512;
+    return RES_OK;
+  }
+
+private:
+  File::IOFile m_image;
+};
+
+void WriteGuestFile(const char* path, const std::string& contents)
+{
+  GuestFatFsCallbacks callbacks(File::GetUserPath(F_WIISDCARDIMAGE_IDX));
+  Common::RunInFatFsContext(callbacks, [&] {
+    FATFS fs{};
+    ASSERT_EQ(f_mount(&fs, "", 0), FR_OK);
+    FIL file{};
+    ASSERT_EQ(f_open(&file, path, FA_OPEN_ALWAYS | FA_WRITE), FR_OK);
+    UINT written;
+    ASSERT_EQ(f_write(&file, contents.data(), static_cast<UINT>(contents.size()), &written), FR_OK);
+    ASSERT_EQ(f_close(&file), FR_OK);
+    f_unmount("");
+  });
+}
+
+std::string ReadFile(const std::string& path)
+{
+  std::string contents;
+  File::ReadFileToString(path, contents);
+  return contents;
+}
+}  // namespace
+
+TEST(FatFsUtil, IncrementalSync)
+{
+  const std::string user_dir = File::CreateTempDir();
+  File::SetUserPath(D_CACHE_IDX, user_dir + "/Cache");
+  File::SetUserPath(F_WIISDCARDIMAGE_IDX, user_dir + "/sd.raw");
+  File::SetUserPath(D_WIISDCARDSYNCFOLDER_IDX, user_dir + "/SD");
+  const std::string folder = File::GetUserPath(D_WIISDCARDSYNCFOLDER_IDX);
+  ASSERT_TRUE(File::CreateFullPath(folder + "dir/sub/"));
+  File::WriteStringToFile(folder + "a.txt", "hello");
+  File::WriteStringToFile(folder + "dir/b.txt", "bbb");
+  File::WriteStringToFile(folder + "dir/sub/c.txt", "ccc");
+
+  const auto not_cancelled = [] { return false; };
+  ASSERT_TRUE(Common::SyncSDFolderToSDImage(not_cancelled, false));
+
+  // Update the existing image with changes made to the folder.
+  File::WriteStringToFile(folder + "a.txt", "hello world");
+  File::Delete(folder + "dir/b.txt");
+  File::WriteStringToFile(folder + "d.txt", "ddd");
+  ASSERT_TRUE(Common::SyncSDFolderToSDImage(not_cancelled, false));
+
+  // The emulated SD card overwrites one file and creates another.
+  WriteGuestFile("a.txt", "HELLO WORLD");
+  WriteGuestFile("e.txt", "eee");
+
+  // Files the emulated SD card didn't touch are left alone.
+  File::WriteStringToFile(folder + "d.txt", "local");
+
+  ASSERT_TRUE(Common::SyncSDImageToSDFolder(not_cancelled));
+  EXPECT_EQ(ReadFile(folder + "a.txt"), "HELLO WORLD");
+  EXPECT_EQ(ReadFile(folder + "e.txt"), "eee");
+  EXPECT_EQ(ReadFile(folder + "d.txt"), "local");
+  EXPECT_EQ(ReadFile(folder + "dir/sub/c.txt"), "ccc");
+  EXPECT_FALSE(File::Exists(folder + "dir/b.txt"));
+
+  // A full unpack to a different folder shows what the image contains.
+  const std::string other_folder = user_dir + "/Other/";
+  File::SetUserPath(D_WIISDCARDSYNCFOLDER_IDX, other_folder);
+  ASSERT_TRUE(Common::SyncSDImageToSDFolder(not_cancelled));
+  EXPECT_EQ(ReadFile(other_folder + "a.txt"), "HELLO WORLD");
+  EXPECT_EQ(ReadFile(other_folder + "d.txt"), "ddd");
+  EXPECT_EQ(ReadFile(other_folder + "e.txt"), "eee");
+  EXPECT_EQ(ReadFile(other_folder + "dir/sub/c.txt"), "ccc");
+  EXPECT_FALSE(File::Exists(other_folder + "dir/b.txt"));
+
+  File::DeleteDirRecursively(user_dir);
+}
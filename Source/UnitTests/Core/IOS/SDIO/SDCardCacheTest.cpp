@@ -0,0 +1,135 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/IOS/SDIO/SDCardBackend.h"
+#include "Core/IOS/SDIO/SDCardCache.h"
+
+using IOS::HLE::SDCardCache;
+
+namespace
+{
+class MemorySDCard final : public IOS::HLE::SDCardBackend
+{
+public:
+  explicit MemorySDCard(std::vector<u8>* data) : m_data(*data) {}
+
+  u64 GetSize() const override { return m_data.size(); }
+
+  bool Read(u64 offset, u8* buffer, u64 size) override
+  {
+    std::memcpy(buffer, m_data.data() + offset, size);
+    return true;
+  }
+
+  bool Write(u64 offset, const u8* buffer, u64 size) override
+  {
+    std::memcpy(m_data.data() + offset, buffer, size);
+    return true;
+  }
+
+private:
+  std::vector<u8>& m_data;
+};
+
+std::vector<u8> MakeData(size_t size)
+{
+  std::vector<u8> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<u8>(i * 13 + i / 251);
+  return data;
+}
+}  // namespace
+
+TEST(SDCardCache, ReadsAndWritesMatchBackend)
+{
+  // Not a multiple of the block size, so the last block is partial.
+  std::vector<u8> data = MakeData(10 * SDCardCache::BLOCK_SIZE + 1000);
+  std::vector<u8> reference = data;
+  SDCardCache cache(std::make_unique<MemorySDCard>(&data), 4 * SDCardCache::BLOCK_SIZE);
+
+  u32 state = 1;
+  std::vector<u8> buffer;
+  for (int i = 0; i < 2000; ++i)
+  {
+    state = state * 1664525 + 1013904223;
+    const u64 offset = (state >> 8) % reference.size();
+    const u64 size = std::min<u64>((state % 3) * 70000 + 512, reference.size() - offset);
+    buffer.resize(size);
+
+    if (i % 5 == 0)
+    {
+      std::fill(buffer.begin(), buffer.end(), static_cast<u8>(i));
+      ASSERT_TRUE(cache.Write(offset, buffer.data(), size));
+      std::copy(buffer.begin(), buffer.end(), reference.begin() + offset);
+    }
+    else
+    {
+      ASSERT_TRUE(cache.Read(offset, buffer.data(), size));
+      ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), reference.begin() + offset));
+    }
+  }
+
+  cache.WaitForReadAhead();
+  EXPECT_EQ(data, reference);
+  EXPECT_FALSE(cache.Read(reference.size() - 10, buffer.data(), 20));
+}
+
+TEST(SDCardCache, SequentialReadsAreReadAhead)
+{
+  std::vector<u8> data = MakeData(64 * SDCardCache::BLOCK_SIZE);
+  SDCardCache cache(std::make_unique<MemorySDCard>(&data), 16 * SDCardCache::BLOCK_SIZE);
+
+  std::vector<u8> buffer(SDCardCache::BLOCK_SIZE / 2);
+  u64 offset = 0;
+  for (int i = 0; i < 2; ++i)
+  {
+    ASSERT_TRUE(cache.Read(offset, buffer.data(), buffer.size()));
+    offset += buffer.size();
+  }
+  cache.WaitForReadAhead();
+
+  // Every block after the first was loaded before it was needed.
+  const SDCardCache::Stats before = cache.GetStats();
+  EXPECT_EQ(before.misses, 1u);
+  EXPECT_EQ(before.read_ahead_blocks, SDCardCache::READ_AHEAD_BLOCKS);
+  for (int i = 0; i < 2 * SDCardCache::READ_AHEAD_BLOCKS; ++i)
+  {
+    ASSERT_TRUE(cache.Read(offset, buffer.data(), buffer.size()));
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin() + offset));
+    offset += buffer.size();
+    cache.WaitForReadAhead();
+  }
+
+  const SDCardCache::Stats after = cache.GetStats();
+  EXPECT_EQ(after.misses, 1u);
+  EXPECT_EQ(after.read_ahead_hits, SDCardCache::READ_AHEAD_BLOCKS);
+}
+
+TEST(SDCardCache, EvictsLeastRecentlyUsedBlock)
+{
+  std::vector<u8> data = MakeData(16 * SDCardCache::BLOCK_SIZE);
+  SDCardCache cache(std::make_unique<MemorySDCard>(&data), 2 * SDCardCache::BLOCK_SIZE);
+
+  // Reading backwards never triggers read-ahead.
+  u8 byte;
+  const auto read_block = [&](u64 index) {
+    ASSERT_TRUE(cache.Read(index * SDCardCache::BLOCK_SIZE + 1, &byte, 1));
+  };
+  read_block(2);
+  read_block(1);
+  read_block(2);
+  read_block(0);  // evicts block 1
+  read_block(2);
+  EXPECT_EQ(cache.GetStats().misses, 3u);
+  read_block(1);
+  EXPECT_EQ(cache.GetStats().misses, 4u);
+  EXPECT_EQ(cache.GetStats().hits, 2u);
+}
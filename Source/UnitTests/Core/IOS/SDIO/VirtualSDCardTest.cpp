@@ -0,0 +1,144 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+// clang-format off
+#include "ff.h"
+#include "diskio.h"
+// clang-format on
+
+#include "Common/CommonTypes.h"
+#include "Common/FatFsUtil.h"
+#include "Common/FileUtil.h"
+#include "Core/IOS/SDIO/VirtualSDCard.h"
+
+using IOS::HLE::VirtualSDCard;
+
+namespace
+{
+// Accesses the card the way the emulated software does.
+class GuestFatFsCallbacks : public Common::FatFsCallbacks
+{
+public:
+  explicit GuestFatFsCallbacks(VirtualSDCard& card) : m_card(card) {}
+
+  int DiskRead(u8 pdrv, u8* buff, u32 sector, unsigned int count) override
+  {
+    return m_card.Read(u64(sector) * 512, buff, count * 512) ? RES_OK : RES_ERROR;
+  }
+
+  int DiskWrite(u8 pdrv, const u8* buff, u32 sector, unsigned int count) override
+  {
+    return m_card.Write(u64(sector) * 512, buff, count * 512) ? RES_OK : RES_ERROR;
+  }
+
+  int DiskIOCtl(u8 pdrv, u8 cmd, void* buff) override
+  {
+    if (cmd == GET_SECTOR_COUNT)
+      *static_cast<LBA_t*>(buff) = m_card.GetSize() / 512;
+    return RES_OK;
+  }
+
+private:
+  VirtualSDCard& m_card;
+};
+
+void RunOnCard(VirtualSDCard& card, const std::function<void()>& function)
+{
+  GuestFatFsCallbacks callbacks(card);
+  Common::RunInFatFsContext(callbacks, [&] {
+    FATFS fs{};
+    ASSERT_EQ(f_mount(&fs, "", 1), FR_OK);
+    function();
+    f_unmount("");
+  });
+}
+
+std::string ReadGuestFile(const char* path)
+{
+  FIL file{};
+  if (f_open(&file, path, FA_READ) != FR_OK)
+    return "<missing>";
+  std::string contents(f_size(&file), '\0');
+  UINT read;
+  f_read(&file, contents.data(), static_cast<UINT>(contents.size()), &read);
+  f_close(&file);
+  return contents;
+}
+
+void WriteGuestFile(const char* path, const std::string& contents)
+{
+  FIL file{};
+  ASSERT_EQ(f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE), FR_OK);
+  UINT written;
+  ASSERT_EQ(f_write(&file, contents.data(), static_cast<UINT>(contents.size()), &written), FR_OK);
+  ASSERT_EQ(f_close(&file), FR_OK);
+}
+
+std::string ReadFile(const std::string& path)
+{
+  std::string contents;
+  if (!File::ReadFileToString(path, contents))
+    return "<missing>";
+  return contents;
+}
+}  // namespace
+
+TEST(VirtualSDCard, ServesAndUpdatesFolder)
+{
+  const std::string folder = File::CreateTempDir() + "/";
+  ASSERT_TRUE(File::CreateFullPath(folder + "dir/sub/"));
+  std::string large(300000, '\0');
+  for (size_t i = 0; i < large.size(); ++i)
+    large[i] = static_cast<char>(i * 7);
+  File::WriteStringToFile(folder + "A Long File Name.txt", "hello");
+  File::WriteStringToFile(folder + "dir/large.bin", large);
+  File::WriteStringToFile(folder + "dir/sub/b.txt", "bbb");
+  File::WriteStringToFile(folder + "dir/sub/c.txt", "ccc");
+  File::WriteStringToFile(folder + "empty.txt", "");
+
+  std::unique_ptr<VirtualSDCard> card = VirtualSDCard::Create(folder, 0);
+  ASSERT_TRUE(card);
+
+  RunOnCard(*card, [&] {
+    EXPECT_EQ(ReadGuestFile("A Long File Name.txt"), "hello");
+    EXPECT_EQ(ReadGuestFile("dir/large.bin"), large);
+    EXPECT_EQ(ReadGuestFile("dir/sub/b.txt"), "bbb");
+    EXPECT_EQ(ReadGuestFile("empty.txt"), "");
+
+    FILINFO info{};
+    ASSERT_EQ(f_stat("dir/sub", &info), FR_OK);
+    EXPECT_TRUE(info.fattrib & AM_DIR);
+
+    // Overwrite, create, delete, and swap two files whose data stays on the host until flushed.
+    WriteGuestFile("A Long File Name.txt", "HELLO WORLD");
+    WriteGuestFile("dir/new.txt", "new");
+    EXPECT_EQ(f_unlink("empty.txt"), FR_OK);
+    EXPECT_EQ(f_rename("dir/sub/b.txt", "dir/sub/tmp.txt"), FR_OK);
+    EXPECT_EQ(f_rename("dir/sub/c.txt", "dir/sub/b.txt"), FR_OK);
+    EXPECT_EQ(f_rename("dir/sub/tmp.txt", "dir/sub/c.txt"), FR_OK);
+  });
+
+  ASSERT_TRUE(card->Flush());
+  EXPECT_EQ(ReadFile(folder + "A Long File Name.txt"), "HELLO WORLD");
+  EXPECT_EQ(ReadFile(folder + "dir/new.txt"), "new");
+  EXPECT_EQ(ReadFile(folder + "dir/large.bin"), large);
+  EXPECT_EQ(ReadFile(folder + "dir/sub/b.txt"), "ccc");
+  EXPECT_EQ(ReadFile(folder + "dir/sub/c.txt"), "bbb");
+  EXPECT_FALSE(File::Exists(folder + "empty.txt"));
+
+  // The card still works after flushing, and later changes are flushed when it is destroyed.
+  RunOnCard(*card, [&] {
+    EXPECT_EQ(ReadGuestFile("dir/sub/b.txt"), "ccc");
+    EXPECT_EQ(f_unlink("dir/large.bin"), FR_OK);
+  });
+  card.reset();
+  EXPECT_FALSE(File::Exists(folder + "dir/large.bin"));
+  EXPECT_EQ(ReadFile(folder + "dir/sub/c.txt"), "bbb");
+
+  File::DeleteDirRecursively(folder);
+}
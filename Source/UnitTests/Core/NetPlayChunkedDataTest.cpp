@@ -0,0 +1,100 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/NetPlayChunkedData.h"
+
+static std::vector<u8> MakeData(size_t size, u32 seed)
+{
+  std::vector<u8> data(size);
+  u32 state = seed;
+  for (u8& byte : data)
+  {
+    state = state * 1664525 + 1013904223;
+    byte = static_cast<u8>(state >> 24);
+  }
+  return data;
+}
+
+TEST(NetPlayChunkedData, ChunksCoverDataWithinSizeLimits)
+{
+  const std::vector<u8> data = MakeData(4 * 1024 * 1024 + 123, 1);
+  const std::vector<NetPlay::ChunkInfo> chunks = NetPlay::SplitIntoChunks(data);
+
+  ASSERT_FALSE(chunks.empty());
+  u64 offset = 0;
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    EXPECT_EQ(chunks[i].offset, offset);
+    EXPECT_LE(chunks[i].size, NetPlay::CHUNK_MAX_SIZE);
+    if (i + 1 != chunks.size())
+      EXPECT_GE(chunks[i].size, NetPlay::CHUNK_MIN_SIZE);
+    EXPECT_EQ(chunks[i].hash,
+              NetPlay::HashChunk({data.data() + chunks[i].offset, chunks[i].size}));
+    offset += chunks[i].size;
+  }
+  EXPECT_EQ(offset, data.size());
+}
+
+TEST(NetPlayChunkedData, InsertionOnlyChangesNearbyChunks)
+{
+  const std::vector<u8> original = MakeData(4 * 1024 * 1024, 2);
+  std::vector<u8> modified = original;
+  modified.insert(modified.begin() + 1024 * 1024, {1, 2, 3, 4, 5});
+
+  std::set<NetPlay::ChunkHash> original_hashes;
+  for (const NetPlay::ChunkInfo& chunk : NetPlay::SplitIntoChunks(original))
+    original_hashes.insert(chunk.hash);
+
+  const std::vector<NetPlay::ChunkInfo> modified_chunks = NetPlay::SplitIntoChunks(modified);
+  const size_t new_chunks = std::ranges::count_if(modified_chunks, [&](const auto& chunk) {
+    return !original_hashes.contains(chunk.hash);
+  });
+
+  // With fixed-size blocks, every block after the insertion would change.
+  EXPECT_GE(new_chunks, 1u);
+  EXPECT_LE(new_chunks, 3u);
+}
+
+TEST(NetPlayChunkedData, CacheStoresLoadsAndPrunes)
+{
+  const std::string directory = File::CreateTempDir() + DIR_SEP;
+  const std::vector<u8> first = MakeData(100 * 1024, 3);
+  const std::vector<u8> second = MakeData(100 * 1024, 4);
+  const NetPlay::ChunkHash first_hash = NetPlay::HashChunk(first);
+  const NetPlay::ChunkHash second_hash = NetPlay::HashChunk(second);
+
+  {
+    NetPlay::ChunkCache cache(directory, 150 * 1024);
+    EXPECT_FALSE(cache.Load(first_hash, static_cast<u32>(first.size())));
+    cache.Store(first_hash, first);
+    cache.Store(second_hash, second);
+    EXPECT_EQ(cache.Load(second_hash, static_cast<u32>(second.size())), second);
+  }
+
+  {
+    // A new session finds the chunks from the previous one.
+    NetPlay::ChunkCache cache(directory, 150 * 1024);
+    EXPECT_EQ(cache.Load(first_hash, static_cast<u32>(first.size())), first);
+
+    // Data that was just received is kept even if it doesn't fit.
+    cache.Prune(first.size() + second.size());
+    EXPECT_TRUE(cache.Load(second_hash, static_cast<u32>(second.size())));
+    EXPECT_TRUE(cache.Load(first_hash, static_cast<u32>(first.size())));
+
+    // Only one chunk fits, and the one that was just used is kept.
+    cache.Prune();
+    EXPECT_TRUE(cache.Load(first_hash, static_cast<u32>(first.size())));
+    EXPECT_FALSE(cache.Load(second_hash, static_cast<u32>(second.size())));
+  }
+
+  File::DeleteDirRecursively(directory);
+}
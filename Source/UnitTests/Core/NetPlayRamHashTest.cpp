@@ -0,0 +1,95 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayRamHash.h"
+
+static std::vector<u8> MakeRam()
+{
+  std::vector<u8> ram(24 * 1024 * 1024);
+  for (size_t i = 0; i < ram.size(); ++i)
+    ram[i] = static_cast<u8>(i * 13 + (i >> 12));
+  return ram;
+}
+
+TEST(NetPlayRamHash, IdenticalRamMatches)
+{
+  const std::vector<u8> ram = MakeRam();
+  const NetPlay::RamHashes a = NetPlay::HashRam(60, ram);
+  const NetPlay::RamHashes b = NetPlay::HashRam(60, ram);
+
+  EXPECT_EQ(a.regions.size(), ram.size() / NetPlay::RAM_HASH_REGION_SIZE);
+  EXPECT_EQ(a.combined, b.combined);
+  EXPECT_FALSE(NetPlay::FindRamDivergence(a, b));
+}
+
+TEST(NetPlayRamHash, ReportsDifferingRange)
+{
+  std::vector<u8> ram = MakeRam();
+  const NetPlay::RamHashes before = NetPlay::HashRam(120, ram);
+
+  ram[0x00345678] ^= 1;
+  ram[0x01234567] ^= 1;
+  const NetPlay::RamHashes after = NetPlay::HashRam(120, ram);
+
+  const auto divergence = NetPlay::FindRamDivergence(before, after);
+  ASSERT_TRUE(divergence);
+  EXPECT_EQ(divergence->begin_address, 0x80340000u);
+  EXPECT_EQ(divergence->end_address, 0x81240000u);
+  EXPECT_EQ(divergence->num_regions, 2u);
+}
+
+TEST(NetPlayRamHash, ReportsDifferentRamSizes)
+{
+  const std::vector<u8> ram = MakeRam();
+  const std::vector<u8> larger_ram(ram.size() + NetPlay::RAM_HASH_REGION_SIZE);
+  std::vector<u8> copy = ram;
+  copy.resize(larger_ram.size());
+
+  const auto divergence =
+      NetPlay::FindRamDivergence(NetPlay::HashRam(0, ram), NetPlay::HashRam(0, copy));
+  ASSERT_TRUE(divergence);
+  EXPECT_EQ(divergence->begin_address, 0x80000000u + static_cast<u32>(ram.size()));
+  EXPECT_EQ(divergence->num_regions, 1u);
+}
+
+TEST(NetPlayRamHash, HasherSamplesOnWorkerThread)
+{
+  std::vector<u8> ram = MakeRam();
+  std::vector<NetPlay::RamHashes> results;
+
+  NetPlay::RamHasher hasher;
+  std::mutex mutex;
+  hasher.Start([&](NetPlay::RamHashes hashes) {
+    std::lock_guard lk(mutex);
+    results.push_back(std::move(hashes));
+  });
+  hasher.Sample(0, ram);
+  // The sample is a copy, so changing RAM afterwards must not affect it.
+  ram[100] ^= 0xff;
+  hasher.Sample(60, ram);
+
+  // Stopping drops pending samples, so wait for both to be hashed first.
+  for (int i = 0; i < 500; ++i)
+  {
+    {
+      std::lock_guard lk(mutex);
+      if (results.size() == 2)
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  hasher.Stop();
+
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0].frame, 0u);
+  EXPECT_EQ(results[1].frame, 60u);
+  EXPECT_NE(results[0].combined, results[1].combined);
+}
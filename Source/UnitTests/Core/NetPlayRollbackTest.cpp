@@ -0,0 +1,245 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayRollback.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace
+{
+// A tiny deterministic "emulator" whose state depends on every input it was given.
+struct ToyState
+{
+  u64 frame_count = 0;
+  u64 accumulator = 0;
+  u32 pad_sums[2] = {};
+};
+
+constexpr int NUM_PEER_PADS = 2;
+
+// Changes every few polls, so that repeating the last input is sometimes a wrong prediction.
+GCPadStatus MakeInput(int pad, u64 poll)
+{
+  GCPadStatus status;
+  status.button = static_cast<u16>(((poll / 5) * 7 + pad * 3) & 0xfff);
+  status.stickX = static_cast<u8>(poll / 3 + pad);
+  return status;
+}
+
+void ApplyInput(ToyState& state, int pad, const GCPadStatus& status)
+{
+  state.accumulator = state.accumulator * 31 + status.button + status.stickX * 7 + pad;
+  state.pad_sums[pad] += status.button;
+}
+
+struct Message
+{
+  u64 deliver_tick;
+  int pad;
+  GCPadStatus status;
+};
+
+class Peer
+{
+public:
+  Peer(int local_pad, u32 max_rollback_frames, u32 sync_test_frames = 0) : m_local_pad(local_pad)
+  {
+    NetPlay::RollbackSession::Callbacks callbacks;
+    callbacks.save_state = [this](Common::UniqueBuffer<u8>& buffer) {
+      if (buffer.size() < sizeof(ToyState))
+        buffer.reset(sizeof(ToyState));
+      std::memcpy(buffer.data(), &m_state, sizeof(ToyState));
+      return sizeof(ToyState);
+    };
+    callbacks.load_state = [this](std::span<const u8> state) {
+      if (state.size() != sizeof(ToyState))
+        return false;
+      std::memcpy(&m_state, state.data(), sizeof(ToyState));
+      return true;
+    };
+    callbacks.on_desync = [this](u64, u64, u64) { ++m_desync_callbacks; };
+    m_session = std::make_unique<NetPlay::RollbackSession>(max_rollback_frames, sync_test_frames,
+                                                           std::move(callbacks));
+  }
+
+  // Runs one new frame, plus any frames that have to be run again first.
+  void Step(u64 tick, u32 delay, Peer* remote)
+  {
+    Deliver(tick);
+    do
+    {
+      RunFrame(tick, delay, remote);
+    } while (m_session->IsResimulating());
+  }
+
+  void Deliver(u64 tick)
+  {
+    while (!m_inbox.empty() && m_inbox.front().deliver_tick <= tick)
+    {
+      m_session->AddRemoteInput(m_inbox.front().pad, m_inbox.front().status);
+      m_inbox.pop_front();
+    }
+  }
+
+  void DeliverAll() { Deliver(~u64(0)); }
+
+  NetPlay::RollbackSession& GetSession() { return *m_session; }
+  const std::map<u64, ToyState>& GetStates() const { return m_states; }
+  int GetDesyncCallbacks() const { return m_desync_callbacks; }
+
+  // When set, every frame also changes the state based on something outside of it.
+  bool m_nondeterministic = false;
+
+private:
+  void RunFrame(u64 tick, u32 delay, Peer* remote)
+  {
+    m_session->OnFrameBoundary();
+    m_states[m_session->GetFrame()] = m_state;
+
+    for (int pad = 0; pad < NUM_PEER_PADS; ++pad)
+    {
+      if (!remote && pad != m_local_pad)
+        continue;
+
+      if (pad == m_local_pad && m_session->NeedsLocalInput(pad))
+      {
+        const GCPadStatus status = MakeInput(pad, m_local_polls++);
+        m_session->AddLocalInput(pad, status);
+        if (remote)
+          remote->m_inbox.push_back({tick + delay, pad, status});
+      }
+
+      // Stands in for waiting on the network.
+      if (!m_session->CanPoll(pad))
+        DeliverAll();
+      ASSERT_TRUE(m_session->CanPoll(pad));
+
+      ApplyInput(m_state, pad, m_session->Poll(pad));
+    }
+
+    ++m_state.frame_count;
+    if (m_nondeterministic)
+      m_state.accumulator += ++m_outside_counter;
+  }
+
+  const int m_local_pad;
+  std::unique_ptr<NetPlay::RollbackSession> m_session;
+  ToyState m_state;
+  std::deque<Message> m_inbox;
+  u64 m_local_polls = 0;
+  u64 m_outside_counter = 0;
+  int m_desync_callbacks = 0;
+  // State at the start of each frame, as of the last time that frame was run.
+  std::map<u64, ToyState> m_states;
+};
+
+// The state at the start of frame, if every input had been known in advance.
+ToyState ReferenceState(u64 frame)
+{
+  ToyState state;
+  for (u64 poll = 0; poll + 1 < frame; ++poll)
+  {
+    for (int pad = 0; pad < NUM_PEER_PADS; ++pad)
+      ApplyInput(state, pad, MakeInput(pad, poll));
+    ++state.frame_count;
+  }
+  return state;
+}
+
+bool operator==(const ToyState& a, const ToyState& b)
+{
+  return std::memcmp(&a, &b, sizeof(ToyState)) == 0;
+}
+
+void RunLoopback(Peer& a, Peer& b, u64 ticks, u32 delay)
+{
+  for (u64 tick = 0; tick < ticks; ++tick)
+  {
+    a.Step(tick, delay, &b);
+    b.Step(tick, delay, &a);
+  }
+
+  // Let all inputs arrive, then run a few more frames so that the last mispredictions are fixed.
+  a.DeliverAll();
+  b.DeliverAll();
+  for (u64 tick = ticks; tick < ticks + 10; ++tick)
+  {
+    a.Step(tick, 0, &b);
+    b.Step(tick, 0, &a);
+  }
+}
+}  // namespace
+
+TEST(NetPlayRollback, PeersConvergeAfterMispredictions)
+{
+  Peer a(0, 8);
+  Peer b(1, 8);
+  RunLoopback(a, b, 300, 3);
+
+  const NetPlay::RollbackSession::Stats stats_a = a.GetSession().GetStats();
+  const NetPlay::RollbackSession::Stats stats_b = b.GetSession().GetStats();
+  EXPECT_GT(stats_a.predicted_inputs, 0u);
+  EXPECT_GT(stats_a.mispredicted_inputs, 0u);
+  EXPECT_GT(stats_a.rollbacks, 0u);
+  EXPECT_GT(stats_b.rollbacks, 0u);
+  EXPECT_LE(stats_a.max_rollback_depth, 8u);
+
+  // Frames that all inputs were known for must match the reference on both sides.
+  for (u64 frame = 1; frame <= 290; ++frame)
+  {
+    const ToyState expected = ReferenceState(frame);
+    ASSERT_TRUE(a.GetStates().at(frame) == expected) << "frame " << frame;
+    ASSERT_TRUE(b.GetStates().at(frame) == expected) << "frame " << frame;
+  }
+}
+
+TEST(NetPlayRollback, NoRollbackWithoutLatency)
+{
+  Peer a(0, 8);
+  Peer b(1, 8);
+
+  // Both inputs of a frame are available before either peer polls them.
+  for (u64 tick = 0; tick < 100; ++tick)
+  {
+    a.Step(tick, 0, &b);
+    b.DeliverAll();
+    b.Step(tick, 0, &a);
+    a.DeliverAll();
+  }
+
+  EXPECT_EQ(b.GetSession().GetStats().rollbacks, 0u);
+  EXPECT_TRUE(b.GetStates().at(100) == ReferenceState(100));
+}
+
+TEST(NetPlayRollback, SyncTestPassesForDeterministicState)
+{
+  Peer peer(0, 8, 4);
+  for (u64 tick = 0; tick < 100; ++tick)
+    peer.Step(tick, 0, nullptr);
+
+  const NetPlay::RollbackSession::Stats stats = peer.GetSession().GetStats();
+  EXPECT_GT(stats.checked_frames, 0u);
+  EXPECT_EQ(stats.desyncs, 0u);
+  EXPECT_EQ(stats.predicted_inputs, 0u);
+  EXPECT_EQ(peer.GetDesyncCallbacks(), 0);
+}
+
+TEST(NetPlayRollback, SyncTestDetectsNondeterminism)
+{
+  Peer peer(0, 8, 4);
+  peer.m_nondeterministic = true;
+  for (u64 tick = 0; tick < 20; ++tick)
+    peer.Step(tick, 0, nullptr);
+
+  const NetPlay::RollbackSession::Stats stats = peer.GetSession().GetStats();
+  EXPECT_GT(stats.desyncs, 0u);
+  EXPECT_EQ(peer.GetDesyncCallbacks(), static_cast<int>(stats.desyncs));
+}
@@ -0,0 +1,222 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/ScopeGuard.h"
+#include "Common/Swap.h"
+#include "Common/x64ABI.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Jit64/Jit.h"
+#include "Core/PowerPC/Jit64Common/Jit64AsmCommon.h"
+#include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
+#include "Core/System.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr std::array<EQuantizeType, 4> INTEGER_TYPES{QUANTIZE_U8, QUANTIZE_U16, QUANTIZE_S8,
+                                                     QUANTIZE_S16};
+
+class TestQuantizedMemoryRoutines : public QuantizedMemoryRoutines
+{
+public:
+  explicit TestQuantizedMemoryRoutines(Core::System& system)
+      : QuantizedMemoryRoutines(jit), jit(system)
+  {
+    using namespace Gen;
+
+    AllocCodeSpace(65536);
+    m_const_pool.Init(AllocChildCodeSpace(4096), 4096);
+
+    for (const EQuantizeType type : INTEGER_TYPES)
+    {
+      for (const bool single : {false, true})
+      {
+        // u32 (*)(u64 floats, u32 gqr)
+        quantize[single][type] = reinterpret_cast<Quantize>(AlignCode4());
+        ABI_PushRegistersAndAdjustStack(ABI_ALL_CALLEE_SAVED, 8, 16);
+        MOVQ_xmm(XMM0, R(ABI_PARAM1));
+        MOV(32, R(RSCRATCH2), R(ABI_PARAM2));
+        GenQuantize(single, type, -1);
+        MOV(32, R(ABI_RETURN), R(RSCRATCH));
+        ABI_PopRegistersAndAdjustStack(ABI_ALL_CALLEE_SAVED, 8, 16);
+        RET();
+
+        // u64 (*)(u32 value, u32 gqr)
+        dequantize[single][type] = reinterpret_cast<Dequantize>(AlignCode4());
+        ABI_PushRegistersAndAdjustStack(ABI_ALL_CALLEE_SAVED, 8, 16);
+        MOV(32, R(RSCRATCH2), R(ABI_PARAM2));
+        MOV(32, R(RSCRATCH_EXTRA), R(ABI_PARAM1));
+        GenDequantize(single, type, -1);
+        MOVQ_xmm(R(ABI_RETURN), XMM0);
+        ABI_PopRegistersAndAdjustStack(ABI_ALL_CALLEE_SAVED, 8, 16);
+        RET();
+      }
+    }
+  }
+
+  using Quantize = u32 (*)(u64, u32);
+  using Dequantize = u64 (*)(u32, u32);
+
+  Quantize quantize[2][8]{};
+  Dequantize dequantize[2][8]{};
+  Jit64 jit;
+};
+
+// The interpreter's psq_st conversion, as it ends up in memory.
+template <typename T>
+u32 InterpreterQuantize(float value, u32 scale)
+{
+  return static_cast<std::make_unsigned_t<T>>(ScaleAndClamp<T>(value, scale));
+}
+
+u32 QuantizeExpected(EQuantizeType type, float value, u32 scale)
+{
+  switch (type)
+  {
+  case QUANTIZE_U8:
+    return InterpreterQuantize<u8>(value, scale);
+  case QUANTIZE_U16:
+    return InterpreterQuantize<u16>(value, scale);
+  case QUANTIZE_S8:
+    return InterpreterQuantize<s8>(value, scale);
+  default:
+    return InterpreterQuantize<s16>(value, scale);
+  }
+}
+
+float DequantizeExpected(EQuantizeType type, u32 value, u32 scale)
+{
+  switch (type)
+  {
+  case QUANTIZE_U8:
+    return Dequantize<u8>(value, scale);
+  case QUANTIZE_U16:
+    return Dequantize<u16>(value, scale);
+  case QUANTIZE_S8:
+    return Dequantize<s8>(value, scale);
+  default:
+    return Dequantize<s16>(value, scale);
+  }
+}
+
+u32 TypeBits(EQuantizeType type)
+{
+  return type == QUANTIZE_U8 || type == QUANTIZE_S8 ? 8 : 16;
+}
+
+// Converts the value that the JIT passes to the store code to the value that ends up in memory,
+// read as a big endian integer. Paired values are stored without swapping.
+u32 StoredValue(EQuantizeType type, bool single, u32 value)
+{
+  if (single)
+    return value & ((1u << TypeBits(type)) - 1);
+  if (TypeBits(type) == 8)
+    return Common::swap16(static_cast<u16>(value));
+  return Common::swap32(value);
+}
+
+void CheckRoutines(const TestQuantizedMemoryRoutines& routines)
+{
+  // NaNs aren't included because the interpreter's behavior for them is undefined.
+  const std::vector<float> float_values{
+      0.0f,      -0.0f,     0.25f,     -0.25f,    0.5f,      -0.5f,      0.75f,      1.0f,
+      -1.0f,     1.5f,      -1.5f,     2.5f,      100.25f,   -100.75f,   126.5f,     127.0f,
+      127.9f,    128.0f,    -127.5f,   -128.0f,   -128.5f,   -129.0f,    254.5f,     255.0f,
+      255.5f,    256.0f,    1000.0f,   -1000.0f,  32766.5f,  32767.0f,   32767.5f,   32768.0f,
+      -32768.0f, -32768.5f, -32769.0f, 65534.5f,  65535.0f,  65535.5f,   65536.0f,   70000.0f,
+      1.0e10f,   -1.0e10f,  1.0e-30f,  -1.0e-30f, 1.0e-40f,  -1.0e-40f,  3.0e38f,    -3.0e38f,
+      std::numeric_limits<float>::infinity(),     -std::numeric_limits<float>::infinity()};
+
+  for (const EQuantizeType type : INTEGER_TYPES)
+  {
+    const u32 bits = TypeBits(type);
+    const bool is_signed = type == QUANTIZE_S8 || type == QUANTIZE_S16;
+
+    for (u32 scale = 0; scale < 64; ++scale)
+    {
+      const u32 gqr = scale << 8;
+
+      for (std::size_t i = 0; i < float_values.size(); ++i)
+      {
+        const float ps0 = float_values[i];
+        const float ps1 = float_values[float_values.size() - 1 - i];
+        const u64 pair = std::bit_cast<u32>(ps0) | u64(std::bit_cast<u32>(ps1)) << 32;
+
+        const u32 single = routines.quantize[true][type](pair, gqr);
+        EXPECT_EQ(StoredValue(type, true, single), QuantizeExpected(type, ps0, scale))
+            << "type " << type << " scale " << scale << " value " << ps0;
+
+        const u32 paired = routines.quantize[false][type](pair, gqr);
+        const u32 expected = QuantizeExpected(type, ps0, scale) << bits |
+                             QuantizeExpected(type, ps1, scale);
+        EXPECT_EQ(StoredValue(type, false, paired), expected)
+            << "type " << type << " scale " << scale << " values " << ps0 << " " << ps1;
+      }
+
+      const u32 step = bits == 8 ? 1 : 97;
+      for (u32 value = 0; value < (1u << bits); value += step)
+      {
+        const u32 other = (1u << bits) - 1 - value;
+
+        // Single loads of signed types are sign extended by the load.
+        const u32 single_input =
+            is_signed ? static_cast<u32>(bits == 8 ? s32(s8(value)) : s32(s16(value))) : value;
+        const u64 single = routines.dequantize[true][type](single_input, gqr);
+        EXPECT_EQ(static_cast<u32>(single),
+                  std::bit_cast<u32>(DequantizeExpected(type, value, scale)))
+            << "type " << type << " scale " << scale << " value " << value;
+        EXPECT_EQ(static_cast<u32>(single >> 32), std::bit_cast<u32>(1.0f));
+
+        const u64 paired = routines.dequantize[false][type](value << bits | other, gqr);
+        EXPECT_EQ(static_cast<u32>(paired),
+                  std::bit_cast<u32>(DequantizeExpected(type, value, scale)))
+            << "type " << type << " scale " << scale << " value " << value;
+        EXPECT_EQ(static_cast<u32>(paired >> 32),
+                  std::bit_cast<u32>(DequantizeExpected(type, other, scale)))
+            << "type " << type << " scale " << scale << " value " << other;
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(Jit64, QuantizedLoadStoreMatchesInterpreter)
+{
+  Core::DeclareAsCPUThread();
+  Common::ScopeGuard cpu_thread_guard([] { Core::UndeclareAsCPUThread(); });
+
+  // The routines have paths for different CPU features. Check all of them that this CPU can run.
+  const CPUInfo original_cpu_info = cpu_info;
+  Common::ScopeGuard cpu_info_guard([&] { cpu_info = original_cpu_info; });
+
+  for (const bool sse4_1 : {false, true})
+  {
+    for (const bool avx : {false, true})
+    {
+      if ((sse4_1 && !original_cpu_info.bSSE4_1) || (avx && !original_cpu_info.bAVX) ||
+          (avx && !sse4_1))
+      {
+        continue;
+      }
+
+      SCOPED_TRACE(testing::Message() << "SSE4.1 " << sse4_1 << " AVX " << avx);
+      cpu_info.bSSE4_1 = sse4_1;
+      cpu_info.bAVX = avx;
+
+      const TestQuantizedMemoryRoutines routines(Core::System::GetInstance());
+      CheckRoutines(routines);
+    }
+  }
+}
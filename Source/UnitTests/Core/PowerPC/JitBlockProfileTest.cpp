@@ -0,0 +1,76 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/PowerPC/JitCommon/JitBlockProfile.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+
+namespace
+{
+PPCAnalyst::CodeBuffer MakeCode(u32 address, u32 first_instruction, u32 num_instructions)
+{
+  PPCAnalyst::CodeBuffer code(num_instructions);
+  for (u32 i = 0; i < num_instructions; ++i)
+  {
+    code[i].address = address + i * 4;
+    code[i].inst.hex = first_instruction + i;
+  }
+  return code;
+}
+}  // namespace
+
+TEST(JitBlockProfile, PersistsBlocksAcrossSessions)
+{
+  const std::string folder = File::CreateTempDir();
+  const std::string path = folder + "/GALE01.jitprofile";
+  const PPCAnalyst::CodeBuffer code_a = MakeCode(0x80003000, 0x38600000, 4);
+  const PPCAnalyst::CodeBuffer code_b = MakeCode(0x80004000, 0x7c0802a6, 8);
+
+  {
+    JitBlockProfile profile;
+    profile.Open(path);
+    EXPECT_TRUE(profile.GetPendingBlocks().empty());
+    profile.Record(0x80003000, FEATURE_FLAG_MSR_IR, code_a);
+    profile.Record(0x80004000, FEATURE_FLAG_MSR_IR, code_b);
+    profile.Record(0x80004000, FEATURE_FLAG_MSR_IR, code_b);
+    EXPECT_EQ(profile.GetBlockCount(), 2u);
+  }
+
+  const PPCAnalyst::CodeBuffer changed_b = MakeCode(0x80004000, 0x7c0802a6, 6);
+  {
+    JitBlockProfile profile;
+    profile.Open(path);
+    const std::vector<JitBlockProfile::Block>& pending = profile.GetPendingBlocks();
+    ASSERT_EQ(pending.size(), 2u);
+    for (const JitBlockProfile::Block& block : pending)
+    {
+      const PPCAnalyst::CodeBuffer& code = block.effective_address == 0x80003000 ? code_a : code_b;
+      EXPECT_EQ(block.feature_flags, FEATURE_FLAG_MSR_IR);
+      EXPECT_EQ(block.first_instruction, code[0].inst.hex);
+      EXPECT_EQ(block.num_instructions, code.size());
+      EXPECT_EQ(block.code_hash, JitBlockProfile::HashCode(code));
+    }
+
+    // The same block with different code replaces the recorded one.
+    profile.Record(0x80004000, FEATURE_FLAG_MSR_IR, changed_b);
+  }
+
+  JitBlockProfile profile;
+  profile.Open(path);
+  ASSERT_EQ(profile.GetPendingBlocks().size(), 2u);
+  for (const JitBlockProfile::Block& block : profile.GetPendingBlocks())
+  {
+    if (block.effective_address == 0x80004000)
+      EXPECT_EQ(block.code_hash, JitBlockProfile::HashCode(changed_b));
+  }
+  EXPECT_NE(JitBlockProfile::HashCode(code_b), JitBlockProfile::HashCode(changed_b));
+  profile.Close();
+
+  File::DeleteDirRecursively(folder);
+}
@@ -0,0 +1,208 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/System.h"
+
+namespace
+{
+class FakeBlockCache final : public JitBaseBlockCache
+{
+public:
+  explicit FakeBlockCache(JitBase& jit) : JitBaseBlockCache(jit) {}
+
+  // The destination of each exit, by the address of its LinkData.
+  std::vector<std::pair<const JitBlock::LinkData*, const JitBlock*>> links;
+
+private:
+  void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override
+  {
+    links.emplace_back(&source, dest);
+  }
+};
+
+class FakeJit final : public JitBase
+{
+public:
+  explicit FakeJit(Core::System& system) : JitBase(system), m_block_cache(*this) {}
+
+  // CPUCoreBase methods
+  void Init() override {}
+  void Shutdown() override {}
+  void ClearCache() override {}
+  void Run() override {}
+  void SingleStep() override {}
+  const char* GetName() const override { return nullptr; }
+  // JitBase methods
+  JitBaseBlockCache* GetBlockCache() override { return &m_block_cache; }
+  void Jit(u32 em_address) override {}
+  void EraseSingleBlock(const JitBlock& block) override { m_block_cache.EraseSingleBlock(block); }
+  std::vector<MemoryStats> GetMemoryStats() const override { return {}; }
+  std::size_t DisassembleNearCode(const JitBlock&, std::ostream&) const override { return 0; }
+  std::size_t DisassembleFarCode(const JitBlock&, std::ostream&) const override { return 0; }
+  const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
+  bool HandleFault(uintptr_t access_address, SContext* ctx) override { return false; }
+
+  FakeBlockCache m_block_cache;
+};
+
+// Adds a finalized block of consecutive instructions with the given exits.
+JitBlock* AddBlock(JitBaseBlockCache& cache, u32 address, u32 num_instructions,
+                   const std::vector<u32>& exits = {})
+{
+  JitBlock* block = cache.AllocateBlock(address);
+  block->normalEntry = reinterpret_cast<u8*>(block);
+  for (u32 exit : exits)
+  {
+    JitBlock::LinkData link_data{};
+    link_data.exitAddress = exit;
+    block->linkData.push_back(link_data);
+  }
+
+  PPCAnalyst::CodeBlock code_block;
+  code_block.m_num_instructions = num_instructions;
+  for (u32 i = 0; i < num_instructions; ++i)
+    code_block.m_physical_addresses.insert(address + i * 4);
+
+  cache.FinalizeBlock(*block, true, code_block, {});
+  return block;
+}
+}  // namespace
+
+class JitCacheTest : public ::testing::Test
+{
+protected:
+  JitCacheTest() : m_jit(Core::System::GetInstance()), m_cache(m_jit.m_block_cache)
+  {
+    m_cache.Clear();
+  }
+
+  FakeJit m_jit;
+  FakeBlockCache& m_cache;
+};
+
+TEST_F(JitCacheTest, LookupAndInvalidate)
+{
+  JitBlock* a = AddBlock(m_cache, 0x80003000, 8);
+  // Crosses into the next page.
+  JitBlock* b = AddBlock(m_cache, 0x80003ff0, 8);
+  JitBlock* c = AddBlock(m_cache, 0x80004100, 4);
+  EXPECT_EQ(m_cache.GetBlockCount(), 3u);
+
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80003000, {}), a);
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80003ff0, {}), b);
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80004100, {}), c);
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80003004, {}), nullptr);
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80003000, FEATURE_FLAG_PERFMON), nullptr);
+
+  // Only the part of b that is in the second page.
+  m_cache.InvalidateICache(0x80004000, 0x20, false);
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80003ff0, {}), nullptr);
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80003000, {}), a);
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80004100, {}), c);
+  EXPECT_EQ(m_cache.GetBlockCount(), 2u);
+
+  // Right after the end of a.
+  m_cache.InvalidateICache(0x80003020, 0x20, false);
+  EXPECT_EQ(m_cache.GetBlockCount(), 2u);
+
+  m_jit.EraseSingleBlock(*c);
+  EXPECT_EQ(m_cache.GetBlockFromStartAddress(0x80004100, {}), nullptr);
+  EXPECT_EQ(m_cache.GetBlockCount(), 1u);
+
+  m_cache.ErasePhysicalRange(0x80003000, 0x2000);
+  EXPECT_EQ(m_cache.GetBlockCount(), 0u);
+}
+
+TEST_F(JitCacheTest, LinksFollowDestinationBlock)
+{
+  JitBlock* caller = AddBlock(m_cache, 0x80010000, 4, {0x80020000, 0x80030000});
+  JitBlock* other_caller = AddBlock(m_cache, 0x80010100, 4, {0x80020000});
+  EXPECT_FALSE(caller->linkData[0].linkStatus);
+
+  m_cache.links.clear();
+  JitBlock* callee = AddBlock(m_cache, 0x80020000, 4);
+  EXPECT_TRUE(caller->linkData[0].linkStatus);
+  EXPECT_FALSE(caller->linkData[1].linkStatus);
+  EXPECT_TRUE(other_caller->linkData[0].linkStatus);
+  EXPECT_EQ(m_cache.links.size(), 2u);
+  for (const auto& [link, dest] : m_cache.links)
+    EXPECT_EQ(dest, callee);
+
+  // Removing a caller takes its exits out of the list for the callee.
+  m_jit.EraseSingleBlock(*other_caller);
+  m_cache.links.clear();
+  m_cache.InvalidateICacheLine(0x80020000);
+  EXPECT_FALSE(caller->linkData[0].linkStatus);
+  ASSERT_EQ(m_cache.links.size(), 1u);
+  EXPECT_EQ(m_cache.links[0].first, &caller->linkData[0]);
+  EXPECT_EQ(m_cache.links[0].second, nullptr);
+
+  // Recompiling the callee links it again.
+  AddBlock(m_cache, 0x80020000, 4);
+  EXPECT_TRUE(caller->linkData[0].linkStatus);
+}
+
+// Not a test of correctness, but a way to measure the block cache operations that run on the CPU
+// thread during invalidation storms.
+TEST_F(JitCacheTest, Benchmark)
+{
+  constexpr u32 BASE = 0x80004000;
+  constexpr u32 NUM_BLOCKS = 0x10000;
+  constexpr u32 BLOCK_INSTRUCTIONS = 8;
+  constexpr u32 BLOCK_SIZE = BLOCK_INSTRUCTIONS * 4;
+  constexpr u32 CODE_SIZE = NUM_BLOCKS * BLOCK_SIZE;
+
+  using Clock = std::chrono::steady_clock;
+  const auto report = [](const char* name, u32 count, Clock::time_point start) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    fmt::print("{:<28} {:>8.1f} ns/op\n", name, static_cast<double>(ns.count()) / count);
+  };
+
+  const auto populate = [&] {
+    for (u32 i = 0; i < NUM_BLOCKS; ++i)
+    {
+      const u32 address = BASE + i * BLOCK_SIZE;
+      AddBlock(m_cache, address, BLOCK_INSTRUCTIONS, {address + BLOCK_SIZE, BASE});
+    }
+  };
+
+  Clock::time_point start = Clock::now();
+  populate();
+  report("FinalizeBlock", NUM_BLOCKS, start);
+  ASSERT_EQ(m_cache.GetBlockCount(), NUM_BLOCKS);
+
+  constexpr u32 NUM_LOOKUPS = NUM_BLOCKS * 8;
+  u32 found = 0;
+  start = Clock::now();
+  for (u32 i = 0; i < NUM_LOOKUPS; ++i)
+  {
+    const u32 address = BASE + (i * 7919 % NUM_BLOCKS) * BLOCK_SIZE;
+    found += m_cache.GetBlockFromStartAddress(address, {}) != nullptr;
+  }
+  report("GetBlockFromStartAddress", NUM_LOOKUPS, start);
+  EXPECT_EQ(found, NUM_LOOKUPS);
+
+  start = Clock::now();
+  for (u32 offset = 0; offset < CODE_SIZE; offset += 32)
+    m_cache.InvalidateICache(BASE + offset, 32, false);
+  report("InvalidateICache (32 bytes)", CODE_SIZE / 32, start);
+  EXPECT_EQ(m_cache.GetBlockCount(), 0u);
+
+  populate();
+  start = Clock::now();
+  for (u32 offset = 0; offset < CODE_SIZE; offset += 0x1000)
+    m_cache.ErasePhysicalRange(BASE + offset, 0x1000);
+  report("ErasePhysicalRange (4 KiB)", CODE_SIZE / 0x1000, start);
+  EXPECT_EQ(m_cache.GetBlockCount(), 0u);
+}
@@ -0,0 +1,174 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
+
+using State::DELTA_PAGE_SIZE;
+
+static std::vector<u8> MakeState(size_t size)
+{
+  std::vector<u8> state(size);
+  for (size_t i = 0; i < size; ++i)
+    state[i] = static_cast<u8>(i * 7 + i / 251);
+  return state;
+}
+
+static std::vector<u8> RoundTrip(const std::vector<u8>& base, const State::StateDelta& delta)
+{
+  Common::UniqueBuffer<u8> out;
+  EXPECT_TRUE(State::ApplyDelta(base, delta, out));
+  return std::vector<u8>(out.begin(), out.end());
+}
+
+static std::vector<u8> RoundTrip(const std::vector<u8>& base, const State::StateSections& sections,
+                                 const State::StateDelta& delta)
+{
+  Common::UniqueBuffer<u8> out;
+  EXPECT_TRUE(State::ApplyDelta(base, sections, delta, out));
+  return std::vector<u8>(out.begin(), out.end());
+}
+
+TEST(StateDelta, IdenticalStateIsEmpty)
+{
+  const std::vector<u8> base = MakeState(DELTA_PAGE_SIZE * 8);
+  State::StateDelta delta;
+  State::CreateDelta(base, base, delta);
+
+  EXPECT_TRUE(delta.pages.empty());
+  EXPECT_TRUE(delta.data.empty());
+  EXPECT_EQ(RoundTrip(base, delta), base);
+}
+
+TEST(StateDelta, OnlyChangedPagesAreStored)
+{
+  const std::vector<u8> base = MakeState(DELTA_PAGE_SIZE * 8);
+  std::vector<u8> current = base;
+  current[DELTA_PAGE_SIZE * 2 + 5] ^= 0xFF;
+  current[DELTA_PAGE_SIZE * 6] ^= 0x01;
+  current[DELTA_PAGE_SIZE * 6 + 1] ^= 0x01;
+
+  State::StateDelta delta;
+  State::CreateDelta(base, current, delta);
+
+  EXPECT_EQ(delta.pages, (std::vector<u32>{2, 6}));
+  EXPECT_EQ(delta.data.size(), DELTA_PAGE_SIZE * 2);
+  EXPECT_EQ(RoundTrip(base, delta), current);
+}
+
+TEST(StateDelta, GrowingState)
+{
+  const std::vector<u8> base = MakeState(DELTA_PAGE_SIZE * 3 + 100);
+  std::vector<u8> current = MakeState(DELTA_PAGE_SIZE * 5 + 17);
+
+  State::StateDelta delta;
+  State::CreateDelta(base, current, delta);
+
+  // The partial last page of the base and everything after it must be stored.
+  EXPECT_EQ(delta.pages, (std::vector<u32>{3, 4, 5}));
+  EXPECT_EQ(RoundTrip(base, delta), current);
+}
+
+TEST(StateDelta, ShrinkingState)
+{
+  const std::vector<u8> base = MakeState(DELTA_PAGE_SIZE * 5);
+  std::vector<u8> current(base.begin(), base.begin() + DELTA_PAGE_SIZE * 2 + 10);
+  current[1] ^= 0xFF;
+
+  State::StateDelta delta;
+  State::CreateDelta(base, current, delta);
+
+  EXPECT_EQ(delta.pages, (std::vector<u32>{0}));
+  EXPECT_EQ(RoundTrip(base, delta), current);
+}
+
+TEST(StateDelta, RejectsIncompleteDelta)
+{
+  const std::vector<u8> base = MakeState(DELTA_PAGE_SIZE);
+  const std::vector<u8> current = MakeState(DELTA_PAGE_SIZE * 3);
+
+  State::StateDelta delta;
+  State::CreateDelta(base, current, delta);
+  delta.pages.pop_back();
+  delta.data.resize(delta.data.size() - DELTA_PAGE_SIZE);
+
+  Common::UniqueBuffer<u8> out;
+  EXPECT_FALSE(State::ApplyDelta(base, delta, out));
+}
+
+// A small section in front of a large one, like the movie and texture cache data in front of
+// the emulated memory.
+static std::vector<u8> MakeSectionedState(size_t small_size, const std::vector<u8>& large,
+                                          State::StateSections* sections)
+{
+  std::vector<u8> state = MakeState(small_size);
+  state.insert(state.end(), large.begin(), large.end());
+  *sections = {small_size, state.size()};
+  return state;
+}
+
+TEST(StateDelta, GrowingSectionDoesNotShiftLaterSections)
+{
+  const std::vector<u8> large = MakeState(DELTA_PAGE_SIZE * 64);
+  std::vector<u8> changed_large = large;
+  changed_large[DELTA_PAGE_SIZE * 10 + 3] ^= 0xFF;
+
+  State::StateSections base_sections;
+  State::StateSections current_sections;
+  const std::vector<u8> base = MakeSectionedState(1000, large, &base_sections);
+  const std::vector<u8> current = MakeSectionedState(1016, changed_large, &current_sections);
+
+  State::StateDelta delta;
+  State::CreateDelta(base, base_sections, current, current_sections, delta);
+
+  // The first section has a single page, so the changed page of the second one is page 11.
+  EXPECT_EQ(delta.pages, (std::vector<u32>{0, 11}));
+  EXPECT_EQ(delta.data.size(), 1016 + DELTA_PAGE_SIZE);
+  EXPECT_EQ(delta.sections, current_sections);
+  EXPECT_EQ(RoundTrip(base, base_sections, delta), current);
+
+  // Compared as a single section, every page after the growing part looks changed.
+  State::StateDelta unsectioned_delta;
+  State::CreateDelta(base, current, unsectioned_delta);
+  EXPECT_GT(unsectioned_delta.pages.size(), 60u);
+}
+
+TEST(StateDelta, SectionMissingFromBaseIsStored)
+{
+  const std::vector<u8> base = MakeState(DELTA_PAGE_SIZE * 2);
+  const State::StateSections base_sections{base.size()};
+  std::vector<u8> current = base;
+  const std::vector<u8> extra = MakeState(DELTA_PAGE_SIZE + 1);
+  current.insert(current.end(), extra.begin(), extra.end());
+  const State::StateSections current_sections{base.size(), current.size()};
+
+  State::StateDelta delta;
+  State::CreateDelta(base, base_sections, current, current_sections, delta);
+
+  EXPECT_EQ(delta.pages, (std::vector<u32>{2, 3}));
+  EXPECT_EQ(RoundTrip(base, base_sections, delta), current);
+}
+
+TEST(StateDelta, RejectsDeltaWithoutShiftedSectionPages)
+{
+  const std::vector<u8> large = MakeState(DELTA_PAGE_SIZE * 4);
+  State::StateSections base_sections;
+  State::StateSections current_sections;
+  const std::vector<u8> base = MakeSectionedState(100, large, &base_sections);
+  const std::vector<u8> current = MakeSectionedState(200, large, &current_sections);
+
+  State::StateDelta delta;
+  State::CreateDelta(base, base_sections, current, current_sections, delta);
+  ASSERT_EQ(delta.pages, (std::vector<u32>{0}));
+  delta.pages.clear();
+  delta.data.clear();
+
+  Common::UniqueBuffer<u8> out;
+  EXPECT_FALSE(State::ApplyDelta(base, base_sections, delta, out));
+}
@@ -0,0 +1,141 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/Buffer.h"
+#include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
+#include "Core/StateRewind.h"
+
+constexpr size_t STATE_SIZE = State::DELTA_PAGE_SIZE * 16;
+
+// Every frame changes one page, so most captures are stored as small deltas.
+static Common::UniqueBuffer<u8> MakeState(u64 frame)
+{
+  Common::UniqueBuffer<u8> state(STATE_SIZE);
+  std::fill(state.begin(), state.end(), u8(0x55));
+  const size_t page = frame % 16;
+  std::fill_n(state.data() + page * State::DELTA_PAGE_SIZE, State::DELTA_PAGE_SIZE, u8(frame));
+  return state;
+}
+
+static bool MatchesFrame(const Common::UniqueBuffer<u8>& state, u64 frame)
+{
+  const Common::UniqueBuffer<u8> expected = MakeState(frame);
+  return state.size() == expected.size() &&
+         std::equal(state.begin(), state.end(), expected.begin());
+}
+
+static void PushFrames(State::RewindBuffer& buffer, u64 first, u64 last, u64 interval)
+{
+  for (u64 frame = first; frame <= last; frame += interval)
+    buffer.Push(frame, MakeState(frame), {STATE_SIZE}, 0);
+}
+
+TEST(StateRewind, RestoresNewestCaptureAtOrBeforeFrame)
+{
+  State::RewindBuffer buffer;
+  buffer.Reset(10, 64 * 1024 * 1024);
+  PushFrames(buffer, 0, 400, 10);
+
+  Common::UniqueBuffer<u8> out;
+  u64 restored_frame = 0;
+  ASSERT_TRUE(buffer.Restore(255, out, &restored_frame));
+  EXPECT_EQ(restored_frame, 250u);
+  EXPECT_TRUE(MatchesFrame(out, 250));
+
+  ASSERT_TRUE(buffer.Restore(1000, out, &restored_frame));
+  EXPECT_EQ(restored_frame, 400u);
+  EXPECT_TRUE(MatchesFrame(out, 400));
+
+  const State::RewindStats stats = buffer.GetStats();
+  EXPECT_EQ(stats.num_states, 41u);
+  EXPECT_EQ(stats.oldest_frame, 0u);
+  EXPECT_EQ(stats.newest_frame, 400u);
+  // The uncompressed keyframe and the spare buffer are counted too.
+  EXPECT_GE(stats.memory_usage, 2 * STATE_SIZE);
+}
+
+TEST(StateRewind, EvictsOldestCapturesOverBudget)
+{
+  State::RewindBuffer buffer;
+  buffer.Reset(1, 16 * 1024);
+  PushFrames(buffer, 0, 300, 1);
+
+  Common::UniqueBuffer<u8> out;
+  u64 restored_frame = 0;
+  ASSERT_TRUE(buffer.Restore(300, out, &restored_frame));
+  EXPECT_TRUE(MatchesFrame(out, 300));
+  EXPECT_FALSE(buffer.Restore(0, out, &restored_frame));
+
+  const State::RewindStats stats = buffer.GetStats();
+  EXPECT_GT(stats.oldest_frame, 0u);
+  EXPECT_LT(stats.num_states, 301u);
+}
+
+TEST(StateRewind, OlderCaptureReplacesHistory)
+{
+  State::RewindBuffer buffer;
+  buffer.Reset(1, 64 * 1024 * 1024);
+  PushFrames(buffer, 0, 100, 1);
+
+  buffer.DiscardAfter(40);
+  EXPECT_TRUE(buffer.HasCaptureForFrame(40));
+  EXPECT_EQ(buffer.GetStats().newest_frame, 40u);
+
+  // After going back, the timeline diverges from the discarded captures.
+  buffer.Push(30, MakeState(1234), {STATE_SIZE}, 0);
+
+  Common::UniqueBuffer<u8> out;
+  u64 restored_frame = 0;
+  ASSERT_TRUE(buffer.Restore(35, out, &restored_frame));
+  EXPECT_EQ(restored_frame, 30u);
+  EXPECT_TRUE(MatchesFrame(out, 1234));
+
+  ASSERT_TRUE(buffer.Restore(29, out, &restored_frame));
+  EXPECT_TRUE(MatchesFrame(out, 29));
+}
+
+TEST(StateRewind, GrowingSectionKeepsDeltas)
+{
+  State::RewindBuffer buffer;
+  buffer.Reset(1, 64 * 1024 * 1024);
+
+  // A small section in front of the memory that grows every frame, like the movie input log.
+  const auto make_sectioned_state = [](u64 frame, State::StateSections* sections) {
+    const size_t small_size = 100 + frame * 8;
+    Common::UniqueBuffer<u8> state(small_size + STATE_SIZE);
+    std::fill_n(state.data(), small_size, u8(frame));
+    const Common::UniqueBuffer<u8> memory = MakeState(frame);
+    std::copy(memory.begin(), memory.end(), state.data() + small_size);
+    *sections = {small_size, state.size()};
+    return state;
+  };
+
+  for (u64 frame = 0; frame < 32; ++frame)
+  {
+    State::StateSections sections;
+    Common::UniqueBuffer<u8> state = make_sectioned_state(frame, &sections);
+    buffer.Push(frame, std::move(state), std::move(sections), 0);
+  }
+
+  Common::UniqueBuffer<u8> out;
+  u64 restored_frame = 0;
+  ASSERT_TRUE(buffer.Restore(31, out, &restored_frame));
+  State::StateSections sections;
+  const Common::UniqueBuffer<u8> expected = make_sectioned_state(31, &sections);
+  EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+
+  // Only the keyframes that are due after a run of deltas are stored.
+  const State::RewindStats stats = buffer.GetStats();
+  EXPECT_EQ(stats.total_keyframes, 2u);
+  EXPECT_EQ(stats.forced_keyframes, 0u);
+  EXPECT_EQ(stats.total_deltas, 30u);
+  EXPECT_EQ(stats.num_keyframes, 2u);
+  EXPECT_EQ(stats.num_deltas, 30u);
+  EXPECT_LT(stats.last_delta_size, STATE_SIZE / 4);
+}
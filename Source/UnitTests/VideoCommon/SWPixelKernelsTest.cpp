@@ -0,0 +1,227 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/PixelKernels.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using PixelKernels::CombinerInputs;
+using PixelKernels::CombinerParams;
+
+struct Kernels
+{
+  const char* name;
+  PixelKernels::CombineFunction combine;
+  PixelKernels::FilterFunction filter;
+};
+
+std::vector<Kernels> GetKernels()
+{
+  std::vector<Kernels> kernels{{"Scalar", PixelKernels::Scalar::Combine,
+                                PixelKernels::Scalar::FilterTexels}};
+#ifdef _M_X86_64
+  if (cpu_info.bAVX2)
+    kernels.push_back({"AVX2", PixelKernels::AVX2::Combine, PixelKernels::AVX2::FilterTexels});
+#endif
+  return kernels;
+}
+
+constexpr std::array<s32, 3> BIAS{0, 128, -128};
+constexpr std::array<u32, 4> LEFT_SHIFT{0, 1, 2, 0};
+constexpr std::array<u32, 4> RIGHT_SHIFT{0, 0, 0, 1};
+
+// The combiner as the Tev computed it one channel at a time before it used the kernels.
+s32 ReferenceCombine(bool alpha, u32 a, u32 b, u32 c_in, s32 d, u32 bias, bool sub, u32 scale)
+{
+  const u16 c = c_in + (c_in >> 7);
+
+  s32 temp = a * (256 - c) + (b * c);
+  temp <<= LEFT_SHIFT[scale];
+  temp += (scale == 3) ? 0 : sub ? 127 : 128;
+  if (alpha)
+  {
+    temp = sub ? (-temp >> 8) : (temp >> 8);
+  }
+  else
+  {
+    temp >>= 8;
+    temp = sub ? -temp : temp;
+  }
+
+  s32 result = ((d + BIAS[bias]) << LEFT_SHIFT[scale]) + temp;
+  return result >> RIGHT_SHIFT[scale];
+}
+
+CombinerParams MakeParams(u32 color_bias, bool color_sub, u32 color_scale, u32 alpha_bias,
+                          bool alpha_sub, u32 alpha_scale)
+{
+  CombinerParams params;
+  for (int i = 0; i < 4; i++)
+  {
+    const bool alpha = i == 0;
+    const u32 bias = alpha ? alpha_bias : color_bias;
+    const bool sub = alpha ? alpha_sub : color_sub;
+    const u32 scale = alpha ? alpha_scale : color_scale;
+
+    params.bias[i] = BIAS[bias];
+    params.round[i] = scale == 3 ? 0 : sub ? 127 : 128;
+    params.left_shift[i] = LEFT_SHIFT[scale];
+    params.right_shift[i] = RIGHT_SHIFT[scale];
+    params.negate_before_shift[i] = alpha && sub ? -1 : 0;
+    params.negate_after_shift[i] = !alpha && sub ? -1 : 0;
+  }
+  return params;
+}
+}  // namespace
+
+TEST(SWPixelKernels, CombineMatchesReference)
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> u8_dist(0, 255);
+  std::uniform_int_distribution<int> d_dist(-1024, 1023);
+
+  // Values at the edges of the input ranges, followed by random ones
+  std::vector<CombinerInputs> inputs;
+  for (const s16 edge_abc : {0, 1, 127, 128, 129, 254, 255})
+  {
+    for (const s16 edge_d : {-1024, -129, -1, 0, 1, 255, 1023})
+    {
+      inputs.push_back({{edge_abc, 255, 0, edge_abc},
+                        {0, edge_abc, 255, edge_abc},
+                        {edge_abc, edge_abc, 128, 255},
+                        {edge_d, edge_d, 0, edge_d}});
+    }
+  }
+  for (int i = 0; i < 2000; i++)
+  {
+    CombinerInputs input;
+    for (int lane = 0; lane < 4; lane++)
+    {
+      input.a[lane] = static_cast<s16>(u8_dist(rng));
+      input.b[lane] = static_cast<s16>(u8_dist(rng));
+      input.c[lane] = static_cast<s16>(u8_dist(rng));
+      input.d[lane] = static_cast<s16>(d_dist(rng));
+    }
+    inputs.push_back(input);
+  }
+
+  for (const Kernels& kernels : GetKernels())
+  {
+    SCOPED_TRACE(kernels.name);
+
+    for (u32 bias = 0; bias < 3; bias++)
+    {
+      for (const bool sub : {false, true})
+      {
+        for (u32 scale = 0; scale < 4; scale++)
+        {
+          // Use different settings for alpha, so mixing up the lanes is noticed.
+          const u32 alpha_bias = (bias + 1) % 3;
+          const bool alpha_sub = !sub;
+          const u32 alpha_scale = (scale + 1) % 4;
+          const CombinerParams params =
+              MakeParams(bias, sub, scale, alpha_bias, alpha_sub, alpha_scale);
+
+          for (const CombinerInputs& input : inputs)
+          {
+            std::array<s16, 4> result;
+            kernels.combine(input, params, &result);
+
+            for (int lane = 0; lane < 4; lane++)
+            {
+              const bool alpha = lane == 0;
+              const s32 expected = ReferenceCombine(
+                  alpha, input.a[lane], input.b[lane], input.c[lane], input.d[lane],
+                  alpha ? alpha_bias : bias, alpha ? alpha_sub : sub, alpha ? alpha_scale : scale);
+              ASSERT_EQ(result[lane], expected)
+                  << "lane " << lane << " bias " << bias << " sub " << sub << " scale " << scale
+                  << " a " << input.a[lane] << " b " << input.b[lane] << " c " << input.c[lane]
+                  << " d " << input.d[lane];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(SWPixelKernels, FilterMatchesReference)
+{
+  std::mt19937 rng(5678);
+  std::uniform_int_distribution<int> u8_dist(0, 255);
+
+  for (const Kernels& kernels : GetKernels())
+  {
+    SCOPED_TRACE(kernels.name);
+
+    for (int i = 0; i < 64; i++)
+    {
+      u8 texels[4][4];
+      for (auto& texel : texels)
+      {
+        for (u8& channel : texel)
+          channel = i == 0 ? 255 : static_cast<u8>(u8_dist(rng));
+      }
+
+      // Bilinear filtering, as done by the texture sampler
+      for (u32 fract_s = 0; fract_s < 128; fract_s++)
+      {
+        for (u32 fract_t = 0; fract_t < 128; fract_t++)
+        {
+          const u32 weights[4] = {(128 - fract_s) * (128 - fract_t), fract_s * (128 - fract_t),
+                                  (128 - fract_s) * fract_t, fract_s * fract_t};
+          u8 sample[4];
+          kernels.filter(texels, weights, 14, sample);
+
+          for (int channel = 0; channel < 4; channel++)
+          {
+            u32 expected = 0;
+            for (int texel = 0; texel < 4; texel++)
+              expected += texels[texel][channel] * weights[texel];
+            ASSERT_EQ(sample[channel], static_cast<u8>(expected >> 14))
+                << "fract " << fract_s << " " << fract_t << " channel " << channel;
+          }
+        }
+      }
+
+      // Blending between two mipmaps
+      for (u32 lod_fract = 0; lod_fract < 16; lod_fract++)
+      {
+        const u32 weights[4] = {16 - lod_fract, lod_fract, 0, 0};
+        u8 sample[4];
+        kernels.filter(texels, weights, 4, sample);
+
+        for (int channel = 0; channel < 4; channel++)
+        {
+          const u32 expected =
+              texels[0][channel] * (16 - lod_fract) + texels[1][channel] * lod_fract;
+          ASSERT_EQ(sample[channel], static_cast<u8>(expected >> 4))
+              << "lod fract " << lod_fract << " channel " << channel;
+        }
+      }
+
+      // Blending with the fog color
+      for (u32 fog = 0; fog <= 256; fog++)
+      {
+        const u32 weights[4] = {256 - fog, fog, 0, 0};
+        u8 sample[4];
+        kernels.filter(texels, weights, 8, sample);
+
+        for (int channel = 0; channel < 4; channel++)
+        {
+          const u32 expected = texels[0][channel] * (256 - fog) + texels[1][channel] * fog;
+          ASSERT_EQ(sample[channel], static_cast<u8>(expected >> 8))
+              << "fog " << fog << " channel " << channel;
+        }
+      }
+    }
+  }
+}
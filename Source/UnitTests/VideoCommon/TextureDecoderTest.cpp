@@ -0,0 +1,55 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
+#include "VideoCommon/TextureDecoder.h"
+
+#include <gtest/gtest.h>
+
+TEST(TextureDecoder, ParallelDecodeMatchesSerial)
+{
+  constexpr TextureFormat FORMATS[] = {
+      TextureFormat::I4,     TextureFormat::I8,    TextureFormat::IA4, TextureFormat::IA8,
+      TextureFormat::RGB565, TextureFormat::RGB5A3, TextureFormat::RGBA8, TextureFormat::C4,
+      TextureFormat::C8,     TextureFormat::C14X2, TextureFormat::CMPR,
+  };
+  // Sizes that don't split evenly into bands, and one that is too small to be split at all
+  constexpr std::pair<int, int> SIZES[] = {{1024, 1024}, {256, 200}, {1016, 72}, {64, 64}};
+
+  Common::ThreadPool pool;
+  pool.Start("Texture Decoder Test", 4);
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> byte_dist(0, 255);
+
+  std::vector<u8> tlut(0x8000);
+  for (u8& byte : tlut)
+    byte = static_cast<u8>(byte_dist(rng));
+
+  for (const TextureFormat format : FORMATS)
+  {
+    for (const auto& [width, height] : SIZES)
+    {
+      SCOPED_TRACE(fmt::format("{} {}x{}", format, width, height));
+
+      std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(width, height, format));
+      for (u8& byte : src)
+        byte = static_cast<u8>(byte_dist(rng));
+
+      std::vector<u8> serial(width * height * 4);
+      std::vector<u8> parallel(width * height * 4);
+      TexDecoder_Decode(serial.data(), src.data(), width, height, format, tlut.data(),
+                        TLUTFormat::RGB5A3);
+      TexDecoder_Decode(parallel.data(), src.data(), width, height, format, tlut.data(),
+                        TLUTFormat::RGB5A3, &pool);
+
+      EXPECT_EQ(serial, parallel);
+    }
+  }
+}
@@ -0,0 +1,138 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureHashIndex.h"
+
+#include <gtest/gtest.h>
+
+using VideoCommon::TextureHashIndex;
+
+namespace
+{
+std::vector<int> FindAll(const TextureHashIndex<int>& index, u64 hash)
+{
+  std::vector<int> values;
+  index.ForEach(hash, [&](int value) {
+    values.push_back(value);
+    return false;
+  });
+  return values;
+}
+
+std::vector<int> FindAll(const std::multimap<u64, int>& reference, u64 hash)
+{
+  std::vector<int> values;
+  const auto range = reference.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+    values.push_back(it->second);
+  return values;
+}
+}  // namespace
+
+TEST(TextureHashIndex, Empty)
+{
+  TextureHashIndex<int> index;
+  EXPECT_EQ(index.Size(), 0u);
+  EXPECT_TRUE(FindAll(index, 1234).empty());
+  EXPECT_FALSE(index.Erase(1234, 1));
+}
+
+TEST(TextureHashIndex, KeepsInsertionOrderForEqualHashes)
+{
+  TextureHashIndex<int> index;
+  for (int i = 0; i < 10; i++)
+    index.Insert(42, i);
+  index.Insert(43, 100);
+
+  EXPECT_EQ(FindAll(index, 42), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  EXPECT_TRUE(index.Erase(42, 3));
+  EXPECT_FALSE(index.Erase(42, 3));
+  EXPECT_EQ(FindAll(index, 42), (std::vector<int>{0, 1, 2, 4, 5, 6, 7, 8, 9}));
+  EXPECT_EQ(FindAll(index, 43), (std::vector<int>{100}));
+  EXPECT_EQ(index.Size(), 10u);
+}
+
+TEST(TextureHashIndex, StopsWhenFunctionReturnsTrue)
+{
+  TextureHashIndex<int> index;
+  for (int i = 0; i < 5; i++)
+    index.Insert(7, i);
+
+  std::vector<int> visited;
+  index.ForEach(7, [&](int value) {
+    visited.push_back(value);
+    return value == 2;
+  });
+  EXPECT_EQ(visited, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(TextureHashIndex, MatchesMultimap)
+{
+  std::mt19937_64 rng(99);
+  // Few distinct hashes, so that there are long runs of equal hashes and many collisions
+  std::uniform_int_distribution<u64> hash_dist(0, 300);
+  std::uniform_int_distribution<int> op_dist(0, 2);
+
+  TextureHashIndex<int> index;
+  std::multimap<u64, int> reference;
+  std::vector<std::pair<u64, int>> inserted;
+
+  for (int i = 0; i < 20000; i++)
+  {
+    if (op_dist(rng) != 0 || inserted.empty())
+    {
+      const u64 hash = hash_dist(rng) * 0x100000001ULL;
+      index.Insert(hash, i);
+      reference.emplace(hash, i);
+      inserted.emplace_back(hash, i);
+    }
+    else
+    {
+      std::uniform_int_distribution<std::size_t> pick(0, inserted.size() - 1);
+      const std::size_t victim = pick(rng);
+      const auto [hash, value] = inserted[victim];
+      inserted[victim] = inserted.back();
+      inserted.pop_back();
+
+      ASSERT_TRUE(index.Erase(hash, value));
+      const auto range = reference.equal_range(hash);
+      reference.erase(std::find_if(range.first, range.second,
+                                   [value](const auto& it) { return it.second == value; }));
+    }
+
+    if (i % 97 == 0)
+    {
+      ASSERT_EQ(index.Size(), reference.size());
+      for (u64 hash = 0; hash <= 300; hash++)
+      {
+        const u64 key = hash * 0x100000001ULL;
+        std::vector<int> values = FindAll(index, key);
+        std::vector<int> expected = FindAll(reference, key);
+        std::ranges::sort(values);
+        std::ranges::sort(expected);
+        ASSERT_EQ(values, expected) << "hash " << key;
+      }
+    }
+  }
+
+  std::size_t count = 0;
+  index.ForEachEntry([&](u64 hash, int value) {
+    ++count;
+    const auto range = reference.equal_range(hash);
+    EXPECT_NE(std::find_if(range.first, range.second,
+                           [value](const auto& it) { return it.second == value; }),
+              range.second);
+  });
+  EXPECT_EQ(count, reference.size());
+
+  index.Clear();
+  EXPECT_EQ(index.Size(), 0u);
+  EXPECT_TRUE(FindAll(index, 0).empty());
+}